@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/dbus/codec.h>
+#include <biometry/devices/fingerprint_reader.h>
+#include <biometry/dictionary.h>
+#include <biometry/progress.h>
+#include <biometry/variant.h>
+#include <biometry/util/statistics.h>
+
+#include <core/dbus/message.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// benchmark_codec measures the cost of the types travelling with every progress update:
+//   * encoding and decoding progress payloads carrying guidance hints with masks and
+//     blob previews between 1 kB and 1 MB to and from D-Bus messages,
+//   * copying and assigning Variant instances,
+//   * looking up entries in and decoding hints from a Dictionary.
+// Pass --json to receive the results in a machine-readable format.
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+// Safe us some typing.
+typedef biometry::devices::FingerprintReader::GuidedEnrollment::Hints Hints;
+
+static constexpr const std::size_t trials{25};
+
+struct Result
+{
+    std::string name;
+    biometry::util::Statistics stats; ///< Cost of a single iteration in [ns].
+};
+
+// measure runs f for trials batches of iterations, returning statistics over the cost
+// of a single iteration. Batching keeps clock overhead out of the results for cheap operations.
+biometry::util::Statistics measure(std::size_t iterations, const std::function<void()>& f)
+{
+    biometry::util::Statistics stats;
+
+    for (std::size_t t = 0; t < trials; t++)
+    {
+        auto before = Clock::now();
+        for (std::size_t i = 0; i < iterations; i++)
+            f();
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before);
+        stats.update(duration.count() / static_cast<double>(iterations));
+    }
+
+    return stats;
+}
+
+// iterations_for returns the number of iterations per batch for payloads of size bytes,
+// keeping the runtime of a batch roughly constant.
+std::size_t iterations_for(std::size_t size)
+{
+    return std::max<std::size_t>(1, (1 << 20) / std::max<std::size_t>(size, 1024));
+}
+
+core::dbus::Message::Ptr make_message()
+{
+    return core::dbus::Message::make_method_call(
+                "com.ubuntu.biometryd.Benchmark",
+                core::dbus::types::ObjectPath{"/com/ubuntu/biometryd/Benchmark"},
+                "com.ubuntu.biometryd.Benchmark",
+                "Progress");
+}
+
+// make_hints returns hints as reported by a fingerprint reader during enrollment,
+// with mask_count rectangles marking the regions that have been scanned.
+Hints make_hints(std::size_t mask_count)
+{
+    Hints hints;
+    hints.is_finger_present = true;
+    hints.is_main_cluster_identified = true;
+    hints.suggested_next_direction = biometry::devices::FingerprintReader::Direction::north_east;
+    hints.masks = std::vector<biometry::Rectangle>{};
+
+    for (std::size_t i = 0; i < mask_count; i++)
+        hints.masks->push_back(biometry::Rectangle{biometry::Point{0.01 * i, 0.01 * i}, biometry::Point{0.01 * i + 0.1, 0.01 * i + 0.1}});
+
+    return hints;
+}
+
+// make_progress returns a progress update carrying hints and, if preview_size is
+// larger than 0, a preview image of preview_size bytes.
+biometry::Progress make_progress(std::size_t mask_count, std::size_t preview_size)
+{
+    biometry::Progress progress;
+    progress.percent = biometry::Percent::from_raw_value(0.42);
+    progress.details = make_hints(mask_count).to_dictionary();
+
+    if (preview_size > 0)
+        progress.details["preview"] = biometry::Variant::bl(std::vector<std::uint8_t>(preview_size, 42));
+
+    return progress;
+}
+
+std::string describe(std::size_t size)
+{
+    return size >= (1 << 20) ? std::to_string(size >> 20) + "MB" : std::to_string(size >> 10) + "kB";
+}
+
+std::vector<Result> run_codec()
+{
+    std::vector<Result> results;
+
+    results.push_back({"message/create", measure(10000, []()
+    {
+        make_message();
+    })});
+
+    const std::vector<std::pair<std::string, biometry::Progress>> payloads
+    {
+        {"hints/4 masks", make_progress(4, 0)},
+        {"hints/64 masks", make_progress(64, 0)},
+        {"preview/1kB", make_progress(4, 1 << 10)},
+        {"preview/64kB", make_progress(4, 1 << 16)},
+        {"preview/1MB", make_progress(4, 1 << 20)}
+    };
+
+    for (const auto& payload : payloads)
+    {
+        auto it = payload.second.details.find("preview");
+        auto iterations = iterations_for(it == payload.second.details.end() ? 0 : it->second.blob().size());
+
+        results.push_back({"encode/" + payload.first, measure(iterations, [&payload]()
+        {
+            make_message()->writer() << payload.second;
+        })});
+
+        auto msg = make_message();
+        msg->writer() << payload.second;
+
+        results.push_back({"decode/" + payload.first, measure(iterations, [&msg]()
+        {
+            biometry::Progress progress;
+            msg->reader() >> progress;
+        })});
+    }
+
+    return results;
+}
+
+std::vector<Result> run_variant()
+{
+    std::vector<Result> results;
+
+    const std::vector<std::pair<std::string, biometry::Variant>> values
+    {
+        {"integer", biometry::Variant::i(42)},
+        {"string", biometry::Variant::s("FingerprintReader::Hints::is_finger_present")},
+        {"masks/64", make_hints(64).to_dictionary().at(Hints::key_masks)},
+        {"blob/1kB", biometry::Variant::bl(std::vector<std::uint8_t>(1 << 10, 42))},
+        {"blob/1MB", biometry::Variant::bl(std::vector<std::uint8_t>(1 << 20, 42))}
+    };
+
+    for (const auto& value : values)
+    {
+        auto iterations = value.second.type() == biometry::Variant::Type::blob ? iterations_for(value.second.blob().size()) : 100000;
+
+        results.push_back({"variant/copy/" + value.first, measure(iterations, [&value]()
+        {
+            biometry::Variant copy{value.second};
+            (void) copy;
+        })});
+
+        biometry::Variant target = biometry::Variant::i(0);
+        results.push_back({"variant/assign/" + value.first, measure(iterations, [&value, &target]()
+        {
+            target = value.second;
+        })});
+    }
+
+    return results;
+}
+
+std::vector<Result> run_dictionary()
+{
+    std::vector<Result> results;
+
+    auto dict = make_progress(16, 1 << 10).details;
+    for (std::size_t i = 0; i < 16; i++)
+        dict["vendor::key" + std::to_string(i)] = biometry::Variant::i(i);
+
+    results.push_back({"dictionary/find", measure(100000, [&dict]()
+    {
+        auto it = dict.find(Hints::key_is_finger_present);
+        if (it == dict.end()) std::cout << "missing key" << std::endl;
+    })});
+
+    results.push_back({"dictionary/copy", measure(10000, [&dict]()
+    {
+        biometry::Dictionary copy{dict};
+        (void) copy;
+    })});
+
+    results.push_back({"hints/from_dictionary", measure(10000, [&dict]()
+    {
+        Hints hints;
+        hints.from_dictionary(dict);
+    })});
+
+    auto hints = make_hints(16);
+    results.push_back({"hints/to_dictionary", measure(10000, [&hints]()
+    {
+        hints.to_dictionary();
+    })});
+
+    return results;
+}
+
+void print_header(std::ostream& out)
+{
+    out << std::setw(32) << std::left << "operation"
+        << std::setw(16) << std::right << "mean"
+        << std::setw(16) << std::right << "std.dev."
+        << std::setw(16) << std::right << "min"
+        << std::setw(16) << std::right << "max"
+        << std::setw(8) << std::right << "unit" << std::endl;
+}
+
+void print(std::ostream& out, const Result& result)
+{
+    out << std::setw(32) << std::left << result.name
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << result.stats.mean()
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << std::sqrt(result.stats.variance())
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << result.stats.min()
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << result.stats.max()
+        << std::setw(8) << std::right << "ns" << std::endl;
+}
+
+void print_json(std::ostream& out, const std::vector<Result>& results)
+{
+    out << "{\"benchmark\": \"codec\", \"unit\": \"ns\", \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const auto& r = results[i];
+        out << (i > 0 ? ", " : "")
+            << "{\"operation\": \"" << r.name << "\""
+            << std::fixed << std::setprecision(2)
+            << ", \"mean\": " << r.stats.mean()
+            << ", \"stddev\": " << std::sqrt(r.stats.variance())
+            << ", \"min\": " << r.stats.min()
+            << ", \"max\": " << r.stats.max() << "}";
+    }
+
+    out << "]}" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+
+    bool json{false};
+
+    po::options_description desc{"benchmark_codec"};
+    desc.add_options()
+        ("help", "prints this help")
+        ("json", po::bool_switch(&json), "print results in JSON format");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::vector<Result> results;
+    for (const auto& suite : {run_codec, run_variant, run_dictionary})
+    {
+        auto r = suite();
+        results.insert(results.end(), r.begin(), r.end());
+    }
+
+    if (json)
+    {
+        print_json(std::cout, results);
+    }
+    else
+    {
+        print_header(std::cout);
+        for (const auto& result : results)
+            print(std::cout, result);
+    }
+
+    return EXIT_SUCCESS;
+}
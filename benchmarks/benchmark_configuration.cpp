@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/util/benchmark.h>
+#include <biometry/util/binary_configuration_builder.h>
+#include <biometry/util/configuration.h>
+#include <biometry/util/json_configuration_builder.h>
+#include <biometry/util/statistics.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// benchmark_configuration measures loading a large vendor device configuration:
+//   * decoding the JSON source,
+//   * loading the binary form created by 'biometryd config compile',
+//   * resolving common paths within the resulting Configuration.
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+static constexpr const std::size_t trials{50};
+static constexpr const std::size_t sensors{256};
+static constexpr const std::size_t calibration_points{128};
+static constexpr const std::size_t lookups{1000000};
+
+// make_vendor_config returns a JSON configuration resembling what vendors ship for
+// devices with a larger number of sensor profiles and calibration tables.
+std::string make_vendor_config()
+{
+    std::stringstream ss;
+    ss << R"_({"defaultDevice": {"id": "android", "config": {"vendor": "ACME Corp.", "model": "Fingerprint Sensor FS-1000", "sensors": [)_";
+
+    for (std::size_t s = 0; s < sensors; s++)
+    {
+        if (s > 0) ss << ",";
+        ss << R"_({"id": )_" << s
+           << R"_(, "name": "sensor-)_" << s
+           << R"_(", "enabled": )_" << (s % 2 == 0 ? "true" : "false")
+           << R"_(, "threshold": )_" << 0.5 + s / 1000.
+           << R"_(, "geometry": {"x": 0, "y": 0, "width": 160, "height": 160}, "calibration": [)_";
+
+        for (std::size_t c = 0; c < calibration_points; c++)
+            ss << (c > 0 ? "," : "") << (s * calibration_points + c) / 3.;
+
+        ss << "]}";
+    }
+
+    ss << R"_(]}}, "dispatcher": {"type": "workerThread", "capacity": 1024}})_";
+    return ss.str();
+}
+
+void print_header(std::ostream& out)
+{
+    out << std::setw(24) << std::left << "operation"
+        << std::setw(16) << std::right << "mean"
+        << std::setw(16) << std::right << "std.dev."
+        << std::setw(16) << std::right << "min"
+        << std::setw(16) << std::right << "max"
+        << std::setw(8) << std::right << "unit" << std::endl;
+}
+
+void print(std::ostream& out, const std::string& name, const biometry::util::Statistics& stats, const std::string& unit)
+{
+    out << std::setw(24) << std::left << name
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << stats.mean()
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << std::sqrt(stats.variance())
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << stats.min()
+        << std::setw(16) << std::right << std::fixed << std::setprecision(2) << stats.max()
+        << std::setw(8) << std::right << unit << std::endl;
+}
+}
+
+int main()
+{
+    const auto json = make_vendor_config();
+
+    const auto source = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("biometryd-benchmark-%%%%-%%%%.json");
+    const auto compiled = biometry::util::compiled_configuration_path_for(source);
+
+    std::ofstream{source.string()} << json;
+    biometry::util::compile_configuration(source, compiled);
+
+    std::cout << "Vendor configuration: " << json.size() << " bytes JSON, "
+              << boost::filesystem::file_size(compiled) << " bytes binary" << std::endl;
+
+    print_header(std::cout);
+
+    print(std::cout, "json", biometry::util::Benchmark{[&json]()
+    {
+        std::stringstream in{json};
+        biometry::util::JsonConfigurationBuilder{in}.build_configuration();
+    }}.trials(trials).run(), "µs");
+
+    print(std::cout, "binary", biometry::util::Benchmark{[&compiled]()
+    {
+        biometry::util::BinaryConfigurationBuilder{compiled}.build_configuration();
+    }}.trials(trials).run(), "µs");
+
+    print(std::cout, "load_configuration", biometry::util::Benchmark{[&source]()
+    {
+        biometry::util::load_configuration(source);
+    }}.trials(trials).run(), "µs");
+
+    const auto configuration = biometry::util::load_configuration(source);
+
+    biometry::util::Statistics lookup;
+    for (std::size_t t = 0; t < trials; t++)
+    {
+        double sum = 0;
+        auto before = Clock::now();
+
+        for (std::size_t i = 0; i < lookups / trials; i++)
+        {
+            const auto& sensor = configuration["defaultDevice"]["config"]["sensors"][i % sensors];
+            sum += sensor["threshold"].value().floating_point();
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before);
+        lookup.update(duration.count() / static_cast<double>(lookups / trials));
+
+        // Keep the compiler from dropping the lookups.
+        if (sum < 0) std::cout << sum;
+    }
+
+    print(std::cout, "lookup", lookup, "ns");
+
+    boost::filesystem::remove(source);
+    boost::filesystem::remove(compiled);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/application.h>
+#include <biometry/dispatching_service.h>
+#include <biometry/reason.h>
+#include <biometry/runtime.h>
+#include <biometry/user.h>
+
+#include <biometry/dbus/skeleton/service.h>
+#include <biometry/dbus/stub/service.h>
+
+#include <biometry/devices/simulated.h>
+#include <biometry/util/dispatcher.h>
+#include <biometry/util/statistics.h>
+
+#include <core/dbus/asio/executor.h>
+#include <core/dbus/fixture.h>
+#include <core/posix/fork.h>
+#include <core/posix/signal.h>
+
+#include <boost/program_options.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// benchmark_dbus measures the complete stack from stub to skeleton and device:
+// a daemon process exposes a Simulated device without any latency on a private bus,
+// and N concurrent clients drive size, list, enroll and identify operations
+// through their own connections. For every kind of operation, we report:
+//   * the overall throughput in operations per second,
+//   * percentiles of the latency of individual operations,
+//   * allocations per operation in the daemon and in the clients,
+//   * the growth of the daemon's resident set size.
+// Pass --json to receive the results in a machine-readable format.
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+static constexpr const std::chrono::seconds operation_timeout{30};
+static constexpr const std::chrono::milliseconds daemon_startup{500};
+
+// Allocations counts calls to operator new. The counters live in memory shared
+// with the forked daemon, keeping allocations of the daemon and the clients apart.
+struct Allocations
+{
+    std::atomic<std::uint64_t> daemon{0};
+    std::atomic<std::uint64_t> clients{0};
+};
+
+Allocations* allocations{nullptr};
+bool is_daemon{false};
+}
+
+void* operator new(std::size_t size)
+{
+    if (allocations)
+        (is_daemon ? allocations->daemon : allocations->clients).fetch_add(1, std::memory_order_relaxed);
+
+    if (auto p = std::malloc(size > 0 ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+struct Options
+{
+    std::size_t clients{4};      ///< Number of concurrent clients.
+    std::size_t operations{500}; ///< Operations per client and kind of operation.
+    bool json{false};            ///< Print results in JSON format.
+};
+
+struct Result
+{
+    std::string operation;
+    std::size_t count{0};               ///< Operations started.
+    std::size_t failures{0};            ///< Operations that did not succeed.
+    double throughput{0};               ///< Operations per second.
+    biometry::util::Statistics latency; ///< Latency in [µs].
+    double p50{0}, p90{0}, p99{0};      ///< Latency percentiles in [µs].
+    double daemon_allocations{0};       ///< Allocations per operation in the daemon.
+    double client_allocations{0};       ///< Allocations per operation in the clients.
+    std::int64_t rss_growth{0};         ///< Growth of the daemon's resident set size in [kB].
+};
+
+// rss returns the resident set size of process pid in [kB].
+std::int64_t rss(pid_t pid)
+{
+    std::ifstream in{"/proc/" + std::to_string(pid) + "/statm"};
+    std::int64_t size{0}, resident{0};
+    in >> size >> resident;
+    return resident * ::sysconf(_SC_PAGESIZE) / 1024;
+}
+
+// percentile returns the p-th percentile of the sorted sample.
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+
+    auto index = static_cast<std::size_t>(std::ceil(p * sorted.size())) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Waiter is an observer fulfilling a promise with the success of the operation it observes.
+template<typename T>
+class Waiter : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    void on_started() override {}
+    void on_progress(const Progress&) override {}
+    void on_canceled(const Reason&) override { promise.set_value(false); }
+    void on_failed(const Error&) override { promise.set_value(false); }
+    void on_succeeded(const Result&) override { promise.set_value(true); }
+
+    std::promise<bool> promise;
+};
+
+// Client bundles a connection to the bus and the stub device talking to the daemon.
+struct Client
+{
+    explicit Client(core::dbus::testing::Fixture& fixture)
+        : rt{biometry::Runtime::create()},
+          bus{fixture.session_bus()}
+    {
+        bus->install_executor(core::dbus::asio::make_executor(bus, rt->service()));
+        rt->start();
+
+        service = biometry::dbus::stub::Service::create_for_bus(bus);
+        device = service->default_device();
+    }
+
+    ~Client()
+    {
+        bus->stop();
+    }
+
+    std::shared_ptr<biometry::Runtime> rt;
+    core::dbus::Bus::Ptr bus;
+    std::shared_ptr<biometry::Service> service;
+    std::shared_ptr<biometry::Device> device;
+};
+
+// measure runs options.operations operations created by factory on every client
+// concurrently, waiting for each operation to finish before starting the next one.
+template<typename T>
+Result measure(const std::string& name,
+               const std::vector<std::unique_ptr<Client>>& clients,
+               const Options& options,
+               pid_t daemon,
+               const std::function<typename biometry::Operation<T>::Ptr(biometry::Device&)>& factory)
+{
+    Result result;
+    result.operation = name;
+    result.count = clients.size() * options.operations;
+
+    std::vector<std::vector<double>> latencies(clients.size());
+    std::vector<std::size_t> failures(clients.size(), 0);
+    std::vector<std::thread> threads;
+
+    auto rss_before = rss(daemon);
+    auto daemon_before = allocations->daemon.load();
+    auto clients_before = allocations->clients.load();
+    auto before = Clock::now();
+
+    for (std::size_t c = 0; c < clients.size(); c++)
+    {
+        threads.emplace_back([&, c]()
+        {
+            latencies[c].reserve(options.operations);
+
+            for (std::size_t i = 0; i < options.operations; i++)
+            {
+                auto started = Clock::now();
+
+                auto waiter = std::make_shared<Waiter<T>>();
+                auto future = waiter->promise.get_future();
+                auto op = factory(*clients[c]->device);
+                op->start_with_observer(waiter);
+
+                if (future.wait_for(operation_timeout) != std::future_status::ready || not future.get())
+                    failures[c]++;
+
+                latencies[c].push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started).count());
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - before).count();
+
+    std::vector<double> sorted;
+    for (std::size_t c = 0; c < clients.size(); c++)
+    {
+        result.failures += failures[c];
+        sorted.insert(sorted.end(), latencies[c].begin(), latencies[c].end());
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    for (auto latency : sorted)
+        result.latency.update(latency);
+
+    result.p50 = percentile(sorted, 0.5);
+    result.p90 = percentile(sorted, 0.9);
+    result.p99 = percentile(sorted, 0.99);
+    result.throughput = result.count / seconds;
+    result.daemon_allocations = (allocations->daemon.load() - daemon_before) / static_cast<double>(result.count);
+    result.client_allocations = (allocations->clients.load() - clients_before) / static_cast<double>(result.count);
+    result.rss_growth = rss(daemon) - rss_before;
+
+    return result;
+}
+
+// run_daemon exposes a Simulated device on the session bus of fixture until receiving sig_term.
+core::posix::exit::Status run_daemon(core::dbus::testing::Fixture& fixture)
+{
+    is_daemon = true;
+
+    auto trap = core::posix::trap_signals_for_all_subsequent_threads({core::posix::Signal::sig_term});
+    trap->signal_raised().connect([trap](core::posix::Signal)
+    {
+        trap->stop();
+    });
+
+    auto rt = biometry::Runtime::create();
+    auto bus = fixture.session_bus();
+    bus->install_executor(core::dbus::asio::make_executor(bus, rt->service()));
+    rt->start();
+
+    biometry::devices::Simulated::Model model;
+    auto zero = biometry::devices::Simulated::Latency::fixed(0);
+    model.latency = {zero, zero, zero, zero, zero, zero, zero, zero};
+    model.lockout.attempts = 0;
+    model.capacity = std::numeric_limits<std::uint32_t>::max();
+
+    auto service = std::make_shared<biometry::DispatchingService>(
+                biometry::util::create_dispatcher_for_runtime(rt),
+                std::make_shared<biometry::devices::Simulated>(model));
+    auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(bus, service);
+
+    trap->run();
+
+    bus->stop();
+    rt->stop();
+
+    return core::posix::exit::Status::success;
+}
+
+void print_header(std::ostream& out)
+{
+    out << std::setw(10) << std::left << "operation"
+        << std::setw(10) << std::right << "ops"
+        << std::setw(10) << std::right << "failed"
+        << std::setw(12) << std::right << "ops/s"
+        << std::setw(14) << std::right << "mean [µs]"
+        << std::setw(13) << std::right << "p50 [µs]"
+        << std::setw(13) << std::right << "p90 [µs]"
+        << std::setw(13) << std::right << "p99 [µs]"
+        << std::setw(13) << std::right << "max [µs]"
+        << std::setw(14) << std::right << "daemon allocs"
+        << std::setw(14) << std::right << "client allocs"
+        << std::setw(12) << std::right << "rss [kB]" << std::endl;
+}
+
+void print(std::ostream& out, const Result& result)
+{
+    out << std::setw(10) << std::left << result.operation
+        << std::setw(10) << std::right << result.count
+        << std::setw(10) << std::right << result.failures
+        << std::setw(12) << std::right << std::fixed << std::setprecision(0) << result.throughput
+        << std::setw(13) << std::right << std::fixed << std::setprecision(2) << result.latency.mean()
+        << std::setw(12) << std::right << std::fixed << std::setprecision(2) << result.p50
+        << std::setw(12) << std::right << std::fixed << std::setprecision(2) << result.p90
+        << std::setw(12) << std::right << std::fixed << std::setprecision(2) << result.p99
+        << std::setw(12) << std::right << std::fixed << std::setprecision(2) << result.latency.max()
+        << std::setw(14) << std::right << std::fixed << std::setprecision(1) << result.daemon_allocations
+        << std::setw(14) << std::right << std::fixed << std::setprecision(1) << result.client_allocations
+        << std::setw(12) << std::right << result.rss_growth << std::endl;
+}
+
+void print_json(std::ostream& out, const Options& options, const std::vector<Result>& results)
+{
+    out << "{\"benchmark\": \"dbus\", \"clients\": " << options.clients
+        << ", \"operationsPerClient\": " << options.operations << ", \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const auto& r = results[i];
+        out << (i > 0 ? ", " : "")
+            << "{\"operation\": \"" << r.operation << "\""
+            << ", \"count\": " << r.count
+            << ", \"failures\": " << r.failures
+            << std::fixed << std::setprecision(2)
+            << ", \"throughput\": " << r.throughput
+            << ", \"latency\": {\"unit\": \"us\", \"mean\": " << r.latency.mean()
+            << ", \"stddev\": " << std::sqrt(r.latency.variance())
+            << ", \"min\": " << r.latency.min()
+            << ", \"p50\": " << r.p50
+            << ", \"p90\": " << r.p90
+            << ", \"p99\": " << r.p99
+            << ", \"max\": " << r.latency.max() << "}"
+            << ", \"daemonAllocationsPerOperation\": " << r.daemon_allocations
+            << ", \"clientAllocationsPerOperation\": " << r.client_allocations
+            << ", \"daemonRssGrowth\": " << r.rss_growth << "}";
+    }
+
+    out << "]}" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+
+    Options options;
+
+    po::options_description desc{"benchmark_dbus"};
+    desc.add_options()
+        ("help", "prints this help")
+        ("clients", po::value<std::size_t>(&options.clients), "number of concurrent clients")
+        ("operations", po::value<std::size_t>(&options.operations), "operations per client and kind of operation")
+        ("json", po::bool_switch(&options.json), "print results in JSON format");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    auto shared = ::mmap(nullptr, sizeof(Allocations), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED)
+    {
+        std::cerr << "Failed to map shared memory for counting allocations." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    core::dbus::testing::Fixture fixture;
+
+    allocations = new (shared) Allocations{};
+
+    auto daemon = core::posix::fork([&fixture]() { return run_daemon(fixture); }, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(daemon_startup);
+
+    std::vector<Result> results;
+    {
+        std::vector<std::unique_ptr<Client>> clients;
+        for (std::size_t c = 0; c < options.clients; c++)
+            clients.emplace_back(new Client{fixture});
+
+        const auto app = biometry::Application::system();
+        const auto user = biometry::User::current();
+        const auto reason = biometry::Reason::unknown();
+
+        results.push_back(measure<biometry::TemplateStore::SizeQuery>("size", clients, options, daemon.pid(), [&](biometry::Device& d)
+        {
+            return d.template_store().size(app, user);
+        }));
+
+        results.push_back(measure<biometry::TemplateStore::List>("list", clients, options, daemon.pid(), [&](biometry::Device& d)
+        {
+            return d.template_store().list(app, user);
+        }));
+
+        results.push_back(measure<biometry::TemplateStore::Enrollment>("enroll", clients, options, daemon.pid(), [&](biometry::Device& d)
+        {
+            return d.template_store().enroll(app, user);
+        }));
+
+        results.push_back(measure<biometry::Identification>("identify", clients, options, daemon.pid(), [&](biometry::Device& d)
+        {
+            return d.identifier().identify_user(app, reason);
+        }));
+    }
+
+    daemon.send_signal_or_throw(core::posix::Signal::sig_term);
+    daemon.wait_for(core::posix::wait::Flags::untraced);
+
+    if (options.json)
+    {
+        print_json(std::cout, options, results);
+    }
+    else
+    {
+        print_header(std::cout);
+        for (const auto& result : results)
+            print(std::cout, result);
+    }
+
+    return EXIT_SUCCESS;
+}
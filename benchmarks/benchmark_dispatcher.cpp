@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/runtime.h>
+#include <biometry/util/dispatcher.h>
+#include <biometry/util/statistics.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// benchmark_dispatcher compares the available biometry::util::Dispatcher implementations
+// with respect to:
+//   * the cost of a single call to dispatch on the producer side,
+//   * the latency between posting and executing a task,
+//   * the overall throughput in tasks per second,
+// for 1 to 8 concurrent producers.
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+static constexpr const std::size_t tasks_per_run{200000};
+static constexpr const std::size_t max_producers{8};
+
+struct Result
+{
+    biometry::util::Statistics post;    ///< Cost of dispatch in [ns], measured per producer.
+    biometry::util::Statistics latency; ///< Post to execution latency in [µs].
+    double throughput;                  ///< Tasks per second.
+};
+
+Result run(biometry::util::Dispatcher& dispatcher, std::size_t producers)
+{
+    Result result;
+
+    const std::size_t tasks_per_producer = tasks_per_run / producers;
+    const std::size_t total = tasks_per_producer * producers;
+
+    std::atomic<std::size_t> executed{0};
+    std::vector<std::thread> threads;
+    std::vector<double> post_costs(producers, 0.);
+
+    auto before = Clock::now();
+
+    for (std::size_t p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+        {
+            auto start = Clock::now();
+
+            for (std::size_t i = 0; i < tasks_per_producer; i++)
+            {
+                auto posted = Clock::now();
+                dispatcher.dispatch([&result, &executed, posted]()
+                {
+                    // Both dispatcher implementations serialize task execution,
+                    // there is no need to synchronize access to result.latency.
+                    result.latency.update(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - posted).count());
+                    executed.fetch_add(1, std::memory_order_release);
+                });
+            }
+
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            post_costs[p] = duration.count() / static_cast<double>(tasks_per_producer);
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    while (executed.load(std::memory_order_acquire) < total)
+        std::this_thread::yield();
+
+    auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - before).count();
+
+    for (auto cost : post_costs)
+        result.post.update(cost);
+
+    result.throughput = total / seconds;
+    return result;
+}
+
+void print_header(std::ostream& out)
+{
+    out << std::setw(14) << std::left << "dispatcher"
+        << std::setw(10) << std::right << "producers"
+        << std::setw(14) << std::right << "post [ns]"
+        << std::setw(16) << std::right << "latency [µs]"
+        << std::setw(16) << std::right << "std.dev. [µs]"
+        << std::setw(16) << std::right << "max [µs]"
+        << std::setw(16) << std::right << "tasks/s" << std::endl;
+}
+
+void print(std::ostream& out, const std::string& name, std::size_t producers, const Result& result)
+{
+    out << std::setw(14) << std::left << name
+        << std::setw(10) << std::right << producers
+        << std::setw(14) << std::right << std::fixed << std::setprecision(2) << result.post.mean()
+        << std::setw(15) << std::right << std::fixed << std::setprecision(2) << result.latency.mean()
+        << std::setw(15) << std::right << std::fixed << std::setprecision(2) << std::sqrt(result.latency.variance())
+        << std::setw(15) << std::right << std::fixed << std::setprecision(2) << result.latency.max()
+        << std::setw(16) << std::right << std::fixed << std::setprecision(0) << result.throughput << std::endl;
+}
+}
+
+int main()
+{
+    auto runtime = biometry::Runtime::create();
+    runtime->start();
+
+    const std::vector<std::pair<std::string, std::function<std::shared_ptr<biometry::util::Dispatcher>()>>> dispatchers
+    {
+        {"strand", [runtime]() { return biometry::util::create_dispatcher_for_runtime(runtime); }},
+        {"workerThread", []() { return biometry::util::create_dispatcher_with_worker_thread(); }}
+    };
+
+    print_header(std::cout);
+
+    for (const auto& pair : dispatchers)
+    {
+        for (std::size_t producers = 1; producers <= max_producers; producers++)
+        {
+            auto dispatcher = pair.second();
+            print(std::cout, pair.first, producers, run(*dispatcher, producers));
+        }
+    }
+
+    runtime->stop();
+
+    return EXIT_SUCCESS;
+}
@@ -38,6 +38,9 @@ struct BIOMETRY_DLL_PUBLIC Service
 
     /// @brief create_stub returns an implementation of biometry::Service
     /// transparently accessing a remote instance exposed via dbus.
+    ///
+    /// All stubs of a process share one bus connection and the threads executing it.
+    /// Both are torn down when the last stub and the devices obtained from it go away.
     /// @throws std::runtime_error in case of issues.
     static std::shared_ptr<biometry::Service> create_stub();
 };
@@ -61,6 +61,14 @@ public:
         virtual std::string author() const = 0;
         /// @brief description returns a one-line summary of the device implementation.
         virtual std::string description() const = 0;
+        /// @brief supports_hot_swap returns true if instances can be replaced while the daemon is running.
+        ///
+        /// Devices holding on to resources that cannot be released again, e.g., a HAL instance,
+        /// return false and only pick up configuration changes after a restart.
+        virtual bool supports_hot_swap() const
+        {
+            return true;
+        }
 
     protected:
         /// @cond
@@ -83,6 +83,11 @@ public:
     };
 
     /// @brief start_with_observer starts the operation, handing updates to 'observer'.
+    ///
+    /// Implementations might only create the actual operation when being started, e.g., the
+    /// dbus stubs create and start a remote operation with a single call. Errors in doing so
+    /// are reported via Observer::on_failed, and are not thrown from the call creating the
+    /// operation or from start_with_observer.
     virtual void start_with_observer(const typename Observer::Ptr& observer) = 0;
 
     /// @brief cancel stops the operation, confirming cancellation to the installed observer.
@@ -19,7 +19,10 @@
 #ifndef BASE_BRIDGE_H_
 #define BASE_BRIDGE_H_
 
+#include <biometry/util/logging.h>
+
 #include <assert.h>
+#include <ctype.h>
 #include <dlfcn.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -42,23 +45,62 @@ class HIDDEN_SYMBOL Bridge
         return bridge; 
     }
 
+    bool is_loaded() const
+    {
+        return lib_handle != NULL || lib_override_handle != NULL;
+    }
+
+    // UBUNTU_PLATFORM_API_TEST_OVERRIDE lists the modules whose symbols are resolved
+    // from a test version, separated by commas, colons or whitespace.
     void* resolve_symbol(const char* symbol, const char* module = "") const
     {
         static const char* test_modules = secure_getenv("UBUNTU_PLATFORM_API_TEST_OVERRIDE");
-        if (test_modules && strstr(test_modules, module)) {
-            printf("Platform API: INFO: Overriding symbol '%s' with test version\n", symbol);
-            return Scope::dlsym_fn(lib_override_handle, symbol);
-        } else {
-            return Scope::dlsym_fn(lib_handle, symbol);
+        if (lib_override_handle && test_modules && lists_module(test_modules, module)) {
+            // Test versions are regular host libraries, see Bridge().
+            if (void* overridden = ::dlsym(lib_override_handle, symbol)) {
+                biometry::util::logging::info("Platform API: Overriding symbol '%s' with test version", symbol);
+                return overridden;
+            }
         }
+
+        // Symbols not provided by a test version fall back to the actual library.
+        if (lib_handle)
+            return Scope::dlsym_fn(lib_handle, symbol);
+
+        return NULL;
     }
 
   protected:
+    static bool is_separator(char c)
+    {
+        return c == ',' || c == ':' || isspace(static_cast<unsigned char>(c));
+    }
+
+    // lists_module returns true if module is one of the tokens in modules, never matching an empty module.
+    static bool lists_module(const char* modules, const char* module)
+    {
+        size_t length = strlen(module);
+        if (length == 0)
+            return false;
+
+        for (const char* p = strstr(modules, module); p != NULL; p = strstr(p + 1, module)) {
+            bool starts = p == modules || is_separator(p[-1]);
+            bool ends = p[length] == '\0' || is_separator(p[length]);
+            if (starts && ends)
+                return true;
+        }
+
+        return false;
+    }
+
     Bridge()
-        : lib_handle(Scope::dlopen_fn(Scope::path(), RTLD_LAZY))
+        : lib_handle(Scope::dlopen_fn(Scope::path(), RTLD_LAZY)),
+          lib_override_handle(NULL)
     {
+        // Test versions are built for the host and cannot be loaded by Scope's loader.
+        // The actual library might be missing on test machines, see is_loaded().
         if (Scope::override_path() && secure_getenv("UBUNTU_PLATFORM_API_TEST_OVERRIDE"))
-            lib_override_handle = (Scope::dlopen_fn(Scope::override_path(), RTLD_LAZY));
+            lib_override_handle = ::dlopen(Scope::override_path(), RTLD_LAZY);
     }
 
     ~Bridge()
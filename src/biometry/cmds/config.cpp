@@ -21,6 +21,8 @@
 
 #include <biometry/daemon.h>
 
+#include <biometry/util/binary_configuration_builder.h>
+
 #include <boost/bimap.hpp>
 
 namespace cli = biometry::util::cli;
@@ -36,8 +38,36 @@ std::string enumerate_flags()
 }
 }
 
+biometry::cmds::Config::Compile::Compile()
+    : CommandWithFlagsAndAction{cli::Name{"compile"}, cli::Usage{"config compile"}, cli::Description{"compiles a daemon configuration to its binary form"}}
+{
+    flag(cli::make_flag(cli::Name{"config"}, cli::Description{"The JSON daemon configuration"}, config_));
+    flag(cli::make_flag(cli::Name{"output"}, cli::Description{"The binary configuration, defaults to <config>.bin"}, output_));
+
+    action([this](const cli::Command::Context& ctxt)
+    {
+        if (not config_) throw cli::Command::FlagsMissing{};
+
+        auto output = output_ ? *output_ : biometry::util::compiled_configuration_path_for(*config_);
+
+        try
+        {
+            biometry::util::compile_configuration(*config_, output);
+        }
+        catch (const std::exception& e)
+        {
+            ctxt.cout << "Failed to compile " << config_->string() << ": " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        ctxt.cout << "Compiled " << config_->string() << " to " << output.string() << std::endl;
+        return EXIT_SUCCESS;
+    });
+}
+
 biometry::cmds::Config::Config()
-    : CommandWithFlagsAndAction{cli::Name{"config"}, cli::Usage{"queries configuration options of the daemon"}, cli::Description{"queries configuration options of the daemon"}}
+    : CommandWithFlagsAndAction{cli::Name{"config"}, cli::Usage{"queries configuration options of the daemon"}, cli::Description{"queries configuration options of the daemon"}},
+      compile_{std::make_shared<Compile>()}
 {
     flag(cli::make_flag(cli::Name{"flag"}, cli::Description{"one of {" + enumerate_flags() + "}"}, flag_));
 
@@ -59,6 +89,16 @@ biometry::cmds::Config::Config()
     });
 }
 
+int biometry::cmds::Config::run(const Context& ctxt)
+{
+    // CommandWithFlagsAndAction does not know about positional arguments, we
+    // dispatch to our only subcommand manually.
+    if (not ctxt.args.empty() && ctxt.args.front() == compile_->name().as_string())
+        return compile_->run(Context{ctxt.cin, ctxt.cout, {ctxt.args.begin() + 1, ctxt.args.end()}});
+
+    return CommandWithFlagsAndAction::run(ctxt);
+}
+
 namespace
 {
 typedef boost::bimap<biometry::cmds::Config::Flag, std::string> Lut;
@@ -25,6 +25,8 @@
 
 #include <biometry/util/cli.h>
 
+#include <boost/filesystem.hpp>
+
 #include <iosfwd>
 #include <memory>
 
@@ -43,11 +45,29 @@ public:
         custom_plugin_directory   ///< The custom plugin installation directory.
     };
 
+    /// @brief Compile validates a JSON configuration and writes its binary form.
+    ///
+    /// The daemon prefers the binary form over the JSON configuration if it is up to date.
+    class Compile : public util::cli::CommandWithFlagsAndAction
+    {
+    public:
+        /// @brief Compile configures a new instance.
+        Compile();
+
+    private:
+        biometry::Optional<boost::filesystem::path> config_;
+        biometry::Optional<boost::filesystem::path> output_;
+    };
+
     /// @brief Config configures a new instance.
     Config();
 
+    // From CommandWithFlagsAndAction
+    int run(const Context& context) override;
+
 private:
     biometry::Optional<Flag> flag_;
+    std::shared_ptr<Compile> compile_;
 };
 
 /// @brief operator<< inserts flag into out and returns out.
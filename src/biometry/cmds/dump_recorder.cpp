@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <biometry/cmds/dump_recorder.h>
+
+#include <biometry/daemon.h>
+
+#include <biometry/hardware/flight_recorder.h>
+
+namespace cli = biometry::util::cli;
+
+biometry::cmds::DumpRecorder::DumpRecorder()
+    : CommandWithFlagsAndAction{cli::Name{"dump-recorder"}, cli::Usage{"dump-recorder"}, cli::Description{"print the HAL calls and callbacks of the daemon"}}
+{
+    flag(cli::make_flag(cli::Name{"file"}, cli::Description{"The flight recorder, defaults to the daemon's"}, file));
+
+    action([this](const cli::Command::Context& ctxt)
+    {
+        auto path = file ? *file : biometry::Daemon::Configuration::flight_recorder_path();
+
+        try
+        {
+            for (const auto& record : biometry::hardware::FlightRecorder::read(path))
+                ctxt.cout << record << std::endl;
+        }
+        catch (const std::exception& e)
+        {
+            ctxt.cout << "Failed to read " << path.string() << ": " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    });
+}
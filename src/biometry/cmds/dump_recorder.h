@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BIOMETRYD_CMDS_DUMP_RECORDER_H_
+#define BIOMETRYD_CMDS_DUMP_RECORDER_H_
+
+#include <biometry/optional.h>
+
+#include <biometry/util/cli.h>
+
+#include <boost/filesystem.hpp>
+
+namespace biometry
+{
+namespace cmds
+{
+/// @brief DumpRecorder decodes the HAL flight recorder of the daemon and prints all records to stdout.
+///
+/// The recorder file survives crashes of the daemon, the command is meant for post-mortem analysis.
+class DumpRecorder : public util::cli::CommandWithFlagsAndAction
+{
+public:
+    /// @brief DumpRecorder configures a new instance.
+    DumpRecorder();
+
+private:
+    Optional<boost::filesystem::path> file;
+};
+}
+}
+
+#endif // BIOMETRYD_CMDS_DUMP_RECORDER_H_
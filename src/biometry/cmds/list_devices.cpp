@@ -30,8 +30,8 @@ biometry::cmds::ListDevices::ListDevices()
     action([](const cli::Command::Context& ctxt)
     {
         ctxt.cout << "Known devices:" << std::endl;
-        for (const auto& pair : biometry::device_registry())
-            ctxt.cout << " - " << pair.first << "\t" << pair.second->description() << std::endl;
+        for (const auto& entry : biometry::device_registry())
+            ctxt.cout << " - " << entry.id << "\t" << entry.description << std::endl;
         return 0;
     });
 }
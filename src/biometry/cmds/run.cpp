@@ -19,22 +19,38 @@
 
 #include <biometry/cmds/run.h>
 
+#include <biometry/daemon.h>
 #include <biometry/device_registry.h>
+#include <biometry/devices/activity_tracking.h>
+#include <biometry/devices/deferred.h>
+#include <biometry/devices/instrumented.h>
 #include <biometry/dispatching_service.h>
 #include <biometry/runtime.h>
 #include <biometry/dbus/skeleton/service.h>
+#include <biometry/hardware/flight_recorder.h>
 
+#include <biometry/util/activity_monitor.h>
+#include <biometry/util/binary_configuration_builder.h>
 #include <biometry/util/configuration.h>
-#include <biometry/util/json_configuration_builder.h>
-#include <biometry/util/streaming_configuration_builder.h>
+#include <biometry/util/dispatcher.h>
+#include <biometry/util/file_watcher.h>
+#include <biometry/util/logging.h>
+#include <biometry/util/tracing.h>
 
 #include <core/dbus/bus.h>
 #include <core/dbus/asio/executor.h>
 
 #include <core/posix/signal.h>
 
+#include <chrono>
 #include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace cli = biometry::util::cli;
 
@@ -50,15 +66,23 @@ const std::unordered_map<std::string, biometry::Device::Id>& device_id_lut()
     return instance;
 }
 
-std::shared_ptr<biometry::Device> device_from_config(const boost::filesystem::path& config_file)
+// configuration_from_file prefers an up-to-date binary form of config_file
+// created by 'biometryd config compile', falling back to parsing the JSON.
+biometry::util::Configuration configuration_from_file(const boost::filesystem::path& config_file)
 {
-    using StreamingJsonConfigurationBuilder = biometry::util::StreamingConfigurationBuilder<biometry::util::JsonConfigurationBuilder>;
-    StreamingJsonConfigurationBuilder builder{StreamingJsonConfigurationBuilder::make_streamer(config_file)};
-    auto configuration = builder.build_configuration();
+    return biometry::util::load_configuration(config_file);
+}
 
-    auto default_device = configuration["defaultDevice"];
+biometry::Device::Descriptor::Ptr descriptor_from_config(const biometry::util::Configuration& configuration)
+{
+    return biometry::device_registry().at(configuration["defaultDevice"][std::string("id")].value().string());
+}
+
+std::shared_ptr<biometry::Device> device_from_config(const biometry::util::Configuration& configuration)
+{
+    const auto& default_device = configuration["defaultDevice"];
     biometry::util::Configuration device_config; device_config["config"] = default_device["config"];
-    auto default_device_descriptor = biometry::device_registry().at(default_device[std::string("id")].value().string());
+    auto default_device_descriptor = descriptor_from_config(configuration);
 
     return default_device_descriptor->create(device_config);
 }
@@ -70,9 +94,368 @@ std::shared_ptr<biometry::Device> device_from_oracle(const biometry::util::Prope
     return default_device_descriptor->create({});
 }
 
-std::shared_ptr<biometry::Device> create_default_device(const biometry::Optional<boost::filesystem::path>& config_file, const biometry::util::PropertyStore& property_store)
+std::shared_ptr<biometry::Device> create_default_device(const biometry::Optional<biometry::util::Configuration>& configuration, const biometry::util::PropertyStore& property_store)
 {
-    return config_file ? device_from_config(*config_file) : device_from_oracle(property_store);
+    return configuration ? device_from_config(*configuration) : device_from_oracle(property_store);
+}
+
+// StartupProfile records the time spent in the individual phases of bringing up the daemon.
+class StartupProfile
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    explicit StartupProfile(bool enabled) : enabled{enabled}, started{Clock::now()}
+    {
+    }
+
+    // record adds a phase named name, that started at then and finished right now.
+    void record(const std::string& name, Clock::time_point then)
+    {
+        if (not enabled)
+            return;
+
+        auto now = Clock::now();
+        std::lock_guard<std::mutex> lg{guard};
+        phases.emplace_back(name, std::make_pair(then - started, now - then));
+    }
+
+    // print writes a breakdown of all recorded phases to out.
+    void print(std::ostream& out) const
+    {
+        if (not enabled)
+            return;
+
+        std::lock_guard<std::mutex> lg{guard};
+        out << "Startup profile:" << std::endl;
+        for (const auto& phase : phases)
+            out << "  " << std::left << std::setw(16) << phase.first
+                << " started at " << std::right << std::setw(8) << as_millis(phase.second.first) << " ms"
+                << " took " << std::setw(8) << as_millis(phase.second.second) << " ms" << std::endl;
+    }
+
+private:
+    static double as_millis(Clock::duration d)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(d).count();
+    }
+
+    bool enabled;
+    Clock::time_point started;
+    mutable std::mutex guard;
+    std::vector<std::pair<std::string, std::pair<Clock::duration, Clock::duration>>> phases;
+};
+
+// JoiningThread joins the wrapped thread on destruction.
+struct JoiningThread
+{
+    ~JoiningThread()
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    std::thread thread;
+};
+
+// ConfigurationReloader picks up changes to the daemon configuration at runtime.
+//
+// Only the default device is recreated, and only if its section of the configuration
+// changed and both the current and the next device support being swapped at runtime.
+// The bus connection and all other components stay untouched, operations in flight
+// finish on the previous device and new requests wait for it to be released.
+class ConfigurationReloader
+{
+public:
+    typedef std::function<std::shared_ptr<biometry::Device>(const std::shared_ptr<biometry::Device>&)> Wrapper;
+    typedef std::function<void(const std::shared_ptr<biometry::Device>&, const std::function<void()>&)> Swap;
+
+    ConfigurationReloader(const boost::filesystem::path& config_file,
+                          const biometry::util::Configuration& configuration,
+                          const Swap& swap,
+                          const Wrapper& wrap)
+        : config_file{config_file},
+          current{configuration},
+          swap{swap},
+          wrap{wrap}
+    {
+    }
+
+    // create_device returns a new instance of the default device as currently configured.
+    // Must only be called on the thread reloading the configuration.
+    std::shared_ptr<biometry::Device> create_device() const
+    {
+        return device_from_config(current);
+    }
+
+    // reload re-reads the configuration, keeping the current one if the new one is invalid.
+    void reload()
+    {
+        biometry::util::Configuration next;
+
+        try
+        {
+            next = configuration_from_file(config_file);
+        }
+        catch (const std::exception& e)
+        {
+            biometry::util::logging::error("Failed to reload configuration, keeping the current one: %s", e.what());
+            return;
+        }
+
+        bool device_changed{false};
+        for (const auto& section : biometry::util::diff(current, next))
+        {
+            if (section == "defaultDevice")
+                device_changed = true;
+            else
+                biometry::util::logging::warning("Changes to %s take effect after restarting the daemon", section.c_str());
+        }
+
+        if (device_changed)
+        {
+            try
+            {
+                // Devices that cannot be released would end up with a second instance
+                // competing for the same hardware.
+                if (not descriptor_from_config(current)->supports_hot_swap() || not descriptor_from_config(next)->supports_hot_swap())
+                {
+                    biometry::util::logging::warning("Changes to defaultDevice take effect after restarting the daemon");
+                }
+                else
+                {
+                    // The previous device might be released after we are gone, we log
+                    // via util::logging instead of referring to any of our state.
+                    swap(wrap(device_from_config(next)), []()
+                    {
+                        biometry::util::logging::info("Released previous default device");
+                    });
+                }
+            }
+            catch (const std::exception& e)
+            {
+                biometry::util::logging::error("Failed to instantiate device, keeping the current one: %s", e.what());
+                return;
+            }
+        }
+
+        current = std::move(next);
+    }
+
+private:
+    boost::filesystem::path config_file;
+    biometry::util::Configuration current;
+    Swap swap;
+    Wrapper wrap;
+};
+
+// IdleRelease releases the default device and the worker threads of the device lane
+// while the daemon is idle, and acquires both again as soon as the next request comes in.
+//
+// The default device is replaced by a Deferred device while released, queueing requests
+// until the device has been recreated. Acquiring only resumes the device lane right away,
+// the device is recreated on a dedicated thread. While acquired, the monitor tracking
+// our activity does not call into us at all.
+//
+// The device is only recreated once the previous instance has been released, such that
+// both never compete for the hardware.
+class IdleRelease : public std::enable_shared_from_this<IdleRelease>
+{
+public:
+    typedef ConfigurationReloader::Wrapper Wrapper;
+    typedef std::function<std::shared_ptr<biometry::Device>()> Factory;
+
+    IdleRelease(const std::shared_ptr<biometry::Runtime>& runtime, const std::shared_ptr<biometry::util::Dispatcher>& creator)
+        : runtime{runtime},
+          creator{creator}
+    {
+    }
+
+    // attach starts managing the default device of service. Devices are created
+    // with factory on the thread of creator, and wrapped by wrap.
+    void attach(const std::shared_ptr<biometry::DispatchingService>& service, const Wrapper& wrap, const Factory& factory)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        this->service = service;
+        this->wrap = wrap;
+        this->factory = factory;
+    }
+
+    // release replaces the default device by a placeholder, suspending the device lane
+    // once the previous device has been released.
+    void release()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        // A request that came in while releasing is not of interest anymore.
+        wanted = false;
+
+        if (not service || state != State::acquired)
+            return;
+
+        biometry::util::logging::info("Idle, releasing default device");
+
+        state = State::releasing;
+        placeholder = std::make_shared<biometry::devices::Deferred>();
+
+        // The previous device is released on the device lane, which we cannot suspend from there.
+        std::weak_ptr<IdleRelease> wp{shared_from_this()};
+        service->swap_default_device(wrap(placeholder), [wp, rt = runtime]()
+        {
+            rt->service(biometry::Runtime::Lane::background).post([wp]()
+            {
+                if (auto sp = wp.lock())
+                    sp->released();
+            });
+        });
+    }
+
+    // acquire resumes the device lane and recreates the default device.
+    void acquire()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        switch (state)
+        {
+        case State::acquired:
+            break;
+        case State::releasing:
+            wanted = true;
+            break;
+        case State::released:
+            runtime->resume(biometry::Runtime::Lane::device);
+            recreate_locked();
+            break;
+        }
+    }
+
+    // swap_default_device replaces the default device by device while acquired. Released devices
+    // are recreated from the current configuration anyways, and we drop device in that case.
+    void swap_default_device(const std::shared_ptr<biometry::Device>& device, const std::function<void()>& on_drained)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (state == State::acquired)
+            service->swap_default_device(device, on_drained);
+    }
+
+private:
+    enum class State
+    {
+        acquired,
+        releasing,
+        released
+    };
+
+    // released is invoked on the background lane once the previous device has been released.
+    void released()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (state != State::releasing)
+            return;
+
+        if (wanted)
+        {
+            wanted = false;
+            recreate_locked();
+            return;
+        }
+
+        runtime->suspend(biometry::Runtime::Lane::device);
+        state = State::released;
+        biometry::util::logging::info("Released default device");
+    }
+
+    // recreate_locked hands over a new device to the placeholder, the caller has to hold guard.
+    void recreate_locked()
+    {
+        state = State::acquired;
+
+        creator->dispatch([placeholder = placeholder, factory = factory]()
+        {
+            try
+            {
+                placeholder->resolve(factory());
+                biometry::util::logging::info("Acquired default device");
+            }
+            catch (const std::exception& e)
+            {
+                // Requests fail until we have been idle again, and retry then.
+                biometry::util::logging::error("Failed to instantiate device: %s", e.what());
+                placeholder->fail(e.what());
+            }
+        });
+    }
+
+    std::shared_ptr<biometry::Runtime> runtime;
+    std::shared_ptr<biometry::util::Dispatcher> creator;
+
+    std::mutex guard;
+    std::shared_ptr<biometry::DispatchingService> service;
+    Wrapper wrap;
+    Factory factory;
+    State state{State::acquired};
+    // Set if a request came in while releasing.
+    bool wanted{false};
+    std::shared_ptr<biometry::devices::Deferred> placeholder;
+};
+
+// The largest queue we are willing to allocate for a worker thread dispatcher.
+constexpr const std::int64_t max_dispatcher_capacity = 1 << 16;
+
+// dispatcher_capacity validates the configured capacity of a worker thread dispatcher,
+// rounding it up to the next power of 2 as required by the underlying ring buffer.
+std::size_t dispatcher_capacity(std::int64_t capacity)
+{
+    if (capacity <= 0 || capacity > max_dispatcher_capacity)
+        throw std::runtime_error{"Invalid dispatcher capacity " + std::to_string(capacity) +
+                                 ", expected a value in [1, " + std::to_string(max_dispatcher_capacity) + "]"};
+
+    // The ring buffer requires room for at least 2 tasks.
+    std::size_t result{2};
+    while (result < static_cast<std::size_t>(capacity))
+        result <<= 1;
+
+    return result;
+}
+
+// create_dispatcher selects the dispatcher implementation according to the optional
+// "dispatcher" section of the daemon configuration, e.g.:
+//   "dispatcher": { "type": "workerThread", "capacity": 1024 }
+// Falls back to dispatching via a strand on the device lane of the runtime.
+std::shared_ptr<biometry::util::Dispatcher> create_dispatcher(const biometry::Optional<biometry::util::Configuration>& configuration, const std::shared_ptr<biometry::Runtime>& runtime)
+{
+    if (not configuration)
+        return biometry::util::create_dispatcher_for_runtime(runtime, biometry::Runtime::Lane::device);
+
+    const auto& dispatcher = (*configuration)["dispatcher"];
+    const auto& type = dispatcher["type"];
+
+    if (not type)
+        return biometry::util::create_dispatcher_for_runtime(runtime, biometry::Runtime::Lane::device);
+
+    const auto& name = type.value().string();
+
+    if (name == "strand")
+        return biometry::util::create_dispatcher_for_runtime(runtime, biometry::Runtime::Lane::device);
+
+    if (name == "workerThread")
+    {
+        const auto& capacity = dispatcher["capacity"];
+        return capacity ?
+            biometry::util::create_dispatcher_with_worker_thread(dispatcher_capacity(capacity.value().integer())) :
+            biometry::util::create_dispatcher_with_worker_thread();
+    }
+
+    throw std::runtime_error{"Unknown dispatcher type " + name + ", expected one of strand, workerThread"};
+}
+
+// dump_trace writes all recorded spans to path as Chrome trace JSON, replacing earlier dumps.
+void dump_trace(const boost::filesystem::path& path)
+{
+    std::ofstream out{path.string()};
+    biometry::util::tracing::dump(out);
 }
 }
 
@@ -103,36 +486,232 @@ biometry::cmds::Run::Run(const std::shared_ptr<biometry::util::PropertyStore>& p
       property_store{property_store}
 {
     flag(cli::make_flag(cli::Name{"config"}, cli::Description{"The daemon configuration"}, config));
+    flag(cli::make_flag(cli::Name{"idle-timeout"}, cli::Description{"Release the device and its worker threads after being idle for the given number of seconds"}, idle_timeout));
+    flag(cli::make_flag(cli::Name{"exit-on-idle"}, cli::Description{"Exit instead of releasing the device after being idle if set to 1, relying on D-Bus activation"}, exit_on_idle));
+    flag(cli::make_flag(cli::Name{"profile-startup"}, cli::Description{"Print a breakdown of the time spent during startup if set to 1"}, profile_startup));
+    flag(cli::make_flag(cli::Name{"trace"}, cli::Description{"Write operation spans to the file on SIGUSR1 and exit"}, trace));
+    flag(cli::make_flag(cli::Name{"flight-recorder"}, cli::Description{"Record HAL calls and callbacks to the file"}, flight_recorder));
+    flag(cli::make_flag(cli::Name{"log"}, cli::Description{"Log to syslog, stderr (the default) or the file"}, log));
+    flag(cli::make_flag(cli::Name{"log-severity"}, cli::Description{"Drop messages below debug, info, warning or error"}, log_severity));
     action([this](const cli::Command::Context& ctxt)
     {
-        auto trap = core::posix::trap_signals_for_all_subsequent_threads({core::posix::Signal::sig_term});
-        trap->signal_raised().connect([trap](const core::posix::Signal&) mutable
+        // An idle timeout of 0 keeps the device around all the time.
+        const bool release_on_idle = idle_timeout && *idle_timeout > 0;
+        // If asked to, we exit after being idle, and D-Bus activation brings us back up.
+        const bool on_demand = release_on_idle && exit_on_idle;
+
+        if (log_severity)
+            biometry::util::logging::set_severity(*log_severity);
+
+        try
         {
+            if (log)
+                biometry::util::logging::set_sink(
+                    *log == "syslog" ? biometry::util::logging::syslog_sink() :
+                    *log == "stderr" ? biometry::util::logging::stderr_sink() :
+                                       biometry::util::logging::file_sink(*log));
+        }
+        catch (const std::exception& e)
+        {
+            ctxt.cout << "Failed to set up logging: " << e.what() << std::endl;
+        }
+
+        // The flight recorder is a debugging aid, we carry on without it if the file is not accessible.
+        try
+        {
+            biometry::hardware::FlightRecorder::install(std::make_shared<biometry::hardware::FlightRecorder>(
+                flight_recorder ? *flight_recorder : biometry::Daemon::Configuration::flight_recorder_path()));
+        }
+        catch (const std::exception& e)
+        {
+            ctxt.cout << "Failed to open flight recorder: " << e.what() << std::endl;
+        }
+
+        if (trace)
+            biometry::util::tracing::enable();
+
+        auto trap = trace ?
+            core::posix::trap_signals_for_all_subsequent_threads({core::posix::Signal::sig_term, core::posix::Signal::sig_usr1}) :
+            core::posix::trap_signals_for_all_subsequent_threads({core::posix::Signal::sig_term});
+        trap->signal_raised().connect([this, trap](const core::posix::Signal& signal) mutable
+        {
+            if (signal == core::posix::Signal::sig_usr1)
+            {
+                dump_trace(*trace);
+                return;
+            }
+
             trap->stop();
         });
         
+        StartupProfile profile{profile_startup};
+        auto then = StartupProfile::Clock::now();
+
         try
         {
-            auto device = create_default_device(config, *Run::property_store);
-                    
-            auto runtime = Runtime::create();
+            Optional<biometry::util::Configuration> configuration;
+            if (config)
+                configuration = configuration_from_file(*config);
+
+            profile.record("configuration", then);
+
+            // Creating the device might take a while, e.g., when talking to the HAL.
+            // We acquire the bus name and export our objects right away, queueing up requests
+            // reaching us before the device becomes available.
+            auto deferred = std::make_shared<biometry::devices::Deferred>();
+            std::shared_ptr<biometry::Device> device = deferred;
+
+            bool device_failed{false};
+            JoiningThread device_creation;
+            // The thread runs concurrently to us, and reports via logging instead of ctxt.cout.
+            device_creation.thread = std::thread{[this, &profile, &device_failed, on_demand, configuration, deferred, trap]()
+            {
+                auto then = StartupProfile::Clock::now();
+
+                try
+                {
+                    deferred->resolve(create_default_device(configuration, *Run::property_store));
+                    profile.record("device", then);
+                }
+                catch (const std::exception& e)
+                {
+                    biometry::util::logging::error("Failed to instantiate device: %s", e.what());
+                    device_failed = true;
+                    deferred->fail(e.what());
+
+                    // Without an idle timeout, we might be supervised by a job that would respawn
+                    // us right away. We rather stay around, failing requests instead of spinning.
+                    if (on_demand)
+                        trap->stop();
+                }
+            }};
+
+            then = StartupProfile::Clock::now();
+            // Bus I/O, including cancels and replies to observers, runs on a lane of its own
+            // at a raised priority, such that calls blocking on the HAL cannot delay it.
+            Runtime::Lanes lanes;
+            lanes.bus = Runtime::LaneConfiguration{Runtime::worker_threads, -5};
+            lanes.device = Runtime::LaneConfiguration{1, 0};
+            lanes.background = Runtime::LaneConfiguration{1, 10};
+
+            auto runtime = Runtime::create(lanes, Runtime::Supervision{});
             runtime->start();
-        
+            profile.record("runtime", then);
+
+            // After being idle for a while, we release the HAL session and the worker threads of
+            // the device lane, and acquire both again on the next request. When started on demand
+            // via D-Bus activation, we shut down instead and the bus daemon brings us back up.
+            std::shared_ptr<biometry::util::Dispatcher> creator;
+            std::shared_ptr<IdleRelease> idle_release;
+            biometry::util::ActivityMonitor::Ptr monitor;
+            if (on_demand)
+            {
+                monitor = biometry::util::ActivityMonitor::create(runtime->service(Runtime::Lane::background), std::chrono::seconds{*idle_timeout}, [trap]()
+                {
+                    trap->stop();
+                });
+            }
+            else if (release_on_idle)
+            {
+                creator = biometry::util::create_dispatcher_with_worker_thread();
+                idle_release = std::make_shared<IdleRelease>(runtime, creator);
+                monitor = biometry::util::ActivityMonitor::create(runtime->service(Runtime::Lane::background), std::chrono::seconds{*idle_timeout},
+                                                                  [idle_release]() { idle_release->release(); },
+                                                                  [idle_release]() { idle_release->acquire(); });
+            }
+
+            auto track = [monitor](const std::shared_ptr<biometry::Device>& device) -> std::shared_ptr<biometry::Device>
+            {
+                auto instrumented = std::make_shared<biometry::devices::Instrumented>(device);
+
+                if (not monitor)
+                    return instrumented;
+
+                return std::make_shared<biometry::devices::ActivityTracking>(monitor, instrumented);
+            };
+
+            device = track(device);
+
+            then = StartupProfile::Clock::now();
             auto bus = this->bus_factory();
-            bus->install_executor(core::dbus::asio::make_executor(bus, runtime->service()));
+            bus->install_executor(core::dbus::asio::make_executor(bus, runtime->service(Runtime::Lane::bus)));
 
             auto impl = std::make_shared<biometry::DispatchingService>(
-                biometry::util::create_dispatcher_for_runtime(runtime),device);
-            auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(bus, impl);            
+                create_dispatcher(configuration, runtime), device,
+                biometry::util::create_dispatcher_for_runtime(runtime, Runtime::Lane::bus));
+            auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(bus, impl);
+            profile.record("export", then);
+
+            ConfigurationReloader::Swap swap = [impl](const std::shared_ptr<biometry::Device>& device, const std::function<void()>& on_drained)
+            {
+                impl->swap_default_device(device, on_drained);
+            };
+
+            IdleRelease::Factory factory = [this, configuration]()
+            {
+                return create_default_device(configuration, *Run::property_store);
+            };
+
+            if (idle_release)
+            {
+                swap = [idle_release](const std::shared_ptr<biometry::Device>& device, const std::function<void()>& on_drained)
+                {
+                    idle_release->swap_default_device(device, on_drained);
+                };
+            }
+
+            biometry::util::FileWatcher::Ptr watcher;
+            if (config)
+            {
+                // Devices are recreated on a dedicated thread, keeping the runtime responsive
+                // while talking to the HAL. Reloads are serialized by the worker thread, and
+                // so is recreating the device after having been idle.
+                if (not creator)
+                    creator = biometry::util::create_dispatcher_with_worker_thread();
+
+                auto reloader = std::make_shared<ConfigurationReloader>(*config, *configuration, swap, track);
+                watcher = biometry::util::FileWatcher::create(runtime->service(Runtime::Lane::background), *config, [creator, reloader]()
+                {
+                    creator->dispatch([reloader]() { reloader->reload(); });
+                });
+
+                factory = [reloader]() { return reloader->create_device(); };
+            }
+
+            if (idle_release)
+                idle_release->attach(impl, track, factory);
 
             trap->run();
 
+            if (watcher)
+                watcher->stop();
+
+            if (device_creation.thread.joinable())
+                device_creation.thread.join();
+
+            // All phases have been recorded by now, and we are the only ones writing to ctxt.cout.
+            profile.print(ctxt.cout);
+
             bus->stop();
             runtime->stop();
+            biometry::util::logging::flush();
+
+            if (trace)
+                dump_trace(*trace);
+
+            // Only report failure if we are started on demand, we might be respawned right away otherwise.
+            if (device_failed && on_demand)
+                return EXIT_FAILURE;
         }
         catch (...)
         {
-            ctxt.cout << "Failed to instantiate device...going to sleep" << std::endl;
+            if (on_demand)
+            {
+                ctxt.cout << "Failed to start up...exiting" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            ctxt.cout << "Failed to start up...going to sleep" << std::endl;
             trap->run();
         }
 
@@ -21,6 +21,7 @@
 #define BIOMETRYD_CMDS_RUN_H_
 
 #include <biometry/util/cli.h>
+#include <biometry/util/logging.h>
 #include <biometry/util/property_store.h>
 
 #include <biometry/device.h>
@@ -31,6 +32,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -67,6 +69,13 @@ private:
     BusFactory bus_factory;
     std::shared_ptr<biometry::util::PropertyStore> property_store;
     Optional<boost::filesystem::path> config;
+    Optional<std::uint32_t> idle_timeout;
+    bool exit_on_idle{false};
+    bool profile_startup{false};
+    Optional<boost::filesystem::path> trace;
+    Optional<boost::filesystem::path> flight_recorder;
+    Optional<std::string> log;
+    Optional<util::logging::Severity> log_severity;
 };
 }
 }
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <biometry/cmds/stats.h>
+
+#include <biometry/runtime.h>
+#include <biometry/dbus/stub/service.h>
+
+#include <biometry/util/metrics.h>
+
+#include <core/dbus/asio/executor.h>
+
+namespace cli = biometry::util::cli;
+
+biometry::cmds::Stats::Stats(const Run::BusFactory& bus_factory)
+    : CommandWithFlagsAndAction{cli::Name{"stats"}, cli::Usage{"stats"}, cli::Description{"print the metrics of the running daemon"}},
+      bus_factory{bus_factory}
+{
+    action([this](const cli::Command::Context& ctxt)
+    {
+        auto runtime = Runtime::create();
+        runtime->start();
+
+        auto bus = this->bus_factory();
+        bus->install_executor(core::dbus::asio::make_executor(bus, runtime->service()));
+
+        int result = EXIT_SUCCESS;
+
+        try
+        {
+            ctxt.cout << biometry::dbus::stub::Service::create_for_bus(bus)->metrics();
+        }
+        catch (const std::exception& e)
+        {
+            ctxt.cout << "Failed to query metrics: " << e.what() << std::endl;
+            result = EXIT_FAILURE;
+        }
+
+        bus->stop();
+        runtime->stop();
+
+        return result;
+    });
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BIOMETRYD_CMDS_STATS_H_
+#define BIOMETRYD_CMDS_STATS_H_
+
+#include <biometry/cmds/run.h>
+
+#include <biometry/util/cli.h>
+
+namespace biometry
+{
+namespace cmds
+{
+/// @brief Stats queries the metrics of a running daemon and prints them to stdout.
+class Stats : public util::cli::CommandWithFlagsAndAction
+{
+public:
+    /// @brief Stats creates a new instance, connecting to the daemon via buses created by bus_factory.
+    explicit Stats(const Run::BusFactory& bus_factory = Run::system_bus_factory());
+
+private:
+    Run::BusFactory bus_factory;
+};
+}
+}
+
+#endif // BIOMETRYD_CMDS_STATS_H_
@@ -31,9 +31,8 @@
 #include <biometry/dbus/service.h>
 
 #include <biometry/util/benchmark.h>
+#include <biometry/util/binary_configuration_builder.h>
 #include <biometry/util/configuration.h>
-#include <biometry/util/json_configuration_builder.h>
-#include <biometry/util/streaming_configuration_builder.h>
 
 #include <iomanip>
 #include <future>
@@ -94,14 +93,11 @@ private:
 
 std::shared_ptr<biometry::Device> device_from_config_file(const boost::filesystem::path& file)
 {
-    using StreamingJsonConfigurationBuilder = biometry::util::StreamingConfigurationBuilder<biometry::util::JsonConfigurationBuilder>;
-    StreamingJsonConfigurationBuilder builder{StreamingJsonConfigurationBuilder::make_streamer(file)};
-
-    const auto configuration = builder.build_configuration();
+    const auto configuration = biometry::util::load_configuration(file);
 
     static const auto throw_configuration_invalid = [](){ std::throw_with_nested(biometry::cmds::Test::ConfigurationInvalid{});};
 
-    const auto id = configuration
+    const auto& id = configuration
             ("device",  throw_configuration_invalid)
             ("id",      throw_configuration_invalid);
     biometry::util::Configuration config; config["config"] = configuration
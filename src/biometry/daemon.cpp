@@ -22,10 +22,12 @@
 #include <biometry/devices/plugin/enumerator.h>
 
 #include <biometry/cmds/config.h>
+#include <biometry/cmds/dump_recorder.h>
 #include <biometry/cmds/enroll.h>
 #include <biometry/cmds/identify.h>
 #include <biometry/cmds/list_devices.h>
 #include <biometry/cmds/run.h>
+#include <biometry/cmds/stats.h>
 #include <biometry/cmds/test.h>
 #include <biometry/cmds/version.h>
 
@@ -44,9 +46,11 @@ biometry::Daemon::Daemon()
 {
     cmd.command(std::make_shared<cmds::Enroll>())
        .command(std::make_shared<cmds::Config>())
+       .command(std::make_shared<cmds::DumpRecorder>())
        .command(std::make_shared<cmds::Identify>())
        .command(std::make_shared<cmds::ListDevices>())
        .command(std::make_shared<cmds::Run>(std::make_shared<biometry::util::AndroidPropertyStore>()))
+       .command(std::make_shared<cmds::Stats>())
        .command(std::make_shared<cmds::Test>())
        .command(std::make_shared<cmds::Version>());
 }
@@ -53,6 +53,10 @@ public:
         /// @brief default_plugin_directories returns the paths that should be scanned for
         /// plugins.
         static std::set<boost::filesystem::path> default_plugin_directories();
+
+        /// @brief flight_recorder_path returns the default path of the file
+        /// that HAL calls and callbacks are recorded to.
+        static boost::filesystem::path flight_recorder_path();
     };
 
     /// @brief Daemon creates a new instance, populating the map of known commands.
@@ -343,6 +343,11 @@ template<> struct Codec<biometry::Variant>
             }
             case biometry::Variant::Type::blob:
             {
+                auto vw = sw.open_variant(types::Signature{helper::TypeMapper<std::vector<std::uint8_t>>::signature()});
+                {
+                    Codec<std::vector<std::uint8_t>>::encode_argument(vw, in.blob());
+                }
+                sw.close_variant(std::move(vw));
                 break;
             }
             case biometry::Variant::Type::vector:
@@ -404,6 +409,8 @@ template<> struct Codec<biometry::Variant>
             }
             case biometry::Variant::Type::blob:
             {
+                std::vector<std::uint8_t> b; Codec<std::vector<std::uint8_t>>::decode_argument(vr, b);
+                out.blob(b);
                 break;
             }
             case biometry::Variant::Type::vector:
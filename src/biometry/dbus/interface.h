@@ -20,11 +20,14 @@
 #ifndef BIOMETRYD_DBUS_INTERFACE_H_
 #define BIOMETRYD_DBUS_INTERFACE_H_
 
+#include <biometry/dictionary.h>
+
 #include <core/dbus/macros.h>
 #include <core/dbus/types/object_path.h>
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace biometry
 {
@@ -43,6 +46,28 @@ struct Errors
     };
 };
 
+struct Features
+{
+    /// @brief CreateAndStart marks support for the *AndStart methods, creating and
+    /// starting an operation with a single round-trip.
+    struct CreateAndStart
+    {
+        static inline std::string name()
+        {
+            return "com.ubuntu.biometryd.Feature.CreateAndStart";
+        }
+    };
+
+    /// @brief Metrics marks support for the com.ubuntu.biometryd.Metrics interface.
+    struct Metrics
+    {
+        static inline std::string name()
+        {
+            return "com.ubuntu.biometryd.Feature.Metrics";
+        }
+    };
+};
+
 struct Service
 {
     static inline std::string name()
@@ -74,6 +99,52 @@ struct Service
                 return std::chrono::seconds{5};
             }
         };
+
+        struct Features
+        {
+            static inline std::string name()
+            {
+                return "Features";
+            }
+
+            typedef biometry::dbus::interface::Service Interface;
+            typedef std::vector<std::string> ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
+    };
+};
+
+/// @brief Metrics is exposed on Service::path(), exporting the daemon's metrics registry.
+struct Metrics
+{
+    static inline std::string name()
+    {
+        return "com.ubuntu.biometryd.Metrics";
+    }
+
+    struct Methods
+    {
+        Methods() = delete;
+
+        struct Snapshot
+        {
+            static inline std::string name()
+            {
+                return "Snapshot";
+            }
+
+            typedef biometry::dbus::interface::Metrics Interface;
+            typedef biometry::Dictionary ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
     };
 };
 
@@ -172,6 +243,23 @@ struct Identifier
                 return std::chrono::seconds{5};
             }
         };
+
+        struct IdentifyUserAndStart
+        {
+            static inline const std::string& name()
+            {
+                static const std::string s{"IdentifyUserAndStart"};
+                return s;
+            }
+
+            typedef biometry::dbus::interface::Identifier Interface;
+            typedef core::dbus::types::ObjectPath ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
     };
 };
 
@@ -204,6 +292,23 @@ struct TemplateStore
             }
         };
 
+        struct SizeAndStart
+        {
+            static inline const std::string& name()
+            {
+                static const std::string s{"SizeAndStart"};
+                return s;
+            }
+
+            typedef biometry::dbus::interface::TemplateStore Interface;
+            typedef core::dbus::types::ObjectPath ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
+
         struct List
         {
             static inline const std::string& name()
@@ -221,6 +326,23 @@ struct TemplateStore
             }
         };
 
+        struct ListAndStart
+        {
+            static inline const std::string& name()
+            {
+                static const std::string s{"ListAndStart"};
+                return s;
+            }
+
+            typedef biometry::dbus::interface::TemplateStore Interface;
+            typedef core::dbus::types::ObjectPath ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
+
         struct Enroll
         {
             static inline const std::string& name()
@@ -239,6 +361,23 @@ struct TemplateStore
             }
         };
 
+        struct EnrollAndStart
+        {
+            static inline const std::string& name()
+            {
+                static const std::string s{"EnrollAndStart"};
+                return s;
+            }
+
+            typedef biometry::dbus::interface::TemplateStore Interface;
+            typedef core::dbus::types::ObjectPath ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
+
         struct Remove
         {
             static inline const std::string& name()
@@ -256,6 +395,23 @@ struct TemplateStore
             }
         };
 
+        struct RemoveAndStart
+        {
+            static inline const std::string& name()
+            {
+                static const std::string s{"RemoveAndStart"};
+                return s;
+            }
+
+            typedef biometry::dbus::interface::TemplateStore Interface;
+            typedef core::dbus::types::ObjectPath ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
+
         struct Clear
         {
             static inline const std::string& name()
@@ -265,6 +421,23 @@ struct TemplateStore
             }
 
 
+            typedef biometry::dbus::interface::TemplateStore Interface;
+            typedef core::dbus::types::ObjectPath ResultType;
+
+            inline static const std::chrono::milliseconds default_timeout()
+            {
+                return std::chrono::seconds{5};
+            }
+        };
+
+        struct ClearAndStart
+        {
+            static inline const std::string& name()
+            {
+                static const std::string s{"ClearAndStart"};
+                return s;
+            }
+
             typedef biometry::dbus::interface::TemplateStore Interface;
             typedef core::dbus::types::ObjectPath ResultType;
 
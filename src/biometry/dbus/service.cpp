@@ -20,31 +20,270 @@
 #include <biometry/dbus/service.h>
 #include <biometry/dbus/stub/service.h>
 
+#include <biometry/device.h>
+#include <biometry/identifier.h>
+#include <biometry/operation.h>
 #include <biometry/runtime.h>
+#include <biometry/template_store.h>
+#include <biometry/verifier.h>
+
+#include <biometry/util/metrics.h>
 
 #include <core/dbus/bus.h>
 #include <core/dbus/asio/executor.h>
 
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 namespace
 {
-std::shared_ptr<biometry::Runtime> runtime()
+// live_contexts returns the gauge tracking the number of ClientContext instances alive in the process.
+biometry::util::Metrics::Gauge& live_contexts()
 {
-    static auto rt = biometry::Runtime::create();
-    return rt;
+    return biometry::util::metrics().gauge("dbus_client_contexts");
 }
 
-core::dbus::Bus::Ptr bus()
+// ClientContext bundles the resources shared by all stubs of a process:
+// one connection to the system bus and a Runtime executing it.
+class ClientContext
 {
-    auto bus = std::make_shared<core::dbus::Bus>(core::dbus::WellKnownBus::system);
-    bus->install_executor(core::dbus::asio::make_executor(bus, runtime()->service()));
+public:
+    // A single worker is sufficient to serve the executor of the bus.
+    static constexpr const std::uint32_t worker_threads = 1;
+
+    // acquire returns the process-wide instance, creating it if no stub is alive.
+    static std::shared_ptr<ClientContext> acquire()
+    {
+        static std::mutex guard;
+        static std::weak_ptr<ClientContext> instance;
+
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (auto sp = instance.lock())
+            return sp;
+
+        auto sp = std::make_shared<ClientContext>();
+        instance = sp;
+        return sp;
+    }
+
+    ClientContext()
+        : runtime{biometry::Runtime::create(worker_threads)},
+          bus{std::make_shared<core::dbus::Bus>(core::dbus::WellKnownBus::system)}
+    {
+        bus->install_executor(core::dbus::asio::make_executor(bus, runtime->service()));
+        runtime->start();
+
+        std::promise<std::thread::id> id;
+        runtime->service().post([&id]() { id.set_value(std::this_thread::get_id()); });
+        worker = id.get_future().get();
+
+        live_contexts().increment();
+    }
+
+    // Stops the bus before the Runtime executing it goes away.
+    ~ClientContext()
+    {
+        live_contexts().decrement();
+
+        bus->stop();
 
-    runtime()->start();
+        // The last reference might be released by a handler running on the worker,
+        // which cannot join itself. We leave the teardown to a helper thread in that case,
+        // keeping the bus alive until the handler has returned.
+        if (std::this_thread::get_id() == worker)
+        {
+            std::thread{[rt = std::move(runtime), bus = std::move(bus)]() mutable
+            {
+                rt.reset();
+                bus.reset();
+            }}.detach();
+        }
+    }
 
-    return bus;
+    std::shared_ptr<biometry::Runtime> runtime;
+    core::dbus::Bus::Ptr bus;
+    std::thread::id worker;
+};
+
+// bind_to_context returns a pointer to p, keeping context alive for as long as the pointer is around.
+template<typename T>
+std::shared_ptr<T> bind_to_context(const std::shared_ptr<ClientContext>& context, const std::shared_ptr<T>& p)
+{
+    auto holder = std::make_shared<std::pair<std::shared_ptr<ClientContext>, std::shared_ptr<T>>>(context, p);
+    return std::shared_ptr<T>{holder, p.get()};
 }
+
+// ContextBoundOperation keeps the ClientContext alive for as long as the operation is
+// around, and for as long as its observer is waiting for updates from the remote side.
+template<typename T>
+class ContextBoundOperation : public biometry::Operation<T>
+{
+public:
+    static typename biometry::Operation<T>::Ptr bind(const std::shared_ptr<ClientContext>& context, const typename biometry::Operation<T>::Ptr& impl)
+    {
+        return std::make_shared<ContextBoundOperation<T>>(context, impl);
+    }
+
+    ContextBoundOperation(const std::shared_ptr<ClientContext>& context, const typename biometry::Operation<T>::Ptr& impl)
+        : context{context},
+          impl{impl}
+    {
+    }
+
+    void start_with_observer(const typename biometry::Operation<T>::Observer::Ptr& observer) override
+    {
+        impl->start_with_observer(bind_to_context(context, observer));
+    }
+
+    void cancel() override
+    {
+        impl->cancel();
+    }
+
+private:
+    std::shared_ptr<ClientContext> context;
+    typename biometry::Operation<T>::Ptr impl;
+};
+
+// ContextBoundDevice keeps the ClientContext alive for as long as the device or any of
+// the operations created by it are alive.
+class ContextBoundDevice : public biometry::Device
+{
+public:
+    class TemplateStore : public biometry::TemplateStore
+    {
+    public:
+        TemplateStore(const std::shared_ptr<ClientContext>& context, const std::shared_ptr<biometry::Device>& impl)
+            : context{context},
+              impl{impl}
+        {
+        }
+
+        biometry::Operation<SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override
+        {
+            return ContextBoundOperation<SizeQuery>::bind(context, impl->template_store().size(app, user));
+        }
+
+        biometry::Operation<List>::Ptr list(const biometry::Application& app, const biometry::User& user) override
+        {
+            return ContextBoundOperation<List>::bind(context, impl->template_store().list(app, user));
+        }
+
+        biometry::Operation<Enrollment>::Ptr enroll(const biometry::Application& app, const biometry::User& user) override
+        {
+            return ContextBoundOperation<Enrollment>::bind(context, impl->template_store().enroll(app, user));
+        }
+
+        biometry::Operation<Removal>::Ptr remove(const biometry::Application& app, const biometry::User& user, TemplateId id) override
+        {
+            return ContextBoundOperation<Removal>::bind(context, impl->template_store().remove(app, user, id));
+        }
+
+        biometry::Operation<Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override
+        {
+            return ContextBoundOperation<Clearance>::bind(context, impl->template_store().clear(app, user));
+        }
+
+    private:
+        std::shared_ptr<ClientContext> context;
+        std::shared_ptr<biometry::Device> impl;
+    };
+
+    class Identifier : public biometry::Identifier
+    {
+    public:
+        Identifier(const std::shared_ptr<ClientContext>& context, const std::shared_ptr<biometry::Device>& impl)
+            : context{context},
+              impl{impl}
+        {
+        }
+
+        biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override
+        {
+            return ContextBoundOperation<biometry::Identification>::bind(context, impl->identifier().identify_user(app, reason));
+        }
+
+    private:
+        std::shared_ptr<ClientContext> context;
+        std::shared_ptr<biometry::Device> impl;
+    };
+
+    class Verifier : public biometry::Verifier
+    {
+    public:
+        Verifier(const std::shared_ptr<ClientContext>& context, const std::shared_ptr<biometry::Device>& impl)
+            : context{context},
+              impl{impl}
+        {
+        }
+
+        biometry::Operation<biometry::Verification>::Ptr verify_user(const biometry::Application& app, const biometry::User& user, const biometry::Reason& reason) override
+        {
+            return ContextBoundOperation<biometry::Verification>::bind(context, impl->verifier().verify_user(app, user, reason));
+        }
+
+    private:
+        std::shared_ptr<ClientContext> context;
+        std::shared_ptr<biometry::Device> impl;
+    };
+
+    ContextBoundDevice(const std::shared_ptr<ClientContext>& context, const std::shared_ptr<biometry::Device>& impl)
+        : context{context},
+          template_store_{context, impl},
+          identifier_{context, impl},
+          verifier_{context, impl}
+    {
+    }
+
+    biometry::TemplateStore& template_store() override
+    {
+        return template_store_;
+    }
+
+    biometry::Identifier& identifier() override
+    {
+        return identifier_;
+    }
+
+    biometry::Verifier& verifier() override
+    {
+        return verifier_;
+    }
+
+private:
+    std::shared_ptr<ClientContext> context;
+    TemplateStore template_store_;
+    Identifier identifier_;
+    Verifier verifier_;
+};
+
+// ContextBoundService keeps the ClientContext alive for as long as the
+// service or any of the devices handed out by it are alive.
+class ContextBoundService : public biometry::Service
+{
+public:
+    ContextBoundService(const std::shared_ptr<ClientContext>& context, const std::shared_ptr<biometry::Service>& impl)
+        : context{context},
+          impl{impl}
+    {
+    }
+
+    std::shared_ptr<biometry::Device> default_device() const override
+    {
+        return std::make_shared<ContextBoundDevice>(context, impl->default_device());
+    }
+
+private:
+    std::shared_ptr<ClientContext> context;
+    std::shared_ptr<biometry::Service> impl;
+};
 }
 
 std::shared_ptr<biometry::Service> biometry::dbus::Service::create_stub()
-{    
-    return biometry::dbus::stub::Service::create_for_bus(bus());
+{
+    auto context = ClientContext::acquire();
+    return std::make_shared<ContextBoundService>(context, biometry::dbus::stub::Service::create_for_bus(context->bus));
 }
@@ -22,11 +22,15 @@
 #include <biometry/application.h>
 #include <biometry/user.h>
 
+#include <biometry/util/metrics.h>
+
 #include <core/dbus/macros.h>
 #include <core/dbus/object.h>
 
 #include <core/posix/this_process.h>
 
+#include <chrono>
+
 namespace
 {
 bool is_running_in_a_testing_environment()
@@ -105,11 +109,16 @@ void biometry::dbus::skeleton::DaemonCredentialsResolver::resolve_credentials(
         const core::dbus::Message::Ptr& msg,
         const std::function<void(const Optional<RequestVerifier::Credentials>&)>& then)
 {
+    auto started = std::chrono::steady_clock::now();
+
     DBus::Stub stub{bus};
-    stub.get_connection_unix_user_async(msg->sender(), [stub, msg, then](biometry::Optional<std::uint32_t> uid) mutable
+    stub.get_connection_unix_user_async(msg->sender(), [stub, msg, then, started](biometry::Optional<std::uint32_t> uid) mutable
     {
-        stub.get_connection_app_armor_security_async(msg->sender(), [stub, msg, then, uid](const biometry::Optional<std::string>& label) mutable
+        stub.get_connection_app_armor_security_async(msg->sender(), [stub, msg, then, started, uid](const biometry::Optional<std::string>& label) mutable
         {
+            static auto& duration = biometry::util::metrics().histogram("credentials_resolution_duration_us");
+            duration.observe(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started));
+
             Optional<RequestVerifier::Credentials> credentials;
             RequestVerifier::Credentials cred = {biometry::Application{label.get()}, biometry::User{uid.get()}};
             then((label && uid ? credentials = cred : credentials));
@@ -43,6 +43,60 @@ struct PrefixedPath
 
     std::string suffix;
 };
+
+// ForwardingTemplateStore resolves the template store of a device on every request.
+class ForwardingTemplateStore : public biometry::TemplateStore
+{
+public:
+    explicit ForwardingTemplateStore(biometry::Device& device) : device(device)
+    {
+    }
+
+    biometry::Operation<SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override
+    {
+        return device.template_store().size(app, user);
+    }
+
+    biometry::Operation<List>::Ptr list(const biometry::Application& app, const biometry::User& user) override
+    {
+        return device.template_store().list(app, user);
+    }
+
+    biometry::Operation<Enrollment>::Ptr enroll(const biometry::Application& app, const biometry::User& user) override
+    {
+        return device.template_store().enroll(app, user);
+    }
+
+    biometry::Operation<Removal>::Ptr remove(const biometry::Application& app, const biometry::User& user, TemplateId id) override
+    {
+        return device.template_store().remove(app, user, id);
+    }
+
+    biometry::Operation<Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override
+    {
+        return device.template_store().clear(app, user);
+    }
+
+private:
+    biometry::Device& device;
+};
+
+// ForwardingIdentifier resolves the identifier of a device on every request.
+class ForwardingIdentifier : public biometry::Identifier
+{
+public:
+    explicit ForwardingIdentifier(biometry::Device& device) : device(device)
+    {
+    }
+
+    biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override
+    {
+        return device.identifier().identify_user(app, reason);
+    }
+
+private:
+    biometry::Device& device;
+};
 }
 
 /// @brief create_for_bus returns a new skeleton::Device instance connected to bus, forwarding calls to impl.
@@ -88,33 +142,30 @@ biometry::dbus::skeleton::Device::Device(
       service_{service},
       object_{object}
 {
-    object_->install_method_handler<biometry::dbus::interface::Device::Methods::TemplateStore>([this](const core::dbus::Message::Ptr& msg)
-    {
-        auto path = PrefixedPath{"template_store"}.prefix(object_->path());
+    auto template_store_path = PrefixedPath{"template_store"}.prefix(object_->path());
+    auto identifier_path = PrefixedPath{"identifier"}.prefix(object_->path());
 
-        template_store_([this, &path]()
-        {
-            return TemplateStore::create_for_service_and_object(bus_, service_, service_->add_object_for_path(path), std::ref(template_store()),
-                                                                std::make_shared<TemplateStore::RequestVerifier>(), std::make_shared<DaemonCredentialsResolver>(bus_));
-        });
+    // We export all sub-objects right away, such that stubs holding on to their
+    // paths keep on working if we are restarted, e.g., after exiting on idle.
+    forwarding_template_store_ = std::make_shared<ForwardingTemplateStore>(*this);
+    template_store_ = TemplateStore::create_for_service_and_object(bus_, service_, service_->add_object_for_path(template_store_path), std::ref(*forwarding_template_store_),
+                                                                   std::make_shared<TemplateStore::RequestVerifier>(), std::make_shared<DaemonCredentialsResolver>(bus_));
+
+    forwarding_identifier_ = std::make_shared<ForwardingIdentifier>(*this);
+    identifier_ = Identifier::create_for_service_and_object(bus_, service_, service_->add_object_for_path(identifier_path), std::ref(*forwarding_identifier_),
+                                                            std::make_shared<Identifier::RequestVerifier>(), std::make_shared<DaemonCredentialsResolver>(bus_));
 
+    object_->install_method_handler<biometry::dbus::interface::Device::Methods::TemplateStore>([this, template_store_path](const core::dbus::Message::Ptr& msg)
+    {
         auto reply = core::dbus::Message::make_method_return(msg);
-        reply->writer() << path;
+        reply->writer() << template_store_path;
         this->bus_->send(reply);
     });
 
-    object_->install_method_handler<biometry::dbus::interface::Device::Methods::Identifier>([this](const core::dbus::Message::Ptr& msg)
+    object_->install_method_handler<biometry::dbus::interface::Device::Methods::Identifier>([this, identifier_path](const core::dbus::Message::Ptr& msg)
     {
-        auto path = PrefixedPath{"identifier"}.prefix(object_->path());
-
-        identifier_([this, &path]()
-        {
-            return Identifier::create_for_service_and_object(bus_, service_, service_->add_object_for_path(path), std::ref(identifier()),
-                                                             std::make_shared<Identifier::RequestVerifier>(), std::make_shared<DaemonCredentialsResolver>(bus_));
-        });
-
         auto reply = core::dbus::Message::make_method_return(msg);
-        reply->writer() << path;
+        reply->writer() << identifier_path;
         this->bus_->send(reply);
     });
 }
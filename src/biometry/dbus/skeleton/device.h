@@ -26,8 +26,6 @@
 #include <biometry/dbus/skeleton/identifier.h>
 #include <biometry/dbus/skeleton/template_store.h>
 
-#include <biometry/util/once.h>
-
 #include <core/dbus/object.h>
 #include <core/dbus/service.h>
 
@@ -68,8 +66,12 @@ private:
     core::dbus::Service::Ptr service_;
     core::dbus::Object::Ptr object_;
 
-    util::Once<std::shared_ptr<biometry::dbus::skeleton::TemplateStore>> template_store_;
-    util::Once<std::shared_ptr<biometry::dbus::skeleton::Identifier>> identifier_;
+    // Sub-objects are exported right away and resolve the template store and identifier of impl
+    // per request. Stubs can thus rely on their paths across restarts of the service.
+    std::shared_ptr<biometry::TemplateStore> forwarding_template_store_;
+    std::shared_ptr<biometry::Identifier> forwarding_identifier_;
+    std::shared_ptr<biometry::dbus::skeleton::TemplateStore> template_store_;
+    std::shared_ptr<biometry::dbus::skeleton::Identifier> identifier_;
 };
 }
 }
@@ -23,8 +23,10 @@
 #include <biometry/dbus/codec.h>
 #include <biometry/dbus/interface.h>
 #include <biometry/dbus/skeleton/operation.h>
+#include <biometry/devices/instrumented.h>
 
 #include <biometry/util/atomic_counter.h>
+#include <biometry/util/tracing.h>
 
 #include <boost/format.hpp>
 
@@ -78,25 +80,34 @@ biometry::dbus::skeleton::Identifier::Identifier(
       service{service},
       object{object}
 {
-    object->install_method_handler<biometry::dbus::interface::Identifier::Methods::IdentifyUser>([this](const core::dbus::Message::Ptr& msg)
+    auto on_identify_user = [this](const core::dbus::Message::Ptr& msg, bool start)
     {
-        Identifier::credentials_resolver->resolve_credentials(msg, [this, msg](const Optional<RequestVerifier::Credentials>& credentials)
+        auto span = util::tracing::begin_span("identification");
+
+        Identifier::credentials_resolver->resolve_credentials(msg, [this, msg, start, span](const Optional<RequestVerifier::Credentials>& credentials)
         {
+            util::tracing::Scope scope{span};
+            util::tracing::instant(span, "credentials_resolved");
+
             if (not credentials)
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
             biometry::Application app = biometry::Application::system(); biometry::Reason reason = biometry::Reason::unknown();
             auto reader = msg->reader(); reader >> app >> reason;
+            core::dbus::types::ObjectPath observer_path; if (start) reader >> observer_path;
 
             if (not this->request_verifier->verify_identify_user_request(app, credentials.get()))
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
+            devices::Instrumented::Requester requester{credentials.get().app};
             auto op = identify_user(app, reason);
 
             core::dbus::types::ObjectPath op_path
@@ -108,19 +119,35 @@ biometry::dbus::skeleton::Identifier::Identifier(
                     % util::counter<Identifier>().increment()).str()
             };
 
-            ops.synchronized([this, op_path, op](IdentificationOps::ValueType& ops)
+            auto skeleton_op = skeleton::Operation<Identification>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+
+            ops.synchronized([op_path, skeleton_op](IdentificationOps::ValueType& ops)
             {
-                ops[op_path] = skeleton::Operation<Identification>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+                ops[op_path] = skeleton_op;
             });
 
+            if (start)
+                skeleton_op->start_with_remote_observer(msg, observer_path);
+
             auto reply = core::dbus::Message::make_method_return(msg);
             reply->writer() << op_path;
             this->bus->send(reply);
         });
+    };
+
+    object->install_method_handler<biometry::dbus::interface::Identifier::Methods::IdentifyUser>([on_identify_user](const core::dbus::Message::Ptr& msg)
+    {
+        on_identify_user(msg, false);
+    });
+
+    object->install_method_handler<biometry::dbus::interface::Identifier::Methods::IdentifyUserAndStart>([on_identify_user](const core::dbus::Message::Ptr& msg)
+    {
+        on_identify_user(msg, true);
     });
 }
 
 biometry::dbus::skeleton::Identifier::~Identifier()
 {
     object->uninstall_method_handler<biometry::dbus::interface::Identifier::Methods::IdentifyUser>();
+    object->uninstall_method_handler<biometry::dbus::interface::Identifier::Methods::IdentifyUserAndStart>();
 }
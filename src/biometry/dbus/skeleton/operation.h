@@ -27,6 +27,9 @@
 
 #include <biometry/dbus/stub/observer.h>
 
+#include <biometry/util/metrics.h>
+#include <biometry/util/tracing.h>
+
 #include <core/dbus/object.h>
 #include <core/dbus/service.h>
 
@@ -61,13 +64,41 @@ public:
     void start_with_observer(const typename Observer::Ptr& observer) override;
     void cancel() override;
 
+    /// @brief start_with_remote_observer starts the operation, reporting to the observer
+    /// that the sender of msg exposes at path.
+    void start_with_remote_observer(const core::dbus::Message::Ptr& msg, const core::dbus::types::ObjectPath& path);
+
 private:
+    /// @brief SpanObserver records replies to the remote observer to the span of the operation.
+    class SpanObserver : public Observer
+    {
+    public:
+        SpanObserver(const util::tracing::Span& span, const typename Observer::Ptr& impl);
+
+        // From biometry::Operation<T>::Observer
+        void on_started() override;
+        void on_progress(const Progress& progress) override;
+        void on_canceled(const Reason& reason) override;
+        void on_failed(const Error& error) override;
+        void on_succeeded(const Result& result) override;
+
+    private:
+        util::tracing::Span span;
+        typename Observer::Ptr impl;
+    };
+
+    /// @brief live_operations returns the gauge counting live operations, looked up in the registry
+    /// only once to keep its lock off the path creating operations.
+    static util::Metrics::Gauge& live_operations();
+
     /// @brief Service creates a new instance for the given remote service and object.
     Operation(const core::dbus::Bus::Ptr& bus, const core::dbus::Object::Ptr& object, const typename biometry::Operation<T>::Ptr& impl);
 
     typename biometry::Operation<T>::Ptr impl;
     core::dbus::Bus::Ptr bus;
     core::dbus::Object::Ptr object;
+    util::Metrics::Gauge& live;
+    util::tracing::Span span;
 };
 }
 }
@@ -87,20 +118,45 @@ biometry::dbus::skeleton::Operation<T>::~Operation()
 {
     object->uninstall_method_handler<biometry::dbus::interface::Operation::Methods::StartWithObserver>();
     object->uninstall_method_handler<biometry::dbus::interface::Operation::Methods::Cancel>();
+    live.decrement();
 }
 
 template<typename T>
 void biometry::dbus::skeleton::Operation<T>::start_with_observer(const typename Observer::Ptr& observer)
 {
-    impl->start_with_observer(observer);
+    util::tracing::Scope scope{span};
+    util::tracing::instant(span, "start");
+
+    typename Observer::Ptr o{observer};
+    if (span.id != util::tracing::no_span)
+        o = std::make_shared<SpanObserver>(span, observer);
+
+    impl->start_with_observer(o);
 }
 
 template<typename T>
 void biometry::dbus::skeleton::Operation<T>::cancel()
 {
+    util::tracing::Scope scope{span};
+    util::tracing::instant(span, "cancel");
+
     impl->cancel();
 }
 
+template<typename T>
+void biometry::dbus::skeleton::Operation<T>::start_with_remote_observer(const core::dbus::Message::Ptr& msg, const core::dbus::types::ObjectPath& path)
+{
+    auto object = core::dbus::Service::use_service(bus, msg->sender())->object_for_path(path);
+    start_with_observer(biometry::dbus::stub::Observer<T>::create_for_object(object));
+}
+
+template<typename T>
+biometry::util::Metrics::Gauge& biometry::dbus::skeleton::Operation<T>::live_operations()
+{
+    static auto& gauge = util::metrics().gauge("skeleton_objects_live", {{"type", "operation"}});
+    return gauge;
+}
+
 template<typename T>
 biometry::dbus::skeleton::Operation<T>::Operation(
         const core::dbus::Bus::Ptr& bus,
@@ -108,13 +164,17 @@ biometry::dbus::skeleton::Operation<T>::Operation(
         const typename biometry::Operation<T>::Ptr& impl)
     : impl{impl},
       bus{bus},
-      object{object}
+      object{object},
+      live(live_operations()),
+      // Operations are created from within the method handler that began the span.
+      span{util::tracing::current()}
 {
+    live.increment();
+
     object->install_method_handler<biometry::dbus::interface::Operation::Methods::StartWithObserver>([this](const core::dbus::Message::Ptr& msg)
     {
         core::dbus::types::ObjectPath path; msg->reader() >> path;
-        auto object = core::dbus::Service::use_service(this->bus, msg->sender())->object_for_path(path);
-        start_with_observer(biometry::dbus::stub::Observer<T>::create_for_object(object));
+        start_with_remote_observer(msg, path);
 
         this->bus->send(core::dbus::Message::make_method_return(msg));
     });
@@ -126,4 +186,49 @@ biometry::dbus::skeleton::Operation<T>::Operation(
     });
 }
 
+template<typename T>
+biometry::dbus::skeleton::Operation<T>::SpanObserver::SpanObserver(const util::tracing::Span& span, const typename Observer::Ptr& impl)
+    : span(span),
+      impl{impl}
+{
+}
+
+template<typename T>
+void biometry::dbus::skeleton::Operation<T>::SpanObserver::on_started()
+{
+    util::tracing::instant(span, "on_started");
+    impl->on_started();
+}
+
+template<typename T>
+void biometry::dbus::skeleton::Operation<T>::SpanObserver::on_progress(const Progress& progress)
+{
+    util::tracing::instant(span, "on_progress");
+    impl->on_progress(progress);
+}
+
+template<typename T>
+void biometry::dbus::skeleton::Operation<T>::SpanObserver::on_canceled(const Reason& reason)
+{
+    util::tracing::instant(span, "on_canceled");
+    impl->on_canceled(reason);
+    util::tracing::end_span(span);
+}
+
+template<typename T>
+void biometry::dbus::skeleton::Operation<T>::SpanObserver::on_failed(const Error& error)
+{
+    util::tracing::instant(span, "on_failed");
+    impl->on_failed(error);
+    util::tracing::end_span(span);
+}
+
+template<typename T>
+void biometry::dbus::skeleton::Operation<T>::SpanObserver::on_succeeded(const Result& result)
+{
+    util::tracing::instant(span, "on_succeeded");
+    impl->on_succeeded(result);
+    util::tracing::end_span(span);
+}
+
 #endif // BIOMETRYD_DBUS_SKELETON_OPERATION_H_
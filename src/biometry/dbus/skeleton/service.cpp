@@ -19,8 +19,11 @@
 
 #include <biometry/dbus/skeleton/service.h>
 
+#include <biometry/dbus/codec.h>
 #include <biometry/dbus/interface.h>
 
+#include <biometry/util/metrics.h>
+
 namespace
 {
 const core::dbus::types::ObjectPath default_device_path("/default_device");
@@ -42,20 +45,43 @@ biometry::dbus::skeleton::Service::Service(const core::dbus::Bus::Ptr& bus,
       service_{service},
       object_{object}
 {
+    // The device is exported right away, such that stubs holding on to its
+    // path keep on working if we are restarted, e.g., after exiting on idle.
+    default_device();
+
     object_->install_method_handler<biometry::dbus::interface::Service::Methods::DefaultDevice>([this](const core::dbus::Message::Ptr& msg)
     {
-        // Ensure that the device gets created on demand.
-        default_device();
-
         auto reply = core::dbus::Message::make_method_return(msg);
         reply->writer() << core::dbus::types::ObjectPath(default_device_path);
         this->bus_->send(reply);
     });
+
+    object_->install_method_handler<biometry::dbus::interface::Service::Methods::Features>([this](const core::dbus::Message::Ptr& msg)
+    {
+        static const std::vector<std::string> features
+        {
+            biometry::dbus::interface::Features::CreateAndStart::name(),
+            biometry::dbus::interface::Features::Metrics::name()
+        };
+
+        auto reply = core::dbus::Message::make_method_return(msg);
+        reply->writer() << features;
+        this->bus_->send(reply);
+    });
+
+    object_->install_method_handler<biometry::dbus::interface::Metrics::Methods::Snapshot>([this](const core::dbus::Message::Ptr& msg)
+    {
+        auto reply = core::dbus::Message::make_method_return(msg);
+        reply->writer() << biometry::util::metrics().snapshot().to_dictionary();
+        this->bus_->send(reply);
+    });
 }
 
 biometry::dbus::skeleton::Service::~Service()
 {
     object_->uninstall_method_handler<biometry::dbus::interface::Service::Methods::DefaultDevice>();
+    object_->uninstall_method_handler<biometry::dbus::interface::Service::Methods::Features>();
+    object_->uninstall_method_handler<biometry::dbus::interface::Metrics::Methods::Snapshot>();
 }
 
 std::shared_ptr<biometry::Device> biometry::dbus::skeleton::Service::default_device() const
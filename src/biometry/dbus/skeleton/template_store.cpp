@@ -24,8 +24,10 @@
 #include <biometry/dbus/codec.h>
 #include <biometry/dbus/interface.h>
 #include <biometry/dbus/skeleton/operation.h>
+#include <biometry/devices/instrumented.h>
 
 #include <biometry/util/atomic_counter.h>
+#include <biometry/util/tracing.h>
 #include <biometry/util/synchronized.h>
 
 #include <boost/format.hpp>
@@ -130,25 +132,34 @@ biometry::dbus::skeleton::TemplateStore::TemplateStore(
       service{service},
       object{object}
 {
-    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Size>([this](const core::dbus::Message::Ptr& msg)
+    auto on_size = [this](const core::dbus::Message::Ptr& msg, bool start)
     {
-        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg](const Optional<RequestVerifier::Credentials>& credentials)
+        auto span = util::tracing::begin_span("size_query");
+
+        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg, start, span](const Optional<RequestVerifier::Credentials>& credentials)
         {
+            util::tracing::Scope scope{span};
+            util::tracing::instant(span, "credentials_resolved");
+
             if (not credentials)
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
             biometry::User user; biometry::Application app = biometry::Application::system();
             auto reader = msg->reader(); reader >> app >> user;
+            core::dbus::types::ObjectPath observer_path; if (start) reader >> observer_path;
 
             if (not this->request_verifier->verify_size_request({app, user}, credentials.get()))
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
+            devices::Instrumented::Requester requester{credentials.get().app};
             auto op = size(app, user);
 
             core::dbus::types::ObjectPath op_path
@@ -160,36 +171,60 @@ biometry::dbus::skeleton::TemplateStore::TemplateStore(
                     % util::counter<TemplateStore>().increment()).str()
             };
 
-            ops.size.synchronized([this, op_path, op](SizeOps::ValueType& ops)
+            auto skeleton_op = skeleton::Operation<SizeQuery>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+
+            ops.size.synchronized([op_path, skeleton_op](SizeOps::ValueType& ops)
             {
-                ops[op_path] = skeleton::Operation<SizeQuery>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+                ops[op_path] = skeleton_op;
             });
 
+            if (start)
+                skeleton_op->start_with_remote_observer(msg, observer_path);
+
             auto reply = core::dbus::Message::make_method_return(msg);
             reply->writer() << op_path;
             this->bus->send(reply);
         });
+    };
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Size>([on_size](const core::dbus::Message::Ptr& msg)
+    {
+        on_size(msg, false);
     });
 
-    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::List>([this](const core::dbus::Message::Ptr& msg)
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::SizeAndStart>([on_size](const core::dbus::Message::Ptr& msg)
     {
-        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg](const Optional<RequestVerifier::Credentials>& credentials)
+        on_size(msg, true);
+    });
+
+    auto on_list = [this](const core::dbus::Message::Ptr& msg, bool start)
+    {
+        auto span = util::tracing::begin_span("list");
+
+        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg, start, span](const Optional<RequestVerifier::Credentials>& credentials)
         {
+            util::tracing::Scope scope{span};
+            util::tracing::instant(span, "credentials_resolved");
+
             if (not credentials)
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
             biometry::User user; biometry::Application app = biometry::Application::system();
             auto reader = msg->reader(); reader >> app >> user;
+            core::dbus::types::ObjectPath observer_path; if (start) reader >> observer_path;
 
             if (not this->request_verifier->verify_list_request({app, user}, credentials.get()))
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
+            devices::Instrumented::Requester requester{credentials.get().app};
             auto op = list(app, user);
 
             core::dbus::types::ObjectPath op_path
@@ -201,36 +236,60 @@ biometry::dbus::skeleton::TemplateStore::TemplateStore(
                     % util::counter<TemplateStore>().increment()).str()
             };
 
-            ops.list.synchronized([this, op_path, op](ListOps::ValueType& ops)
+            auto skeleton_op = skeleton::Operation<List>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+
+            ops.list.synchronized([op_path, skeleton_op](ListOps::ValueType& ops)
             {
-                ops[op_path] = skeleton::Operation<List>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+                ops[op_path] = skeleton_op;
             });
 
+            if (start)
+                skeleton_op->start_with_remote_observer(msg, observer_path);
+
             auto reply = core::dbus::Message::make_method_return(msg);
             reply->writer() << op_path;
             this->bus->send(reply);
         });
+    };
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::List>([on_list](const core::dbus::Message::Ptr& msg)
+    {
+        on_list(msg, false);
+    });
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::ListAndStart>([on_list](const core::dbus::Message::Ptr& msg)
+    {
+        on_list(msg, true);
     });
 
-    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Enroll>([this](const core::dbus::Message::Ptr& msg)
+    auto on_enroll = [this](const core::dbus::Message::Ptr& msg, bool start)
     {
-        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg](const Optional<RequestVerifier::Credentials>& credentials)
+        auto span = util::tracing::begin_span("enrollment");
+
+        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg, start, span](const Optional<RequestVerifier::Credentials>& credentials)
         {
+            util::tracing::Scope scope{span};
+            util::tracing::instant(span, "credentials_resolved");
+
             if (not credentials)
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
             biometry::User user; biometry::Application app = biometry::Application::system();
             auto reader = msg->reader(); reader >> app >> user;
+            core::dbus::types::ObjectPath observer_path; if (start) reader >> observer_path;
 
             if (not this->request_verifier->verify_enroll_request({app, user}, credentials.get()))
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
+            devices::Instrumented::Requester requester{credentials.get().app};
             auto op = enroll(app, user);
 
             core::dbus::types::ObjectPath op_path
@@ -242,36 +301,60 @@ biometry::dbus::skeleton::TemplateStore::TemplateStore(
                     % util::counter<TemplateStore>().increment()).str()
             };
 
-            ops.enroll.synchronized([this, op_path, op](EnrollOps::ValueType& ops)
+            auto skeleton_op = skeleton::Operation<Enrollment>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+
+            ops.enroll.synchronized([op_path, skeleton_op](EnrollOps::ValueType& ops)
             {
-                ops[op_path] = skeleton::Operation<Enrollment>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+                ops[op_path] = skeleton_op;
             });
 
+            if (start)
+                skeleton_op->start_with_remote_observer(msg, observer_path);
+
             auto reply = core::dbus::Message::make_method_return(msg);
             reply->writer() << op_path;
             this->bus->send(reply);
         });
+    };
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Enroll>([on_enroll](const core::dbus::Message::Ptr& msg)
+    {
+        on_enroll(msg, false);
+    });
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::EnrollAndStart>([on_enroll](const core::dbus::Message::Ptr& msg)
+    {
+        on_enroll(msg, true);
     });
 
-    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Remove>([this](const core::dbus::Message::Ptr& msg)
+    auto on_remove = [this](const core::dbus::Message::Ptr& msg, bool start)
     {
-        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg](const Optional<RequestVerifier::Credentials>& credentials)
+        auto span = util::tracing::begin_span("removal");
+
+        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg, start, span](const Optional<RequestVerifier::Credentials>& credentials)
         {
+            util::tracing::Scope scope{span};
+            util::tracing::instant(span, "credentials_resolved");
+
             if (not credentials)
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
             biometry::User user; biometry::Application app = biometry::Application::system(); biometry::TemplateStore::TemplateId id{0};
             auto reader = msg->reader(); reader >> app >> user >> id;
+            core::dbus::types::ObjectPath observer_path; if (start) reader >> observer_path;
 
             if (not this->request_verifier->verify_remove_request({app, user}, credentials.get()))
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
+            devices::Instrumented::Requester requester{credentials.get().app};
             auto op = remove(app, user, id);
 
             core::dbus::types::ObjectPath op_path
@@ -283,36 +366,60 @@ biometry::dbus::skeleton::TemplateStore::TemplateStore(
                     % util::counter<TemplateStore>().increment()).str()
             };
 
-            ops.remove.synchronized([this, op_path, op](RemoveOps::ValueType& ops)
+            auto skeleton_op = skeleton::Operation<Removal>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+
+            ops.remove.synchronized([op_path, skeleton_op](RemoveOps::ValueType& ops)
             {
-                ops[op_path] = skeleton::Operation<Removal>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+                ops[op_path] = skeleton_op;
             });
 
+            if (start)
+                skeleton_op->start_with_remote_observer(msg, observer_path);
+
             auto reply = core::dbus::Message::make_method_return(msg);
             reply->writer() << op_path;
             this->bus->send(reply);
         });
+    };
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Remove>([on_remove](const core::dbus::Message::Ptr& msg)
+    {
+        on_remove(msg, false);
+    });
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::RemoveAndStart>([on_remove](const core::dbus::Message::Ptr& msg)
+    {
+        on_remove(msg, true);
     });
 
-    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Clear>([this](const core::dbus::Message::Ptr& msg)
+    auto on_clear = [this](const core::dbus::Message::Ptr& msg, bool start)
     {
-        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg](const Optional<RequestVerifier::Credentials>& credentials)
+        auto span = util::tracing::begin_span("clearance");
+
+        TemplateStore::credentials_resolver->resolve_credentials(msg, [this, msg, start, span](const Optional<RequestVerifier::Credentials>& credentials)
         {
+            util::tracing::Scope scope{span};
+            util::tracing::instant(span, "credentials_resolved");
+
             if (not credentials)
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
             biometry::User user; biometry::Application app = biometry::Application::system();
             auto reader = msg->reader(); reader >> app >> user;
+            core::dbus::types::ObjectPath observer_path; if (start) reader >> observer_path;
 
             if (not this->request_verifier->verify_clear_request({app, user}, credentials.get()))
             {
                 this->bus->send(not_permitted_in_reply_to(msg));
+                util::tracing::end_span(span);
                 return;
             }
 
+            devices::Instrumented::Requester requester{credentials.get().app};
             auto op = clear(app, user);
 
             core::dbus::types::ObjectPath op_path
@@ -324,21 +431,43 @@ biometry::dbus::skeleton::TemplateStore::TemplateStore(
                     % util::counter<TemplateStore>().increment()).str()
             };
 
-            ops.clear.synchronized([this, op_path, op](ClearOps::ValueType& ops)
+            auto skeleton_op = skeleton::Operation<Clearance>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+
+            ops.clear.synchronized([op_path, skeleton_op](ClearOps::ValueType& ops)
             {
-                ops[op_path] = skeleton::Operation<Clearance>::create_for_object(this->bus, this->service->add_object_for_path(op_path), op);
+                ops[op_path] = skeleton_op;
             });
 
+            if (start)
+                skeleton_op->start_with_remote_observer(msg, observer_path);
+
             auto reply = core::dbus::Message::make_method_return(msg);
             reply->writer() << op_path;
             this->bus->send(reply);
         });
+    };
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::Clear>([on_clear](const core::dbus::Message::Ptr& msg)
+    {
+        on_clear(msg, false);
+    });
+
+    object->install_method_handler<biometry::dbus::interface::TemplateStore::Methods::ClearAndStart>([on_clear](const core::dbus::Message::Ptr& msg)
+    {
+        on_clear(msg, true);
     });
 }
 
 biometry::dbus::skeleton::TemplateStore::~TemplateStore()
 {
     object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::Size>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::SizeAndStart>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::List>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::ListAndStart>();
     object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::Enroll>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::EnrollAndStart>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::Remove>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::RemoveAndStart>();
     object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::Clear>();
+    object->uninstall_method_handler<biometry::dbus::interface::TemplateStore::Methods::ClearAndStart>();
 }
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRYD_DBUS_STUB_DEFERRED_OPERATION_H_
+#define BIOMETRYD_DBUS_STUB_DEFERRED_OPERATION_H_
+
+#include <biometry/operation.h>
+
+#include <biometry/dbus/interface.h>
+#include <biometry/dbus/skeleton/observer.h>
+
+#include <biometry/util/atomic_counter.h>
+
+#include <core/dbus/object.h>
+#include <core/dbus/service.h>
+
+#include <boost/format.hpp>
+
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace biometry
+{
+namespace dbus
+{
+namespace stub
+{
+/// @brief DeferredOperation is the dbus stub implementation of biometry::Operation<T>
+/// for operations that are created and started with a single call.
+///
+/// No remote call is issued on construction. start_with_observer exposes the observer
+/// first and hands its path to a Starter, that asks the remote side to create and
+/// start the operation in one go, returning the path of the created operation. If
+/// that fails, the error is reported to the observer via on_failed.
+template<typename T>
+class DeferredOperation : public biometry::Operation<T>
+{
+public:
+    // Safe us some typing
+    typedef std::shared_ptr<DeferredOperation<T>> Ptr;
+    typedef biometry::Operation<T> Super;
+
+    using typename Super::Observer;
+
+    /// @brief Starter creates and starts the remote operation, reporting to the given observer path.
+    typedef std::function<core::dbus::types::ObjectPath(const core::dbus::types::ObjectPath&)> Starter;
+
+    /// @brief create_for_service returns a new instance exposing observers below prefix on service.
+    static Ptr create_for_service(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const std::string& prefix, const Starter& starter);
+
+    // From biometry::Operation<T>
+    void start_with_observer(const typename Observer::Ptr& observer) override;
+    void cancel() override;
+
+private:
+    /// @brief DeferredOperation creates a new instance for the given remote service.
+    DeferredOperation(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const std::string& prefix, const Starter& starter);
+
+    /// @brief cancel_remote asks the remote operation to cancel.
+    static void cancel_remote(const core::dbus::Object::Ptr& remote);
+
+    core::dbus::Bus::Ptr bus;
+    core::dbus::Service::Ptr service;
+    std::string prefix;
+    Starter starter;
+
+    std::mutex guard;
+    bool started{false};
+    // Set if cancel was requested before the remote operation became known.
+    bool cancel_pending{false};
+    typename biometry::dbus::skeleton::Observer<T>::Ptr observer;
+    core::dbus::Object::Ptr object;
+};
+
+/// @brief start_remote_operation invokes Method on object with args, returning the path of the created and started operation.
+/// @throws std::runtime_error if the remote call fails.
+template<typename Method, typename... Args>
+inline core::dbus::types::ObjectPath start_remote_operation(const core::dbus::Object::Ptr& object, const Args&... args)
+{
+    auto result = object->invoke_method_synchronously<Method, typename Method::ResultType>(args...);
+
+    if (result.is_error())
+        throw std::runtime_error{result.error().print()};
+
+    return result.value();
+}
+}
+}
+}
+
+template<typename T>
+typename biometry::dbus::stub::DeferredOperation<T>::Ptr biometry::dbus::stub::DeferredOperation<T>::create_for_service(
+        const core::dbus::Bus::Ptr& bus,
+        const core::dbus::Service::Ptr& service,
+        const std::string& prefix,
+        const Starter& starter)
+{
+    return Ptr{new DeferredOperation<T>{bus, service, prefix, starter}};
+}
+
+// From biometry::Operation<T>
+template<typename T>
+void biometry::dbus::stub::DeferredOperation<T>::start_with_observer(const typename Observer::Ptr& observer)
+{
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (started)
+            throw std::logic_error{"DeferredOperation has already been started"};
+
+        started = true;
+    }
+
+    auto path = core::dbus::types::ObjectPath
+    {
+        (boost::format("%1%/observer/%2%") % prefix % util::counter<DeferredOperation<T>>().increment()).str()
+    };
+
+    // The observer has to be reachable before the remote side starts the operation.
+    // We do not hold the guard across the call, observer callbacks might cancel the operation.
+    typename biometry::dbus::skeleton::Observer<T>::Ptr obs;
+    core::dbus::Object::Ptr remote;
+
+    try
+    {
+        obs = biometry::dbus::skeleton::Observer<T>::create_for_object(bus, service->add_object_for_path(path), observer);
+        remote = service->object_for_path(starter(path));
+    }
+    catch (const std::exception& e)
+    {
+        // Errors are reported to the observer, see biometry::Operation::start_with_observer.
+        observer->on_failed(e.what());
+        return;
+    }
+
+    bool cancel_requested{false};
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        this->observer = obs;
+        object = remote;
+        std::swap(cancel_requested, cancel_pending);
+    }
+
+    // Cancel requests that came in before or while starting are forwarded
+    // now, the remote side confirms the cancellation to the observer.
+    if (cancel_requested)
+        cancel_remote(remote);
+}
+
+template<typename T>
+void biometry::dbus::stub::DeferredOperation<T>::cancel()
+{
+    core::dbus::Object::Ptr remote;
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        remote = object;
+
+        // Nothing has been created on the remote side, yet. We remember the
+        // request and forward it as soon as the remote operation is known.
+        if (not remote)
+        {
+            cancel_pending = true;
+            return;
+        }
+    }
+
+    cancel_remote(remote);
+}
+
+template<typename T>
+void biometry::dbus::stub::DeferredOperation<T>::cancel_remote(const core::dbus::Object::Ptr& remote)
+{
+    remote->invoke_method_synchronously<
+            biometry::dbus::interface::Operation::Methods::Cancel,
+            biometry::dbus::interface::Operation::Methods::Cancel::ResultType
+    >();
+}
+
+template<typename T>
+biometry::dbus::stub::DeferredOperation<T>::DeferredOperation(
+        const core::dbus::Bus::Ptr& bus,
+        const core::dbus::Service::Ptr& service,
+        const std::string& prefix,
+        const Starter& starter)
+    : bus{bus},
+      service{service},
+      prefix{prefix},
+      starter{starter}
+{
+}
+
+#endif // BIOMETRYD_DBUS_STUB_DEFERRED_OPERATION_H_
@@ -24,10 +24,11 @@
 #include <biometry/dbus/stub/template_store.h>
 
 /// @brief Device creates a new instance for the given remote service and object;
-biometry::dbus::stub::Device::Device(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object)
+biometry::dbus::stub::Device::Device(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start)
     : bus_{bus},
       service_{service},
-      object_{object}
+      object_{object},
+      create_and_start_{create_and_start}
 {
 }
 
@@ -41,7 +42,7 @@ biometry::TemplateStore& biometry::dbus::stub::Device::template_store()
                 biometry::dbus::interface::Device::Methods::TemplateStore::ResultType
         >();
 
-        return biometry::dbus::stub::TemplateStore::create_for_service_and_object(bus_, service_, service_->object_for_path(result.value()));
+        return biometry::dbus::stub::TemplateStore::create_for_service_and_object(bus_, service_, service_->object_for_path(result.value()), create_and_start_);
     });
 }
 
@@ -54,7 +55,7 @@ biometry::Identifier& biometry::dbus::stub::Device::identifier()
                 biometry::dbus::interface::Device::Methods::Identifier::ResultType
         >();
 
-        return biometry::dbus::stub::Identifier::create_for_service_and_object(bus_, service_, service_->object_for_path(result.value()));
+        return biometry::dbus::stub::Identifier::create_for_service_and_object(bus_, service_, service_->object_for_path(result.value()), create_and_start_);
     });
 }
 
@@ -42,7 +42,8 @@ class Device : public biometry::Device
 {
 public:
     /// @brief Device creates a new instance for the given remote service and object;
-    Device(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object);
+    /// create_and_start indicates whether the remote side offers the *AndStart methods.
+    Device(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start = false);
 
     // From biometry::Device
     biometry::TemplateStore& template_store() override;
@@ -53,6 +54,7 @@ private:
     core::dbus::Bus::Ptr bus_;
     core::dbus::Service::Ptr service_;
     core::dbus::Object::Ptr object_;
+    bool create_and_start_;
 
     util::Once<std::shared_ptr<biometry::dbus::stub::TemplateStore>> template_store_;
     util::Once<std::shared_ptr<biometry::dbus::stub::Identifier>> identifier_;
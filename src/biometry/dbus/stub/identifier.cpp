@@ -21,18 +21,29 @@
 
 #include <biometry/dbus/codec.h>
 #include <biometry/dbus/interface.h>
+#include <biometry/dbus/stub/deferred_operation.h>
 #include <biometry/dbus/stub/operation.h>
 
 biometry::dbus::stub::Identifier::Ptr biometry::dbus::stub::Identifier::create_for_service_and_object(
         const core::dbus::Bus::Ptr& bus,
         const core::dbus::Service::Ptr& service,
-        const core::dbus::Object::Ptr& object)
+        const core::dbus::Object::Ptr& object,
+        bool create_and_start)
 {
-    return Ptr{new Identifier{bus, service, object}};
+    return Ptr{new Identifier{bus, service, object, create_and_start}};
 }
 
 biometry::Operation<biometry::Identification>::Ptr biometry::dbus::stub::Identifier::identify_user(const Application& app, const Reason& reason)
 {
+    if (create_and_start)
+    {
+        auto prefix = (boost::format("%1%/identification") % object->path().as_string()).str();
+        return DeferredOperation<Identification>::create_for_service(bus, service, prefix, [object = this->object, app, reason](const core::dbus::types::ObjectPath& observer)
+        {
+            return start_remote_operation<biometry::dbus::interface::Identifier::Methods::IdentifyUserAndStart>(object, app, reason, observer);
+        });
+    }
+
     auto result = object->invoke_method_synchronously<
             biometry::dbus::interface::Identifier::Methods::IdentifyUser,
             biometry::dbus::interface::Identifier::Methods::IdentifyUser::ResultType
@@ -41,9 +52,10 @@ biometry::Operation<biometry::Identification>::Ptr biometry::dbus::stub::Identif
     return Operation<Identification>::create_for_object_and_service(bus, service, service->object_for_path(result.value()));
 }
 
-biometry::dbus::stub::Identifier::Identifier(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object)
+biometry::dbus::stub::Identifier::Identifier(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start)
     : bus{bus},
       service{service},
-      object{object}
+      object{object},
+      create_and_start{create_and_start}
 {
 }
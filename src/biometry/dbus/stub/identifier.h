@@ -39,18 +39,21 @@ public:
     typedef std::shared_ptr<Identifier> Ptr;
 
     /// @brief create_for_bus creates a new instance connecting to bus, forwarding incoming calls to impl.
-    static Ptr create_for_service_and_object(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object);
+    ///
+    /// If create_and_start is true, operations are created and started with a single call on start_with_observer.
+    static Ptr create_for_service_and_object(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start = false);
 
     // From biometry::Identifier.
     Operation<Identification>::Ptr identify_user(const Application& app, const Reason& reason) override;
 
 private:
     /// @brief Service creates a new instance for the given remote service and object.
-    Identifier(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object);
+    Identifier(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start);
 
     core::dbus::Bus::Ptr bus;
     core::dbus::Service::Ptr service;
     core::dbus::Object::Ptr object;
+    bool create_and_start;
 };
 }
 }
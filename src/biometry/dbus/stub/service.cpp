@@ -19,9 +19,12 @@
 
 #include <biometry/dbus/stub/service.h>
 
+#include <biometry/dbus/codec.h>
 #include <biometry/dbus/interface.h>
 #include <biometry/dbus/stub/device.h>
 
+#include <algorithm>
+
 biometry::dbus::stub::Service::Ptr biometry::dbus::stub::Service::create_for_bus(const core::dbus::Bus::Ptr& bus)
 {
     auto service = core::dbus::Service::use_service(bus, biometry::dbus::interface::Service::name());
@@ -40,7 +43,43 @@ std::shared_ptr<biometry::Device> biometry::dbus::stub::Service::default_device(
     if (result.is_error())
         throw std::runtime_error{result.error().print()};
 
-    return std::make_shared<biometry::dbus::stub::Device>(bus, service, service->object_for_path(result.value()));
+    return std::make_shared<biometry::dbus::stub::Device>(
+                bus, service, service->object_for_path(result.value()),
+                supports(biometry::dbus::interface::Features::CreateAndStart::name()));
+}
+
+biometry::util::Metrics::Snapshot biometry::dbus::stub::Service::metrics() const
+{
+    if (not supports(biometry::dbus::interface::Features::Metrics::name()))
+        throw std::runtime_error{"Remote service does not export metrics"};
+
+    auto result = object->invoke_method_synchronously<
+            biometry::dbus::interface::Metrics::Methods::Snapshot,
+            biometry::dbus::interface::Metrics::Methods::Snapshot::ResultType
+    >();
+
+    if (result.is_error())
+        throw std::runtime_error{result.error().print()};
+
+    biometry::util::Metrics::Snapshot snapshot;
+    snapshot.from_dictionary(result.value());
+    return snapshot;
+}
+
+bool biometry::dbus::stub::Service::supports(const std::string& feature) const
+{
+    const auto& advertised = features([this]()
+    {
+        auto result = object->invoke_method_synchronously<
+                biometry::dbus::interface::Service::Methods::Features,
+                biometry::dbus::interface::Service::Methods::Features::ResultType
+        >();
+
+        // Older daemons do not know about features and reply with an error.
+        return result.is_error() ? std::vector<std::string>{} : result.value();
+    });
+
+    return std::find(advertised.begin(), advertised.end(), feature) != advertised.end();
 }
 
 biometry::dbus::stub::Service::Service(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object)
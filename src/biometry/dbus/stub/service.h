@@ -23,9 +23,15 @@
 #include <biometry/service.h>
 #include <biometry/visibility.h>
 
+#include <biometry/util/metrics.h>
+#include <biometry/util/once.h>
+
 #include <core/dbus/object.h>
 #include <core/dbus/service.h>
 
+#include <string>
+#include <vector>
+
 namespace biometry
 {
 namespace dbus
@@ -49,12 +55,23 @@ public:
     // From biometry::Service.
     std::shared_ptr<biometry::Device> default_device() const override;
 
+    /// @brief metrics returns a snapshot of the remote service's metrics.
+    /// @throws std::runtime_error if the remote service does not export metrics.
+    util::Metrics::Snapshot metrics() const;
+
 private:
     Service(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object);
 
+    /// @brief supports returns true if the remote service advertises feature.
+    ///
+    /// Features are queried once, daemons predating the query advertise no features.
+    bool supports(const std::string& feature) const;
+
     core::dbus::Bus::Ptr bus;
     core::dbus::Service::Ptr service;
     core::dbus::Object::Ptr object;
+
+    util::Once<std::vector<std::string>> features;
 };
 }
 }
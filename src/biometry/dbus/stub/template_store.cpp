@@ -24,18 +24,29 @@
 
 #include <biometry/dbus/codec.h>
 #include <biometry/dbus/interface.h>
+#include <biometry/dbus/stub/deferred_operation.h>
 #include <biometry/dbus/stub/operation.h>
 
 biometry::dbus::stub::TemplateStore::Ptr biometry::dbus::stub::TemplateStore::create_for_service_and_object(
         const core::dbus::Bus::Ptr& bus,
         const core::dbus::Service::Ptr& service,
-        const core::dbus::Object::Ptr& object)
+        const core::dbus::Object::Ptr& object,
+        bool create_and_start)
 {
-    return Ptr{new TemplateStore{bus, service, object}};
+    return Ptr{new TemplateStore{bus, service, object, create_and_start}};
 }
 
 biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::dbus::stub::TemplateStore::size(const biometry::Application& app, const biometry::User& user)
 {
+    if (create_and_start)
+    {
+        auto prefix = (boost::format("%1%/size") % object->path().as_string()).str();
+        return DeferredOperation<SizeQuery>::create_for_service(bus, service, prefix, [object = this->object, app, user](const core::dbus::types::ObjectPath& observer)
+        {
+            return start_remote_operation<biometry::dbus::interface::TemplateStore::Methods::SizeAndStart>(object, app, user, observer);
+        });
+    }
+
     auto result = object->invoke_method_synchronously<
             biometry::dbus::interface::TemplateStore::Methods::Size,
             biometry::dbus::interface::TemplateStore::Methods::Size::ResultType
@@ -46,6 +57,15 @@ biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::dbus::stu
 
 biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::dbus::stub::TemplateStore::list(const biometry::Application& app, const biometry::User& user)
 {
+    if (create_and_start)
+    {
+        auto prefix = (boost::format("%1%/list") % object->path().as_string()).str();
+        return DeferredOperation<List>::create_for_service(bus, service, prefix, [object = this->object, app, user](const core::dbus::types::ObjectPath& observer)
+        {
+            return start_remote_operation<biometry::dbus::interface::TemplateStore::Methods::ListAndStart>(object, app, user, observer);
+        });
+    }
+
     auto result = object->invoke_method_synchronously<
             biometry::dbus::interface::TemplateStore::Methods::List,
             biometry::dbus::interface::TemplateStore::Methods::List::ResultType
@@ -56,6 +76,15 @@ biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::dbus::stub::Te
 
 biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::dbus::stub::TemplateStore::enroll(const biometry::Application& app, const biometry::User& user)
 {
+    if (create_and_start)
+    {
+        auto prefix = (boost::format("%1%/enroll") % object->path().as_string()).str();
+        return DeferredOperation<Enrollment>::create_for_service(bus, service, prefix, [object = this->object, app, user](const core::dbus::types::ObjectPath& observer)
+        {
+            return start_remote_operation<biometry::dbus::interface::TemplateStore::Methods::EnrollAndStart>(object, app, user, observer);
+        });
+    }
+
     auto result = object->invoke_method_synchronously<
             biometry::dbus::interface::TemplateStore::Methods::Enroll,
             biometry::dbus::interface::TemplateStore::Methods::Enroll::ResultType
@@ -66,6 +95,15 @@ biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::dbus::st
 
 biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::dbus::stub::TemplateStore::remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id)
 {
+    if (create_and_start)
+    {
+        auto prefix = (boost::format("%1%/remove") % object->path().as_string()).str();
+        return DeferredOperation<Removal>::create_for_service(bus, service, prefix, [object = this->object, app, user, id](const core::dbus::types::ObjectPath& observer)
+        {
+            return start_remote_operation<biometry::dbus::interface::TemplateStore::Methods::RemoveAndStart>(object, app, user, id, observer);
+        });
+    }
+
     auto result = object->invoke_method_synchronously<
             biometry::dbus::interface::TemplateStore::Methods::Remove,
             biometry::dbus::interface::TemplateStore::Methods::Remove::ResultType
@@ -76,6 +114,15 @@ biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::dbus::stub:
 
 biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::dbus::stub::TemplateStore::clear(const biometry::Application& app, const biometry::User& user)
 {
+    if (create_and_start)
+    {
+        auto prefix = (boost::format("%1%/clear") % object->path().as_string()).str();
+        return DeferredOperation<Clearance>::create_for_service(bus, service, prefix, [object = this->object, app, user](const core::dbus::types::ObjectPath& observer)
+        {
+            return start_remote_operation<biometry::dbus::interface::TemplateStore::Methods::ClearAndStart>(object, app, user, observer);
+        });
+    }
+
     auto result = object->invoke_method_synchronously<
             biometry::dbus::interface::TemplateStore::Methods::Clear,
             biometry::dbus::interface::TemplateStore::Methods::Clear::ResultType
@@ -84,9 +131,10 @@ biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::dbus::stu
     return Operation<Clearance>::create_for_object_and_service(bus, service, service->object_for_path(result.value()));
 }
 
-biometry::dbus::stub::TemplateStore::TemplateStore(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object)
+biometry::dbus::stub::TemplateStore::TemplateStore(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start)
     : bus{bus},
       service{service},
-      object{object}
+      object{object},
+      create_and_start{create_and_start}
 {
 }
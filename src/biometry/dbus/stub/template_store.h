@@ -39,7 +39,9 @@ public:
     typedef std::shared_ptr<TemplateStore> Ptr;
 
     /// @brief create_for_bus creates a new instance on the given service and object.
-    static Ptr create_for_service_and_object(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object);
+    ///
+    /// If create_and_start is true, operations are created and started with a single call on start_with_observer.
+    static Ptr create_for_service_and_object(const core::dbus::Bus::Ptr& bus, const core::dbus::Service::Ptr& service, const core::dbus::Object::Ptr& object, bool create_and_start = false);
 
     // From biometry::Identifier.
     // biometry::Operation<biometry::TemplateStore::Enrollment>
@@ -53,11 +55,13 @@ private:
     /// @brief TemplateStore creates a new instance for the given remote service and object.
     TemplateStore(const core::dbus::Bus::Ptr& bus,
                   const core::dbus::Service::Ptr& service,
-                  const core::dbus::Object::Ptr& object);
+                  const core::dbus::Object::Ptr& object,
+                  bool create_and_start);
 
     core::dbus::Bus::Ptr bus;
     core::dbus::Service::Ptr service;
     core::dbus::Object::Ptr object;
+    bool create_and_start;
 };
 }
 }
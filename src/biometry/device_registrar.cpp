@@ -21,26 +21,32 @@
 
 #include <biometry/device_registry.h>
 
-#include <biometry/devices/android.h>
-#include <biometry/devices/dummy.h>
-#include <biometry/devices/plugin/device.h>
 #include <biometry/devices/plugin/enumerator.h>
 
+#include <vector>
+
 namespace plugin = biometry::devices::plugin;
 
-biometry::DeviceRegistrar::DeviceRegistrar(const biometry::devices::plugin::Enumerator& enumerator)
+namespace
 {
-    biometry::device_registry()[biometry::devices::Dummy::id] = biometry::devices::Dummy::make_descriptor();
-    biometry::device_registry()[biometry::devices::plugin::id] = biometry::devices::plugin::make_descriptor();
-    biometry::device_registry()[biometry::devices::android::id] = biometry::devices::android::make_descriptor();
-
-    enumerator.enumerate([](const biometry::Device::Descriptor::Ptr& desc)
+std::vector<biometry::Device::Descriptor::Ptr> enumerate_plugins(const biometry::devices::plugin::Enumerator& enumerator)
+{
+    std::vector<biometry::Device::Descriptor::Ptr> plugins;
+    enumerator.enumerate([&plugins](const biometry::Device::Descriptor::Ptr& desc)
     {
-        biometry::device_registry()[desc->name()] = desc;
+        plugins.push_back(desc);
     });
+    return plugins;
+}
+}
+
+biometry::DeviceRegistrar::DeviceRegistrar(const biometry::devices::plugin::Enumerator& enumerator)
+    : registry{new DeviceRegistry{enumerate_plugins(enumerator)}},
+      previous{DeviceRegistry::publish(registry.get())}
+{
 }
 
 biometry::DeviceRegistrar::~DeviceRegistrar()
 {
-    biometry::device_registry().clear();
+    DeviceRegistry::publish(previous);
 }
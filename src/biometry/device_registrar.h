@@ -21,8 +21,11 @@
 #define BIOMETRYD_DEVICE_REGISTRAR_H_
 
 #include <biometry/device.h>
+#include <biometry/device_registry.h>
 #include <biometry/visibility.h>
 
+#include <memory>
+
 namespace biometry
 {
 namespace devices
@@ -36,15 +39,19 @@ class Enumerator;
 }
 /// @brief DeviceRegistrar makes devices known to the device registry.
 ///
-/// A DeviceRegistrar adds Device::Descriptor instances to the registry for both:
+/// A DeviceRegistrar publishes a registry knowing about both:
 ///   - builtin devices
 ///   - plugin devices that place their modules into a well-known location
 struct BIOMETRY_DLL_PUBLIC DeviceRegistrar
 {
-    /// @brief DeviceRegistrar initializes the registry for builtin devices and the plugins reported by enumerator.
+    /// @brief DeviceRegistrar publishes a registry for builtin devices and the plugins reported by enumerator.
     DeviceRegistrar(const biometry::devices::plugin::Enumerator& enumerator);
-    /// @brief DeviceRegistrar cleans out the device registry.
+    /// @brief DeviceRegistrar restores the previously published registry.
     ~DeviceRegistrar();
+
+private:
+    std::unique_ptr<DeviceRegistry> registry;
+    const DeviceRegistry* previous;
 };
 }
 
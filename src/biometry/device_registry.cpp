@@ -16,11 +16,206 @@
  * Authored by: Thomas Voß <thomas.voss@canonical.com>
  *
  */
-
 #include <biometry/device_registry.h>
 
-biometry::DeviceRegistry& biometry::device_registry()
+#include <biometry/devices/android.h>
+#include <biometry/devices/dummy.h>
+#include <biometry/devices/plugin/device.h>
+#include <biometry/devices/simulated.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace
+{
+// BuiltinDevice describes a device that is compiled into biometryd.
+struct BuiltinDevice
+{
+    const char* id;
+    const char* description;
+    biometry::Device::Descriptor::Ptr (*make_descriptor)();
+};
+
+constexpr const BuiltinDevice builtin_devices[] =
+{
+    {biometry::devices::Dummy::id, biometry::devices::Dummy::description, &biometry::devices::Dummy::make_descriptor},
+    {biometry::devices::plugin::id, biometry::devices::plugin::description, &biometry::devices::plugin::make_descriptor},
+    {biometry::devices::android::id, biometry::devices::android::description, &biometry::devices::android::make_descriptor},
+    {biometry::devices::Simulated::id, biometry::devices::Simulated::description, &biometry::devices::Simulated::make_descriptor}
+};
+
+constexpr const std::size_t builtin_device_count = sizeof(builtin_devices) / sizeof(builtin_devices[0]);
+
+// We keep the slot table at a power of 2, leaving room for a perfect hash to be found quickly.
+constexpr std::size_t slot_count_for(std::size_t n)
+{
+    std::size_t result = 1;
+    while (result < 2 * n)
+        result <<= 1;
+    return result;
+}
+
+constexpr const std::size_t slot_count = slot_count_for(builtin_device_count);
+
+// hash implements FNV-1a, mixing in seed.
+constexpr std::uint32_t hash(const char* s, std::uint32_t seed)
+{
+    std::uint32_t result = 2166136261u ^ seed;
+    while (*s)
+        result = (result ^ static_cast<unsigned char>(*s++)) * 16777619u;
+    return result;
+}
+
+constexpr bool equal(const char* lhs, const char* rhs)
+{
+    while (*lhs && *lhs == *rhs)
+        lhs++, rhs++;
+    return *lhs == *rhs;
+}
+
+constexpr bool is_perfect(std::uint32_t seed)
 {
-    static DeviceRegistry registry;
-    return registry;
+    bool taken[slot_count] = {};
+    for (std::size_t i = 0; i < builtin_device_count; i++)
+    {
+        auto slot = hash(builtin_devices[i].id, seed) & (slot_count - 1);
+        if (taken[slot])
+            return false;
+        taken[slot] = true;
+    }
+    return true;
+}
+
+constexpr std::uint32_t find_seed()
+{
+    std::uint32_t seed = 0;
+    while (not is_perfect(seed))
+        seed++;
+    return seed;
+}
+
+constexpr const std::uint32_t seed = find_seed();
+
+// Slots maps hash values to indices into builtin_devices, with -1 marking an empty slot.
+struct Slots
+{
+    int index[slot_count];
+};
+
+constexpr Slots make_slots()
+{
+    Slots slots{};
+    for (std::size_t i = 0; i < slot_count; i++)
+        slots.index[i] = -1;
+    for (std::size_t i = 0; i < builtin_device_count; i++)
+        slots.index[hash(builtin_devices[i].id, seed) & (slot_count - 1)] = static_cast<int>(i);
+    return slots;
+}
+
+constexpr const Slots slots = make_slots();
+
+// builtin_index returns the index of the built-in device known as id, -1 if there is none.
+constexpr int builtin_index(const char* id)
+{
+    return slots.index[hash(id, seed) & (slot_count - 1)] >= 0 &&
+           equal(builtin_devices[slots.index[hash(id, seed) & (slot_count - 1)]].id, id) ?
+                slots.index[hash(id, seed) & (slot_count - 1)] : -1;
+}
+
+static_assert(builtin_index("Dummy") == 0, "Dummy must resolve at compile time");
+static_assert(builtin_index("Unknown") == -1, "Unknown devices must not resolve");
+
+std::vector<biometry::DeviceRegistry::Entry> builtin_entries()
+{
+    std::vector<biometry::DeviceRegistry::Entry> entries;
+    for (const auto& device : builtin_devices)
+        entries.push_back({device.id, device.description, device.make_descriptor().get()});
+    return entries;
+}
+
+// current points to the registry published by the most recent DeviceRegistrar.
+std::atomic<const biometry::DeviceRegistry*>& current()
+{
+    static std::atomic<const biometry::DeviceRegistry*> instance{nullptr};
+    return instance;
+}
+}
+
+biometry::DeviceRegistry::DeviceRegistry() : entries(builtin_entries())
+{
+}
+
+biometry::DeviceRegistry::DeviceRegistry(const std::vector<Device::Descriptor::Ptr>& descriptors) : entries(builtin_entries())
+{
+    for (const auto& descriptor : descriptors)
+    {
+        auto id = descriptor->name();
+        if (builtin_index(id.c_str()) >= 0)
+            continue;
+
+        auto it = std::find_if(plugins.begin(), plugins.end(), [&id](const Plugin& plugin) { return plugin.id == id; });
+        if (it != plugins.end())
+            it->descriptor = descriptor;
+        else
+            plugins.push_back(Plugin{id, descriptor->description(), descriptor});
+    }
+
+    std::sort(plugins.begin(), plugins.end(), [](const Plugin& lhs, const Plugin& rhs) { return lhs.id < rhs.id; });
+
+    // plugins does not change anymore, and we can safely refer to its strings.
+    for (const auto& plugin : plugins)
+        entries.push_back({plugin.id.c_str(), plugin.description.c_str(), plugin.descriptor.get()});
+}
+
+biometry::Device::Descriptor::Ptr biometry::DeviceRegistry::at(const Device::Id& id) const
+{
+    auto index = builtin_index(id.c_str());
+    if (index >= 0)
+        return builtin_devices[index].make_descriptor();
+
+    auto it = std::lower_bound(plugins.begin(), plugins.end(), id, [](const Plugin& plugin, const Device::Id& id) { return plugin.id < id; });
+    if (it != plugins.end() && it->id == id)
+        return it->descriptor;
+
+    throw std::out_of_range{"Unknown device: " + id};
+}
+
+std::size_t biometry::DeviceRegistry::count(const Device::Id& id) const
+{
+    if (builtin_index(id.c_str()) >= 0)
+        return 1;
+
+    return std::binary_search(plugins.begin(), plugins.end(), Plugin{id, {}, {}}, [](const Plugin& lhs, const Plugin& rhs) { return lhs.id < rhs.id; }) ? 1 : 0;
+}
+
+std::size_t biometry::DeviceRegistry::size() const
+{
+    return entries.size();
+}
+
+biometry::DeviceRegistry::Iterator biometry::DeviceRegistry::begin() const
+{
+    return entries.begin();
+}
+
+biometry::DeviceRegistry::Iterator biometry::DeviceRegistry::end() const
+{
+    return entries.end();
+}
+
+const biometry::DeviceRegistry* biometry::DeviceRegistry::publish(const DeviceRegistry* registry)
+{
+    return current().exchange(registry);
+}
+
+const biometry::DeviceRegistry& biometry::device_registry()
+{
+    static const DeviceRegistry builtins;
+
+    if (auto registry = current().load())
+        return *registry;
+
+    return builtins;
 }
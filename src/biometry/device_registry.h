@@ -16,21 +16,91 @@
  * Authored by: Thomas Voß <thomas.voss@canonical.com>
  *
  */
-
 #ifndef BIOMETRYD_DEVICE_REGISTRY_H_
 #define BIOMETRYD_DEVICE_REGISTRY_H_
 
 #include <biometry/device.h>
+#include <biometry/do_not_copy_or_move.h>
 #include <biometry/visibility.h>
 
-#include <unordered_map>
+#include <string>
+#include <vector>
 
 namespace biometry
 {
-typedef std::unordered_map<Device::Id, Device::Descriptor::Ptr> DeviceRegistry;
+/// @cond
+struct DeviceRegistrar;
+/// @endcond
+
+/// @brief DeviceRegistry is an immutable lookup table of known devices.
+///
+/// Built-in devices are known at compile time and resolved via a perfect hash
+/// computed by the compiler. Devices contributed by plugins are merged in once
+/// when creating an instance and never change afterwards.
+class BIOMETRY_DLL_PUBLIC DeviceRegistry : public DoNotCopyOrMove
+{
+public:
+    /// @brief Entry describes a single known device.
+    struct Entry
+    {
+        /// @brief id is the unique name of the device.
+        const char* id;
+        /// @brief description is a one-line summary of the device.
+        const char* description;
+        /// @brief descriptor is the descriptor for creating instances of the device.
+        Device::Descriptor* descriptor;
+    };
+
+    // Safe us some typing.
+    typedef std::vector<Entry>::const_iterator Iterator;
+
+    /// @brief DeviceRegistry initializes a new instance knowing about built-in devices only.
+    DeviceRegistry();
+
+    /// @brief DeviceRegistry initializes a new instance knowing about built-in devices and plugins.
+    ///
+    /// Plugins are registered under their name. Built-in devices take precedence over
+    /// plugins of the same name.
+    explicit DeviceRegistry(const std::vector<Device::Descriptor::Ptr>& plugins);
+
+    /// @brief at returns the descriptor of the device known as id.
+    /// @throws std::out_of_range if no device is known as id.
+    Device::Descriptor::Ptr at(const Device::Id& id) const;
+
+    /// @brief count returns 1 if a device is known as id, 0 otherwise.
+    std::size_t count(const Device::Id& id) const;
+
+    /// @brief size returns the number of known devices.
+    std::size_t size() const;
+
+    /// @brief begin returns an iterator pointing to the first known device.
+    Iterator begin() const;
+    /// @brief end returns an iterator pointing past the last known device.
+    Iterator end() const;
+
+private:
+    /// @cond
+    struct Plugin
+    {
+        std::string id;
+        std::string description;
+        Device::Descriptor::Ptr descriptor;
+    };
+    /// @endcond
+
+    friend struct DeviceRegistrar;
+
+    // publish makes registry the process-wide registry, returning the previously published one.
+    static const DeviceRegistry* publish(const DeviceRegistry* registry);
+
+    std::vector<Plugin> plugins;
+    std::vector<Entry> entries;
+};
 
-/// @brief device_registry returns the process-wide registry of known devices:
-BIOMETRY_DLL_PUBLIC DeviceRegistry& device_registry();
+/// @brief device_registry returns the process-wide registry of known devices.
+///
+/// Without a DeviceRegistrar being alive, only built-in devices are known.
+BIOMETRY_DLL_PUBLIC const DeviceRegistry& device_registry();
 }
 
 #endif // BIOMETRYD_DEVICE_REGISTRY_H_
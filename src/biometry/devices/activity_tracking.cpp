@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/devices/activity_tracking.h>
+
+#include <biometry/operation.h>
+
+#include <mutex>
+
+namespace
+{
+// TrackingObserver holds on to an activity until the operation it observes reaches a final state.
+template<typename T>
+class TrackingObserver : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    TrackingObserver(const biometry::util::ActivityMonitor::Activity& activity, const typename Super::Ptr& impl)
+        : activity{activity},
+          impl{impl}
+    {
+    }
+
+    void on_started() override
+    {
+        impl->on_started();
+    }
+
+    void on_progress(const Progress& progress) override
+    {
+        impl->on_progress(progress);
+    }
+
+    void on_canceled(const Reason& reason) override
+    {
+        impl->on_canceled(reason);
+        finish();
+    }
+
+    void on_failed(const Error& error) override
+    {
+        impl->on_failed(error);
+        finish();
+    }
+
+    void on_succeeded(const Result& result) override
+    {
+        impl->on_succeeded(result);
+        finish();
+    }
+
+private:
+    void finish()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        activity.reset();
+    }
+
+    std::mutex guard;
+    biometry::util::ActivityMonitor::Activity activity;
+    typename Super::Ptr impl;
+};
+
+template<typename T>
+class TrackingOperation : public biometry::Operation<T>
+{
+public:
+    TrackingOperation(const biometry::util::ActivityMonitor::Ptr& monitor, const typename biometry::Operation<T>::Ptr& impl)
+        : monitor{monitor},
+          impl{impl}
+    {
+        // Creating an operation is a request to the device, too.
+        monitor->touch();
+    }
+
+    void start_with_observer(const typename biometry::Operation<T>::Observer::Ptr& observer) override
+    {
+        impl->start_with_observer(std::make_shared<TrackingObserver<T>>(monitor->begin(), observer));
+    }
+
+    void cancel() override
+    {
+        impl->cancel();
+    }
+
+private:
+    biometry::util::ActivityMonitor::Ptr monitor;
+    typename biometry::Operation<T>::Ptr impl;
+};
+
+template<typename T>
+typename biometry::Operation<T>::Ptr track(const biometry::util::ActivityMonitor::Ptr& monitor, const typename biometry::Operation<T>::Ptr& impl)
+{
+    return std::make_shared<TrackingOperation<T>>(monitor, impl);
+}
+}
+
+biometry::devices::ActivityTracking::TemplateStore::TemplateStore(const util::ActivityMonitor::Ptr& monitor, const std::shared_ptr<biometry::Device>& impl)
+    : monitor{monitor},
+      impl{impl}
+{
+}
+
+biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::ActivityTracking::TemplateStore::size(const biometry::Application& app, const biometry::User& user)
+{
+    return track<SizeQuery>(monitor, impl->template_store().size(app, user));
+}
+
+biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::ActivityTracking::TemplateStore::list(const biometry::Application& app, const biometry::User& user)
+{
+    return track<List>(monitor, impl->template_store().list(app, user));
+}
+
+biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::ActivityTracking::TemplateStore::enroll(const biometry::Application& app, const biometry::User& user)
+{
+    return track<Enrollment>(monitor, impl->template_store().enroll(app, user));
+}
+
+biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::ActivityTracking::TemplateStore::remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id)
+{
+    return track<Removal>(monitor, impl->template_store().remove(app, user, id));
+}
+
+biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::ActivityTracking::TemplateStore::clear(const biometry::Application& app, const biometry::User& user)
+{
+    return track<Clearance>(monitor, impl->template_store().clear(app, user));
+}
+
+biometry::devices::ActivityTracking::Identifier::Identifier(const util::ActivityMonitor::Ptr& monitor, const std::shared_ptr<biometry::Device>& impl)
+    : monitor{monitor},
+      impl{impl}
+{
+}
+
+biometry::Operation<biometry::Identification>::Ptr biometry::devices::ActivityTracking::Identifier::identify_user(const biometry::Application& app, const biometry::Reason& reason)
+{
+    return track<biometry::Identification>(monitor, impl->identifier().identify_user(app, reason));
+}
+
+biometry::devices::ActivityTracking::Verifier::Verifier(const util::ActivityMonitor::Ptr& monitor, const std::shared_ptr<biometry::Device>& impl)
+    : monitor{monitor},
+      impl{impl}
+{
+}
+
+biometry::Operation<biometry::Verification>::Ptr biometry::devices::ActivityTracking::Verifier::verify_user(const biometry::Application& app, const biometry::User& user, const biometry::Reason& reason)
+{
+    return track<biometry::Verification>(monitor, impl->verifier().verify_user(app, user, reason));
+}
+
+biometry::devices::ActivityTracking::ActivityTracking(const util::ActivityMonitor::Ptr& monitor, const std::shared_ptr<Device>& device)
+    : template_store_{monitor, device},
+      identifier_{monitor, device},
+      verifier_{monitor, device}
+{
+}
+
+biometry::TemplateStore& biometry::devices::ActivityTracking::template_store()
+{
+    return template_store_;
+}
+
+biometry::Identifier& biometry::devices::ActivityTracking::identifier()
+{
+    return identifier_;
+}
+
+biometry::Verifier& biometry::devices::ActivityTracking::verifier()
+{
+    return verifier_;
+}
@@ -20,12 +20,19 @@
 #include <arpa/inet.h>
 
 #include <biometry/devices/android.h>
+#include <biometry/hardware/flight_recorder.h>
 #include <biometry/util/configuration.h>
+#include <biometry/util/logging.h>
+#include <biometry/util/metrics.h>
 #include <biometry/util/not_implemented.h>
 #include <biometry/util/property_store.h>
+#include <biometry/util/tracing.h>
 
 #include <biometry/device_registry.h>
 
+#include <array>
+#include <stdexcept>
+
 std::string IntToStringFingerprintError(int error, int vendorCode){
     switch(error) {
         case ERROR_NO_ERROR: return "ERROR_NO_ERROR";
@@ -64,23 +71,82 @@ std::string IntToStringRequestStatus(int error){
 
 namespace
 {
+// next_operation_id hands out the ids that tie HAL calls and callbacks of an operation together
+// in the flight recorder.
+std::uint64_t next_operation_id()
+{
+    static std::atomic<std::uint64_t> id{1};
+    return id.fetch_add(1, std::memory_order_relaxed);
+}
 
-class androidEnrollOperation : public biometry::Operation<biometry::TemplateStore::Enrollment>
+// hal_call_duration returns the latency histogram of the HAL entry point call.
+//
+// The histograms of all entry points are looked up in the registry once, on first use,
+// keeping the lock of the registry off the path of HAL calls.
+biometry::util::Metrics::Histogram& hal_call_duration(biometry::hardware::FlightRecorder::Event call)
 {
-public:
-    typename biometry::Operation<biometry::TemplateStore::Enrollment>::Observer::Ptr mobserver;
-    int totalrem = 0;
+    typedef biometry::hardware::FlightRecorder::Event Event;
+    static constexpr const std::size_t count = static_cast<std::size_t>(Event::enumerate_cb) + 1;
 
-    androidEnrollOperation(UHardwareBiometry hybris_fp_instance, uid_t user_id)
-     : hybris_fp_instance{hybris_fp_instance},
-       user_id{user_id}
+    static const std::array<biometry::util::Metrics::Histogram*, count> histograms = []()
+    {
+        std::array<biometry::util::Metrics::Histogram*, count> result;
+        result.fill(nullptr);
+        for (auto i = static_cast<std::size_t>(Event::enroll); i <= static_cast<std::size_t>(Event::authenticate); i++)
+            result[i] = &biometry::util::metrics().histogram(
+                        "hal_call_duration_us", {{"call", biometry::hardware::FlightRecorder::name(static_cast<Event>(i))}});
+        return result;
+    }();
+
+    auto histogram = histograms.at(static_cast<std::size_t>(call));
+    if (not histogram)
+        throw std::logic_error{std::string{"Not a HAL entry point: "} + biometry::hardware::FlightRecorder::name(call)};
+
+    return *histogram;
+}
+
+// timed invokes the HAL entry point call through f, recording call with its arguments and result
+// to the flight recorder, its duration to the latency histogram of call and as a slice of span.
+template<typename F>
+auto timed(const biometry::util::tracing::Span& span, std::uint64_t operation, biometry::hardware::FlightRecorder::Event call,
+           std::initializer_list<std::int64_t> arguments, F&& f) -> decltype(f())
+{
+    struct Slice
+    {
+        Slice(const biometry::util::tracing::Span& span, const char* call) : span(span), call{call}
+        {
+            biometry::util::tracing::begin(span, call);
+        }
+
+        ~Slice()
+        {
+            biometry::util::tracing::end(span, call);
+        }
+
+        const biometry::util::tracing::Span& span;
+        const char* call;
+    } slice{span, biometry::hardware::FlightRecorder::name(call)};
+
+    biometry::hardware::FlightRecorder::record(call, operation, arguments);
+
+    decltype(f()) result;
     {
+        biometry::util::Metrics::Histogram::Timer timer{hal_call_duration(call)};
+        result = f();
     }
 
-    void start_with_observer(const typename biometry::Operation<biometry::TemplateStore::Enrollment>::Observer::Ptr& observer) override
+    biometry::hardware::FlightRecorder::record(biometry::hardware::FlightRecorder::Event::returned, operation, {static_cast<std::int64_t>(call), result});
+    return result;
+}
+
+// Recorded hands the HAL callbacks to the static callbacks of Op, recording each of them
+// to the flight recorder and as an instant of the span of the operation first.
+template<typename Op>
+struct Recorded
+{
+    // notify routes all HAL callbacks to op.
+    static void notify(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance, Op* op)
     {
-        mobserver = observer;
-        observer->on_started();
         UHardwareBiometryParams fp_params;
 
         fp_params.enrollresult_cb = enrollresult_cb;
@@ -89,22 +155,91 @@ public:
         fp_params.error_cb = error_cb;
         fp_params.removed_cb = removed_cb;
         fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
+        fp_params.context = op;
+
+        api.setNotify(hybris_fp_instance, &fp_params);
+    }
+
+    static void record(biometry::hardware::FlightRecorder::Event event, void* context, std::initializer_list<std::int64_t> arguments)
+    {
+        biometry::hardware::FlightRecorder::record(event, static_cast<Op*>(context)->id, arguments);
+        biometry::util::tracing::instant(static_cast<Op*>(context)->span, biometry::hardware::FlightRecorder::name(event));
+    }
 
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
+    static void enrollresult_cb(uint64_t device, uint32_t fingerId, uint32_t groupId, uint32_t remaining, void* context)
+    {
+        record(biometry::hardware::FlightRecorder::Event::enrollresult_cb, context, {fingerId, groupId, remaining});
+        Op::enrollresult_cb(device, fingerId, groupId, remaining, context);
+    }
+
+    static void acquired_cb(uint64_t device, UHardwareBiometryFingerprintAcquiredInfo info, int32_t vendorCode, void* context)
+    {
+        record(biometry::hardware::FlightRecorder::Event::acquired_cb, context, {info, vendorCode});
+        Op::acquired_cb(device, info, vendorCode, context);
+    }
+
+    static void authenticated_cb(uint64_t device, uint32_t fingerId, uint32_t groupId, void* context)
+    {
+        record(biometry::hardware::FlightRecorder::Event::authenticated_cb, context, {fingerId, groupId});
+        Op::authenticated_cb(device, fingerId, groupId, context);
+    }
+
+    static void error_cb(uint64_t device, UHardwareBiometryFingerprintError error, int32_t vendorCode, void* context)
+    {
+        record(biometry::hardware::FlightRecorder::Event::error_cb, context, {error, vendorCode});
+        Op::error_cb(device, error, vendorCode, context);
+    }
+
+    static void removed_cb(uint64_t device, uint32_t fingerId, uint32_t groupId, uint32_t remaining, void* context)
+    {
+        record(biometry::hardware::FlightRecorder::Event::removed_cb, context, {fingerId, groupId, remaining});
+        Op::removed_cb(device, fingerId, groupId, remaining, context);
+    }
+
+    static void enumerate_cb(uint64_t device, uint32_t fingerId, uint32_t groupId, uint32_t remaining, void* context)
+    {
+        record(biometry::hardware::FlightRecorder::Event::enumerate_cb, context, {fingerId, groupId, remaining});
+        Op::enumerate_cb(device, fingerId, groupId, remaining, context);
+    }
+};
+
+class androidEnrollOperation : public biometry::Operation<biometry::TemplateStore::Enrollment>
+{
+public:
+    typename biometry::Operation<biometry::TemplateStore::Enrollment>::Observer::Ptr mobserver;
+    int totalrem = 0;
+
+    androidEnrollOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance, uid_t user_id)
+     : api{api},
+       hybris_fp_instance{hybris_fp_instance},
+       user_id{user_id}
+    {
+    }
+
+    void start_with_observer(const typename biometry::Operation<biometry::TemplateStore::Enrollment>::Observer::Ptr& observer) override
+    {
+        mobserver = observer;
+        span = biometry::util::tracing::current();
+        observer->on_started();
+        Recorded<androidEnrollOperation>::notify(api, hybris_fp_instance, this);
 
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_enroll(hybris_fp_instance, 0, 60, user_id);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::enroll, {0, 60, user_id}, [&]() { return api.enroll(hybris_fp_instance, 0, 60, user_id); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
 
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
 
 private:
+    friend struct Recorded<androidEnrollOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
     uid_t user_id;
 
     static void acquired_cb(uint64_t, UHardwareBiometryFingerprintAcquiredInfo, int32_t, void *){}
@@ -122,7 +257,7 @@ private:
             ((androidEnrollOperation*)context)->mobserver->on_progress(biometry::Progress{biometry::Percent::from_raw_value(raw_value), biometry::Dictionary{}});
         } else {
             ((androidEnrollOperation*)context)->mobserver->on_progress(biometry::Progress{biometry::Percent::from_raw_value(1), biometry::Dictionary{}});
-            UHardwareBiometryRequestStatus ret = u_hardware_biometry_postEnroll(((androidEnrollOperation*)context)->hybris_fp_instance);
+            UHardwareBiometryRequestStatus ret = timed(((androidEnrollOperation*)context)->span, ((androidEnrollOperation*)context)->id, biometry::hardware::FlightRecorder::Event::post_enroll, {}, [&]() { return ((androidEnrollOperation*)context)->api.postEnroll(((androidEnrollOperation*)context)->hybris_fp_instance); });
             if (ret == SYS_OK)
                 ((androidEnrollOperation*)context)->mobserver->on_succeeded(fingerId);
             else
@@ -144,8 +279,9 @@ class androidRemovalOperation : public biometry::Operation<biometry::TemplateSto
 public:
     typename biometry::Operation<biometry::TemplateStore::Removal>::Observer::Ptr mobserver;
 
-    androidRemovalOperation(UHardwareBiometry hybris_fp_instance, uint32_t finger)
-     : hybris_fp_instance{hybris_fp_instance},
+    androidRemovalOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance, uint32_t finger)
+     : api{api},
+       hybris_fp_instance{hybris_fp_instance},
        finger{finger}
     {
     }
@@ -153,30 +289,26 @@ public:
     void start_with_observer(const typename biometry::Operation<biometry::TemplateStore::Removal>::Observer::Ptr& observer) override
     {
         mobserver = observer;
+        span = biometry::util::tracing::current();
         observer->on_started();
-        UHardwareBiometryParams fp_params;
-
-        fp_params.enrollresult_cb = enrollresult_cb;
-        fp_params.acquired_cb = acquired_cb;
-        fp_params.authenticated_cb = authenticated_cb;
-        fp_params.error_cb = error_cb;
-        fp_params.removed_cb = removed_cb;
-        fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
-
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_remove(hybris_fp_instance, 0, finger);
+        Recorded<androidRemovalOperation>::notify(api, hybris_fp_instance, this);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::remove, {0, finger}, [&]() { return api.remove(hybris_fp_instance, 0, finger); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
 
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
 
 private:
+    friend struct Recorded<androidRemovalOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
     uint32_t finger;
 
     static void enrollresult_cb(uint64_t, uint32_t, uint32_t, uint32_t, void *){}
@@ -202,38 +334,35 @@ class androidVerificationOperation : public biometry::Operation<biometry::Verifi
 public:
     typename biometry::Operation<biometry::Verification>::Observer::Ptr mobserver;
 
-    androidVerificationOperation(UHardwareBiometry hybris_fp_instance)
-     : hybris_fp_instance{hybris_fp_instance}
+    androidVerificationOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+     : api{api},
+       hybris_fp_instance{hybris_fp_instance}
     {
     }
 
     void start_with_observer(const typename biometry::Operation<biometry::Verification>::Observer::Ptr& observer) override
     {
         mobserver = observer;
+        span = biometry::util::tracing::current();
         observer->on_started();
-        UHardwareBiometryParams fp_params;
-
-        fp_params.enrollresult_cb = enrollresult_cb;
-        fp_params.acquired_cb = acquired_cb;
-        fp_params.authenticated_cb = authenticated_cb;
-        fp_params.error_cb = error_cb;
-        fp_params.removed_cb = removed_cb;
-        fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
-
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_authenticate(hybris_fp_instance, 0, 0);
+        Recorded<androidVerificationOperation>::notify(api, hybris_fp_instance, this);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::authenticate, {0, 0}, [&]() { return api.authenticate(hybris_fp_instance, 0, 0); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
 
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
 
 private:
+    friend struct Recorded<androidVerificationOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
 
     static void enrollresult_cb(uint64_t, uint32_t, uint32_t, uint32_t, void *){}
     static void acquired_cb(uint64_t, UHardwareBiometryFingerprintAcquiredInfo, int32_t, void *){}
@@ -260,38 +389,35 @@ class androidIdentificationOperation : public biometry::Operation<biometry::Iden
 public:
     typename biometry::Operation<biometry::Identification>::Observer::Ptr mobserver;
     
-    androidIdentificationOperation(UHardwareBiometry hybris_fp_instance)
-    : hybris_fp_instance{hybris_fp_instance}
+    androidIdentificationOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+    : api{api},
+      hybris_fp_instance{hybris_fp_instance}
     {
     }
     
     void start_with_observer(const typename biometry::Operation<biometry::Identification>::Observer::Ptr& observer) override
     {
         mobserver = observer;
+        span = biometry::util::tracing::current();
         observer->on_started();
-        UHardwareBiometryParams fp_params;
-        
-        fp_params.enrollresult_cb = enrollresult_cb;
-        fp_params.acquired_cb = acquired_cb;
-        fp_params.authenticated_cb = authenticated_cb;
-        fp_params.error_cb = error_cb;
-        fp_params.removed_cb = removed_cb;
-        fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
-        
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_authenticate(hybris_fp_instance, 0, 0);
+        Recorded<androidIdentificationOperation>::notify(api, hybris_fp_instance, this);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::authenticate, {0, 0}, [&]() { return api.authenticate(hybris_fp_instance, 0, 0); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
     
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
     
 private:
+    friend struct Recorded<androidIdentificationOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
     
     static void enrollresult_cb(uint64_t, uint32_t, uint32_t, uint32_t, void *){}
     static void acquired_cb(uint64_t, UHardwareBiometryFingerprintAcquiredInfo, int32_t, void *){}
@@ -320,38 +446,35 @@ public:
     int totalrem = 0;
     std::vector<uint64_t> result;
 
-    androidListOperation(UHardwareBiometry hybris_fp_instance)
-     : hybris_fp_instance{hybris_fp_instance}
+    androidListOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+     : api{api},
+       hybris_fp_instance{hybris_fp_instance}
     {
     }
 
     void start_with_observer(const typename biometry::Operation<biometry::TemplateStore::List>::Observer::Ptr& observer) override
     {
         mobserver = observer;
+        span = biometry::util::tracing::current();
         observer->on_started();
-        UHardwareBiometryParams fp_params;
-
-        fp_params.enrollresult_cb = enrollresult_cb;
-        fp_params.acquired_cb = acquired_cb;
-        fp_params.authenticated_cb = authenticated_cb;
-        fp_params.error_cb = error_cb;
-        fp_params.removed_cb = removed_cb;
-        fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
-
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_enumerate(hybris_fp_instance);
+        Recorded<androidListOperation>::notify(api, hybris_fp_instance, this);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::enumerate, {}, [&]() { return api.enumerate(hybris_fp_instance); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
 
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
 
 private:
+    friend struct Recorded<androidListOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
 
     static void enrollresult_cb(uint64_t, uint32_t, uint32_t, uint32_t, void *){}
     static void acquired_cb(uint64_t, UHardwareBiometryFingerprintAcquiredInfo, int32_t, void *){}
@@ -391,38 +514,35 @@ public:
     typename biometry::Operation<biometry::TemplateStore::SizeQuery>::Observer::Ptr mobserver;
     int totalrem = 0;
 
-    androidSizeOperation(UHardwareBiometry hybris_fp_instance)
-     : hybris_fp_instance{hybris_fp_instance}
+    androidSizeOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+     : api{api},
+       hybris_fp_instance{hybris_fp_instance}
     {
     }
 
     void start_with_observer(const typename biometry::Operation<biometry::TemplateStore::SizeQuery>::Observer::Ptr& observer) override
     {
         mobserver = observer;
+        span = biometry::util::tracing::current();
         observer->on_started();
-        UHardwareBiometryParams fp_params;
-
-        fp_params.enrollresult_cb = enrollresult_cb;
-        fp_params.acquired_cb = acquired_cb;
-        fp_params.authenticated_cb = authenticated_cb;
-        fp_params.error_cb = error_cb;
-        fp_params.removed_cb = removed_cb;
-        fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
-
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_enumerate(hybris_fp_instance);
+        Recorded<androidSizeOperation>::notify(api, hybris_fp_instance, this);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::enumerate, {}, [&]() { return api.enumerate(hybris_fp_instance); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
 
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
 
 private:
+    friend struct Recorded<androidSizeOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
 
     static void enrollresult_cb(uint64_t, uint32_t, uint32_t, uint32_t, void *){}
     static void acquired_cb(uint64_t, UHardwareBiometryFingerprintAcquiredInfo, int32_t, void *){}
@@ -458,38 +578,35 @@ class androidClearOperation : public biometry::Operation<biometry::TemplateStore
 public:
     typename biometry::Operation<biometry::TemplateStore::Clearance>::Observer::Ptr mobserver;
 
-    androidClearOperation(UHardwareBiometry hybris_fp_instance)
-     : hybris_fp_instance{hybris_fp_instance}
+    androidClearOperation(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+     : api{api},
+       hybris_fp_instance{hybris_fp_instance}
     {
     }
 
     void start_with_observer(const typename biometry::Operation<biometry::TemplateStore::Clearance>::Observer::Ptr& observer) override
     {
         mobserver = observer;
+        span = biometry::util::tracing::current();
         observer->on_started();
-        UHardwareBiometryParams fp_params;
-
-        fp_params.enrollresult_cb = enrollresult_cb;
-        fp_params.acquired_cb = acquired_cb;
-        fp_params.authenticated_cb = authenticated_cb;
-        fp_params.error_cb = error_cb;
-        fp_params.removed_cb = removed_cb;
-        fp_params.enumerate_cb = enumerate_cb;
-        fp_params.context = this;
-
-        u_hardware_biometry_setNotify(hybris_fp_instance, &fp_params);
-        UHardwareBiometryRequestStatus ret = u_hardware_biometry_remove(hybris_fp_instance, 0, 0);
+        Recorded<androidClearOperation>::notify(api, hybris_fp_instance, this);
+        UHardwareBiometryRequestStatus ret = timed(span, id, biometry::hardware::FlightRecorder::Event::remove, {0, 0}, [&]() { return api.remove(hybris_fp_instance, 0, 0); });
         if (ret != SYS_OK)
             observer->on_failed(IntToStringRequestStatus(ret));
     }
 
     void cancel() override
     {
-        u_hardware_biometry_cancel(hybris_fp_instance);
+        timed(biometry::util::tracing::current(), id, biometry::hardware::FlightRecorder::Event::cancel, {}, [&]() { return api.cancel(hybris_fp_instance); });
     }
 
 private:
+    friend struct Recorded<androidClearOperation>;
+
+    const biometry::hardware::FingerprintApi& api;
     UHardwareBiometry hybris_fp_instance;
+    biometry::util::tracing::Span span;
+    std::uint64_t id{next_operation_id()};
 
     static void enrollresult_cb(uint64_t, uint32_t, uint32_t, uint32_t, void *){}
     static void acquired_cb(uint64_t, UHardwareBiometryFingerprintAcquiredInfo, int32_t, void *){}
@@ -514,72 +631,79 @@ private:
 };
 }
 
-biometry::devices::android::TemplateStore::TemplateStore(UHardwareBiometry hybris_fp_instance)
-    : hybris_fp_instance{hybris_fp_instance}
+biometry::devices::android::TemplateStore::TemplateStore(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+    : api{api},
+      hybris_fp_instance{hybris_fp_instance}
 {
 }
 
 biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::android::TemplateStore::size(const biometry::Application&, const biometry::User&)
 {
-    return std::make_shared<androidSizeOperation>(hybris_fp_instance);
+    return std::make_shared<androidSizeOperation>(api, hybris_fp_instance);
 }
 
 biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::android::TemplateStore::list(const biometry::Application&, const biometry::User&)
 {
-    return std::make_shared<androidListOperation>(hybris_fp_instance);
+    return std::make_shared<androidListOperation>(api, hybris_fp_instance);
 }
 
 biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::android::TemplateStore::enroll(const biometry::Application&, const biometry::User& user)
 {
-    return std::make_shared<androidEnrollOperation>(hybris_fp_instance, user.id);
+    return std::make_shared<androidEnrollOperation>(api, hybris_fp_instance, user.id);
 }
 
 biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::android::TemplateStore::remove(const biometry::Application&, const biometry::User&, biometry::TemplateStore::TemplateId id)
 {
-    return std::make_shared<androidRemovalOperation>(hybris_fp_instance, id);
+    return std::make_shared<androidRemovalOperation>(api, hybris_fp_instance, id);
 }
 
 biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::android::TemplateStore::clear(const biometry::Application&, const biometry::User&)
 {
-    return std::make_shared<androidClearOperation>(hybris_fp_instance);
+    return std::make_shared<androidClearOperation>(api, hybris_fp_instance);
 }
 
-biometry::devices::android::Identifier::Identifier(UHardwareBiometry hybris_fp_instance)
-    : hybris_fp_instance{hybris_fp_instance}
+biometry::devices::android::Identifier::Identifier(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+    : api{api},
+      hybris_fp_instance{hybris_fp_instance}
 {
 }
 
 biometry::Operation<biometry::Identification>::Ptr biometry::devices::android::Identifier::identify_user(const biometry::Application&, const biometry::Reason&)
 {
-    return std::make_shared<androidIdentificationOperation>(hybris_fp_instance);
+    return std::make_shared<androidIdentificationOperation>(api, hybris_fp_instance);
 }
 
-biometry::devices::android::Verifier::Verifier(UHardwareBiometry hybris_fp_instance)
-    : hybris_fp_instance{hybris_fp_instance}
+biometry::devices::android::Verifier::Verifier(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+    : api{api},
+      hybris_fp_instance{hybris_fp_instance}
 {
 }
 
 biometry::Operation<biometry::Verification>::Ptr biometry::devices::android::Verifier::verify_user(const biometry::Application&, const biometry::User&, const biometry::Reason&)
 {
-    return std::make_shared<androidVerificationOperation>(hybris_fp_instance);
+    return std::make_shared<androidVerificationOperation>(api, hybris_fp_instance);
+}
+
+biometry::devices::android::android(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance)
+    : android{api, hybris_fp_instance, biometry::util::AndroidPropertyStore{}}
+{
 }
 
-biometry::devices::android::android(UHardwareBiometry hybris_fp_instance)
-    : template_store_{hybris_fp_instance},
-      identifier_{hybris_fp_instance},
-      verifier_{hybris_fp_instance}
+biometry::devices::android::android(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance, const biometry::util::PropertyStore& store)
+    : template_store_{api, hybris_fp_instance},
+      identifier_{api, hybris_fp_instance},
+      verifier_{api, hybris_fp_instance}
 {
-    biometry::util::AndroidPropertyStore store;
     UHardwareBiometryRequestStatus ret = SYS_OK;
     std::string api_level = store.get("ro.product.first_api_level");
     if (api_level.empty())
         api_level = store.get("ro.build.version.sdk");
     if (atoi(api_level.c_str()) <= 27)
-        ret = u_hardware_biometry_setActiveGroup(hybris_fp_instance, 0, (char*)"/data/system/users/0/fpdata/");
+        ret = timed(biometry::util::tracing::current(), 0, biometry::hardware::FlightRecorder::Event::set_active_group, {0}, [&]() { return api.setActiveGroup(hybris_fp_instance, 0, (char*)"/data/system/users/0/fpdata/"); });
     else
-        ret = u_hardware_biometry_setActiveGroup(hybris_fp_instance, 0, (char*)"/data/vendor_de/0/fpdata/");
+        ret = timed(biometry::util::tracing::current(), 0, biometry::hardware::FlightRecorder::Event::set_active_group, {0}, [&]() { return api.setActiveGroup(hybris_fp_instance, 0, (char*)"/data/vendor_de/0/fpdata/"); });
     if (ret != SYS_OK)
-        printf("setActiveGroup failed: %s\n", IntToStringRequestStatus(ret).c_str());
+        biometry::util::logging::warning("setActiveGroup failed: %s", IntToStringRequestStatus(ret).c_str());
 }
 
 biometry::TemplateStore& biometry::devices::android::template_store()
@@ -603,7 +727,10 @@ struct androidDescriptor : public biometry::Device::Descriptor
 {
     std::shared_ptr<biometry::Device> create(const biometry::util::Configuration&) override
     {
-        return std::make_shared<biometry::devices::android>(u_hardware_biometry_new());
+        // Resolving the complete table up front fails fast on an incomplete HAL bridge
+        // and keeps symbol lookup out of individual operations.
+        const auto& api = biometry::hardware::FingerprintApi::resolve();
+        return std::make_shared<biometry::devices::android>(api, api.create());
     }
 
     std::string name() const override
@@ -618,12 +745,20 @@ struct androidDescriptor : public biometry::Device::Descriptor
 
     std::string description() const override
     {
-        return "android is a biometry::Device implementation for connecting to android fp hal using hybris.";
+        return biometry::devices::android::description;
+    }
+
+    bool supports_hot_swap() const override
+    {
+        // The HAL does not offer a way to close an instance created by api.create(),
+        // and only ever notifies a single callback.
+        return false;
     }
 };
 }
 
 biometry::Device::Descriptor::Ptr biometry::devices::android::make_descriptor()
 {
-    return std::make_shared<androidDescriptor>();
+    static androidDescriptor descriptor;
+    return Descriptor::Ptr{Descriptor::Ptr{}, &descriptor};
 }
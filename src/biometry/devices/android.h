@@ -27,6 +27,9 @@
 #include <biometry/verifier.h>
 
 #include <biometry/hardware/biometry.h>
+#include <biometry/hardware/fingerprint_api.h>
+
+#include <biometry/util/property_store.h>
 
 namespace biometry
 {
@@ -37,11 +40,12 @@ class BIOMETRY_DLL_PUBLIC android : public biometry::Device
 {
 public:
     static constexpr const char* id{"android"};
+    static constexpr const char* description{"android is a biometry::Device implementation for connecting to android fp hal using hybris."};
 
     class TemplateStore : public biometry::TemplateStore
     {
     public:
-        TemplateStore(UHardwareBiometry hybris_fp_instance);
+        TemplateStore(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance);
 
         // From biometry::TemplateStore.
         biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override;
@@ -51,38 +55,45 @@ public:
         biometry::Operation<biometry::TemplateStore::Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override;
 
     private:
+        const biometry::hardware::FingerprintApi& api;
         UHardwareBiometry hybris_fp_instance;
     };
 
     class Identifier : public biometry::Identifier
     {
     public:
-        Identifier(UHardwareBiometry hybris_fp_instance);
+        Identifier(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance);
 
         // From biometry::Identifier.
         biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override;
 
     private:
+        const biometry::hardware::FingerprintApi& api;
         UHardwareBiometry hybris_fp_instance;
     };
 
     class Verifier : public biometry::Verifier
     {
     public:
-        Verifier(UHardwareBiometry hybris_fp_instance);
+        Verifier(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance);
 
         // From biometry::Identifier.
         Operation<Verification>::Ptr verify_user(const Application& app, const User& user, const Reason& reason) override;
 
     private:
+        const biometry::hardware::FingerprintApi& api;
         UHardwareBiometry hybris_fp_instance;
     };
 
     /// @brief make_descriptor returns a descriptor instance describing a android device;
     static Descriptor::Ptr make_descriptor();
 
-    /// @brief android initializes a new instance.
-    android(UHardwareBiometry hybris_fp_instance);
+    /// @brief android initializes a new instance, issuing all HAL calls via the pre-resolved api.
+    android(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance);
+
+    /// @brief android initializes a new instance, consulting property_store for the
+    /// api level of the HAL when selecting the template directory.
+    android(const biometry::hardware::FingerprintApi& api, UHardwareBiometry hybris_fp_instance, const biometry::util::PropertyStore& property_store);
 
     // From biometry::Device
     biometry::TemplateStore& template_store() override;
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/devices/deferred.h>
+
+#include <biometry/application.h>
+#include <biometry/operation.h>
+#include <biometry/optional.h>
+#include <biometry/reason.h>
+#include <biometry/user.h>
+
+#include <biometry/util/unique_function.h>
+
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+struct biometry::devices::Deferred::State
+{
+    /// @brief when_settled invokes f once the device has been resolved or has failed.
+    ///
+    /// f is invoked immediately if the device has already been settled, and
+    /// by the thread settling the device otherwise.
+    void when_settled(biometry::util::UniqueFunction<void()>&& f)
+    {
+        {
+            std::lock_guard<std::mutex> lg{guard};
+
+            if (not settled())
+            {
+                pending.push_back(std::move(f));
+                return;
+            }
+        }
+
+        f();
+    }
+
+    /// @brief settle installs either a device or an error, running all pending tasks.
+    void settle(const std::shared_ptr<biometry::Device>& d, const biometry::Optional<std::string>& e)
+    {
+        std::vector<biometry::util::UniqueFunction<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lg{guard};
+
+            if (settled())
+                throw std::logic_error{"Deferred device has already been settled"};
+
+            device = d;
+            error = e;
+            tasks.swap(pending);
+        }
+
+        for (auto& task : tasks)
+            task();
+    }
+
+    /// @brief resolved returns the device if it is available, nullptr otherwise.
+    std::shared_ptr<biometry::Device> resolved()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return device;
+    }
+
+    /// @brief outcome returns the device or the error, only valid once settled.
+    std::pair<std::shared_ptr<biometry::Device>, std::string> outcome()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return {device, error ? *error : std::string{}};
+    }
+
+    bool settled() const
+    {
+        return device || error;
+    }
+
+    std::mutex guard;
+    std::shared_ptr<biometry::Device> device;
+    biometry::Optional<std::string> error;
+    std::vector<biometry::util::UniqueFunction<void()>> pending;
+};
+
+namespace
+{
+// DeferredOperation creates the actual operation once the device has been settled.
+template<typename T>
+class DeferredOperation : public biometry::Operation<T>, public std::enable_shared_from_this<DeferredOperation<T>>
+{
+public:
+    typedef std::function<typename biometry::Operation<T>::Ptr(biometry::Device&)> Factory;
+
+    DeferredOperation(const std::shared_ptr<biometry::devices::Deferred::State>& state, const Factory& factory)
+        : state{state},
+          factory{factory}
+    {
+    }
+
+    void start_with_observer(const typename biometry::Operation<T>::Observer::Ptr& observer) override
+    {
+        auto thiz = this->shared_from_this();
+        state->when_settled([thiz, observer]()
+        {
+            thiz->start_with_observer_once_settled(observer);
+        });
+    }
+
+    void cancel() override
+    {
+        typename biometry::Operation<T>::Ptr op;
+        {
+            std::lock_guard<std::mutex> lg{guard};
+            canceled = true;
+            op = impl;
+        }
+
+        if (op)
+            op->cancel();
+    }
+
+private:
+    void start_with_observer_once_settled(const typename biometry::Operation<T>::Observer::Ptr& observer)
+    {
+        auto outcome = state->outcome();
+
+        if (not outcome.first)
+        {
+            observer->on_failed(outcome.second);
+            return;
+        }
+
+        auto op = factory(*outcome.first);
+        {
+            std::lock_guard<std::mutex> lg{guard};
+
+            if (canceled)
+            {
+                observer->on_canceled("Canceled before the device became available");
+                return;
+            }
+
+            impl = op;
+        }
+
+        op->start_with_observer(observer);
+    }
+
+    std::shared_ptr<biometry::devices::Deferred::State> state;
+    Factory factory;
+
+    std::mutex guard;
+    bool canceled{false};
+    typename biometry::Operation<T>::Ptr impl;
+};
+
+// make_operation returns the actual operation if the device is available, and a DeferredOperation otherwise.
+template<typename T>
+typename biometry::Operation<T>::Ptr make_operation(
+        const std::shared_ptr<biometry::devices::Deferred::State>& state,
+        const typename DeferredOperation<T>::Factory& factory)
+{
+    if (auto device = state->resolved())
+        return factory(*device);
+
+    return std::make_shared<DeferredOperation<T>>(state, factory);
+}
+}
+
+biometry::devices::Deferred::TemplateStore::TemplateStore(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::Deferred::TemplateStore::size(const biometry::Application& app, const biometry::User& user)
+{
+    return make_operation<SizeQuery>(state, [app, user](biometry::Device& device) { return device.template_store().size(app, user); });
+}
+
+biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::Deferred::TemplateStore::list(const biometry::Application& app, const biometry::User& user)
+{
+    return make_operation<List>(state, [app, user](biometry::Device& device) { return device.template_store().list(app, user); });
+}
+
+biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::Deferred::TemplateStore::enroll(const biometry::Application& app, const biometry::User& user)
+{
+    return make_operation<Enrollment>(state, [app, user](biometry::Device& device) { return device.template_store().enroll(app, user); });
+}
+
+biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::Deferred::TemplateStore::remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id)
+{
+    return make_operation<Removal>(state, [app, user, id](biometry::Device& device) { return device.template_store().remove(app, user, id); });
+}
+
+biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::Deferred::TemplateStore::clear(const biometry::Application& app, const biometry::User& user)
+{
+    return make_operation<Clearance>(state, [app, user](biometry::Device& device) { return device.template_store().clear(app, user); });
+}
+
+biometry::devices::Deferred::Identifier::Identifier(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::Identification>::Ptr biometry::devices::Deferred::Identifier::identify_user(const biometry::Application& app, const biometry::Reason& reason)
+{
+    return make_operation<biometry::Identification>(state, [app, reason](biometry::Device& device) { return device.identifier().identify_user(app, reason); });
+}
+
+biometry::devices::Deferred::Verifier::Verifier(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::Verification>::Ptr biometry::devices::Deferred::Verifier::verify_user(const biometry::Application& app, const biometry::User& user, const biometry::Reason& reason)
+{
+    return make_operation<biometry::Verification>(state, [app, user, reason](biometry::Device& device) { return device.verifier().verify_user(app, user, reason); });
+}
+
+biometry::devices::Deferred::Deferred()
+    : state{std::make_shared<State>()},
+      template_store_{state},
+      identifier_{state},
+      verifier_{state}
+{
+}
+
+void biometry::devices::Deferred::resolve(const std::shared_ptr<biometry::Device>& device)
+{
+    if (not device)
+        throw std::logic_error{"Cannot resolve a Deferred device to null"};
+
+    state->settle(device, biometry::Optional<std::string>{});
+}
+
+void biometry::devices::Deferred::fail(const std::string& error)
+{
+    state->settle(nullptr, error);
+}
+
+biometry::TemplateStore& biometry::devices::Deferred::template_store()
+{
+    return template_store_;
+}
+
+biometry::Identifier& biometry::devices::Deferred::identifier()
+{
+    return identifier_;
+}
+
+biometry::Verifier& biometry::devices::Deferred::verifier()
+{
+    return verifier_;
+}
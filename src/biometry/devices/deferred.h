@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef BIOMETRYD_DEVICES_DEFERRED_H_
+#define BIOMETRYD_DEVICES_DEFERRED_H_
+
+#include <biometry/device.h>
+
+#include <biometry/identifier.h>
+#include <biometry/template_store.h>
+#include <biometry/verifier.h>
+
+#include <memory>
+#include <string>
+
+namespace biometry
+{
+namespace devices
+{
+/// @brief Deferred is a biometry::Device that stands in for a device that is still being created.
+///
+/// Requests reaching a Deferred instance before the actual device is available are queued,
+/// and carried out once the device has been handed over by means of resolve. Requests arriving
+/// afterwards are forwarded right away.
+class BIOMETRY_DLL_PUBLIC Deferred : public biometry::Device
+{
+public:
+    /// @cond
+    struct State;
+    /// @endcond
+
+    // Safe us some typing.
+    typedef std::shared_ptr<Deferred> Ptr;
+
+    class TemplateStore : public biometry::TemplateStore
+    {
+    public:
+        TemplateStore(const std::shared_ptr<State>& state);
+
+        // From biometry::TemplateStore.
+        biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::List>::Ptr list(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr enroll(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Removal>::Ptr remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id) override;
+        biometry::Operation<biometry::TemplateStore::Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    class Identifier : public biometry::Identifier
+    {
+    public:
+        Identifier(const std::shared_ptr<State>& state);
+
+        // From biometry::Identifier.
+        biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    class Verifier : public biometry::Verifier
+    {
+    public:
+        Verifier(const std::shared_ptr<State>& state);
+
+        // From biometry::Verifier.
+        Operation<Verification>::Ptr verify_user(const Application& app, const User& user, const Reason& reason) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    /// @brief Deferred creates a new instance, queueing requests until resolve or fail is called.
+    Deferred();
+
+    /// @brief resolve hands over the actual device, carrying out all queued requests.
+    /// @throws std::logic_error if the instance has already been resolved or failed.
+    void resolve(const std::shared_ptr<biometry::Device>& device);
+
+    /// @brief fail marks the actual device as unavailable, failing all queued and future requests with error.
+    /// @throws std::logic_error if the instance has already been resolved or failed.
+    void fail(const std::string& error);
+
+    // From biometry::Device
+    biometry::TemplateStore& template_store() override;
+    biometry::Identifier& identifier() override;
+    biometry::Verifier& verifier() override;
+
+private:
+    std::shared_ptr<State> state;
+    TemplateStore template_store_;
+    Identifier identifier_;
+    Verifier verifier_;
+};
+}
+}
+
+#endif // BIOMETRYD_DEVICES_DEFERRED_H_
@@ -23,24 +23,90 @@
 #include <biometry/operation.h>
 #include <biometry/template_store.h>
 
+#include <biometry/util/tracing.h>
+
 namespace
 {
+// ReplyingObserver hands all notifications to a dispatcher, keeping the
+// threads reporting progress from executing the observer.
+template<typename T>
+class ReplyingObserver : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    ReplyingObserver(const std::shared_ptr<biometry::util::Dispatcher>& replies, const typename Super::Ptr& impl)
+        : replies{replies},
+          impl{impl}
+    {
+    }
+
+    void on_started() override
+    {
+        replies->dispatch([i = impl]() { i->on_started(); });
+    }
+
+    void on_progress(const Progress& progress) override
+    {
+        replies->dispatch([i = impl, progress]() { i->on_progress(progress); });
+    }
+
+    void on_canceled(const Reason& reason) override
+    {
+        replies->dispatch([i = impl, reason]() { i->on_canceled(reason); });
+    }
+
+    void on_failed(const Error& error) override
+    {
+        replies->dispatch([i = impl, error]() { i->on_failed(error); });
+    }
+
+    void on_succeeded(const Result& result) override
+    {
+        replies->dispatch([i = impl, result]() { i->on_succeeded(result); });
+    }
+
+private:
+    std::shared_ptr<biometry::util::Dispatcher> replies;
+    typename Super::Ptr impl;
+};
+
 template<typename T>
 class DispatchingOperation : public biometry::Operation<T>
 {
 public:
 
-    DispatchingOperation(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Operation<T>>& impl)
+    DispatchingOperation(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher,
+                         const std::shared_ptr<biometry::util::Dispatcher>& replies,
+                         const std::shared_ptr<biometry::Operation<T>>& impl)
         : dispatcher{dispatcher},
+          replies{replies},
           impl{impl}
     {
     }
 
     void start_with_observer(const typename biometry::Operation<T>::Observer::Ptr& observer) override
     {
-        auto i= impl;
-        dispatcher->dispatch([i, observer]()
+        auto span = biometry::util::tracing::current();
+        biometry::util::tracing::instant(span, "dispatch");
+
+        typename biometry::Operation<T>::Observer::Ptr o{observer};
+        if (replies)
+            o = std::make_shared<ReplyingObserver<T>>(replies, observer);
+
+        // The observer is moved along with the task, without further copies on the
+        // way to execution. We hand a copy of impl to the task, keeping our reference
+        // for cancel(), and the span is a plain value.
+        dispatcher->dispatch([i = impl, observer = std::move(o), span]()
         {
+            biometry::util::tracing::Scope scope{span};
+            biometry::util::tracing::instant(span, "execute");
+
             i->start_with_observer(observer);
         });
     }
@@ -53,67 +119,72 @@ public:
 
 private:
     std::shared_ptr<biometry::util::Dispatcher> dispatcher;
+    std::shared_ptr<biometry::util::Dispatcher> replies;
     std::shared_ptr<biometry::Operation<T>> impl;
 };
 }
 
-biometry::devices::Dispatching::TemplateStore::TemplateStore(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& impl)
+biometry::devices::Dispatching::TemplateStore::TemplateStore(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::util::Dispatcher>& replies, const std::shared_ptr<biometry::Device>& impl)
     : dispatcher{dispatcher},
+      replies{replies},
       impl{impl}
 {
 }
 
 biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::Dispatching::TemplateStore::size(const biometry::Application& app, const biometry::User& user)
 {
-    return std::make_shared<DispatchingOperation<biometry::TemplateStore::SizeQuery>>(dispatcher, impl->template_store().size(app, user));
+    return std::make_shared<DispatchingOperation<biometry::TemplateStore::SizeQuery>>(dispatcher, replies, impl->template_store().size(app, user));
 }
 
 biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::Dispatching::TemplateStore::list(const biometry::Application& app, const biometry::User& user)
 {
-    return std::make_shared<DispatchingOperation<biometry::TemplateStore::List>>(dispatcher, impl->template_store().list(app, user));
+    return std::make_shared<DispatchingOperation<biometry::TemplateStore::List>>(dispatcher, replies, impl->template_store().list(app, user));
 }
 
 biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::Dispatching::TemplateStore::enroll(const biometry::Application& app, const biometry::User& user)
 {
-    return std::make_shared<DispatchingOperation<biometry::TemplateStore::Enrollment>>(dispatcher, impl->template_store().enroll(app, user));
+    return std::make_shared<DispatchingOperation<biometry::TemplateStore::Enrollment>>(dispatcher, replies, impl->template_store().enroll(app, user));
 }
 
 biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::Dispatching::TemplateStore::remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id)
 {
-    return std::make_shared<DispatchingOperation<biometry::TemplateStore::Removal>>(dispatcher, impl->template_store().remove(app, user, id));
+    return std::make_shared<DispatchingOperation<biometry::TemplateStore::Removal>>(dispatcher, replies, impl->template_store().remove(app, user, id));
 }
 
 biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::Dispatching::TemplateStore::clear(const biometry::Application& app, const biometry::User& user)
 {
-    return std::make_shared<DispatchingOperation<biometry::TemplateStore::Clearance>>(dispatcher, impl->template_store().clear(app, user));
+    return std::make_shared<DispatchingOperation<biometry::TemplateStore::Clearance>>(dispatcher, replies, impl->template_store().clear(app, user));
 }
 
-biometry::devices::Dispatching::Identifier::Identifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& impl)
+biometry::devices::Dispatching::Identifier::Identifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::util::Dispatcher>& replies, const std::shared_ptr<biometry::Device>& impl)
     : dispatcher{dispatcher},
+      replies{replies},
       impl{impl}
 {
 }
 
 biometry::Operation<biometry::Identification>::Ptr biometry::devices::Dispatching::Identifier::identify_user(const biometry::Application& app, const biometry::Reason& reason)
 {
-    return std::make_shared<DispatchingOperation<biometry::Identification>>(dispatcher, impl->identifier().identify_user(app, reason));
+    return std::make_shared<DispatchingOperation<biometry::Identification>>(dispatcher, replies, impl->identifier().identify_user(app, reason));
 }
 
-biometry::devices::Dispatching::Verifier::Verifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& impl)
+biometry::devices::Dispatching::Verifier::Verifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::util::Dispatcher>& replies, const std::shared_ptr<biometry::Device>& impl)
     : dispatcher{dispatcher},
+      replies{replies},
       impl{impl}
 {
 }
 
 biometry::Operation<biometry::Verification>::Ptr biometry::devices::Dispatching::Verifier::verify_user(const biometry::Application& app, const biometry::User& user, const biometry::Reason& reason)
 {
-    return std::make_shared<DispatchingOperation<biometry::Verification>>(dispatcher, impl->verifier().verify_user(app, user, reason));
+    return std::make_shared<DispatchingOperation<biometry::Verification>>(dispatcher, replies, impl->verifier().verify_user(app, user, reason));
 }
 
-biometry::devices::Dispatching::Dispatching(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& device)
-    : template_store_{dispatcher, device},
-      identifier_{dispatcher, device},
-      verifier_{dispatcher, device}
+biometry::devices::Dispatching::Dispatching(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& device,
+                                             const std::shared_ptr<biometry::util::Dispatcher>& replies)
+    : template_store_{dispatcher, replies, device},
+      identifier_{dispatcher, replies, device},
+      verifier_{dispatcher, replies, device}
 {
 }
 
@@ -46,7 +46,7 @@ public:
     class TemplateStore : public biometry::TemplateStore
     {
     public:
-        TemplateStore(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& impl);
+        TemplateStore(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::util::Dispatcher>& replies, const std::shared_ptr<biometry::Device>& impl);
 
         // From biometry::TemplateStore.
         biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override;
@@ -57,38 +57,46 @@ public:
 
     private:
         std::shared_ptr<biometry::util::Dispatcher> dispatcher;
+        std::shared_ptr<biometry::util::Dispatcher> replies;
         std::shared_ptr<biometry::Device> impl;
     };
 
     class Identifier : public biometry::Identifier
     {
     public:
-        Identifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& impl);
+        Identifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::util::Dispatcher>& replies, const std::shared_ptr<biometry::Device>& impl);
 
         // From biometry::Identifier.
         biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override;
 
     private:
         std::shared_ptr<biometry::util::Dispatcher> dispatcher;
+        std::shared_ptr<biometry::util::Dispatcher> replies;
         std::shared_ptr<biometry::Device> impl;
     };
 
     class Verifier : public biometry::Verifier
     {
     public:
-        Verifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& impl);
+        Verifier(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::util::Dispatcher>& replies, const std::shared_ptr<biometry::Device>& impl);
 
         // From biometry::Identifier.
         Operation<Verification>::Ptr verify_user(const Application& app, const User& user, const Reason& reason) override;
 
     private:
         std::shared_ptr<biometry::util::Dispatcher> dispatcher;
+        std::shared_ptr<biometry::util::Dispatcher> replies;
         std::shared_ptr<biometry::Device> impl;
     };
 
     /// @brief Forwarding creates a new instance, forwarding calls to device.
+    ///
+    /// If replies is set, observers are notified via replies instead of on the
+    /// thread reporting progress, e.g., keeping replies to remote observers on a
+    /// low-latency lane while dispatcher executes blocking device calls.
     /// @throws std::runtime_error if device is null.
-    Dispatching(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& device);
+    Dispatching(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& device,
+                const std::shared_ptr<biometry::util::Dispatcher>& replies = std::shared_ptr<biometry::util::Dispatcher>{});
 
     // From biometry::Device
     biometry::TemplateStore& template_store() override;
@@ -98,12 +98,15 @@ struct DummyDescriptor : public biometry::Device::Descriptor
 
     std::string description() const override
     {
-        return "Dummy is a biometry::Device implementation for tesing purposes.";
+        return biometry::devices::Dummy::description;
     }
 };
 }
 
 biometry::Device::Descriptor::Ptr biometry::devices::Dummy::make_descriptor()
 {
-    return std::make_shared<DummyDescriptor>();
+    // Built-in descriptors live for the lifetime of the process, we hand out
+    // non-owning pointers and avoid allocating on every lookup.
+    static DummyDescriptor descriptor;
+    return Descriptor::Ptr{Descriptor::Ptr{}, &descriptor};
 }
@@ -35,6 +35,7 @@ class BIOMETRY_DLL_PUBLIC Dummy : public biometry::Device
 {
 public:
     static constexpr const char* id{"Dummy"};
+    static constexpr const char* description{"Dummy is a biometry::Device implementation for tesing purposes."};
 
     template<typename T>
     struct Operation : public biometry::Operation<T>
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/devices/instrumented.h>
+
+#include <biometry/application.h>
+#include <biometry/operation.h>
+
+#include <biometry/util/metrics.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+// The requester of operations created by the current thread, see Instrumented::Requester.
+thread_local const biometry::Application* requester{nullptr};
+
+// OperationMetrics bundles the metrics recorded for one type of operation requested by one app.
+struct OperationMetrics
+{
+    OperationMetrics(const std::string& type, const std::string& app)
+        : started(biometry::util::metrics().counter("operations_started_total", {{"type", type}, {"app", app}})),
+          succeeded(biometry::util::metrics().counter("operations_succeeded_total", {{"type", type}, {"app", app}})),
+          failed(biometry::util::metrics().counter("operations_failed_total", {{"type", type}, {"app", app}})),
+          canceled(biometry::util::metrics().counter("operations_canceled_total", {{"type", type}, {"app", app}})),
+          duration(biometry::util::metrics().histogram("operation_duration_us", {{"type", type}}))
+    {
+    }
+
+    biometry::util::Metrics::Counter& started;
+    biometry::util::Metrics::Counter& succeeded;
+    biometry::util::Metrics::Counter& failed;
+    biometry::util::Metrics::Counter& canceled;
+    biometry::util::Metrics::Histogram& duration;
+};
+
+// Apps hands out the index of the slot holding the metrics of an app in all OperationMetricsTables.
+//
+// The first Instrumented::max_apps apps get a slot of their own, all apps beyond share the slot of "other",
+// bounding the size of the registry. Apps seen before are found without taking any lock.
+class Apps
+{
+public:
+    // other is the index of the slot shared by all apps beyond Instrumented::max_apps.
+    static constexpr const std::size_t other = biometry::devices::Instrumented::max_apps;
+
+    // instance returns the process-wide Apps.
+    static Apps& instance()
+    {
+        static Apps apps;
+        return apps;
+    }
+
+    // index_of returns the index of the slot of label, handing out a new one if any is left.
+    std::size_t index_of(const std::string& label)
+    {
+        auto n = size.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < n; i++)
+            if (labels[i] == label)
+                return i;
+
+        if (n == other)
+            return other;
+
+        std::lock_guard<std::mutex> lg{guard};
+
+        // Another thread might have handed out slots in the meantime.
+        n = size.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < n; i++)
+            if (labels[i] == label)
+                return i;
+
+        if (n == other)
+            return other;
+
+        labels[n] = label;
+        size.store(n + 1, std::memory_order_release);
+
+        return n;
+    }
+
+    // label returns the label of the app owning the slot index.
+    const std::string& label(std::size_t index) const
+    {
+        static const std::string other_label{"other"};
+        return index == other ? other_label : labels[index];
+    }
+
+private:
+    Apps() = default;
+
+    std::mutex guard;
+    std::array<std::string, other> labels;
+    std::atomic<std::size_t> size{0};
+};
+
+constexpr const std::size_t Apps::other;
+
+// OperationMetricsTable caches the metrics of one type of operation per app.
+//
+// Metrics of an app are looked up in the registry on the first operation the app requests,
+// all later operations find them without taking any lock.
+class OperationMetricsTable
+{
+public:
+    explicit OperationMetricsTable(const std::string& type) : type{type}
+    {
+        for (auto& slot : slots)
+            slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // metrics_for returns the metrics recorded for operations requested by app.
+    const OperationMetrics& metrics_for(const biometry::Application& app)
+    {
+        auto index = Apps::instance().index_of(app.as_string());
+
+        if (auto metrics = slots[index].load(std::memory_order_acquire))
+            return *metrics;
+
+        std::lock_guard<std::mutex> lg{guard};
+        if (not owned[index])
+        {
+            owned[index].reset(new OperationMetrics{type, Apps::instance().label(index)});
+            slots[index].store(owned[index].get(), std::memory_order_release);
+        }
+
+        return *owned[index];
+    }
+
+private:
+    std::string type;
+    std::mutex guard;
+    std::array<std::unique_ptr<OperationMetrics>, Apps::other + 1> owned;
+    std::array<std::atomic<const OperationMetrics*>, Apps::other + 1> slots;
+};
+
+// InstrumentedObserver records the outcome of the operation it observes.
+template<typename T>
+class InstrumentedObserver : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    InstrumentedObserver(const OperationMetrics& metrics, const typename Super::Ptr& impl)
+        : metrics(metrics),
+          impl{impl}
+    {
+        this->metrics.started.increment();
+    }
+
+    void on_started() override
+    {
+        impl->on_started();
+    }
+
+    void on_progress(const Progress& progress) override
+    {
+        impl->on_progress(progress);
+    }
+
+    void on_canceled(const Reason& reason) override
+    {
+        finish(metrics.canceled);
+        impl->on_canceled(reason);
+    }
+
+    void on_failed(const Error& error) override
+    {
+        finish(metrics.failed);
+        impl->on_failed(error);
+    }
+
+    void on_succeeded(const Result& result) override
+    {
+        finish(metrics.succeeded);
+        impl->on_succeeded(result);
+    }
+
+private:
+    void finish(biometry::util::Metrics::Counter& outcome)
+    {
+        // Only the first final state counts.
+        if (finished.exchange(true))
+            return;
+
+        outcome.increment();
+        metrics.duration.observe(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - then));
+    }
+
+    OperationMetrics metrics;
+    std::chrono::steady_clock::time_point then{std::chrono::steady_clock::now()};
+    std::atomic<bool> finished{false};
+    typename Super::Ptr impl;
+};
+
+template<typename T>
+class InstrumentedOperation : public biometry::Operation<T>
+{
+public:
+    InstrumentedOperation(const OperationMetrics& metrics, const typename biometry::Operation<T>::Ptr& impl)
+        : metrics(metrics),
+          impl{impl}
+    {
+    }
+
+    void start_with_observer(const typename biometry::Operation<T>::Observer::Ptr& observer) override
+    {
+        impl->start_with_observer(std::make_shared<InstrumentedObserver<T>>(metrics, observer));
+    }
+
+    void cancel() override
+    {
+        impl->cancel();
+    }
+
+private:
+    OperationMetrics metrics;
+    typename biometry::Operation<T>::Ptr impl;
+};
+
+template<typename T>
+typename biometry::Operation<T>::Ptr instrument(OperationMetricsTable& table, const biometry::Application& app, const typename biometry::Operation<T>::Ptr& impl)
+{
+    return std::make_shared<InstrumentedOperation<T>>(table.metrics_for(requester ? *requester : app), impl);
+}
+}
+
+constexpr const std::size_t biometry::devices::Instrumented::max_apps;
+
+biometry::devices::Instrumented::Requester::Requester(const biometry::Application& app) : previous{requester}
+{
+    requester = &app;
+}
+
+biometry::devices::Instrumented::Requester::~Requester()
+{
+    requester = previous;
+}
+
+biometry::devices::Instrumented::TemplateStore::TemplateStore(const std::shared_ptr<biometry::Device>& impl)
+    : impl{impl}
+{
+}
+
+biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::Instrumented::TemplateStore::size(const biometry::Application& app, const biometry::User& user)
+{
+    static OperationMetricsTable table{"size_query"};
+    return instrument<SizeQuery>(table, app, impl->template_store().size(app, user));
+}
+
+biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::Instrumented::TemplateStore::list(const biometry::Application& app, const biometry::User& user)
+{
+    static OperationMetricsTable table{"list"};
+    return instrument<List>(table, app, impl->template_store().list(app, user));
+}
+
+biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::Instrumented::TemplateStore::enroll(const biometry::Application& app, const biometry::User& user)
+{
+    static OperationMetricsTable table{"enrollment"};
+    return instrument<Enrollment>(table, app, impl->template_store().enroll(app, user));
+}
+
+biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::Instrumented::TemplateStore::remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id)
+{
+    static OperationMetricsTable table{"removal"};
+    return instrument<Removal>(table, app, impl->template_store().remove(app, user, id));
+}
+
+biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::Instrumented::TemplateStore::clear(const biometry::Application& app, const biometry::User& user)
+{
+    static OperationMetricsTable table{"clearance"};
+    return instrument<Clearance>(table, app, impl->template_store().clear(app, user));
+}
+
+biometry::devices::Instrumented::Identifier::Identifier(const std::shared_ptr<biometry::Device>& impl)
+    : impl{impl}
+{
+}
+
+biometry::Operation<biometry::Identification>::Ptr biometry::devices::Instrumented::Identifier::identify_user(const biometry::Application& app, const biometry::Reason& reason)
+{
+    static OperationMetricsTable table{"identification"};
+    return instrument<biometry::Identification>(table, app, impl->identifier().identify_user(app, reason));
+}
+
+biometry::devices::Instrumented::Verifier::Verifier(const std::shared_ptr<biometry::Device>& impl)
+    : impl{impl}
+{
+}
+
+biometry::Operation<biometry::Verification>::Ptr biometry::devices::Instrumented::Verifier::verify_user(const biometry::Application& app, const biometry::User& user, const biometry::Reason& reason)
+{
+    static OperationMetricsTable table{"verification"};
+    return instrument<biometry::Verification>(table, app, impl->verifier().verify_user(app, user, reason));
+}
+
+biometry::devices::Instrumented::Instrumented(const std::shared_ptr<Device>& device)
+    : template_store_{device},
+      identifier_{device},
+      verifier_{device}
+{
+}
+
+biometry::TemplateStore& biometry::devices::Instrumented::template_store()
+{
+    return template_store_;
+}
+
+biometry::Identifier& biometry::devices::Instrumented::identifier()
+{
+    return identifier_;
+}
+
+biometry::Verifier& biometry::devices::Instrumented::verifier()
+{
+    return verifier_;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRYD_DEVICES_INSTRUMENTED_H_
+#define BIOMETRYD_DEVICES_INSTRUMENTED_H_
+
+#include <biometry/device.h>
+
+#include <biometry/identifier.h>
+#include <biometry/template_store.h>
+#include <biometry/verifier.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace biometry
+{
+namespace devices
+{
+/// @brief Instrumented is a biometry::Device that records metrics about the operations
+/// of a second biometry::Device implementation to the process-wide util::Metrics registry.
+///
+/// Per type of operation and per application, we count operations started, succeeded,
+/// failed and canceled, and we track the time from start to completion. Applications are
+/// identified by the Requester in scope, falling back to the app named in the request. At
+/// most max_apps applications are tracked individually, all others are counted as "other".
+class BIOMETRY_DLL_PUBLIC Instrumented : public biometry::Device
+{
+public:
+    // Safe us some typing.
+    typedef std::shared_ptr<Instrumented> Ptr;
+
+    /// @brief max_apps is the number of applications tracked individually.
+    static constexpr const std::size_t max_apps{32};
+
+    /// @brief Requester makes app the requester of all operations created by the calling thread for its lifetime.
+    ///
+    /// The app named in a request is under the control of the caller. Skeletons resolve the
+    /// credentials of the caller and hand them to us by means of a Requester.
+    class BIOMETRY_DLL_PUBLIC Requester
+    {
+    public:
+        /// @brief Requester makes app the requester of the calling thread.
+        explicit Requester(const biometry::Application& app);
+        Requester(const Requester&) = delete;
+        /// @brief ~Requester restores the previous requester.
+        ~Requester();
+        Requester& operator=(const Requester&) = delete;
+
+    private:
+        const biometry::Application* previous;
+    };
+
+    class TemplateStore : public biometry::TemplateStore
+    {
+    public:
+        explicit TemplateStore(const std::shared_ptr<biometry::Device>& impl);
+
+        // From biometry::TemplateStore.
+        biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::List>::Ptr list(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr enroll(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Removal>::Ptr remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id) override;
+        biometry::Operation<biometry::TemplateStore::Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override;
+
+    private:
+        std::shared_ptr<biometry::Device> impl;
+    };
+
+    class Identifier : public biometry::Identifier
+    {
+    public:
+        explicit Identifier(const std::shared_ptr<biometry::Device>& impl);
+
+        // From biometry::Identifier.
+        biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override;
+
+    private:
+        std::shared_ptr<biometry::Device> impl;
+    };
+
+    class Verifier : public biometry::Verifier
+    {
+    public:
+        explicit Verifier(const std::shared_ptr<biometry::Device>& impl);
+
+        // From biometry::Verifier.
+        Operation<Verification>::Ptr verify_user(const Application& app, const User& user, const Reason& reason) override;
+
+    private:
+        std::shared_ptr<biometry::Device> impl;
+    };
+
+    /// @brief Instrumented creates a new instance, recording metrics about operations on device.
+    explicit Instrumented(const std::shared_ptr<Device>& device);
+
+    // From biometry::Device
+    biometry::TemplateStore& template_store() override;
+    biometry::Identifier& identifier() override;
+    biometry::Verifier& verifier() override;
+
+private:
+    TemplateStore template_store_;
+    Identifier identifier_;
+    Verifier verifier_;
+};
+}
+}
+
+#endif // BIOMETRYD_DEVICES_INSTRUMENTED_H_
@@ -53,7 +53,7 @@ struct PluginDescriptor : public biometry::Device::Descriptor
 
     std::string description() const override
     {
-        return "Plugin loads device implementations from shared modules.";
+        return plugin::description;
     }
 };
 }
@@ -61,5 +61,6 @@ struct PluginDescriptor : public biometry::Device::Descriptor
 /// @brief make_descriptor returns a descriptor instance describing a plugin device;
 biometry::Device::Descriptor::Ptr plugin::make_descriptor()
 {
-    return std::make_shared<PluginDescriptor>();
+    static PluginDescriptor descriptor;
+    return biometry::Device::Descriptor::Ptr{biometry::Device::Descriptor::Ptr{}, &descriptor};
 }
@@ -37,6 +37,9 @@ BIOMETRY_DLL_PUBLIC biometry::Device::Descriptor::Ptr make_descriptor();
 /// @brief id is the unique name for registering the device type with the device registry.
 static constexpr const char* id{"Plugin"};
 
+/// @brief description is a one-line summary of the device type.
+static constexpr const char* description{"Plugin loads device implementations from shared modules."};
+
 /// @cond
 using Device = biometry::devices::Forwarding;
 /// @endcond
@@ -0,0 +1,827 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/devices/simulated.h>
+
+#include <biometry/application.h>
+#include <biometry/device_registry.h>
+#include <biometry/operation.h>
+#include <biometry/reason.h>
+#include <biometry/user.h>
+#include <biometry/devices/fingerprint_reader.h>
+
+#include <biometry/util/unique_function.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Scheduler runs tasks once their deadline has passed on a dedicated thread,
+// standing in for the interrupt context of a sensor.
+class Scheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef biometry::util::UniqueFunction<void()> Task;
+
+    Scheduler() : queue{std::make_shared<Queue>()}
+    {
+        auto q = queue;
+        worker = std::thread{[q]() { q->run(); }};
+    }
+
+    ~Scheduler()
+    {
+        queue->stop();
+
+        // The last reference to the device might be released by one of our own tasks.
+        // The worker only touches the queue, which it keeps alive by itself.
+        if (worker.get_id() == std::this_thread::get_id())
+            worker.detach();
+        else
+            worker.join();
+    }
+
+    // schedule runs task after delay has passed.
+    void schedule(const std::chrono::milliseconds& delay, Task&& task)
+    {
+        queue->push(Clock::now() + delay, std::move(task));
+    }
+
+private:
+    struct Queue
+    {
+        void push(Clock::time_point deadline, Task&& task)
+        {
+            {
+                std::lock_guard<std::mutex> lg{guard};
+                tasks.emplace(deadline, std::move(task));
+            }
+            wakeup.notify_one();
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lg{guard};
+                stopping = true;
+            }
+            wakeup.notify_one();
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> ul{guard};
+
+            while (not stopping)
+            {
+                if (tasks.empty())
+                {
+                    wakeup.wait(ul);
+                    continue;
+                }
+
+                auto next = tasks.begin();
+                if (next->first > Clock::now())
+                {
+                    wakeup.wait_until(ul, next->first);
+                    continue;
+                }
+
+                auto task = std::move(next->second);
+                tasks.erase(next);
+
+                ul.unlock();
+                task();
+                // Releasing the task might release the last reference to the device.
+                task = Task{};
+                ul.lock();
+            }
+
+            // Pending tasks might hold references to operations, we release them without the lock held.
+            auto pending = std::move(tasks);
+            ul.unlock();
+        }
+
+        std::mutex guard;
+        std::condition_variable wakeup;
+        std::multimap<Clock::time_point, Task> tasks;
+        bool stopping{false};
+    };
+
+    std::shared_ptr<Queue> queue;
+    std::thread worker;
+};
+
+// number returns the numeric value of node, or fallback if node is empty.
+double number(const biometry::util::Configuration::Node& node, double fallback)
+{
+    if (not node)
+        return fallback;
+
+    switch (node.value().type())
+    {
+    case biometry::Variant::Type::integer:
+        return static_cast<double>(node.value().integer());
+    case biometry::Variant::Type::floating_point:
+        return node.value().floating_point();
+    default:
+        throw std::runtime_error{"Expected a number for " + node.key().to_string()};
+    }
+}
+
+// rate returns the probability stored in node, or fallback if node is empty.
+double rate(const biometry::util::Configuration::Node& node, double fallback)
+{
+    auto result = number(node, fallback);
+    if (result < 0 || result > 1)
+        throw std::runtime_error{"Expected a value in [0, 1] for " + node.key().to_string()};
+    return result;
+}
+}
+
+struct biometry::devices::Simulated::State
+{
+    explicit State(const Model& model) : model{model}, rng{model.seed}
+    {
+    }
+
+    /// @brief sample draws a value from latency.
+    std::chrono::milliseconds sample(const Latency& latency)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return latency.sample(rng);
+    }
+
+    /// @brief roll returns true with the given probability.
+    bool roll(double probability)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return std::bernoulli_distribution{probability}(rng);
+    }
+
+    /// @brief locked_out returns true if the sensor does not accept requests right now.
+    bool locked_out()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return Clock::now() < locked_until;
+    }
+
+    /// @brief match returns true if a finger enrolled for a user in candidates is recognized,
+    /// tracking consecutive rejections for locking out the sensor.
+    bool match(bool candidates)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (candidates && not std::bernoulli_distribution{model.rejection_rate}(rng))
+        {
+            rejections = 0;
+            return true;
+        }
+
+        if (model.lockout.attempts > 0 && ++rejections >= model.lockout.attempts)
+        {
+            rejections = 0;
+            locked_until = Clock::now() + model.lockout.duration;
+        }
+
+        return false;
+    }
+
+    /// @brief count returns the number of templates enrolled for user.
+    std::uint32_t count(const biometry::User& user)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        auto it = templates.find(user.id);
+        return it == templates.end() ? 0 : it->second.size();
+    }
+
+    /// @brief list returns the ids of all templates enrolled for user.
+    std::vector<biometry::TemplateStore::TemplateId> list(const biometry::User& user)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        auto it = templates.find(user.id);
+        return it == templates.end() ? std::vector<biometry::TemplateStore::TemplateId>{} : it->second;
+    }
+
+    /// @brief add stores a new template for user, returning false if the user's templates are exhausted.
+    bool add(const biometry::User& user, biometry::TemplateStore::TemplateId& id)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        auto& ids = templates[user.id];
+
+        if (ids.size() >= model.capacity)
+            return false;
+
+        id = next_id++;
+        ids.push_back(id);
+        return true;
+    }
+
+    /// @brief remove drops the template id of user, returning false if it does not exist.
+    bool remove(const biometry::User& user, biometry::TemplateStore::TemplateId id)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        auto& ids = templates[user.id];
+        auto it = std::find(ids.begin(), ids.end(), id);
+
+        if (it == ids.end())
+            return false;
+
+        ids.erase(it);
+        return true;
+    }
+
+    /// @brief clear drops all templates of user.
+    void clear(const biometry::User& user)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        templates.erase(user.id);
+    }
+
+    /// @brief any_user returns the user with the smallest id that enrolled at least one template.
+    bool any_user(biometry::User& user)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        for (const auto& pair : templates)
+        {
+            if (not pair.second.empty())
+            {
+                user = biometry::User{pair.first};
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+
+    const Model model;
+
+    std::mutex guard;
+    std::mt19937 rng;
+    std::map<uid_t, std::vector<biometry::TemplateStore::TemplateId>> templates;
+    biometry::TemplateStore::TemplateId next_id{1};
+    std::uint32_t rejections{0};
+    Clock::time_point locked_until{};
+
+    Scheduler scheduler;
+};
+
+namespace
+{
+// Safe us some typing.
+typedef biometry::devices::Simulated::State State;
+
+constexpr const char* hardware_error{"Simulated hardware error"};
+constexpr const char* locked_out{"Sensor is locked out"};
+
+// SimulatedOperation implements cancelation and completion of operations, leaving the
+// actual sequence of steps to subclasses.
+template<typename T>
+class SimulatedOperation : public biometry::Operation<T>, public std::enable_shared_from_this<SimulatedOperation<T>>
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Observer;
+
+    explicit SimulatedOperation(const std::shared_ptr<State>& state) : state{state}
+    {
+    }
+
+    void start_with_observer(const typename Observer::Ptr& observer) override
+    {
+        {
+            std::lock_guard<std::mutex> lg{guard};
+
+            if (started)
+                throw std::logic_error{"Operation has already been started"};
+
+            started = true;
+            if (not finished)
+                this->observer = observer;
+        }
+
+        if (not this->observer)
+        {
+            observer->on_canceled("Canceled before being started");
+            return;
+        }
+
+        observer->on_started();
+        run();
+    }
+
+    void cancel() override
+    {
+        if (auto o = finish())
+            o->on_canceled("Canceled");
+    }
+
+protected:
+    // run kicks off the simulated sequence of steps.
+    virtual void run() = 0;
+
+    // after runs step on the sensor once a delay drawn from latency has passed, unless
+    // the operation finished in between.
+    void after(const biometry::devices::Simulated::Latency& latency, std::function<void()> step)
+    {
+        auto thiz = this->shared_from_this();
+        state->scheduler.schedule(state->sample(latency), [thiz, step]()
+        {
+            if (thiz->pending())
+                step();
+        });
+    }
+
+    void progress(const typename T::Progress& progress)
+    {
+        if (auto o = current())
+            o->on_progress(progress);
+    }
+
+    void fail(const typename T::Error& error)
+    {
+        if (auto o = finish())
+            o->on_failed(error);
+    }
+
+    void succeed(const typename T::Result& result)
+    {
+        if (auto o = finish())
+            o->on_succeeded(result);
+    }
+
+    std::shared_ptr<State> state;
+
+private:
+    bool pending()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return not finished;
+    }
+
+    typename Observer::Ptr current()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return observer;
+    }
+
+    typename Observer::Ptr finish()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        finished = true;
+        return std::move(observer);
+    }
+
+    std::mutex guard;
+    bool started{false};
+    bool finished{false};
+    typename Observer::Ptr observer;
+};
+
+// touched returns progress reporting a finger on the sensor.
+biometry::Progress touched(double percent)
+{
+    biometry::devices::FingerprintReader::GuidedEnrollment::Hints hints;
+    hints.is_finger_present = true;
+    return biometry::Progress{biometry::Percent::from_raw_value(percent), hints.to_dictionary()};
+}
+
+class SizeOperation : public SimulatedOperation<biometry::TemplateStore::SizeQuery>
+{
+public:
+    SizeOperation(const std::shared_ptr<State>& state, const biometry::User& user)
+        : SimulatedOperation{state}, user{user}
+    {
+    }
+
+    void run() override
+    {
+        after(state->model.latency.size, [this]()
+        {
+            if (state->roll(state->model.failure_rate))
+                return fail(hardware_error);
+
+            succeed(state->count(user));
+        });
+    }
+
+private:
+    biometry::User user;
+};
+
+class ListOperation : public SimulatedOperation<biometry::TemplateStore::List>
+{
+public:
+    ListOperation(const std::shared_ptr<State>& state, const biometry::User& user)
+        : SimulatedOperation{state}, user{user}
+    {
+    }
+
+    void run() override
+    {
+        after(state->model.latency.list, [this]()
+        {
+            if (state->roll(state->model.failure_rate))
+                return fail(hardware_error);
+
+            succeed(state->list(user));
+        });
+    }
+
+private:
+    biometry::User user;
+};
+
+class EnrollmentOperation : public SimulatedOperation<biometry::TemplateStore::Enrollment>
+{
+public:
+    EnrollmentOperation(const std::shared_ptr<State>& state, const biometry::User& user)
+        : SimulatedOperation{state}, user{user}
+    {
+    }
+
+    void run() override
+    {
+        if (state->count(user) >= state->model.capacity)
+            return fail("Template capacity exceeded");
+
+        step(0);
+    }
+
+private:
+    // step waits for the finger to be placed on the sensor and processes the resulting image.
+    void step(std::uint32_t i)
+    {
+        auto steps = std::max<std::uint32_t>(state->model.enrollment_steps, 1);
+
+        after(state->model.latency.touch, [this, i, steps]()
+        {
+            progress(touched(static_cast<double>(i) / steps));
+
+            after(state->model.latency.enroll, [this, i, steps]()
+            {
+                if (state->roll(state->model.failure_rate))
+                    return fail(hardware_error);
+
+                if (i + 1 < steps)
+                {
+                    progress(biometry::Progress{biometry::Percent::from_raw_value(static_cast<double>(i + 1) / steps), biometry::Dictionary{}});
+                    return step(i + 1);
+                }
+
+                biometry::TemplateStore::TemplateId id;
+                if (not state->add(user, id))
+                    return fail("Template capacity exceeded");
+
+                progress(biometry::Progress{biometry::Percent::from_raw_value(1), biometry::Dictionary{}});
+                succeed(id);
+            });
+        });
+    }
+
+    biometry::User user;
+};
+
+class RemovalOperation : public SimulatedOperation<biometry::TemplateStore::Removal>
+{
+public:
+    RemovalOperation(const std::shared_ptr<State>& state, const biometry::User& user, biometry::TemplateStore::TemplateId id)
+        : SimulatedOperation{state}, user{user}, id{id}
+    {
+    }
+
+    void run() override
+    {
+        after(state->model.latency.remove, [this]()
+        {
+            if (state->roll(state->model.failure_rate))
+                return fail(hardware_error);
+
+            if (not state->remove(user, id))
+                return fail("Unknown template");
+
+            succeed(id);
+        });
+    }
+
+private:
+    biometry::User user;
+    biometry::TemplateStore::TemplateId id;
+};
+
+class ClearanceOperation : public SimulatedOperation<biometry::TemplateStore::Clearance>
+{
+public:
+    ClearanceOperation(const std::shared_ptr<State>& state, const biometry::User& user)
+        : SimulatedOperation{state}, user{user}
+    {
+    }
+
+    void run() override
+    {
+        after(state->model.latency.clear, [this]()
+        {
+            if (state->roll(state->model.failure_rate))
+                return fail(hardware_error);
+
+            state->clear(user);
+            succeed(biometry::Void{});
+        });
+    }
+
+private:
+    biometry::User user;
+};
+
+class IdentificationOperation : public SimulatedOperation<biometry::Identification>
+{
+public:
+    explicit IdentificationOperation(const std::shared_ptr<State>& state)
+        : SimulatedOperation{state}
+    {
+    }
+
+    void run() override
+    {
+        if (state->locked_out())
+            return fail(locked_out);
+
+        after(state->model.latency.touch, [this]()
+        {
+            progress(touched(0));
+
+            after(state->model.latency.identify, [this]()
+            {
+                if (state->roll(state->model.failure_rate))
+                    return fail(hardware_error);
+
+                if (state->locked_out())
+                    return fail(locked_out);
+
+                biometry::User user;
+                auto enrolled = state->any_user(user);
+
+                if (not state->match(enrolled))
+                    return fail("Could not identify user");
+
+                succeed(user);
+            });
+        });
+    }
+};
+
+class VerificationOperation : public SimulatedOperation<biometry::Verification>
+{
+public:
+    VerificationOperation(const std::shared_ptr<State>& state, const biometry::User& user)
+        : SimulatedOperation{state}, user{user}
+    {
+    }
+
+    void run() override
+    {
+        if (state->locked_out())
+            return fail(locked_out);
+
+        after(state->model.latency.touch, [this]()
+        {
+            progress(touched(0));
+
+            after(state->model.latency.verify, [this]()
+            {
+                if (state->roll(state->model.failure_rate))
+                    return fail(hardware_error);
+
+                if (state->locked_out())
+                    return fail(locked_out);
+
+                succeed(state->match(state->count(user) > 0) ?
+                            biometry::Verification::Result::verified :
+                            biometry::Verification::Result::not_verified);
+            });
+        });
+    }
+
+private:
+    biometry::User user;
+};
+}
+
+biometry::devices::Simulated::Latency biometry::devices::Simulated::Latency::fixed(double ms)
+{
+    return Latency{Distribution::fixed, ms, 0, 0, 60000};
+}
+
+biometry::devices::Simulated::Latency biometry::devices::Simulated::Latency::from_configuration(const util::Configuration::Node& config, const Latency& fallback)
+{
+    Latency result{fallback};
+
+    if (const auto& distribution = config["distribution"])
+    {
+        const auto& name = distribution.value().string();
+
+        if (name == "fixed")
+            result.distribution = Distribution::fixed;
+        else if (name == "uniform")
+            result.distribution = Distribution::uniform;
+        else if (name == "normal")
+            result.distribution = Distribution::normal;
+        else if (name == "exponential")
+            result.distribution = Distribution::exponential;
+        else
+            throw std::runtime_error{"Unknown latency distribution: " + name};
+    }
+
+    result.mean = number(config["mean"], result.mean);
+    result.stddev = number(config["stddev"], result.stddev);
+    result.min = number(config["min"], result.min);
+    result.max = number(config["max"], result.max);
+
+    if (result.min < 0 || result.max < result.min)
+        throw std::runtime_error{"Invalid latency bounds"};
+
+    return result;
+}
+
+std::chrono::milliseconds biometry::devices::Simulated::Latency::sample(std::mt19937& rng) const
+{
+    double ms{mean};
+
+    switch (distribution)
+    {
+    case Distribution::fixed:
+        return std::chrono::milliseconds{static_cast<std::int64_t>(mean)};
+    case Distribution::uniform:
+        ms = std::uniform_real_distribution<double>{min, max}(rng);
+        break;
+    case Distribution::normal:
+        ms = std::normal_distribution<double>{mean, stddev}(rng);
+        break;
+    case Distribution::exponential:
+        ms = mean > 0 ? std::exponential_distribution<double>{1. / mean}(rng) : 0.;
+        break;
+    }
+
+    return std::chrono::milliseconds{static_cast<std::int64_t>(std::min(std::max(ms, min), max))};
+}
+
+biometry::devices::Simulated::Model biometry::devices::Simulated::Model::from_configuration(const util::Configuration::Node& config)
+{
+    Model model;
+
+    model.seed = static_cast<std::uint32_t>(number(config["seed"], model.seed));
+
+    const auto& latency = config["latency"];
+    model.latency.touch = Latency::from_configuration(latency["touch"], model.latency.touch);
+    model.latency.enroll = Latency::from_configuration(latency["enroll"], model.latency.enroll);
+    model.latency.identify = Latency::from_configuration(latency["identify"], model.latency.identify);
+    model.latency.verify = Latency::from_configuration(latency["verify"], model.latency.verify);
+    model.latency.size = Latency::from_configuration(latency["size"], model.latency.size);
+    model.latency.list = Latency::from_configuration(latency["list"], model.latency.list);
+    model.latency.remove = Latency::from_configuration(latency["remove"], model.latency.remove);
+    model.latency.clear = Latency::from_configuration(latency["clear"], model.latency.clear);
+
+    model.enrollment_steps = static_cast<std::uint32_t>(number(config["enrollmentSteps"], model.enrollment_steps));
+    model.failure_rate = rate(config["failureRate"], model.failure_rate);
+    model.rejection_rate = rate(config["rejectionRate"], model.rejection_rate);
+
+    const auto& lockout = config["lockout"];
+    model.lockout.attempts = static_cast<std::uint32_t>(number(lockout["attempts"], model.lockout.attempts));
+    model.lockout.duration = std::chrono::milliseconds{static_cast<std::int64_t>(number(lockout["duration"], model.lockout.duration.count()))};
+
+    model.capacity = static_cast<std::uint32_t>(number(config["capacity"], model.capacity));
+
+    return model;
+}
+
+biometry::devices::Simulated::TemplateStore::TemplateStore(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::Simulated::TemplateStore::size(const biometry::Application&, const biometry::User& user)
+{
+    return std::make_shared<SizeOperation>(state, user);
+}
+
+biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::Simulated::TemplateStore::list(const biometry::Application&, const biometry::User& user)
+{
+    return std::make_shared<ListOperation>(state, user);
+}
+
+biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::Simulated::TemplateStore::enroll(const biometry::Application&, const biometry::User& user)
+{
+    return std::make_shared<EnrollmentOperation>(state, user);
+}
+
+biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::Simulated::TemplateStore::remove(const biometry::Application&, const biometry::User& user, biometry::TemplateStore::TemplateId id)
+{
+    return std::make_shared<RemovalOperation>(state, user, id);
+}
+
+biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::Simulated::TemplateStore::clear(const biometry::Application&, const biometry::User& user)
+{
+    return std::make_shared<ClearanceOperation>(state, user);
+}
+
+biometry::devices::Simulated::Identifier::Identifier(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::Identification>::Ptr biometry::devices::Simulated::Identifier::identify_user(const biometry::Application&, const biometry::Reason&)
+{
+    return std::make_shared<IdentificationOperation>(state);
+}
+
+biometry::devices::Simulated::Verifier::Verifier(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::Verification>::Ptr biometry::devices::Simulated::Verifier::verify_user(const biometry::Application&, const biometry::User& user, const biometry::Reason&)
+{
+    return std::make_shared<VerificationOperation>(state, user);
+}
+
+biometry::devices::Simulated::Simulated() : Simulated{Model{}}
+{
+}
+
+biometry::devices::Simulated::Simulated(const Model& model)
+    : state{std::make_shared<State>(model)},
+      template_store_{state},
+      identifier_{state},
+      verifier_{state}
+{
+}
+
+biometry::TemplateStore& biometry::devices::Simulated::template_store()
+{
+    return template_store_;
+}
+
+biometry::Identifier& biometry::devices::Simulated::identifier()
+{
+    return identifier_;
+}
+
+biometry::Verifier& biometry::devices::Simulated::verifier()
+{
+    return verifier_;
+}
+
+namespace
+{
+struct SimulatedDescriptor : public biometry::Device::Descriptor
+{
+    std::shared_ptr<biometry::Device> create(const biometry::util::Configuration& config) override
+    {
+        return std::make_shared<biometry::devices::Simulated>(biometry::devices::Simulated::Model::from_configuration(config["config"]));
+    }
+
+    std::string name() const override
+    {
+        return "Simulated";
+    }
+
+    std::string author() const override
+    {
+        return "Thomas Voß (thomas.voss@canonical.com)";
+    }
+
+    std::string description() const override
+    {
+        return biometry::devices::Simulated::description;
+    }
+};
+}
+
+biometry::Device::Descriptor::Ptr biometry::devices::Simulated::make_descriptor()
+{
+    static SimulatedDescriptor descriptor;
+    return Descriptor::Ptr{Descriptor::Ptr{}, &descriptor};
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRYD_DEVICES_SIMULATED_H_
+#define BIOMETRYD_DEVICES_SIMULATED_H_
+
+#include <biometry/device.h>
+
+#include <biometry/identifier.h>
+#include <biometry/template_store.h>
+#include <biometry/verifier.h>
+
+#include <biometry/util/configuration.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+namespace biometry
+{
+namespace devices
+{
+/// @brief Simulated is a biometry::Device modelling a fingerprint sensor in software.
+///
+/// Operations complete asynchronously after latencies drawn from configurable
+/// distributions, report touch events and enrollment progress, and fail, reject
+/// or lock out according to configurable rates. Templates are kept in memory.
+/// Simulated enables load and latency testing of the complete stack on machines
+/// without fingerprint hardware.
+class BIOMETRY_DLL_PUBLIC Simulated : public biometry::Device
+{
+public:
+    static constexpr const char* id{"Simulated"};
+    static constexpr const char* description{"Simulated models a fingerprint sensor in software."};
+
+    /// @cond
+    struct State;
+    /// @endcond
+
+    /// @brief Latency models the distribution of the time a step of an operation takes.
+    struct BIOMETRY_DLL_PUBLIC Latency
+    {
+        /// @brief Distribution enumerates all supported distributions.
+        enum class Distribution
+        {
+            fixed,      ///< Always takes mean milliseconds.
+            uniform,    ///< Takes between min and max milliseconds.
+            normal,     ///< Normally distributed around mean with stddev, clamped to [min, max].
+            exponential ///< Exponentially distributed with the given mean, clamped to [min, max].
+        };
+
+        /// @brief fixed returns a Latency always taking ms milliseconds.
+        static Latency fixed(double ms);
+
+        /// @brief from_configuration decodes a latency from config, falling back to fallback for missing fields, e.g.:
+        ///   { "distribution": "normal", "mean": 50, "stddev": 10 }
+        /// @throws std::runtime_error if the distribution is unknown.
+        static Latency from_configuration(const util::Configuration::Node& config, const Latency& fallback);
+
+        /// @brief sample draws a single latency value from the distribution, using rng.
+        std::chrono::milliseconds sample(std::mt19937& rng) const;
+
+        Distribution distribution{Distribution::fixed};
+        double mean{0};    ///< Mean of the distribution in [ms].
+        double stddev{0};  ///< Standard deviation of a normal distribution in [ms].
+        double min{0};     ///< Lower bound in [ms].
+        double max{60000}; ///< Upper bound in [ms].
+    };
+
+    /// @brief Model bundles all parameters of the simulation.
+    ///
+    /// Model is decoded from the "config" section of a device configuration, with all
+    /// fields being optional:
+    ///   {
+    ///     "seed": 42,
+    ///     "latency": { "touch": {...}, "enroll": {...}, "identify": {...}, "verify": {...},
+    ///                  "size": {...}, "list": {...}, "remove": {...}, "clear": {...} },
+    ///     "enrollmentSteps": 5,
+    ///     "failureRate": 0.01,
+    ///     "rejectionRate": 0.02,
+    ///     "lockout": { "attempts": 5, "duration": 30000 },
+    ///     "capacity": 5
+    ///   }
+    struct BIOMETRY_DLL_PUBLIC Model
+    {
+        /// @brief Latencies bundles the latency of the individual steps of operations.
+        struct Latencies
+        {
+            Latency touch{Latency::Distribution::uniform, 0, 0, 200, 600}; ///< Until a finger is placed on the sensor.
+            Latency enroll{Latency::Distribution::normal, 80, 20, 20, 1000}; ///< Processing a single enrollment step.
+            Latency identify{Latency::Distribution::normal, 60, 15, 10, 1000}; ///< Matching against all templates.
+            Latency verify{Latency::Distribution::normal, 40, 10, 10, 1000}; ///< Matching against the templates of a user.
+            Latency size{Latency::fixed(2)}; ///< Counting templates.
+            Latency list{Latency::fixed(2)}; ///< Listing templates.
+            Latency remove{Latency::fixed(10)}; ///< Removing a single template.
+            Latency clear{Latency::fixed(20)}; ///< Removing all templates of a user.
+        };
+
+        /// @brief Lockout describes how the sensor reacts to repeated rejections.
+        struct Lockout
+        {
+            std::uint32_t attempts{5}; ///< Consecutive rejections before the sensor locks out, 0 disables lockout.
+            std::chrono::milliseconds duration{30000}; ///< Time until the sensor accepts requests again.
+        };
+
+        /// @brief from_configuration decodes a model from config.
+        /// @throws std::runtime_error if config contains invalid values.
+        static Model from_configuration(const util::Configuration::Node& config);
+
+        std::uint32_t seed{0}; ///< Seeds the random number generator, keeping runs reproducible.
+        Latencies latency;
+        std::uint32_t enrollment_steps{5}; ///< Number of touches required to enroll a template.
+        double failure_rate{0}; ///< Probability of an operation failing with a hardware error.
+        double rejection_rate{0}; ///< Probability of rejecting an enrolled finger.
+        Lockout lockout;
+        std::uint32_t capacity{5}; ///< Maximum number of templates per user.
+    };
+
+    class TemplateStore : public biometry::TemplateStore
+    {
+    public:
+        TemplateStore(const std::shared_ptr<State>& state);
+
+        // From biometry::TemplateStore.
+        biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::List>::Ptr list(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr enroll(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Removal>::Ptr remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id) override;
+        biometry::Operation<biometry::TemplateStore::Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    class Identifier : public biometry::Identifier
+    {
+    public:
+        Identifier(const std::shared_ptr<State>& state);
+
+        // From biometry::Identifier.
+        biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    class Verifier : public biometry::Verifier
+    {
+    public:
+        Verifier(const std::shared_ptr<State>& state);
+
+        // From biometry::Verifier.
+        Operation<Verification>::Ptr verify_user(const Application& app, const User& user, const Reason& reason) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    /// @brief make_descriptor returns a descriptor instance describing a Simulated device.
+    static Descriptor::Ptr make_descriptor();
+
+    /// @brief Simulated initializes a new instance simulating a sensor with default parameters.
+    Simulated();
+
+    /// @brief Simulated initializes a new instance simulating model.
+    explicit Simulated(const Model& model);
+
+    // From biometry::Device
+    biometry::TemplateStore& template_store() override;
+    biometry::Identifier& identifier() override;
+    biometry::Verifier& verifier() override;
+
+private:
+    std::shared_ptr<State> state;
+    TemplateStore template_store_;
+    Identifier identifier_;
+    Verifier verifier_;
+};
+}
+}
+
+#endif // BIOMETRYD_DEVICES_SIMULATED_H_
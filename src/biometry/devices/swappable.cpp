@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/devices/swappable.h>
+
+#include <biometry/application.h>
+#include <biometry/devices/deferred.h>
+#include <biometry/operation.h>
+#include <biometry/reason.h>
+#include <biometry/user.h>
+
+#include <mutex>
+#include <stdexcept>
+
+/// @brief Generation bundles an implementation with the operations created by it.
+///
+/// Operations hold on to their Generation until they reach a final state. The
+/// implementation is released together with the last reference to its Generation.
+struct biometry::devices::Swappable::Generation
+{
+    Generation(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& device)
+        : dispatcher{dispatcher},
+          device{device}
+    {
+    }
+
+    ~Generation()
+    {
+        // The last reference might be dropped from within a callback of the implementation
+        // itself. We hand over the implementation to the dispatcher instead of tearing it
+        // down on a thread it might own.
+        if (not retired)
+            return;
+
+        dispatcher->dispatch([device = std::move(device), on_drained = std::move(on_drained)]() mutable
+        {
+            device.reset();
+            if (on_drained)
+                on_drained();
+        });
+    }
+
+    std::shared_ptr<biometry::util::Dispatcher> dispatcher;
+    std::shared_ptr<biometry::Device> device;
+    bool retired{false};
+    std::function<void()> on_drained;
+};
+
+struct biometry::devices::Swappable::State : public std::enable_shared_from_this<biometry::devices::Swappable::State>
+{
+    /// @brief current returns the Generation new operations should be bound to.
+    std::shared_ptr<Generation> current()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return generation;
+    }
+
+    /// @brief swap retires the current Generation, staging next until the retired Generation has drained.
+    ///
+    /// In the meantime, new operations are bound to a Generation that queues them on a
+    /// Deferred device. Swapping again before the retired Generation has drained replaces
+    /// the staged implementation, releasing the superseded one right away.
+    void swap(const std::shared_ptr<biometry::Device>& next, const std::function<void()>& on_drained)
+    {
+        std::shared_ptr<Generation> previous;
+        std::shared_ptr<biometry::Device> superseded;
+        {
+            std::lock_guard<std::mutex> lg{guard};
+
+            if (deferred)
+            {
+                superseded = staged;
+                staged = next;
+            }
+            else
+            {
+                deferred = std::make_shared<biometry::devices::Deferred>();
+                staged = next;
+
+                previous = generation;
+                previous->retired = true;
+                previous->on_drained = [thiz = shared_from_this(), on_drained]()
+                {
+                    thiz->resolve();
+                    if (on_drained)
+                        on_drained();
+                };
+                generation = std::make_shared<Generation>(dispatcher, deferred);
+            }
+        }
+
+        // The superseded implementation has never been handed out to any operation.
+        if (superseded)
+        {
+            dispatcher->dispatch([superseded = std::move(superseded), on_drained]() mutable
+            {
+                superseded.reset();
+                if (on_drained)
+                    on_drained();
+            });
+        }
+
+        // previous goes out of scope here, without holding the lock, releasing
+        // the implementation right away if no operations are pending.
+    }
+
+    /// @brief resolve hands over the staged implementation to the operations queued in the meantime.
+    void resolve()
+    {
+        std::shared_ptr<biometry::devices::Deferred> d;
+        std::shared_ptr<biometry::Device> next;
+        {
+            std::lock_guard<std::mutex> lg{guard};
+            d.swap(deferred);
+            next.swap(staged);
+        }
+
+        d->resolve(next);
+    }
+
+    std::shared_ptr<biometry::util::Dispatcher> dispatcher;
+    std::mutex guard;
+    std::shared_ptr<Generation> generation;
+    // deferred and staged are set while a retired Generation is draining.
+    std::shared_ptr<biometry::devices::Deferred> deferred;
+    std::shared_ptr<biometry::Device> staged;
+};
+
+namespace
+{
+// Safe us some typing.
+typedef biometry::devices::Swappable::Generation Generation;
+
+// BoundObserver keeps a Generation alive until the operation it observes reaches a final state.
+template<typename T>
+class BoundObserver : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    BoundObserver(const std::shared_ptr<Generation>& generation, const typename Super::Ptr& impl)
+        : generation{generation},
+          impl{impl}
+    {
+    }
+
+    void on_started() override
+    {
+        impl->on_started();
+    }
+
+    void on_progress(const Progress& progress) override
+    {
+        impl->on_progress(progress);
+    }
+
+    void on_canceled(const Reason& reason) override
+    {
+        impl->on_canceled(reason);
+        finish();
+    }
+
+    void on_failed(const Error& error) override
+    {
+        impl->on_failed(error);
+        finish();
+    }
+
+    void on_succeeded(const Result& result) override
+    {
+        impl->on_succeeded(result);
+        finish();
+    }
+
+private:
+    void finish()
+    {
+        std::shared_ptr<Generation> g;
+        {
+            std::lock_guard<std::mutex> lg{guard};
+            g.swap(generation);
+        }
+    }
+
+    std::mutex guard;
+    std::shared_ptr<Generation> generation;
+    typename Super::Ptr impl;
+};
+
+// BoundOperation keeps a Generation alive until it is started, handing it over to its observer.
+template<typename T>
+class BoundOperation : public biometry::Operation<T>
+{
+public:
+    BoundOperation(const std::shared_ptr<Generation>& generation, const typename biometry::Operation<T>::Ptr& impl)
+        : generation{generation},
+          impl{impl}
+    {
+    }
+
+    void start_with_observer(const typename biometry::Operation<T>::Observer::Ptr& observer) override
+    {
+        std::shared_ptr<Generation> g;
+        {
+            std::lock_guard<std::mutex> lg{guard};
+            g.swap(generation);
+        }
+
+        impl->start_with_observer(std::make_shared<BoundObserver<T>>(g, observer));
+    }
+
+    void cancel() override
+    {
+        impl->cancel();
+    }
+
+private:
+    std::mutex guard;
+    std::shared_ptr<Generation> generation;
+    typename biometry::Operation<T>::Ptr impl;
+};
+
+// bind_operation creates an operation on the current implementation, binding it to its Generation.
+template<typename T, typename Factory>
+typename biometry::Operation<T>::Ptr bind_operation(biometry::devices::Swappable::State& state, const Factory& factory)
+{
+    auto generation = state.current();
+    return std::make_shared<BoundOperation<T>>(generation, factory(*generation->device));
+}
+}
+
+biometry::devices::Swappable::TemplateStore::TemplateStore(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr biometry::devices::Swappable::TemplateStore::size(const biometry::Application& app, const biometry::User& user)
+{
+    return bind_operation<SizeQuery>(*state, [&](biometry::Device& device) { return device.template_store().size(app, user); });
+}
+
+biometry::Operation<biometry::TemplateStore::List>::Ptr biometry::devices::Swappable::TemplateStore::list(const biometry::Application& app, const biometry::User& user)
+{
+    return bind_operation<List>(*state, [&](biometry::Device& device) { return device.template_store().list(app, user); });
+}
+
+biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr biometry::devices::Swappable::TemplateStore::enroll(const biometry::Application& app, const biometry::User& user)
+{
+    return bind_operation<Enrollment>(*state, [&](biometry::Device& device) { return device.template_store().enroll(app, user); });
+}
+
+biometry::Operation<biometry::TemplateStore::Removal>::Ptr biometry::devices::Swappable::TemplateStore::remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id)
+{
+    return bind_operation<Removal>(*state, [&](biometry::Device& device) { return device.template_store().remove(app, user, id); });
+}
+
+biometry::Operation<biometry::TemplateStore::Clearance>::Ptr biometry::devices::Swappable::TemplateStore::clear(const biometry::Application& app, const biometry::User& user)
+{
+    return bind_operation<Clearance>(*state, [&](biometry::Device& device) { return device.template_store().clear(app, user); });
+}
+
+biometry::devices::Swappable::Identifier::Identifier(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::Identification>::Ptr biometry::devices::Swappable::Identifier::identify_user(const biometry::Application& app, const biometry::Reason& reason)
+{
+    return bind_operation<biometry::Identification>(*state, [&](biometry::Device& device) { return device.identifier().identify_user(app, reason); });
+}
+
+biometry::devices::Swappable::Verifier::Verifier(const std::shared_ptr<State>& state)
+    : state{state}
+{
+}
+
+biometry::Operation<biometry::Verification>::Ptr biometry::devices::Swappable::Verifier::verify_user(const biometry::Application& app, const biometry::User& user, const biometry::Reason& reason)
+{
+    return bind_operation<biometry::Verification>(*state, [&](biometry::Device& device) { return device.verifier().verify_user(app, user, reason); });
+}
+
+biometry::devices::Swappable::Swappable(const std::shared_ptr<util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& device)
+    : state{std::make_shared<State>()},
+      template_store_{state},
+      identifier_{state},
+      verifier_{state}
+{
+    if (not dispatcher)
+        throw std::runtime_error{"Cannot construct Swappable device for null dispatcher."};
+
+    if (not device)
+        throw std::runtime_error{"Cannot construct Swappable device for null impl."};
+
+    state->dispatcher = dispatcher;
+    state->generation = std::make_shared<Generation>(dispatcher, device);
+}
+
+void biometry::devices::Swappable::swap(const std::shared_ptr<biometry::Device>& device, const std::function<void()>& on_drained)
+{
+    if (not device)
+        throw std::runtime_error{"Cannot swap in null impl."};
+
+    state->swap(device, on_drained);
+}
+
+biometry::TemplateStore& biometry::devices::Swappable::template_store()
+{
+    return template_store_;
+}
+
+biometry::Identifier& biometry::devices::Swappable::identifier()
+{
+    return identifier_;
+}
+
+biometry::Verifier& biometry::devices::Swappable::verifier()
+{
+    return verifier_;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRYD_DEVICES_SWAPPABLE_H_
+#define BIOMETRYD_DEVICES_SWAPPABLE_H_
+
+#include <biometry/device.h>
+
+#include <biometry/identifier.h>
+#include <biometry/template_store.h>
+#include <biometry/verifier.h>
+
+#include <biometry/util/dispatcher.h>
+
+#include <functional>
+#include <memory>
+
+namespace biometry
+{
+namespace devices
+{
+/// @brief Swappable is a biometry::Device whose implementation can be replaced at runtime.
+///
+/// Every operation stays bound to the implementation that created it. After a swap,
+/// the previous implementation is released on a dispatcher once all operations it
+/// created have finished. New requests are queued until then, and only reach the new
+/// implementation after the previous one has been released. With that, implementations
+/// that hand out shared resources (e.g., a single HAL callback) never observe requests
+/// from two generations at the same time.
+class BIOMETRY_DLL_PUBLIC Swappable : public biometry::Device
+{
+public:
+    /// @cond
+    struct Generation;
+    struct State;
+    /// @endcond
+
+    // Safe us some typing.
+    typedef std::shared_ptr<Swappable> Ptr;
+
+    class TemplateStore : public biometry::TemplateStore
+    {
+    public:
+        TemplateStore(const std::shared_ptr<State>& state);
+
+        // From biometry::TemplateStore.
+        biometry::Operation<biometry::TemplateStore::SizeQuery>::Ptr size(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::List>::Ptr list(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Enrollment>::Ptr enroll(const biometry::Application& app, const biometry::User& user) override;
+        biometry::Operation<biometry::TemplateStore::Removal>::Ptr remove(const biometry::Application& app, const biometry::User& user, biometry::TemplateStore::TemplateId id) override;
+        biometry::Operation<biometry::TemplateStore::Clearance>::Ptr clear(const biometry::Application& app, const biometry::User& user) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    class Identifier : public biometry::Identifier
+    {
+    public:
+        Identifier(const std::shared_ptr<State>& state);
+
+        // From biometry::Identifier.
+        biometry::Operation<biometry::Identification>::Ptr identify_user(const biometry::Application& app, const biometry::Reason& reason) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    class Verifier : public biometry::Verifier
+    {
+    public:
+        Verifier(const std::shared_ptr<State>& state);
+
+        // From biometry::Verifier.
+        Operation<Verification>::Ptr verify_user(const Application& app, const User& user, const Reason& reason) override;
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    /// @brief Swappable creates a new instance, forwarding requests to device.
+    ///
+    /// Implementations replaced by swap are released on dispatcher.
+    /// @throws std::runtime_error if dispatcher or device is null.
+    Swappable(const std::shared_ptr<util::Dispatcher>& dispatcher, const std::shared_ptr<biometry::Device>& device);
+
+    /// @brief swap replaces the current implementation by device.
+    ///
+    /// Requests issued after the call are queued and reach device only after the previous
+    /// implementation has been released, i.e., once all of its operations have finished.
+    /// on_drained is invoked on the dispatcher right after that. Swapping again before
+    /// the previous implementation has drained replaces device, which is then released
+    /// without ever seeing a request.
+    /// @throws std::runtime_error if device is null.
+    void swap(const std::shared_ptr<biometry::Device>& device, const std::function<void()>& on_drained = std::function<void()>{});
+
+    // From biometry::Device
+    biometry::TemplateStore& template_store() override;
+    biometry::Identifier& identifier() override;
+    biometry::Verifier& verifier() override;
+
+private:
+    std::shared_ptr<State> state;
+    TemplateStore template_store_;
+    Identifier identifier_;
+    Verifier verifier_;
+};
+}
+}
+
+#endif // BIOMETRYD_DEVICES_SWAPPABLE_H_
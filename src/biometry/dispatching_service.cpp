@@ -23,11 +23,18 @@
 
 #include <memory>
 
-biometry::DispatchingService::DispatchingService(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& default_device)
-    : default_device_{std::make_shared<devices::Dispatching>(dispatcher, default_device)}
+biometry::DispatchingService::DispatchingService(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& default_device,
+                                                 const std::shared_ptr<biometry::util::Dispatcher>& replies)
+    : swappable_{std::make_shared<devices::Swappable>(dispatcher, default_device)},
+      default_device_{std::make_shared<devices::Dispatching>(dispatcher, swappable_, replies)}
 {
 }
 
+void biometry::DispatchingService::swap_default_device(const std::shared_ptr<Device>& device, const std::function<void()>& on_drained)
+{
+    swappable_->swap(device, on_drained);
+}
+
 std::shared_ptr<biometry::Device> biometry::DispatchingService::default_device() const
 {
     return default_device_;
@@ -23,9 +23,11 @@
 #include <biometry/service.h>
 
 #include <biometry/devices/dispatching.h>
+#include <biometry/devices/swappable.h>
 
 #include <boost/asio.hpp>
 
+#include <functional>
 #include <memory>
 
 namespace biometry
@@ -35,12 +37,24 @@ class BIOMETRY_DLL_PUBLIC DispatchingService : public Service
 {
 public:
     /// @brief DispatchingService initializes a new instance with the given default_device.
-    DispatchingService(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& default_device);
+    ///
+    /// If set, replies to observers are dispatched via replies.
+    DispatchingService(const std::shared_ptr<biometry::util::Dispatcher>& dispatcher, const std::shared_ptr<Device>& default_device,
+                       const std::shared_ptr<biometry::util::Dispatcher>& replies = std::shared_ptr<biometry::util::Dispatcher>{});
+
+    /// @brief swap_default_device replaces the implementation behind default_device() by device.
+    ///
+    /// Operations already created keep running on the previous implementation, which
+    /// is released once all of them have finished. Requests issued in the meantime are
+    /// queued and reach device afterwards. on_drained is invoked once the previous
+    /// implementation has been released.
+    void swap_default_device(const std::shared_ptr<Device>& device, const std::function<void()>& on_drained = std::function<void()>{});
 
     // From Service.
     std::shared_ptr<Device> default_device() const override;
 
 protected:
+    devices::Swappable::Ptr swappable_;
     devices::Dispatching::Ptr default_device_;
 };
 }
@@ -36,6 +36,12 @@ namespace internal
 {
 struct HIDDEN_SYMBOL ToHybris
 {
+    // module names us in UBUNTU_PLATFORM_API_TEST_OVERRIDE.
+    static const char* module()
+    {
+        return "biometry";
+    }
+
     static const char* path()
     {
         static const char* cache = "libbiometry_fp_api.so";
@@ -44,7 +50,9 @@ struct HIDDEN_SYMBOL ToHybris
 
     static const char* override_path()
     {
-        return NULL;
+        // Only tests point us to a test version, production builds never load one.
+        static const char* cache = secure_getenv("BIOMETRYD_FP_API_TEST_OVERRIDE_PATH");
+        return cache;
     }
 
     static void* dlopen_fn(const char* path, int flags)
@@ -61,7 +69,7 @@ struct HIDDEN_SYMBOL ToHybris
 
 #define DLSYM(fptr, sym) if (*(fptr) == NULL) \
     {\
-        *((void**)fptr) = (void *) internal::Bridge<internal::ToHybris>::instance().resolve_symbol(sym);\
+        *((void**)fptr) = (void *) internal::Bridge<internal::ToHybris>::instance().resolve_symbol(sym, internal::ToHybris::module());\
     }
 
 #include <biometry/bridge/hybris_bridge_defs.h>
@@ -83,3 +83,47 @@ u_hardware_biometry_authenticate,
 UHardwareBiometry,
 uint64_t,
 uint32_t)
+
+// Pre-resolved table
+#include <biometry/hardware/fingerprint_api.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+template<typename Function>
+void resolve_or_throw(Function& f, const char* symbol)
+{
+    f = reinterpret_cast<Function>(internal::Bridge<internal::ToHybris>::instance().resolve_symbol(symbol, internal::ToHybris::module()));
+    if (f == NULL)
+        throw std::runtime_error{std::string{"Failed to resolve symbol: "} + symbol};
+}
+
+biometry::hardware::FingerprintApi resolve_all()
+{
+    if (not internal::Bridge<internal::ToHybris>::instance().is_loaded())
+        throw std::runtime_error{std::string{"Failed to load "} + internal::ToHybris::path()};
+
+    biometry::hardware::FingerprintApi api;
+    resolve_or_throw(api.create, "u_hardware_biometry_new");
+    resolve_or_throw(api.setNotify, "u_hardware_biometry_setNotify");
+    resolve_or_throw(api.preEnroll, "u_hardware_biometry_preEnroll");
+    resolve_or_throw(api.enroll, "u_hardware_biometry_enroll");
+    resolve_or_throw(api.postEnroll, "u_hardware_biometry_postEnroll");
+    resolve_or_throw(api.getAuthenticatorId, "u_hardware_biometry_getAuthenticatorId");
+    resolve_or_throw(api.cancel, "u_hardware_biometry_cancel");
+    resolve_or_throw(api.enumerate, "u_hardware_biometry_enumerate");
+    resolve_or_throw(api.remove, "u_hardware_biometry_remove");
+    resolve_or_throw(api.setActiveGroup, "u_hardware_biometry_setActiveGroup");
+    resolve_or_throw(api.authenticate, "u_hardware_biometry_authenticate");
+    return api;
+}
+}
+
+const biometry::hardware::FingerprintApi& biometry::hardware::FingerprintApi::resolve()
+{
+    // A throwing initializer leaves the table uninitialized, such that a later call retries.
+    static const FingerprintApi api = resolve_all();
+    return api;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2020 UBports foundation Ltd
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BIOMETRY_HARDWARE_FINGERPRINT_API_H_
+#define BIOMETRY_HARDWARE_FINGERPRINT_API_H_
+
+#include <biometry/hardware/biometry.h>
+
+namespace biometry
+{
+namespace hardware
+{
+/// @brief FingerprintApi is a flat table of the u_hardware_biometry_* entry points
+/// exposed by libbiometry_fp_api.so.
+///
+/// In contrast to the lazily resolving u_hardware_biometry_* C functions, all
+/// symbols are resolved exactly once, keeping dlsym and the test override
+/// lookup off the path of individual operations.
+struct FingerprintApi
+{
+    /// @brief resolve returns the process-wide table, resolving all symbols on first call.
+    /// @throws std::runtime_error if the library could not be loaded or a symbol is missing.
+    static const FingerprintApi& resolve();
+
+    UHardwareBiometry (*create)();
+    uint64_t (*setNotify)(UHardwareBiometry, UHardwareBiometryParams*);
+    uint64_t (*preEnroll)(UHardwareBiometry);
+    UHardwareBiometryRequestStatus (*enroll)(UHardwareBiometry, uint32_t, uint32_t, uint32_t);
+    UHardwareBiometryRequestStatus (*postEnroll)(UHardwareBiometry);
+    uint64_t (*getAuthenticatorId)(UHardwareBiometry);
+    UHardwareBiometryRequestStatus (*cancel)(UHardwareBiometry);
+    UHardwareBiometryRequestStatus (*enumerate)(UHardwareBiometry);
+    UHardwareBiometryRequestStatus (*remove)(UHardwareBiometry, uint32_t, uint32_t);
+    UHardwareBiometryRequestStatus (*setActiveGroup)(UHardwareBiometry, uint32_t, char*);
+    UHardwareBiometryRequestStatus (*authenticate)(UHardwareBiometry, uint64_t, uint32_t);
+};
+}
+}
+
+#endif // BIOMETRY_HARDWARE_FINGERPRINT_API_H_
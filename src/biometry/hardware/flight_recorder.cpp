@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/hardware/flight_recorder.h>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+constexpr const char magic[8] = {'B', 'I', 'O', 'F', 'R', 'E', 'C', '\0'};
+constexpr const std::uint32_t version = 1;
+// Slots start on their own cache line, past the header.
+constexpr const std::size_t header_size = 64;
+
+// Argument names of all events, indexed by event.
+const std::array<std::array<const char*, biometry::hardware::FlightRecorder::max_argument_count>, 15> argument_names
+{{
+    {{"pid", "realtime", nullptr, nullptr}},
+    {{"call", "status", nullptr, nullptr}},
+    {{"gid", "timeout", "uid", nullptr}},
+    {{nullptr, nullptr, nullptr, nullptr}},
+    {{nullptr, nullptr, nullptr, nullptr}},
+    {{nullptr, nullptr, nullptr, nullptr}},
+    {{"gid", "fid", nullptr, nullptr}},
+    {{"gid", nullptr, nullptr, nullptr}},
+    {{"operation", "gid", nullptr, nullptr}},
+    {{"fid", "gid", "remaining", nullptr}},
+    {{"info", "vendor", nullptr, nullptr}},
+    {{"fid", "gid", nullptr, nullptr}},
+    {{"error", "vendor", nullptr, nullptr}},
+    {{"fid", "gid", "remaining", nullptr}},
+    {{"fid", "gid", "remaining", nullptr}}
+}};
+
+bool is_known(biometry::hardware::FlightRecorder::Event event)
+{
+    return static_cast<std::size_t>(event) < argument_names.size();
+}
+
+// Mapping maps a file into memory, unmapping it on destruction unless released.
+class Mapping
+{
+public:
+    Mapping(int fd, std::size_t size, int protection, const fs::path& path) : size{size}
+    {
+        data = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error{error, std::system_category(), "Failed to map " + path.string()};
+        }
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    ~Mapping()
+    {
+        if (data)
+            ::munmap(data, size);
+    }
+
+    char* get() const
+    {
+        return static_cast<char*>(data);
+    }
+
+    char* release()
+    {
+        auto result = get();
+        data = nullptr;
+        return result;
+    }
+
+private:
+    void* data;
+    std::size_t size;
+};
+
+// The process-wide recorder and all recorders that have ever been installed.
+std::atomic<biometry::hardware::FlightRecorder*> installed{nullptr};
+
+std::vector<std::shared_ptr<biometry::hardware::FlightRecorder>>& installed_recorders()
+{
+    static std::vector<std::shared_ptr<biometry::hardware::FlightRecorder>> instance;
+    return instance;
+}
+
+std::mutex& installed_recorders_guard()
+{
+    static std::mutex instance;
+    return instance;
+}
+}
+
+constexpr const std::size_t biometry::hardware::FlightRecorder::max_argument_count;
+constexpr const std::size_t biometry::hardware::FlightRecorder::default_capacity;
+
+// Header is placed at the beginning of every recorder file.
+struct biometry::hardware::FlightRecorder::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint64_t capacity;
+    std::atomic<std::uint64_t> head;
+};
+
+// Slot holds a single record, sequence is 0 while the slot is being written.
+struct biometry::hardware::FlightRecorder::Slot
+{
+    std::atomic<std::uint64_t> sequence;
+    std::uint64_t timestamp;
+    std::uint64_t operation;
+    std::uint32_t event;
+    std::uint32_t argument_count;
+    std::int64_t arguments[max_argument_count];
+};
+
+biometry::hardware::FlightRecorder::FlightRecorder(const boost::filesystem::path& path, std::size_t capacity)
+{
+    static_assert(sizeof(Header) <= header_size, "Header must fit in front of the slots");
+    static_assert(sizeof(Slot) == 64, "Slots must be exactly one cache line");
+
+    if (capacity == 0)
+        throw std::invalid_argument{"FlightRecorder capacity must not be 0"};
+
+    boost::system::error_code ec;
+    if (path.has_parent_path())
+        fs::create_directories(path.parent_path(), ec);
+
+    auto fd = ::open(path.string().c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+        throw std::system_error{errno, std::system_category(), "Failed to open " + path.string()};
+
+    size = header_size + capacity * sizeof(Slot);
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0)
+    {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error{error, std::system_category(), "Failed to query " + path.string()};
+    }
+
+    // We only ever look at the header once the file is known to be large enough.
+    bool reset = static_cast<std::size_t>(st.st_size) != size;
+    if (reset && (::ftruncate(fd, 0) < 0 || ::ftruncate(fd, size) < 0))
+    {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error{error, std::system_category(), "Failed to resize " + path.string()};
+    }
+
+    Mapping mapping{fd, size, PROT_READ | PROT_WRITE, path};
+    ::close(fd);
+
+    header = reinterpret_cast<Header*>(mapping.get());
+    slots = reinterpret_cast<Slot*>(mapping.get() + header_size);
+
+    reset = reset ||
+            std::memcmp(header->magic, magic, sizeof(magic)) != 0 ||
+            header->version != version ||
+            header->slot_size != sizeof(Slot) ||
+            header->capacity != capacity;
+
+    if (reset)
+    {
+        std::memset(mapping.get(), 0, size);
+        header->version = version;
+        header->slot_size = sizeof(Slot);
+        header->capacity = capacity;
+        new (&header->head) std::atomic<std::uint64_t>{0};
+        // The magic goes last, a file that has not been initialized completely is reset on next open.
+        std::memcpy(header->magic, magic, sizeof(magic));
+    }
+
+    mapping.release();
+
+    append(Event::opened, 0, {::getpid(), std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()});
+}
+
+biometry::hardware::FlightRecorder::~FlightRecorder()
+{
+    ::munmap(header, size);
+}
+
+void biometry::hardware::FlightRecorder::append(Event event, std::uint64_t operation, std::initializer_list<std::int64_t> arguments)
+{
+    auto pos = header->head.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[pos % header->capacity];
+
+    // Readers discard the slot while we update it.
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    slot.operation = operation;
+    slot.event = static_cast<std::uint32_t>(event);
+    slot.argument_count = static_cast<std::uint32_t>(std::min(arguments.size(), max_argument_count));
+    std::copy_n(arguments.begin(), slot.argument_count, slot.arguments);
+
+    slot.sequence.store(pos + 1, std::memory_order_release);
+}
+
+std::size_t biometry::hardware::FlightRecorder::capacity() const
+{
+    return header->capacity;
+}
+
+void biometry::hardware::FlightRecorder::install(const std::shared_ptr<FlightRecorder>& recorder)
+{
+    std::lock_guard<std::mutex> lg{installed_recorders_guard()};
+    if (recorder)
+        installed_recorders().push_back(recorder);
+    installed.store(recorder.get(), std::memory_order_release);
+}
+
+void biometry::hardware::FlightRecorder::record(Event event, std::uint64_t operation, std::initializer_list<std::int64_t> arguments)
+{
+    if (auto recorder = installed.load(std::memory_order_acquire))
+        recorder->append(event, operation, arguments);
+}
+
+std::vector<biometry::hardware::FlightRecorder::Record> biometry::hardware::FlightRecorder::read(const boost::filesystem::path& path)
+{
+    auto fd = ::open(path.string().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error{errno, std::system_category(), "Failed to open " + path.string()};
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0)
+    {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error{error, std::system_category(), "Failed to query " + path.string()};
+    }
+
+    auto size = static_cast<std::size_t>(st.st_size);
+    if (size < header_size)
+    {
+        ::close(fd);
+        throw std::runtime_error{path.string() + " is not a flight recorder file"};
+    }
+
+    Mapping mapping{fd, size, PROT_READ, path};
+    ::close(fd);
+
+    auto header = reinterpret_cast<const Header*>(mapping.get());
+    auto slots = reinterpret_cast<const Slot*>(mapping.get() + header_size);
+
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 ||
+        header->version != version ||
+        header->slot_size != sizeof(Slot) ||
+        header->capacity == 0 ||
+        header->capacity > (size - header_size) / sizeof(Slot))
+        throw std::runtime_error{path.string() + " is not a flight recorder file"};
+
+    std::vector<Record> result;
+
+    for (std::size_t i = 0; i < header->capacity; i++)
+    {
+        const auto& slot = slots[i];
+
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        // Slots that have never been written or that have been interrupted mid-write are skipped.
+        if (sequence == 0 || (sequence - 1) % header->capacity != i)
+            continue;
+
+        Record record;
+        record.sequence = sequence;
+        record.timestamp = std::chrono::nanoseconds{slot.timestamp};
+        record.operation = slot.operation;
+        record.event = static_cast<Event>(slot.event);
+        record.argument_count = std::min<std::uint32_t>(slot.argument_count, max_argument_count);
+        record.arguments.fill(0);
+        std::copy_n(slot.arguments, record.argument_count, record.arguments.begin());
+
+        // A writer running concurrently might have claimed the slot while we were copying.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        result.push_back(record);
+    }
+
+    std::sort(result.begin(), result.end(), [](const Record& lhs, const Record& rhs) { return lhs.sequence < rhs.sequence; });
+    return result;
+}
+
+const char* biometry::hardware::FlightRecorder::name(Event event)
+{
+    switch (event)
+    {
+    case Event::opened: return "opened";
+    case Event::returned: return "returned";
+    case Event::enroll: return "enroll";
+    case Event::post_enroll: return "postEnroll";
+    case Event::cancel: return "cancel";
+    case Event::enumerate: return "enumerate";
+    case Event::remove: return "remove";
+    case Event::set_active_group: return "setActiveGroup";
+    case Event::authenticate: return "authenticate";
+    case Event::enrollresult_cb: return "enrollresult_cb";
+    case Event::acquired_cb: return "acquired_cb";
+    case Event::authenticated_cb: return "authenticated_cb";
+    case Event::error_cb: return "error_cb";
+    case Event::removed_cb: return "removed_cb";
+    case Event::enumerate_cb: return "enumerate_cb";
+    }
+
+    return "unknown";
+}
+
+std::ostream& biometry::hardware::operator<<(std::ostream& out, const FlightRecorder::Record& record)
+{
+    out << boost::format("[%1$16.6f] #%2% op %3% %4%(")
+           % (record.timestamp.count() / 1e9)
+           % record.sequence
+           % record.operation
+           % FlightRecorder::name(record.event);
+
+    for (std::size_t i = 0; i < record.argument_count; i++)
+    {
+        if (i > 0)
+            out << ", ";
+
+        if (is_known(record.event) && argument_names[static_cast<std::size_t>(record.event)][i])
+            out << argument_names[static_cast<std::size_t>(record.event)][i] << "=";
+
+        if (record.event == FlightRecorder::Event::returned && i == 0)
+            out << FlightRecorder::name(static_cast<FlightRecorder::Event>(record.arguments[i]));
+        else
+            out << record.arguments[i];
+    }
+
+    return out << ")";
+}
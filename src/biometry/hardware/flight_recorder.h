@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BIOMETRY_HARDWARE_FLIGHT_RECORDER_H_
+#define BIOMETRY_HARDWARE_FLIGHT_RECORDER_H_
+
+#include <biometry/do_not_copy_or_move.h>
+#include <biometry/visibility.h>
+
+#include <boost/filesystem.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace biometry
+{
+namespace hardware
+{
+/// @brief FlightRecorder records HAL calls and callbacks to a fixed-size ring buffer in a memory-mapped file.
+///
+/// The file is mapped shared, records reach the page cache as soon as they are written
+/// and survive a crash of the daemon for post-mortem analysis. Appending a record neither
+/// allocates nor locks, the oldest records are overwritten once the buffer is full.
+class BIOMETRY_DLL_PUBLIC FlightRecorder : public DoNotCopyOrMove
+{
+public:
+    /// @brief Event enumerates all recorded events.
+    ///
+    /// Values are persisted and must not be reordered.
+    enum class Event : std::uint32_t
+    {
+        opened,             ///< A recorder has been opened, arguments: pid, realtime in seconds.
+        returned,           ///< A HAL call returned, arguments: call, status.
+        enroll,             ///< arguments: gid, timeout, uid.
+        post_enroll,        ///< no arguments.
+        cancel,             ///< no arguments.
+        enumerate,          ///< no arguments.
+        remove,             ///< arguments: gid, fid.
+        set_active_group,   ///< arguments: gid.
+        authenticate,       ///< arguments: operation id, gid.
+        enrollresult_cb,    ///< arguments: fid, gid, remaining.
+        acquired_cb,        ///< arguments: acquired info, vendor code.
+        authenticated_cb,   ///< arguments: fid, gid.
+        error_cb,           ///< arguments: error, vendor code.
+        removed_cb,         ///< arguments: fid, gid, remaining.
+        enumerate_cb        ///< arguments: fid, gid, remaining.
+    };
+
+    /// @brief max_argument_count is the maximum number of arguments stored with an event.
+    static constexpr const std::size_t max_argument_count = 4;
+
+    /// @brief default_capacity is the number of records held by a recorder by default.
+    static constexpr const std::size_t default_capacity = 8192;
+
+    /// @brief Record is a decoded entry of a recorder file.
+    struct Record
+    {
+        std::uint64_t sequence;                                 ///< Position of the record in the sequence of all records.
+        std::chrono::nanoseconds timestamp;                     ///< Time of the event on the monotonic clock.
+        std::uint64_t operation;                                ///< Id of the operation the event belongs to, 0 if none.
+        Event event;                                            ///< The recorded event.
+        std::uint32_t argument_count;                           ///< Number of valid entries in arguments.
+        std::array<std::int64_t, max_argument_count> arguments; ///< Arguments of the event.
+    };
+
+    /// @brief FlightRecorder opens the recorder file at path, creating it and its parent directories if necessary.
+    ///
+    /// Records of an existing, compatible file are preserved and appended to, all other files are reset.
+    /// @throws std::system_error if the file cannot be created or mapped.
+    explicit FlightRecorder(const boost::filesystem::path& path, std::size_t capacity = default_capacity);
+    /// @brief ~FlightRecorder unmaps the file, records remain on disk.
+    ~FlightRecorder();
+
+    /// @brief append records event with arguments for operation.
+    ///
+    /// Safe to call from multiple threads concurrently, arguments beyond max_argument_count are dropped.
+    void append(Event event, std::uint64_t operation, std::initializer_list<std::int64_t> arguments);
+
+    /// @brief capacity returns the number of records held by the recorder.
+    std::size_t capacity() const;
+
+    /// @brief install makes recorder the process-wide instance used by record.
+    ///
+    /// Installed recorders are kept alive until the process exits, callers racing
+    /// with a replacement never observe a dangling instance.
+    static void install(const std::shared_ptr<FlightRecorder>& recorder);
+
+    /// @brief record appends to the process-wide instance, doing nothing if none has been installed.
+    static void record(Event event, std::uint64_t operation, std::initializer_list<std::int64_t> arguments);
+
+    /// @brief read decodes all completely written records of the recorder file at path, ordered by sequence.
+    /// @throws std::system_error if the file cannot be opened.
+    /// @throws std::runtime_error if the file is not a recorder file.
+    static std::vector<Record> read(const boost::filesystem::path& path);
+
+    /// @brief name returns a human-readable name of event.
+    static const char* name(Event event);
+
+private:
+    struct Header;
+    struct Slot;
+
+    std::size_t size;
+    Header* header;
+    Slot* slots;
+};
+
+/// @brief operator<< inserts record into out in a human-readable format.
+BIOMETRY_DLL_PUBLIC std::ostream& operator<<(std::ostream& out, const FlightRecorder::Record& record);
+}
+}
+
+#endif // BIOMETRY_HARDWARE_FLIGHT_RECORDER_H_
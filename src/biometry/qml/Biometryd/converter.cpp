@@ -48,3 +48,27 @@ biometry::qml::FingerprintReader::Direction biometry::qml::Converter::convert(bi
     return static_cast<biometry::qml::FingerprintReader::Direction>(dir);
 }
 
+
+QVariantMap biometry::qml::Converter::convert(const biometry::Dictionary& details)
+{
+    typedef biometry::devices::FingerprintReader::GuidedEnrollment::Hints Hints;
+
+    QVariantMap vm;
+
+    Hints hints;
+    hints.from_dictionary(details);
+
+    if (hints.is_finger_present)
+        vm[Hints::key_is_finger_present] = *hints.is_finger_present;
+
+    if (hints.is_main_cluster_identified)
+        vm[Hints::key_is_main_cluster_identified] = *hints.is_main_cluster_identified;
+
+    if (hints.suggested_next_direction)
+        vm[Hints::key_suggested_next_direction].setValue(convert(*hints.suggested_next_direction));
+
+    if (hints.masks)
+        vm[Hints::key_masks] = convert(*hints.masks);
+
+    return vm;
+}
@@ -20,11 +20,13 @@
 #ifndef BIOMETRYD_QML_CONVERTER_H_
 #define BIOMETRYD_QML_CONVERTER_H_
 
+#include <biometry/dictionary.h>
 #include <biometry/devices/fingerprint_reader.h>
 #include <biometry/qml/Biometryd/fingerprint_reader.h>
 
 #include <QList>
 #include <QRectF>
+#include <QVariantMap>
 
 namespace biometry
 {
@@ -42,6 +44,8 @@ struct Converter
     static QVariantList convert(const std::vector<biometry::Rectangle>& rects);
     /// @brief convert returns the enum value correspondig to dir.
     static FingerprintReader::Direction convert(biometry::devices::FingerprintReader::Direction dir);
+    /// @brief convert returns a QVariantMap containing the guided enrollment hints found in details.
+    static QVariantMap convert(const biometry::Dictionary& details);
 };
 }
 }
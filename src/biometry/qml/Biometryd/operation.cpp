@@ -20,10 +20,133 @@
 #include <biometry/qml/Biometryd/operation.h>
 
 #include <QDebug>
+#include <QMetaMethod>
 #include <QQmlEngine>
 
-biometry::qml::Observer::Observer(QObject*) : QObject{}
+biometry::qml::Dispatcher& biometry::qml::Dispatcher::instance()
 {
+    // The instance is never destroyed: observers might still dispatch
+    // from other threads while static destructors run on exit.
+    static Dispatcher* instance = []()
+    {
+        auto dispatcher = new Dispatcher{};
+        dispatcher->moveToThread(QCoreApplication::instance()->thread());
+        return dispatcher;
+    }();
+
+    return *instance;
+}
+
+bool biometry::qml::Dispatcher::event(QEvent* ev)
+{
+    if (ev->type() == WakeUp::type())
+    {
+        tasks.drain([](Task& task) { task.f(); });
+        return true;
+    }
+
+    return QObject::event(ev);
+}
+
+void biometry::qml::Dispatcher::dispatch(Context ctxt, util::UniqueFunction<void()>&& task)
+{
+    // Only the first task entering an empty queue wakes up the main loop.
+    if (tasks.push(Task{std::move(ctxt), std::move(task)}))
+        QCoreApplication::instance()->postEvent(this, new WakeUp{});
+}
+
+biometry::qml::Observer::Observer(QObject*)
+    : QObject{},
+      progress_wanted_{std::make_shared<std::atomic<bool>>(false)},
+      maximum_progress_rate_{0},
+      latest_{false, 0., biometry::Dictionary{}}
+{
+    throttle_.setSingleShot(true);
+    QObject::connect(&throttle_, &QTimer::timeout, this, &Observer::emit_progress);
+}
+
+int biometry::qml::Observer::maximumProgressRate() const
+{
+    return maximum_progress_rate_;
+}
+
+void biometry::qml::Observer::setMaximumProgressRate(int rate)
+{
+    rate = qMax(0, rate);
+
+    if (rate == maximum_progress_rate_)
+        return;
+
+    maximum_progress_rate_ = rate;
+    Q_EMIT maximumProgressRateChanged();
+}
+
+void biometry::qml::Observer::update_progress(double percent, biometry::Dictionary&& details)
+{
+    // The latest update always wins over a pending one.
+    latest_.pending = true;
+    latest_.percent = percent;
+    latest_.details = std::move(details);
+
+    if (maximum_progress_rate_ == 0)
+    {
+        emit_progress();
+        return;
+    }
+
+    // An emission has already been scheduled and will pick up the latest update.
+    if (throttle_.isActive())
+        return;
+
+    const qint64 interval = 1000 / maximum_progress_rate_;
+    const qint64 elapsed = last_emission_.isValid() ? last_emission_.elapsed() : interval;
+
+    if (elapsed >= interval)
+        emit_progress();
+    else
+        throttle_.start(static_cast<int>(interval - elapsed));
+}
+
+void biometry::qml::Observer::flush_progress()
+{
+    throttle_.stop();
+    if (latest_.pending)
+        emit_progress();
+}
+
+std::shared_ptr<const std::atomic<bool>> biometry::qml::Observer::progress_wanted() const
+{
+    // We refresh the flag here, too, as not all kinds of connections
+    // are guaranteed to be reported via connectNotify.
+    progress_wanted_->store(isSignalConnected(QMetaMethod::fromSignal(&Observer::progressed)));
+    return progress_wanted_;
+}
+
+void biometry::qml::Observer::connectNotify(const QMetaMethod& signal)
+{
+    if (signal == QMetaMethod::fromSignal(&Observer::progressed))
+        progress_wanted_->store(true);
+}
+
+void biometry::qml::Observer::disconnectNotify(const QMetaMethod& signal)
+{
+    // signal is invalid if all connections have been dropped in one go.
+    if (not signal.isValid() || signal == QMetaMethod::fromSignal(&Observer::progressed))
+        progress_wanted_->store(isSignalConnected(QMetaMethod::fromSignal(&Observer::progressed)));
+}
+
+void biometry::qml::Observer::emit_progress()
+{
+    if (not latest_.pending)
+        return;
+
+    latest_.pending = false;
+    last_emission_.start();
+
+    // Decoding details is only worth it if anybody is listening.
+    static const QMetaMethod signal = QMetaMethod::fromSignal(&Observer::progressed);
+    if (isSignalConnected(signal))
+        Q_EMIT progressed(latest_.percent, Converter::convert(latest_.details));
 }
 
 biometry::qml::Operation::Operation(QObject* parent) : QObject{parent}
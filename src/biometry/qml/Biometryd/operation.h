@@ -20,25 +20,31 @@
 #ifndef BIOMETRYD_QML_OPERATION_H_
 #define BIOMETRYD_QML_OPERATION_H_
 
+#include <biometry/dictionary.h>
 #include <biometry/operation.h>
 #include <biometry/reason.h>
 #include <biometry/user.h>
 #include <biometry/visibility.h>
 
 #include <biometry/devices/fingerprint_reader.h>
+#include <biometry/util/mpsc_queue.h>
+#include <biometry/util/unique_function.h>
 
 #include <biometry/qml/Biometryd/converter.h>
 #include <biometry/qml/Biometryd/fingerprint_reader.h>
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QEvent>
 #include <QPointer>
 #include <QObject>
 #include <QVariantMap>
 #include <QRect>
+#include <QTimer>
 #include <QVector>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 
@@ -101,76 +107,91 @@ struct Result<std::vector<biometry::TemplateStore::TemplateId>>
 };
 }
 
-/// @brief DispatcherWithContext dispatches tasks onto the QCoreApplication main loop.
-template<typename Context>
-class BIOMETRY_DLL_PUBLIC DispatcherWithContext : public QObject
+/// @brief Dispatcher dispatches tasks onto the QCoreApplication main loop.
+///
+/// A single instance serves the whole process. Tasks are appended to a lock-free queue
+/// together with a context token that is kept alive until the task has been executed.
+/// At most one wake-up event is pending on the main loop at any time, and handling it
+/// executes all queued tasks in one go.
+class BIOMETRY_DLL_PUBLIC Dispatcher : public QObject
 {
+public:
+    /// @brief Context is an opaque token kept alive until the task referring to it has been executed.
+    typedef std::shared_ptr<void> Context;
+
+    /// @brief instance returns the process-wide instance, living on the thread of the QCoreApplication.
+    static Dispatcher& instance();
+
+    /// @brief event processes events of type WakeUp, draining all pending tasks.
+    bool event(QEvent* ev) override;
+
+    /// @brief dispatch enqueues the given task for execution on the QCoreApplication
+    /// main loop, keeping ctxt alive until then.
+    void dispatch(Context ctxt, util::UniqueFunction<void()>&& task);
+
 private:
-    /// @brief Task is the actual event used for transporting dispatched tasks
-    /// from one thread to the other.
-    class Task : public QEvent
+    /// @brief WakeUp is the event notifying the main loop about pending tasks.
+    class WakeUp : public QEvent
     {
     public:
-        /// @brief type returns the QEvent::Type assigned to DispatcherWithContext<T>::Task.
+        /// @brief type returns the QEvent::Type assigned to Dispatcher::WakeUp.
         static QEvent::Type type()
         {
             static const QEvent::Type t = static_cast<QEvent::Type>(QEvent::registerEventType());
             return t;
         }
 
-        /// @brief Task initializes a new instance with the given null-ary void functor.
-        Task(const std::function<void()>& f) : QEvent{Task::type()}, f{f}
-        {
-        }
-
-        /// @brief run puts the contained functor to execution.
-        void run()
+        /// @brief WakeUp initializes a new instance.
+        WakeUp() : QEvent{WakeUp::type()}
         {
-            f();
         }
-
-    private:
-        std::function<void()> f;
     };
 
-public:
-    /// @brief Dispatcher initializes a default instance.
-    DispatcherWithContext() = default;
-
-    /// @brief event processes events of type Task.
-    bool event(QEvent* ev) override
+    /// @brief Task bundles a null-ary void functor and its context.
+    struct Task
     {
-        if (ev->type() == Task::type())
-        {
-            reinterpret_cast<Task*>(ev)->run();
-            return true;
-        }
+        Context ctxt;
+        util::UniqueFunction<void()> f;
+    };
 
-        return QObject::event(ev);
-    }
+    /// @brief Dispatcher initializes a new instance.
+    Dispatcher() = default;
 
-    /// @brief finalize schedules deletion of this instance onto the QCoreApplication main loop.
-    void finalize()
-    {
-        QCoreApplication::instance()->postEvent(this, new Task{[this]() { delete this; }});
-    }
-
-    /// @brief dispatch enqueues the given task for execution on the QCoreApplication
-    /// main loop.
-    void dispatch(const std::shared_ptr<Context>& ctxt, const std::function<void()>& task)
-    {
-        QCoreApplication::instance()->postEvent(this, new Task{[ctxt, task]() { task();}});
-    }    
+    util::MpscQueue<Task> tasks;
 };
 
 /// @brief Observer monitors an Operation.
+///
+/// Progress updates can be throttled by setting maximumProgressRate. Updates
+/// arriving faster than that are coalesced, with the latest update winning.
 class BIOMETRY_DLL_PUBLIC Observer : public QObject
 {
     Q_OBJECT
+    /// @brief maximumProgressRate limits the number of progressed emissions per second, 0 disables throttling.
+    Q_PROPERTY(int maximumProgressRate READ maximumProgressRate WRITE setMaximumProgressRate NOTIFY maximumProgressRateChanged)
 public:
     /// @brief Observer initializes a new instance with the given parent.
     explicit Observer(QObject* parent = 0);
 
+    /// @brief maximumProgressRate returns the maximum number of progressed emissions per second.
+    int maximumProgressRate() const;
+    /// @brief setMaximumProgressRate adjusts the maximum number of progressed emissions per second.
+    void setMaximumProgressRate(int rate);
+
+    /// @brief update_progress hands a progress update to the observer, emitting progressed
+    /// subject to throttling. Must be called on the thread the observer lives on.
+    ///
+    /// details are only converted to a QVariantMap when progressed is actually emitted
+    /// to a connected handler.
+    void update_progress(double percent, biometry::Dictionary&& details);
+    /// @brief flush_progress immediately emits a pending, throttled progress update.
+    void flush_progress();
+    /// @brief progress_wanted returns a flag that is true while progressed is connected to a handler.
+    /// Must be called on the thread the observer lives on.
+    ///
+    /// The flag can be queried from any thread and outlives the observer.
+    std::shared_ptr<const std::atomic<bool>> progress_wanted() const;
+
     /// @brief started is emitted when the state changes to started.
     Q_SIGNAL void started();
     /// @brief progressed is emitted when the overall operation progresses towards completion.
@@ -186,6 +207,30 @@ public:
     /// @brief succeeded is emitted when the operation completes successfully.
     /// @param result The result of the operation, might be empty.
     Q_SIGNAL void succeeded(const QVariant& result);
+    /// @brief maximumProgressRateChanged is emitted when the maximum progress rate changes.
+    Q_SIGNAL void maximumProgressRateChanged();
+
+protected:
+    // From QObject
+    void connectNotify(const QMetaMethod& signal) override;
+    void disconnectNotify(const QMetaMethod& signal) override;
+
+private:
+    /// @brief emit_progress emits the latest progress update, converting details
+    /// only if a handler is connected.
+    void emit_progress();
+
+    std::shared_ptr<std::atomic<bool>> progress_wanted_;
+    int maximum_progress_rate_;
+    QElapsedTimer last_emission_;
+    QTimer throttle_;
+
+    struct
+    {
+        bool pending;
+        double percent;
+        biometry::Dictionary details;
+    } latest_;
 };
 
 /// @brief Operation models an arbitrary operation as an observable state machine.
@@ -235,16 +280,9 @@ public:
             return Ptr{new Observer{observer}};
         }
 
-        ~Observer()
-        {
-            // observer is owned by the QML Engine. With that,
-            // we only need to take care of our dispatcher instance.
-            dispatcher->finalize();
-        }
-
         void on_started() override
         {
-            dispatcher->dispatch(Observer::shared_from_this(), [this]()
+            Dispatcher::instance().dispatch(Observer::shared_from_this(), [this]()
             {
                 if (observer) QMetaObject::invokeMethod(observer, "started", Qt::AutoConnection);
             });
@@ -252,71 +290,64 @@ public:
 
         void on_progress(const Progress& progress) override
         {
-            QVariantMap vm;
-
-            biometry::devices::FingerprintReader::GuidedEnrollment::Hints hints;
-            hints.from_dictionary(progress.details);
-
-            if (hints.is_finger_present)
-                vm[biometry::devices::FingerprintReader::GuidedEnrollment::Hints::key_is_finger_present] =
-                        *hints.is_finger_present;
-
-            if (hints.is_main_cluster_identified)
-                vm[biometry::devices::FingerprintReader::GuidedEnrollment::Hints::key_is_main_cluster_identified] =
-                        *hints.is_main_cluster_identified;
-
-            if (hints.suggested_next_direction)
-                vm[biometry::devices::FingerprintReader::GuidedEnrollment::Hints::key_suggested_next_direction].setValue(
-                        Converter::convert(*hints.suggested_next_direction));
+            // Without a connected handler, there is no point in waking up the main loop.
+            if (not progress_wanted->load(std::memory_order_relaxed))
+                return;
 
-            if (hints.masks)
-                vm[biometry::devices::FingerprintReader::GuidedEnrollment::Hints::key_masks] =
-                        Converter::convert(*hints.masks);
+            // Details are decoded on the main thread, and only for updates
+            // that make it through the observer's throttling.
+            auto percent = *progress.percent;
+            auto details = progress.details;
 
-            dispatcher->dispatch(Observer::shared_from_this(), [this, progress, vm]()
+            Dispatcher::instance().dispatch(Observer::shared_from_this(), [this, percent, details = std::move(details)]() mutable
             {
-                if (observer) QMetaObject::invokeMethod(observer, "progressed", Qt::AutoConnection,
-                                                        Q_ARG(double, *progress.percent),
-                                                        Q_ARG(QVariantMap, vm));
+                if (observer) observer->update_progress(percent, std::move(details));
             });
         }
 
         void on_canceled(const Reason& reason) override
         {
-            dispatcher->dispatch(Observer::shared_from_this(), [this, reason]()
+            Dispatcher::instance().dispatch(Observer::shared_from_this(), [this, reason]()
             {
-                if (observer) QMetaObject::invokeMethod(observer, "canceled", Qt::AutoConnection,
-                                                        Q_ARG(QString, QString::fromStdString(reason)));
+                if (not observer) return;
+                // Pending progress must not arrive after the operation completed.
+                observer->flush_progress();
+                QMetaObject::invokeMethod(observer, "canceled", Qt::AutoConnection,
+                                          Q_ARG(QString, QString::fromStdString(reason)));
             });
         }
 
         void on_failed(const Error& error) override
         {
-            dispatcher->dispatch(Observer::shared_from_this(), [this, error]()
+            Dispatcher::instance().dispatch(Observer::shared_from_this(), [this, error]()
             {
-                if (observer) QMetaObject::invokeMethod(observer, "failed", Qt::AutoConnection,
-                                                        Q_ARG(QString, QString::fromStdString(error)));
+                if (not observer) return;
+                observer->flush_progress();
+                QMetaObject::invokeMethod(observer, "failed", Qt::AutoConnection,
+                                          Q_ARG(QString, QString::fromStdString(error)));
             });
         }
 
         void on_succeeded(const Result& result) override
         {
-            dispatcher->dispatch(Observer::shared_from_this(), [this, result]()
+            Dispatcher::instance().dispatch(Observer::shared_from_this(), [this, result]()
             {
-                if (observer) QMetaObject::invokeMethod(observer, "succeeded", Qt::AutoConnection,
-                                                        Q_ARG(QVariant, traits::Result<Result>::to_variant(result)));
+                if (not observer) return;
+                observer->flush_progress();
+                QMetaObject::invokeMethod(observer, "succeeded", Qt::AutoConnection,
+                                          Q_ARG(QVariant, traits::Result<Result>::to_variant(result)));
             });
         }
 
     private:
         Observer(qml::Observer* observer)
             : observer{observer},
-              dispatcher{new DispatcherWithContext<Observer>{}}
+              progress_wanted{observer ? observer->progress_wanted() : std::make_shared<std::atomic<bool>>(false)}
         {
         }
 
         QPointer<qml::Observer> observer;
-        DispatcherWithContext<Observer>* dispatcher;
+        std::shared_ptr<const std::atomic<bool>> progress_wanted;
     };
 
     /// @brief TypedOperation initializes a new instance with the given impl and parent.
@@ -56,6 +56,10 @@ std::uint32_t& template_counter()
     return instance;
 }
 
+// Removing the template with this id fails halfway through, giving clients a failing
+// operation to test against. Enrolled templates never end up with it, see template_counter().
+constexpr const biometry::TemplateStore::TemplateId failing_template_id{std::uint64_t{1} << 32};
+
 // We enable testing of projects using the QML bindings by providing an environment
 // variable BIOMETRYD_QML_ENABLE_TESTING. If the variable is set to "1", we install a testing
 // stack emulating the multi-threaded/async behavior of the production system within the test
@@ -262,6 +266,12 @@ struct Removal : public biometry::Operation<biometry::TemplateStore::Removal>,
                     return;
                 }
 
+                if (i > 50 && id == failing_template_id)
+                {
+                    observer->on_failed("Unknown template");
+                    return;
+                }
+
                 observer->on_progress(biometry::Progress{biometry::Percent::from_raw_value(i/100.f), biometry::Dictionary{}});
                 std::this_thread::sleep_for(std::chrono::milliseconds{15});
             }
@@ -410,22 +420,25 @@ void biometry::qml::Plugin::registerTypes(const char *uri)
                 uri, Plugin::major, Plugin::minor, "Biometryd",
                 [](QQmlEngine*, QJSEngine*) -> QObject*
                 {
-                    biometry::qml::Service* result{nullptr};
-
-                    // Trying to create a stub will reach out over the bus to the remote end.
-                    // If the remote service is not available, the function throws and we fall back
-                    // to a testing implementation again.
-                    try
+                    // Creating a stub reaches out over the bus to the remote end. We do so in
+                    // the background, keeping the engine responsive if the daemon is slow to come up.
+                    // If the remote service is not available, we fall back to a testing implementation
+                    // if requested to do so. Until then, and if discovery fails, QML code keeps on
+                    // seeing an unavailable testing device.
+                    return new biometry::qml::Service{[]()
                     {
-                        result = new biometry::qml::Service{biometry::dbus::Service::create_stub()};
-                    }
-                    catch(...)
-                    {
-                        result = new biometry::qml::Service{std::make_shared<for_testing::Service>()};
-                        result->setAvailable(qgetenv("BIOMETRYD_QML_ENABLE_TESTING") == QByteArray{"1"});
-                    }
-
-                    return result;
+                        try
+                        {
+                            return biometry::dbus::Service::create_stub()->default_device();
+                        }
+                        catch(...)
+                        {
+                            if (qgetenv("BIOMETRYD_QML_ENABLE_TESTING") != QByteArray{"1"})
+                                throw;
+                        }
+
+                        return for_testing::Service{}.default_device();
+                    }, std::make_shared<for_testing::Device>()};
                 });
 
     qmlRegisterSingletonType<biometry::qml::FingerprintReader>(uri, Plugin::major, Plugin::minor, "FingerprintReader", [](QQmlEngine*, QJSEngine*) -> QObject*
@@ -20,9 +20,19 @@
 #include <biometry/qml/Biometryd/service.h>
 #include <biometry/qml/Biometryd/device.h>
 
-#include <biometry/dbus/service.h>
+#include <QDebug>
+#include <QMetaObject>
 
-#include <QCoreApplication>
+#include <mutex>
+#include <thread>
+
+struct biometry::qml::Service::PendingDiscovery
+{
+    std::mutex guard;
+    // The instance waiting for the result, reset to nullptr if it goes away early.
+    biometry::qml::Service* owner;
+    std::shared_ptr<biometry::Device> device;
+};
 
 biometry::qml::Device* biometry::qml::Service::defaultDevice() const
 {
@@ -42,10 +52,73 @@ void biometry::qml::Service::setAvailable(bool available)
     Q_EMIT(availableChanged(available_ = available));
 }
 
+bool biometry::qml::Service::isReady() const
+{
+    return ready_;
+}
+
+void biometry::qml::Service::onDiscoveryFinished()
+{
+    std::shared_ptr<biometry::Device> device;
+    {
+        std::lock_guard<std::mutex> lg{pending_->guard};
+        device = std::move(pending_->device);
+    }
+
+    // A placeholder is kept around, QML code might still refer to it.
+    if (device)
+    {
+        defaultDevice_ = new Device{device, this};
+        Q_EMIT(defaultDeviceChanged());
+    }
+
+    setAvailable(static_cast<bool>(device));
+    Q_EMIT(readyChanged(ready_ = true));
+}
+
 biometry::qml::Service::Service(const std::shared_ptr<biometry::Service>& impl, QObject* parent)
+    : Service{[impl]() { return impl->default_device(); }, nullptr, parent}
+{
+}
+
+biometry::qml::Service::Service(const Discovery& discovery, const std::shared_ptr<biometry::Device>& placeholder, QObject* parent)
     : QObject{parent},
-      available_{true},
-      impl_{impl},
-      defaultDevice_{new Device{impl->default_device(), this}}
+      available_{false},
+      ready_{false},
+      pending_{std::make_shared<PendingDiscovery>()},
+      defaultDevice_{placeholder ? new Device{placeholder, this} : nullptr}
+{
+    pending_->owner = this;
+
+    // The thread only refers to the shared discovery state and is thus
+    // safe to outlive this instance.
+    std::thread{[discovery, pending = pending_]()
+    {
+        std::shared_ptr<biometry::Device> device;
+
+        try
+        {
+            device = discovery();
+        }
+        catch (const std::exception& e)
+        {
+            qWarning() << "Failed to discover default device:" << e.what();
+        }
+        catch (...)
+        {
+            qWarning() << "Failed to discover default device.";
+        }
+
+        std::lock_guard<std::mutex> lg{pending->guard};
+        pending->device = device;
+
+        if (pending->owner)
+            QMetaObject::invokeMethod(pending->owner, "onDiscoveryFinished", Qt::QueuedConnection);
+    }}.detach();
+}
+
+biometry::qml::Service::~Service()
 {
+    std::lock_guard<std::mutex> lg{pending_->guard};
+    pending_->owner = nullptr;
 }
@@ -25,6 +25,9 @@
 
 #include <QObject>
 
+#include <functional>
+#include <memory>
+
 namespace biometry
 {
 namespace qml
@@ -34,16 +37,38 @@ class Device;
 /// @endcond
 
 /// @brief Service provides a single point of entry for accessing a biometry::Service instance.
+///
+/// The default device is discovered asynchronously, keeping the thread creating the instance
+/// responsive if the remote service is slow to answer or not running at all. ready becomes true
+/// once discovery has finished, available tells whether a default device has been found. Until
+/// then, or if discovery fails, defaultDevice refers to an unavailable placeholder.
 class BIOMETRY_DLL_PUBLIC Service : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(bool available READ isAvailable NOTIFY availableChanged)
-    Q_PROPERTY(biometry::qml::Device* defaultDevice READ defaultDevice CONSTANT)
+    Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
+    Q_PROPERTY(biometry::qml::Device* defaultDevice READ defaultDevice NOTIFY defaultDeviceChanged)
 public:
-    /// @brief Service initializes a new instance with impl and parent.
+    /// @brief Discovery yields the default device, throwing if it cannot be reached.
+    ///
+    /// Discovery is invoked on a background thread.
+    typedef std::function<std::shared_ptr<biometry::Device>()> Discovery;
+
+    /// @brief Service initializes a new instance with impl and parent, discovering the default device of impl.
     Service(const std::shared_ptr<biometry::Service>& impl, QObject* parent = nullptr);
 
+    /// @brief Service initializes a new instance with parent, running discovery in the background.
+    ///
+    /// defaultDevice refers to placeholder until discovery yields a device.
+    Service(const Discovery& discovery, const std::shared_ptr<biometry::Device>& placeholder, QObject* parent = nullptr);
+
+    /// @brief ~Service detaches the instance from a discovery that is still in flight.
+    ~Service();
+
     /// @brief defaultDevice returns the default Device instance that should be used for identification.
+    ///
+    /// Returns the placeholder handed in on construction until the service is ready, or if no
+    /// default device has been found. The placeholder is never available.
     Q_INVOKABLE biometry::qml::Device* defaultDevice() const;
 
     /// @brief isAvailable returns true if the service is available.
@@ -52,12 +77,29 @@ public:
     /// @brief setAavailable adjusts the value of available to value.
     Q_INVOKABLE void setAvailable(bool available);
 
+    /// @brief isReady returns true if discovery of the default device has finished.
+    Q_INVOKABLE bool isReady() const;
+
     /// @brief availableChanged is emitted with the new value of available.
     Q_SIGNAL void availableChanged(bool);
 
+    /// @brief readyChanged is emitted with the new value of ready.
+    Q_SIGNAL void readyChanged(bool);
+
+    /// @brief defaultDeviceChanged is emitted when the default device has been discovered.
+    Q_SIGNAL void defaultDeviceChanged();
+
 private:
+    /// @cond
+    struct PendingDiscovery;
+    /// @endcond
+
+    /// @brief onDiscoveryFinished picks up the result of the pending discovery on the thread of this instance.
+    Q_SLOT void onDiscoveryFinished();
+
     bool available_;
-    std::shared_ptr<biometry::Service> impl_;
+    bool ready_;
+    std::shared_ptr<PendingDiscovery> pending_;
     biometry::qml::Device* defaultDevice_;
 };
 }
@@ -18,51 +18,169 @@
  */
 #include <biometry/runtime.h>
 
-#include <iostream>
+#include <biometry/util/logging.h>
+#include <biometry/util/metrics.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 namespace
 {
-// exception_safe_run runs service, catching all exceptions and
-// restarting operation until an explicit shutdown has been requested.
-//
-// TODO(tvoss): Catching all exceptions is risky as they might signal unrecoverable
-// errors. We should enable calling code to decide whether an exception should be considered
-// fatal or not.
-void exception_safe_run(boost::asio::io_service& service)
+typedef std::chrono::steady_clock Clock;
+
+std::int64_t now_in_nanoseconds()
 {
-    while (true)
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// restart prepares service for running again after it has been stopped.
+void restart(boost::asio::io_service& service)
+{
+#if BOOST_VERSION >= 106600
+    service.restart();
+#else
+    service.reset();
+#endif
+}
+
+const char* name(biometry::Runtime::Supervision::ExceptionAction action)
+{
+    switch (action)
     {
-        try
-        {
-            service.run();
-            // a clean return from run only happens in case of
-            // stop() being called (we are keeping the service alive with
-            // a service::work instance).
-            break;
-        }
-        catch (const std::exception& e)
-        {
-            std::cerr << e.what();
-        }
-        catch (...)
-        {
-            std::cerr << "Unknown exception caught while executing boost::asio::io_service";
-        }
+    case biometry::Runtime::Supervision::ExceptionAction::retry: return "retry";
+    case biometry::Runtime::Supervision::ExceptionAction::fatal: return "fatal";
     }
+
+    return "unknown";
+}
 }
+
+struct biometry::Runtime::LaneState
+{
+    LaneState(Lane lane, const LaneConfiguration& configuration)
+        : lane{lane},
+          configuration(configuration),
+          service{static_cast<int>(configuration.threads)},
+          strand{service},
+          keep_alive{service}
+    {
+    }
+
+    Lane lane;
+    LaneConfiguration configuration;
+    boost::asio::io_service service;
+    boost::asio::io_service::strand strand;
+    boost::asio::io_service::work keep_alive;
+    bool suspended{false};
+};
+
+struct biometry::Runtime::Worker
+{
+    Worker(Lane lane, std::uint32_t index)
+        : lane{lane},
+          index{index},
+          busy(biometry::util::metrics().gauge("runtime_worker_busy_us", {{"lane", name(lane)}, {"worker", std::to_string(index)}})),
+          handler_duration(biometry::util::metrics().histogram("runtime_handler_duration_us", {{"lane", name(lane)}}))
+    {
+    }
+
+    Lane lane;
+    std::uint32_t index;
+    std::thread thread;
+    // Start of the handler being executed in nanoseconds on the steady clock, 0 while idle.
+    std::atomic<std::int64_t> busy_since{0};
+    // Number of handlers started, identifies the handler being executed.
+    std::atomic<std::uint64_t> handlers{0};
+    // The handler most recently reported as slow, only accessed by the watchdog.
+    std::uint64_t reported{0};
+    // Backoff state, only accessed by the worker thread.
+    std::chrono::milliseconds backoff{0};
+    Clock::time_point resumed;
+
+    biometry::util::Metrics::Gauge& busy;
+    biometry::util::Metrics::Histogram& handler_duration;
+};
+
+thread_local biometry::Runtime::Worker* biometry::Runtime::current_worker_{nullptr};
+
+biometry::Runtime::Supervision::ExceptionPolicy biometry::Runtime::Supervision::retry_all()
+{
+    return [](const std::exception_ptr&) { return ExceptionAction::retry; };
+}
+
+biometry::Runtime::Supervision::ExceptionPolicy biometry::Runtime::Supervision::fatal_all()
+{
+    return [](const std::exception_ptr&) { return ExceptionAction::fatal; };
+}
+
+biometry::Runtime::Watch::Watch() : worker{current_worker_}
+{
+    // Only the outermost Watch on a worker accounts for the handler.
+    if (worker && worker->busy_since.load(std::memory_order_relaxed) != 0)
+        worker = nullptr;
+
+    if (worker)
+    {
+        worker->handlers.fetch_add(1, std::memory_order_relaxed);
+        worker->busy_since.store(now_in_nanoseconds(), std::memory_order_relaxed);
+    }
+}
+
+biometry::Runtime::Watch::~Watch()
+{
+    if (not worker)
+        return;
+
+    auto since = worker->busy_since.exchange(0, std::memory_order_relaxed);
+    worker->handler_duration.observe(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds{now_in_nanoseconds() - since}));
+}
+
+const char* biometry::Runtime::name(Lane lane)
+{
+    switch (lane)
+    {
+    case Lane::bus: return "bus";
+    case Lane::device: return "device";
+    case Lane::background: return "background";
+    }
+
+    return "unknown";
 }
 
 std::shared_ptr<biometry::Runtime> biometry::Runtime::create(std::uint32_t pool_size)
 {
-    return std::shared_ptr<biometry::Runtime>(new biometry::Runtime(pool_size));
+    return create(pool_size, Supervision{});
 }
 
-biometry::Runtime::Runtime(std::uint32_t pool_size)
-    : pool_size_{pool_size},
-      service_{pool_size_},
-      strand_{service_},
-      keep_alive_{service_}
+std::shared_ptr<biometry::Runtime> biometry::Runtime::create(std::uint32_t pool_size, const Supervision& supervision)
 {
+    Lanes lanes;
+    lanes.bus.threads = pool_size;
+    return create(lanes, supervision);
+}
+
+std::shared_ptr<biometry::Runtime> biometry::Runtime::create(const Lanes& lanes, const Supervision& supervision)
+{
+    return std::shared_ptr<biometry::Runtime>(new biometry::Runtime(lanes, supervision));
+}
+
+biometry::Runtime::Runtime(const Lanes& lanes, const Supervision& supervision)
+    : supervision_(supervision)
+{
+    // The bus lane is always set up, other lanes fall back to it.
+    lanes_[static_cast<std::size_t>(Lane::bus)].reset(new LaneState{Lane::bus, lanes.bus});
+
+    if (lanes.device.threads > 0)
+        lanes_[static_cast<std::size_t>(Lane::device)].reset(new LaneState{Lane::device, lanes.device});
+    if (lanes.background.threads > 0)
+        lanes_[static_cast<std::size_t>(Lane::background)].reset(new LaneState{Lane::background, lanes.background});
 }
 
 biometry::Runtime::~Runtime()
@@ -78,31 +196,246 @@ biometry::Runtime::~Runtime()
 
 void biometry::Runtime::start()
 {
-    for (unsigned int i = 0; i < pool_size_; i++)
-        workers_.push_back(std::thread{exception_safe_run, std::ref(service_)});
+    std::lock_guard<std::mutex> lg{lifecycle_};
+
+    // Starting twice would leave the worker threads of the first start behind.
+    if (running_)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lg{guard_};
+        stopping_ = false;
+    }
+
+    for (auto& lane : lanes_)
+    {
+        if (not lane)
+            continue;
+
+        // A previous stop leaves the service in the stopped state.
+        ::restart(lane->service);
+        lane->suspended = false;
+        spawn(*lane);
+    }
+
+    watchdog_ = std::thread{[this]() { watch(); }};
+    running_ = true;
 }
 
 void biometry::Runtime::stop()
 {
-    service_.stop();
+    std::lock_guard<std::mutex> lg{lifecycle_};
+
+    if (not running_)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lg{guard_};
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+
+    for (auto& lane : lanes_)
+        if (lane)
+            lane->service.stop();
 
     for (auto& worker : workers_)
-        if (worker.joinable())
-            worker.join();
+        if (worker->thread.joinable())
+            worker->thread.join();
+
+    if (watchdog_.joinable())
+        watchdog_.join();
+
+    workers_.clear();
+    running_ = false;
+}
+
+void biometry::Runtime::suspend(Lane lane)
+{
+    std::lock_guard<std::mutex> lg{lifecycle_};
+
+    auto& state = lanes_[static_cast<std::size_t>(lane)];
+    if (not running_ || not state || state->suspended)
+        return;
+
+    if (current_worker_ && current_worker_->lane == lane)
+        throw std::logic_error{std::string{"Cannot suspend the "} + name(lane) + " lane from one of its workers"};
+
+    state->service.stop();
+
+    std::vector<std::shared_ptr<Worker>> suspended;
+    {
+        std::lock_guard<std::mutex> lg{guard_};
+        auto it = std::stable_partition(workers_.begin(), workers_.end(), [lane](const std::shared_ptr<Worker>& worker) { return worker->lane != lane; });
+        suspended.assign(it, workers_.end());
+        workers_.erase(it, workers_.end());
+    }
+
+    // Workers backing off wait for guard_, we must not hold it while joining.
+    for (auto& worker : suspended)
+        if (worker->thread.joinable())
+            worker->thread.join();
+
+    // Handlers posted from now on are queued until the lane is resumed.
+    ::restart(state->service);
+    state->suspended = true;
+}
+
+void biometry::Runtime::resume(Lane lane)
+{
+    std::lock_guard<std::mutex> lg{lifecycle_};
+
+    auto& state = lanes_[static_cast<std::size_t>(lane)];
+    if (not running_ || not state || not state->suspended)
+        return;
+
+    state->suspended = false;
+    spawn(*state);
 }
 
-std::function<void(std::function<void()>)> biometry::Runtime::to_dispatcher_functional()
+std::function<void(biometry::util::UniqueFunction<void()>)> biometry::Runtime::to_dispatcher_functional()
 {
     // We have to make sure that we stay alive for as long as
     // calling code requires the dispatcher to work.
     auto sp = shared_from_this();
-    return [sp](std::function<void()> task)
+    return [sp](biometry::util::UniqueFunction<void()> task)
     {
-        sp->strand_.post(task);
+        post_to_strand(sp->state_for(Lane::bus).strand, [task = std::move(task)]() mutable
+        {
+            Watch watch;
+            task();
+        });
     };
 }
 
 boost::asio::io_service& biometry::Runtime::service()
 {
-    return service_;
+    return service(Lane::bus);
+}
+
+boost::asio::io_service& biometry::Runtime::service(Lane lane)
+{
+    return state_for(lane).service;
+}
+
+biometry::Runtime::LaneState& biometry::Runtime::state_for(Lane lane)
+{
+    auto& state = lanes_[static_cast<std::size_t>(lane)];
+    return state ? *state : *lanes_[static_cast<std::size_t>(Lane::bus)];
+}
+
+void biometry::Runtime::spawn(LaneState& lane)
+{
+    for (std::uint32_t i = 0; i < lane.configuration.threads; i++)
+    {
+        auto worker = std::make_shared<Worker>(lane.lane, i);
+        {
+            std::lock_guard<std::mutex> lg{guard_};
+            workers_.push_back(worker);
+        }
+        worker->thread = std::thread{[this, l = &lane, worker]() { run(*l, *worker); }};
+    }
+}
+
+void biometry::Runtime::run(LaneState& lane, Worker& worker)
+{
+    current_worker_ = &worker;
+
+    // Priorities apply to individual threads on Linux. Raising the priority
+    // requires CAP_SYS_NICE, and we keep on running with the default otherwise.
+    if (lane.configuration.nice != 0 &&
+        ::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), lane.configuration.nice) != 0)
+    {
+        biometry::util::logging::warning("Failed to set nice value %d for %s lane: %s",
+                                         lane.configuration.nice, name(lane.lane), std::strerror(errno));
+    }
+
+    while (true)
+    {
+        try
+        {
+            lane.service.run();
+            // a clean return from run only happens in case of
+            // stop() being called (we are keeping the service alive with
+            // a service::work instance).
+            break;
+        }
+        catch (const std::exception& e)
+        {
+            biometry::util::logging::error("%s", e.what());
+            if (not back_off(worker, std::current_exception()))
+                break;
+        }
+        catch (...)
+        {
+            biometry::util::logging::error("Unknown exception caught while executing boost::asio::io_service");
+            if (not back_off(worker, std::current_exception()))
+                break;
+        }
+    }
+
+    current_worker_ = nullptr;
+}
+
+bool biometry::Runtime::back_off(Worker& worker, const std::exception_ptr& e)
+{
+    auto action = supervision_.exception_policy(e);
+    biometry::util::metrics().counter("runtime_handler_exceptions_total", {{"action", ::name(action)}}).increment();
+
+    if (action == Supervision::ExceptionAction::fatal)
+    {
+        biometry::util::logging::error("Exception considered fatal, terminating");
+        biometry::util::logging::flush();
+        std::terminate();
+    }
+
+    // Exceptions in quick succession point to a poisoned handler. We back off
+    // exponentially, keeping the worker from spinning on the handler, and start
+    // over once the worker has been running smoothly for max_backoff.
+    worker.backoff = worker.backoff.count() == 0 || Clock::now() - worker.resumed > supervision_.max_backoff ?
+        supervision_.min_backoff :
+        std::min(worker.backoff * 2, supervision_.max_backoff);
+
+    std::unique_lock<std::mutex> ul{guard_};
+    auto stopping = wakeup_.wait_for(ul, worker.backoff, [this]() { return stopping_; });
+    worker.resumed = Clock::now();
+    return not stopping;
+}
+
+void biometry::Runtime::watch()
+{
+    auto& slow_handlers = biometry::util::metrics().counter("runtime_slow_handlers_total");
+    auto& stuck_workers = biometry::util::metrics().gauge("runtime_stuck_workers");
+    auto threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(supervision_.slow_handler_threshold).count();
+
+    std::unique_lock<std::mutex> ul{guard_};
+
+    while (not wakeup_.wait_for(ul, supervision_.watchdog_interval, [this]() { return stopping_; }))
+    {
+        auto now = now_in_nanoseconds();
+        std::int64_t stuck{0};
+
+        for (auto& worker : workers_)
+        {
+            auto since = worker->busy_since.load(std::memory_order_relaxed);
+            auto busy = since == 0 ? 0 : now - since;
+            worker->busy.set(busy / 1000);
+
+            if (busy < threshold)
+                continue;
+
+            stuck++;
+
+            auto handler = worker->handlers.load(std::memory_order_relaxed);
+            if (handler == worker->reported)
+                continue;
+
+            worker->reported = handler;
+            slow_handlers.increment();
+            biometry::util::logging::warning("Worker %u of %s lane has been executing a handler for %lld ms",
+                                             worker->index, name(worker->lane), static_cast<long long>(busy / 1000000));
+        }
+
+        stuck_workers.set(stuck);
+    }
 }
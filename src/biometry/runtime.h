@@ -21,11 +21,19 @@
 #define BIOMETRYD_RUNTIME_H_
 
 #include <biometry/visibility.h>
+#include <biometry/util/unique_function.h>
 
 #include <boost/asio.hpp>
+#include <boost/version.hpp>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -33,18 +41,130 @@
 
 namespace biometry
 {
+// post_to_strand hands task over to strand for execution. Tasks are moved all the
+// way through the executor-based interface of asio 1.66 and later. Older versions
+// require handlers to be CopyConstructible, and we fall back to sharing the task.
+template<typename Task>
+void post_to_strand(boost::asio::io_service::strand& strand, Task&& task)
+{
+#if BOOST_VERSION >= 106600
+    boost::asio::post(strand, std::move(task));
+#else
+    auto shared = std::make_shared<typename std::decay<Task>::type>(std::move(task));
+    strand.post([shared]() { (*shared)(); });
+#endif
+}
+
 // We bundle our "global" runtime dependencies here, specifically
 // a dispatcher to decouple multiple in-process providers from one
 // another , forcing execution to a well known set of threads.
+//
+// Work is split across lanes, each of them an io_service executed by its
+// own set of threads. A handler blocking on the hardware thus does not
+// delay bus I/O or background work.
+//
+// Worker threads are supervised: exceptions escaping handlers are subject
+// to an ExceptionPolicy, and a watchdog thread reports handlers that keep
+// a worker busy for longer than a threshold.
 class BIOMETRY_DLL_PUBLIC Runtime : public std::enable_shared_from_this<Runtime>
 {
+    // Worker bundles a worker thread with the state inspected by the watchdog.
+    struct Worker;
+    // LaneState bundles the io_service of a lane with the workers executing it.
+    struct LaneState;
+
 public:
     // Our default concurrency setup.
     static constexpr const std::uint32_t worker_threads = 2;
 
+    // Lane enumerates the io_services executed by a Runtime.
+    enum class Lane
+    {
+        bus,        // Low-latency lane for bus I/O, including cancels and replies to observers.
+        device,     // Device control, with handlers potentially blocking on the hardware.
+        background  // Background work, e.g., idle timers or watching configuration files.
+    };
+
+    // name returns the name of lane, e.g., for labeling metrics.
+    static const char* name(Lane lane);
+
+    // LaneConfiguration configures the worker threads executing a lane.
+    struct LaneConfiguration
+    {
+        // Number of worker threads, a lane without threads is served by the bus lane.
+        std::uint32_t threads;
+        // Nice value applied to the worker threads, lower values result in a higher priority.
+        int nice;
+    };
+
+    // Lanes configures all lanes of a Runtime. By default, all work is executed
+    // on the bus lane.
+    struct Lanes
+    {
+        LaneConfiguration bus{worker_threads, 0};
+        LaneConfiguration device{0, 0};
+        LaneConfiguration background{0, 0};
+    };
+
+    // Supervision configures how the Runtime reacts to misbehaving handlers.
+    struct Supervision
+    {
+        // ExceptionAction enumerates the reactions to an exception escaping a handler.
+        enum class ExceptionAction
+        {
+            retry, // Log the exception and resume the worker after backing off.
+            fatal  // Log the exception and terminate the process.
+        };
+
+        // ExceptionPolicy decides how to react to the exception caught from a handler.
+        typedef std::function<ExceptionAction(const std::exception_ptr&)> ExceptionPolicy;
+
+        // retry_all returns an ExceptionPolicy that resumes workers for all exceptions.
+        static ExceptionPolicy retry_all();
+        // fatal_all returns an ExceptionPolicy that terminates the process for all exceptions.
+        static ExceptionPolicy fatal_all();
+
+        // exception_policy is consulted for every exception escaping a handler.
+        ExceptionPolicy exception_policy = retry_all();
+        // Workers back off for min_backoff after an exception, doubling up to max_backoff
+        // for exceptions in quick succession, e.g., caused by a poisoned handler.
+        std::chrono::milliseconds min_backoff{10};
+        std::chrono::milliseconds max_backoff{1000};
+        // Handlers running for longer than slow_handler_threshold are reported.
+        std::chrono::milliseconds slow_handler_threshold{500};
+        // The watchdog inspects workers every watchdog_interval.
+        std::chrono::milliseconds watchdog_interval{100};
+    };
+
+    // Watch marks the calling worker busy for its lifetime, making the handler
+    // it is executing visible to the watchdog. Does nothing if called from a thread
+    // that is not a worker of a Runtime.
+    //
+    // Only tasks handed to dispatchers created for a Runtime and to
+    // to_dispatcher_functional are watched. Handlers posted to a service directly,
+    // e.g., the ones core::dbus executes for incoming messages on the bus lane, are
+    // not visible to the watchdog, but still account for the busy time of a worker.
+    class BIOMETRY_DLL_PUBLIC Watch
+    {
+    public:
+        Watch();
+        Watch(const Watch&) = delete;
+        ~Watch();
+        Watch& operator=(const Watch&) = delete;
+
+    private:
+        Worker* worker;
+    };
+
     // create returns a Runtime instance with pool_size worker threads
-    // executing the underlying service.
+    // executing the bus lane, supervised with default settings.
     static std::shared_ptr<Runtime> create(std::uint32_t pool_size = worker_threads);
+    // create returns a Runtime instance with pool_size worker threads
+    // executing the bus lane, supervised according to supervision.
+    static std::shared_ptr<Runtime> create(std::uint32_t pool_size, const Supervision& supervision);
+    // create returns a Runtime instance executing lanes as configured,
+    // supervised according to supervision.
+    static std::shared_ptr<Runtime> create(const Lanes& lanes, const Supervision& supervision);
 
     Runtime(const Runtime&) = delete;
     Runtime(Runtime&&) = delete;
@@ -53,32 +173,70 @@ public:
     Runtime& operator=(const Runtime&) = delete;
     Runtime& operator=(Runtime&&) = delete;
 
-    // start executes the underlying io_service on a thread pool with
-    // the size configured at creation time.
+    // start executes the io_service of every lane on a thread pool with
+    // the size configured at creation time, and starts the watchdog.
+    // Does nothing if the Runtime is running already. A stopped Runtime
+    // can be started again, handlers posted in the meantime are executed then.
     void start();
 
     // stop cleanly shuts down a Runtime instance,
-    // joining all worker threads.
+    // joining all worker threads and the watchdog.
+    // Does nothing if the Runtime is not running.
     void stop();
 
+    // suspend joins the worker threads of lane, e.g., to release resources while idle.
+    // Handlers posted to the lane in the meantime are queued until resume is called.
+    // Does nothing for lanes served by the bus lane, for lanes suspended already and
+    // if the Runtime is not running. Throws std::logic_error if called from a worker of lane.
+    void suspend(Lane lane);
+
+    // resume starts the worker threads of a lane suspended before.
+    void resume(Lane lane);
+
     // to_dispatcher_functional returns a function for integration
-    // with components that expect a dispatcher for operation.
-    std::function<void(std::function<void()>)> to_dispatcher_functional();
+    // with components that expect a dispatcher for operation. Tasks
+    // are executed in order on the bus lane and watched while executing.
+    std::function<void(util::UniqueFunction<void()>)> to_dispatcher_functional();
 
-    // service returns the underlying boost::asio::io_service that is executed
-    // by the Runtime.
+    // service returns the boost::asio::io_service of the bus lane.
     boost::asio::io_service& service();
 
+    // service returns the boost::asio::io_service executing lane, falling
+    // back to the bus lane if lane has not been configured with threads.
+    boost::asio::io_service& service(Lane lane);
+
 private:
-    // Runtime constructs a new instance, firing up pool_size
-    // worker threads.
-    Runtime(std::uint32_t pool_size);
-
-    std::uint32_t pool_size_;
-    boost::asio::io_service service_;
-    boost::asio::io_service::strand strand_;
-    boost::asio::io_service::work keep_alive_;
-    std::vector<std::thread> workers_;
+    // Runtime constructs a new instance, setting up all lanes
+    // configured with threads.
+    Runtime(const Lanes& lanes, const Supervision& supervision);
+
+    // state_for returns the state executing lane, falling back to the bus lane.
+    LaneState& state_for(Lane lane);
+
+    // spawn starts the worker threads of lane, the caller has to hold lifecycle_.
+    void spawn(LaneState& lane);
+
+    // run executes the service of lane on the calling thread until the Runtime is stopped.
+    void run(LaneState& lane, Worker& worker);
+    // back_off handles the exception e caught by worker, returning false if the worker should exit.
+    bool back_off(Worker& worker, const std::exception_ptr& e);
+    // watch periodically inspects all workers until the Runtime is stopped.
+    void watch();
+
+    // The worker executing on the calling thread, if any.
+    static thread_local Worker* current_worker_;
+
+    Supervision supervision_;
+    // Indexed by Lane, lanes without threads are not set up.
+    std::array<std::unique_ptr<LaneState>, 3> lanes_;
+    std::vector<std::shared_ptr<Worker>> workers_;
+    std::thread watchdog_;
+    // Serializes start, stop, suspend and resume.
+    std::mutex lifecycle_;
+    bool running_{false};
+    std::mutex guard_;
+    std::condition_variable wakeup_;
+    bool stopping_{false};
 };
 }
 
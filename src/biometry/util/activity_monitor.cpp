@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/util/activity_monitor.h>
+
+biometry::util::ActivityMonitor::Ptr biometry::util::ActivityMonitor::create(
+        boost::asio::io_service& service,
+        const std::chrono::milliseconds& timeout,
+        const std::function<void()>& on_idle,
+        const std::function<void()>& on_busy)
+{
+    Ptr sp{new ActivityMonitor{service, timeout, on_idle, on_busy}};
+
+    std::lock_guard<std::mutex> lg{sp->guard};
+    sp->arm_locked();
+
+    return sp;
+}
+
+biometry::util::ActivityMonitor::Activity biometry::util::ActivityMonitor::begin()
+{
+    bool woken{false};
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        ++ongoing;
+        ++generation;
+        timer.cancel();
+        woken = idle;
+    }
+
+    if (woken)
+        wake_up();
+
+    auto sp = shared_from_this();
+    return Activity{nullptr, [sp](void*) { sp->end(); }};
+}
+
+void biometry::util::ActivityMonitor::touch()
+{
+    bool woken{false};
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (ongoing == 0)
+            arm_locked();
+
+        woken = idle;
+    }
+
+    if (woken)
+        wake_up();
+}
+
+biometry::util::ActivityMonitor::ActivityMonitor(
+        boost::asio::io_service& service,
+        const std::chrono::milliseconds& timeout,
+        const std::function<void()>& on_idle,
+        const std::function<void()>& on_busy)
+    : timer{service},
+      timeout{timeout},
+      on_idle{on_idle},
+      on_busy{on_busy}
+{
+}
+
+void biometry::util::ActivityMonitor::end()
+{
+    std::lock_guard<std::mutex> lg{guard};
+
+    if (--ongoing == 0)
+        arm_locked();
+}
+
+void biometry::util::ActivityMonitor::wake_up()
+{
+    std::lock_guard<std::mutex> tl{transition};
+
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        if (not idle)
+            return;
+
+        idle = false;
+    }
+
+    if (on_busy)
+        on_busy();
+}
+
+void biometry::util::ActivityMonitor::arm_locked()
+{
+    auto current = ++generation;
+
+    timer.expires_from_now(timeout);
+
+    std::weak_ptr<ActivityMonitor> wp{shared_from_this()};
+    timer.async_wait([wp, current](const boost::system::error_code& ec)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+            return;
+
+        auto sp = wp.lock();
+        if (not sp)
+            return;
+
+        std::lock_guard<std::mutex> tl{sp->transition};
+
+        {
+            std::lock_guard<std::mutex> lg{sp->guard};
+            // Activity might have begun after the timer expired, but before we got here.
+            if (current != sp->generation)
+                return;
+
+            sp->idle = true;
+        }
+
+        sp->on_idle();
+    });
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef BIOMETRY_UTIL_ACTIVITY_MONITOR_H_
+#define BIOMETRY_UTIL_ACTIVITY_MONITOR_H_
+
+#include <biometry/do_not_copy_or_move.h>
+#include <biometry/visibility.h>
+
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief ActivityMonitor reports a component to be idle if no activity has
+/// been observed for a configurable amount of time.
+///
+/// Monitoring is event-driven: a single timer is armed on the given io_service
+/// whenever the last ongoing activity finishes, and disarmed if a new one begins.
+class BIOMETRY_DLL_PUBLIC ActivityMonitor : public DoNotCopyOrMove, public std::enable_shared_from_this<ActivityMonitor>
+{
+public:
+    // Safe us some typing.
+    typedef std::shared_ptr<ActivityMonitor> Ptr;
+
+    /// @brief Activity is an opaque token, the monitored component is busy for as long as any token is alive.
+    typedef std::shared_ptr<void> Activity;
+
+    /// @brief create returns a new instance invoking on_idle on service after being idle for timeout.
+    ///
+    /// The timer is armed right away, a component that never sees any activity becomes idle, too.
+    /// If given, on_busy is invoked by the first call to begin or touch after on_idle, and both
+    /// calls only return once on_busy has returned. on_idle and on_busy are never invoked
+    /// concurrently and strictly alternate.
+    static Ptr create(boost::asio::io_service& service, const std::chrono::milliseconds& timeout, const std::function<void()>& on_idle,
+                      const std::function<void()>& on_busy = std::function<void()>{});
+
+    /// @brief begin marks the start of an activity that lasts until the returned token is released.
+    Activity begin();
+
+    /// @brief touch notes a short-lived activity, restarting the idle countdown if nothing else is going on.
+    void touch();
+
+private:
+    /// @brief ActivityMonitor initializes a new instance.
+    ActivityMonitor(boost::asio::io_service& service, const std::chrono::milliseconds& timeout, const std::function<void()>& on_idle,
+                    const std::function<void()>& on_busy);
+
+    /// @brief end marks the end of an activity.
+    void end();
+
+    /// @brief wake_up invokes on_busy if nobody else did since on_idle.
+    void wake_up();
+
+    /// @brief arm_locked restarts the idle countdown, the caller has to hold guard.
+    void arm_locked();
+
+    // Serializes invocations of on_idle and on_busy, acquired before guard.
+    std::mutex transition;
+    std::mutex guard;
+    boost::asio::steady_timer timer;
+    std::chrono::milliseconds timeout;
+    std::function<void()> on_idle;
+    std::function<void()> on_busy;
+    std::uint32_t ongoing{0};
+    // Set once on_idle has been invoked, until on_busy has been invoked.
+    bool idle{false};
+    // Incremented whenever the countdown is restarted or disarmed, telling
+    // stale expirations apart from the current one.
+    std::uint64_t generation{0};
+};
+}
+}
+
+#endif // BIOMETRY_UTIL_ACTIVITY_MONITOR_H_
@@ -0,0 +1,412 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/util/binary_configuration_builder.h>
+
+#include <biometry/util/json_configuration_builder.h>
+#include <biometry/util/streaming_configuration_builder.h>
+
+#include <boost/format.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+constexpr const char magic[8] = {'B', 'I', 'O', 'C', 'O', 'N', 'F', '\0'};
+constexpr const std::uint32_t version = 2;
+constexpr const std::uint32_t byte_order = 0x01020304;
+
+// Header is placed at the beginning of every binary configuration file.
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t source_size;
+    std::int64_t source_modified;
+};
+
+// Nodes are stored in pre-order, each of them as a tag:u8 followed by:
+//   none: -, boolean: u8, integer: i64, floating_point: f64, string: length:u32 data:u8[length],
+//   object: count:u32 (name_length:u32 name:u8[name_length] node)[count],
+//   array: count:u32 node[count]
+// The root node is stored as an object.
+enum class Tag : std::uint8_t
+{
+    none,
+    boolean,
+    integer,
+    floating_point,
+    string,
+    object,
+    array
+};
+
+// MappedFile maps a file read-only into memory.
+class MappedFile
+{
+public:
+    explicit MappedFile(const fs::path& path)
+    {
+        auto fd = ::open(path.string().c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::system_error{errno, std::system_category(), "Failed to open " + path.string()};
+
+        struct stat st;
+        if (::fstat(fd, &st) < 0)
+        {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error{error, std::system_category(), "Failed to query " + path.string()};
+        }
+
+        size_ = static_cast<std::size_t>(st.st_size);
+
+        if (size_ > 0)
+        {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED)
+            {
+                auto error = errno;
+                ::close(fd);
+                throw std::system_error{error, std::system_category(), "Failed to map " + path.string()};
+            }
+        }
+
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        if (data_ && data_ != MAP_FAILED)
+            ::munmap(data_, size_);
+    }
+
+    const char* data() const
+    {
+        return static_cast<const char*>(data_);
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    void* data_{nullptr};
+    std::size_t size_{0};
+};
+
+// Reader decodes values from a buffer, throwing if the buffer is exhausted.
+class Reader
+{
+public:
+    Reader(const char* begin, const char* end) : current{begin}, end{end}
+    {
+    }
+
+    template<typename T>
+    T read()
+    {
+        T result;
+        std::memcpy(&result, take(sizeof(T)), sizeof(T));
+        return result;
+    }
+
+    std::string read_string()
+    {
+        auto length = read<std::uint32_t>();
+        return std::string{take(length), length};
+    }
+
+    bool exhausted() const
+    {
+        return current == end;
+    }
+
+private:
+    const char* take(std::size_t n)
+    {
+        if (static_cast<std::size_t>(end - current) < n)
+            throw std::runtime_error{"Binary configuration is truncated"};
+
+        auto result = current;
+        current += n;
+        return result;
+    }
+
+    const char* current;
+    const char* end;
+};
+
+Header read_header(Reader& reader)
+{
+    auto header = reader.read<Header>();
+
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+        throw std::runtime_error{"Not a binary configuration"};
+    if (header.version != version)
+        throw std::runtime_error{(boost::format("Unsupported binary configuration version %1%") % header.version).str()};
+    if (header.byte_order != byte_order)
+        throw std::runtime_error{"Binary configuration has been compiled for a different byte order"};
+
+    return header;
+}
+
+void read_node(Reader& reader, biometry::util::Configuration::Node& node)
+{
+    switch (static_cast<Tag>(reader.read<std::uint8_t>()))
+    {
+    case Tag::none:
+        return;
+    case Tag::boolean:
+        node.value(biometry::Variant::b(reader.read<std::uint8_t>() != 0));
+        return;
+    case Tag::integer:
+        node.value(biometry::Variant::i(reader.read<std::int64_t>()));
+        return;
+    case Tag::floating_point:
+        node.value(biometry::Variant::d(reader.read<double>()));
+        return;
+    case Tag::string:
+        node.value(biometry::Variant::s(reader.read_string()));
+        return;
+    case Tag::object:
+    {
+        node.kind(biometry::util::Configuration::Kind::object);
+        auto count = reader.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < count; i++)
+            read_node(reader, node[reader.read_string()]);
+        return;
+    }
+    case Tag::array:
+    {
+        node.kind(biometry::util::Configuration::Kind::array);
+        auto count = reader.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < count; i++)
+            read_node(reader, node.append());
+        return;
+    }
+    }
+
+    throw std::runtime_error{"Binary configuration contains an unknown node type"};
+}
+
+biometry::util::Configuration read_configuration(Reader& reader)
+{
+    biometry::util::Configuration result;
+    read_node(reader, result.root());
+
+    if (result.root() || result.root().kind() != biometry::util::Configuration::Kind::object)
+        throw std::runtime_error{"Binary configuration does not start with an object"};
+
+    if (not reader.exhausted())
+        throw std::runtime_error{"Binary configuration contains trailing data"};
+
+    return result;
+}
+
+// Writer encodes values into a buffer.
+class Writer
+{
+public:
+    template<typename T>
+    void write(const T& value)
+    {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write_string(boost::string_ref s)
+    {
+        write(static_cast<std::uint32_t>(s.size()));
+        buffer.append(s.data(), s.size());
+    }
+
+    const std::string& data() const
+    {
+        return buffer;
+    }
+
+private:
+    std::string buffer;
+};
+
+void write_node(Writer& writer, const biometry::util::Configuration::Node& node)
+{
+    if (node.kind() != biometry::util::Configuration::Kind::value)
+    {
+        if (node)
+            throw std::runtime_error{"Configuration contains a node with both a value and children"};
+
+        const bool is_object = node.kind() == biometry::util::Configuration::Kind::object;
+
+        writer.write(static_cast<std::uint8_t>(is_object ? Tag::object : Tag::array));
+        writer.write(static_cast<std::uint32_t>(node.children().size()));
+
+        for (const auto& child : node.children())
+        {
+            if (is_object)
+                writer.write_string(child.key());
+            write_node(writer, child);
+        }
+
+        return;
+    }
+
+    const auto& value = node.value();
+    switch (value.type())
+    {
+    case biometry::Variant::Type::none:
+        writer.write(static_cast<std::uint8_t>(Tag::none));
+        return;
+    case biometry::Variant::Type::boolean:
+        writer.write(static_cast<std::uint8_t>(Tag::boolean));
+        writer.write(static_cast<std::uint8_t>(value.boolean() ? 1 : 0));
+        return;
+    case biometry::Variant::Type::integer:
+        writer.write(static_cast<std::uint8_t>(Tag::integer));
+        writer.write(value.integer());
+        return;
+    case biometry::Variant::Type::floating_point:
+        writer.write(static_cast<std::uint8_t>(Tag::floating_point));
+        writer.write(value.floating_point());
+        return;
+    case biometry::Variant::Type::string:
+        writer.write(static_cast<std::uint8_t>(Tag::string));
+        writer.write_string(value.string());
+        return;
+    default:
+        break;
+    }
+
+    throw std::runtime_error{"Configuration contains a value that cannot be represented in binary form"};
+}
+
+biometry::util::Configuration configuration_from_json(const fs::path& source)
+{
+    using StreamingJsonConfigurationBuilder = biometry::util::StreamingConfigurationBuilder<biometry::util::JsonConfigurationBuilder>;
+    StreamingJsonConfigurationBuilder builder{StreamingJsonConfigurationBuilder::make_streamer(source)};
+    return builder.build_configuration();
+}
+}
+
+biometry::util::BinaryConfigurationBuilder::Stamp biometry::util::BinaryConfigurationBuilder::Stamp::for_file(const fs::path& source)
+{
+    struct stat st;
+    if (::stat(source.string().c_str(), &st) < 0)
+        throw std::system_error{errno, std::system_category(), "Failed to query " + source.string()};
+
+    return Stamp
+    {
+        static_cast<std::uint64_t>(st.st_size),
+        static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec
+    };
+}
+
+biometry::util::BinaryConfigurationBuilder::BinaryConfigurationBuilder(const fs::path& path) : path{path}
+{
+}
+
+biometry::Optional<biometry::util::Configuration> biometry::util::BinaryConfigurationBuilder::build_configuration_if(const Stamp& stamp)
+{
+    MappedFile file{path};
+    Reader reader{file.data(), file.data() + file.size()};
+
+    auto header = read_header(reader);
+    if (header.source_size != stamp.size || header.source_modified != stamp.modified)
+        return Optional<Configuration>{};
+
+    return read_configuration(reader);
+}
+
+biometry::util::Configuration biometry::util::BinaryConfigurationBuilder::build_configuration()
+{
+    MappedFile file{path};
+    Reader reader{file.data(), file.data() + file.size()};
+
+    read_header(reader);
+    return read_configuration(reader);
+}
+
+fs::path biometry::util::compiled_configuration_path_for(const fs::path& source)
+{
+    return source.string() + ".bin";
+}
+
+void biometry::util::compile_configuration(const fs::path& source, const fs::path& target)
+{
+    // We take the stamp before parsing, a concurrent modification of source
+    // then results in a stale binary configuration instead of a wrong one.
+    auto stamp = BinaryConfigurationBuilder::Stamp::for_file(source);
+    auto configuration = configuration_from_json(source);
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byte_order = byte_order;
+    header.source_size = stamp.size;
+    header.source_modified = stamp.modified;
+
+    Writer writer;
+    writer.write(header);
+    write_node(writer, configuration.root());
+
+    auto temporary = target.string() + ".tmp";
+    {
+        std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+        out.write(writer.data().data(), writer.data().size());
+        out.flush();
+
+        if (not out)
+            throw std::runtime_error{"Failed to write " + temporary};
+    }
+
+    fs::rename(temporary, target);
+}
+
+biometry::util::Configuration biometry::util::load_configuration(const fs::path& source)
+{
+    auto compiled = compiled_configuration_path_for(source);
+
+    try
+    {
+        if (fs::exists(compiled))
+        {
+            BinaryConfigurationBuilder builder{compiled};
+            if (auto configuration = builder.build_configuration_if(BinaryConfigurationBuilder::Stamp::for_file(source)))
+                return std::move(*configuration);
+        }
+    }
+    catch (...)
+    {
+        // An invalid binary configuration is not fatal, we just fall back to the source.
+    }
+
+    return configuration_from_json(source);
+}
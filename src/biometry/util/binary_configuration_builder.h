@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef BIOMETRY_UTIL_BINARY_CONFIGURATION_BUILDER_H_
+#define BIOMETRY_UTIL_BINARY_CONFIGURATION_BUILDER_H_
+
+#include <biometry/optional.h>
+#include <biometry/util/configuration.h>
+#include <biometry/visibility.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief BinaryConfigurationBuilder implements ConfigurationBuilder for precompiled, binary configuration files.
+///
+/// Binary configuration files are created by compile_configuration from a JSON source. They are
+/// memory-mapped and decoded in a single pass, without any tokenizing or intermediate representation.
+/// The format is specific to the byte order of the machine it has been created on.
+class BIOMETRY_DLL_PUBLIC BinaryConfigurationBuilder : public ConfigurationBuilder
+{
+public:
+    /// @brief Stamp identifies the version of a source file that a binary configuration has been compiled from.
+    struct Stamp
+    {
+        /// @brief for_file returns the Stamp describing the current state of source.
+        static Stamp for_file(const boost::filesystem::path& source);
+
+        std::uint64_t size;     ///< Size of the source file in bytes.
+        std::int64_t modified;  ///< Last modification time of the source file, in nanoseconds since the epoch.
+    };
+
+    /// @brief BinaryConfigurationBuilder initializes a new instance reading from the file at path.
+    BinaryConfigurationBuilder(const boost::filesystem::path& path);
+
+    /// @brief build_configuration_if returns a Configuration assembled from a binary configuration file,
+    /// if the file has been compiled from the version of the source described by stamp.
+    /// @throws std::runtime_error if the file is not a valid binary configuration.
+    Optional<Configuration> build_configuration_if(const Stamp& stamp);
+
+    /// build_configuration returns a Configuration assembled from a binary configuration file.
+    /// @throws std::runtime_error if the file is not a valid binary configuration.
+    Configuration build_configuration() override;
+
+private:
+    boost::filesystem::path path;
+};
+
+/// @brief compiled_configuration_path_for returns the path of the binary configuration compiled from source.
+BIOMETRY_DLL_PUBLIC boost::filesystem::path compiled_configuration_path_for(const boost::filesystem::path& source);
+
+/// @brief compile_configuration validates the JSON configuration in source and writes its binary form to target.
+///
+/// target is replaced atomically, readers either see the previous or the new version.
+/// @throws std::runtime_error if source cannot be parsed or contains values that cannot be represented.
+BIOMETRY_DLL_PUBLIC void compile_configuration(const boost::filesystem::path& source, const boost::filesystem::path& target);
+
+/// @brief load_configuration returns the configuration in the JSON file source.
+///
+/// The binary configuration at compiled_configuration_path_for(source) is preferred if it is
+/// up to date with source. We fall back to parsing source if it is absent, stale or invalid.
+BIOMETRY_DLL_PUBLIC Configuration load_configuration(const boost::filesystem::path& source);
+}
+}
+
+#endif // BIOMETRY_UTIL_BINARY_CONFIGURATION_BUILDER_H_
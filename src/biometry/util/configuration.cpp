@@ -16,35 +16,252 @@
  * Authored by: Thomas Voß <thomas.voss@canonical.com>
  *
  */
-
 #include <biometry/util/configuration.h>
 #include <biometry/util/not_reachable.h>
 
-#include <boost/format.hpp>
-#include <boost/optional.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// Arena owns all nodes and keys of a Configuration.
+//
+// Memory is handed out from large blocks by bumping a pointer, and only returned
+// when the arena is destroyed. Object children are indexed in a single open-addressing
+// hash table keyed by parent and name.
+class biometry::util::Configuration::Arena
+{
+public:
+    Arena()
+    {
+        root = make_node(nullptr, Key{});
+        root->kind_ = Kind::object;
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena()
+    {
+        for (auto node : nodes)
+            node->~Node();
+    }
+
+    Node* make_node(Node* parent, Key key)
+    {
+        auto node = new (allocate(sizeof(Node), alignof(Node))) Node{this, parent, intern(key)};
+        nodes.push_back(node);
+        return node;
+    }
+
+    Node** make_children(std::uint32_t capacity)
+    {
+        return static_cast<Node**>(allocate(capacity * sizeof(Node*), alignof(Node*)));
+    }
+
+    void index(Node* node)
+    {
+        if (2 * (used + 1) > slots.size())
+            rehash(slots.empty() ? 64 : 2 * slots.size());
+
+        insert(node);
+    }
+
+    Node* find(const Node* parent, Key key) const
+    {
+        if (slots.empty())
+            return nullptr;
+
+        auto mask = slots.size() - 1;
+        for (auto i = hash(parent, key) & mask; slots[i]; i = (i + 1) & mask)
+            if (slots[i]->parent == parent && slots[i]->key_ == key)
+                return slots[i];
+
+        return nullptr;
+    }
+
+    Node* root;
+
+private:
+    static constexpr const std::size_t block_size = 16 * 1024;
+
+    static std::size_t hash(const Node* parent, Key key)
+    {
+        // FNV-1a over the key, seeded with the parent's address.
+        std::size_t result = 2166136261u ^ reinterpret_cast<std::uintptr_t>(parent);
+        for (auto c : key)
+            result = (result ^ static_cast<unsigned char>(c)) * 16777619u;
+        return result;
+    }
 
-#include <fstream>
-#include <string>
-#include <tuple>
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        auto offset = (used_in_block + alignment - 1) & ~(alignment - 1);
+
+        if (blocks.empty() || offset + size > block_capacity)
+        {
+            block_capacity = size > block_size ? size : block_size;
+            blocks.emplace_back(new char[block_capacity]);
+            offset = 0;
+        }
+
+        used_in_block = offset + size;
+        return blocks.back().get() + offset;
+    }
+
+    Key intern(Key key)
+    {
+        if (key.empty())
+            return Key{};
+
+        auto data = static_cast<char*>(allocate(key.size(), 1));
+        std::memcpy(data, key.data(), key.size());
+        return Key{data, key.size()};
+    }
+
+    void insert(Node* node)
+    {
+        auto mask = slots.size() - 1;
+        auto i = hash(node->parent, node->key_) & mask;
+
+        while (slots[i])
+            i = (i + 1) & mask;
+
+        slots[i] = node;
+        used++;
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Node*> old(capacity, nullptr);
+        old.swap(slots);
+        used = 0;
+
+        for (auto node : old)
+            if (node && node->parent)
+                insert(node);
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t block_capacity{0};
+    std::size_t used_in_block{0};
+
+    std::vector<Node*> nodes;
+    std::vector<Node*> slots;
+    std::size_t used{0};
+};
 
 namespace
 {
 const biometry::util::Configuration::Node& null()
 {
-    static const biometry::util::Configuration::Node instance;
-    return instance;
+    static const biometry::util::Configuration instance = []()
+    {
+        biometry::util::Configuration result;
+        result.root().kind(biometry::util::Configuration::Kind::value);
+        return result;
+    }();
+
+    return instance.root();
+}
+}
+
+biometry::util::Configuration::Children::Children(const Node& parent) : parent{parent}
+{
 }
+
+biometry::util::Configuration::Children::Iterator biometry::util::Configuration::Children::begin() const
+{
+    return Iterator{parent.children_};
 }
-biometry::util::Configuration::Node::Node(const Variant &value)
-    : value_{value}
+
+biometry::util::Configuration::Children::Iterator biometry::util::Configuration::Children::end() const
+{
+    return Iterator{parent.children_ + parent.size_};
+}
+
+std::size_t biometry::util::Configuration::Children::size() const
+{
+    return parent.size_;
+}
+
+bool biometry::util::Configuration::Children::empty() const
+{
+    return parent.size_ == 0;
+}
+
+std::size_t biometry::util::Configuration::Children::count(const std::string& name) const
+{
+    return parent.find(name) ? 1 : 0;
+}
+
+biometry::util::Configuration::Node::Node(Arena* arena, Node* parent, Key key)
+    : arena{arena},
+      parent{parent},
+      key_{key},
+      kind_{Kind::value},
+      children_{nullptr},
+      size_{0},
+      capacity_{0}
 {
 }
 
+biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator=(const Node& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    // rhs might be a descendant of ours, we copy it out before dropping our children.
+    if (rhs.arena == arena)
+    {
+        Configuration copy;
+        copy.root() = rhs;
+        return *this = copy.root();
+    }
+
+    // Dropped children remain in the arena, detaching them hides them from lookups.
+    for (std::uint32_t i = 0; i < size_; i++)
+        children_[i]->parent = nullptr;
+
+    size_ = 0;
+    kind_ = rhs.kind_;
+    value_ = rhs.value_;
+
+    for (const auto& child : rhs.children())
+    {
+        if (rhs.kind_ == Kind::array)
+            append() = child;
+        else
+            this->child(child.key_) = child;
+    }
+
+    return *this;
+}
+
 biometry::util::Configuration::Node::operator bool() const
 {
     return value_.type() != Variant::Type::none;
 }
 
+biometry::util::Configuration::Key biometry::util::Configuration::Node::key() const
+{
+    return key_;
+}
+
+biometry::util::Configuration::Kind biometry::util::Configuration::Node::kind() const
+{
+    return kind_;
+}
+
+biometry::util::Configuration::Node& biometry::util::Configuration::Node::kind(Kind kind)
+{
+    if (size_ > 0 && kind != kind_)
+        throw std::logic_error{"Cannot change the kind of a node with children"};
+
+    kind_ = kind;
+    return *this;
+}
+
 const biometry::Variant& biometry::util::Configuration::Node::value() const
 {
     return value_;
@@ -56,21 +273,19 @@ biometry::util::Configuration::Node& biometry::util::Configuration::Node::value(
     return *this;
 }
 
-const biometry::util::Configuration::Children& biometry::util::Configuration::Node::children() const
-{
-    return children_;
-}
-
-biometry::util::Configuration::Children& biometry::util::Configuration::Node::children()
+biometry::util::Configuration::Children biometry::util::Configuration::Node::children() const
 {
-    return children_;
+    return Children{*this};
 }
 
 biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator()(const std::string& name, const std::function<void()>& catcher)
 {
     try
     {
-        return children_.at(name);
+        if (auto node = find(name))
+            return const_cast<Node&>(*node);
+
+        throw std::out_of_range{"No such configuration node: " + name};
     }
     catch(...) { catcher(); }
 
@@ -81,7 +296,10 @@ const biometry::util::Configuration::Node& biometry::util::Configuration::Node::
 {
     try
     {
-        return children_.at(name);
+        if (auto node = find(name))
+            return *node;
+
+        throw std::out_of_range{"No such configuration node: " + name};
     }
     catch (...) { catcher(); }
 
@@ -90,70 +308,205 @@ const biometry::util::Configuration::Node& biometry::util::Configuration::Node::
 
 biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator[](const std::string& name)
 {
-    return children_[name];
+    return child(name);
 }
 
 const biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator[](const std::string& name) const
 {
-    auto it = children_.find(name);
-    if (it != children_.end())
-        return it->second;
+    if (auto node = find(name))
+        return *node;
 
     return null();
 }
 
-/*biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator[](const char* name)
+biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator[](std::size_t index)
 {
-    return (*this)[std::string{name}];
+    if (kind_ != Kind::array || index >= size_)
+        throw std::out_of_range{"No such array element: " + std::to_string(index)};
+
+    return *children_[index];
 }
 
-const biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator[](const char* name) const
+const biometry::util::Configuration::Node& biometry::util::Configuration::Node::operator[](std::size_t index) const
 {
-    return (*this)[std::string{name}];
-}*/
+    if (kind_ == Kind::array && index < size_)
+        return *children_[index];
 
-const biometry::util::Configuration::Children& biometry::util::Configuration::children() const
-{
-    return children_;
+    return null();
 }
 
-biometry::util::Configuration::Children& biometry::util::Configuration::children()
+biometry::util::Configuration::Node& biometry::util::Configuration::Node::append()
 {
-    return children_;
+    if (kind_ == Kind::object && size_ > 0)
+        throw std::logic_error{"Cannot append to a node with named children"};
+
+    kind_ = Kind::array;
+
+    if (size_ == capacity_)
+    {
+        auto capacity = capacity_ == 0 ? 4 : 2 * capacity_;
+        auto children = arena->make_children(capacity);
+        std::copy(children_, children_ + size_, children);
+        children_ = children;
+        capacity_ = capacity;
+    }
+
+    return *(children_[size_++] = arena->make_node(this, Key{}));
 }
 
-biometry::util::Configuration::Node& biometry::util::Configuration::operator()(const std::string& name, const std::function<void()>& catcher)
+biometry::util::Configuration::Node& biometry::util::Configuration::Node::child(Key key)
 {
-    try
+    if (auto node = find(key))
+        return const_cast<Node&>(*node);
+
+    if (kind_ == Kind::array && size_ > 0)
+        throw std::logic_error{"Cannot add named children to an array"};
+
+    kind_ = Kind::object;
+
+    if (size_ == capacity_)
     {
-        return children_.at(name);
+        auto capacity = capacity_ == 0 ? 4 : 2 * capacity_;
+        auto children = arena->make_children(capacity);
+        std::copy(children_, children_ + size_, children);
+        children_ = children;
+        capacity_ = capacity;
     }
-    catch(...) { catcher(); }
 
-    util::not_reachable(__FUNCTION__, __FILE__, __LINE__);
+    auto node = arena->make_node(this, key);
+    children_[size_++] = node;
+    arena->index(node);
+
+    return *node;
+}
+
+const biometry::util::Configuration::Node* biometry::util::Configuration::Node::find(Key key) const
+{
+    if (kind_ != Kind::object || size_ == 0)
+        return nullptr;
+
+    return arena->find(this, key);
+}
+
+biometry::util::Configuration::Configuration() : arena{new Arena{}}
+{
+}
+
+biometry::util::Configuration::Configuration(const Configuration& rhs) : Configuration{}
+{
+    root() = rhs.root();
+}
+
+biometry::util::Configuration::Configuration(Configuration&& rhs) : arena{std::move(rhs.arena)}
+{
+    // We keep rhs usable.
+    rhs.arena.reset(new Arena{});
+}
+
+biometry::util::Configuration::~Configuration()
+{
+}
+
+biometry::util::Configuration& biometry::util::Configuration::operator=(const Configuration& rhs)
+{
+    if (this != &rhs)
+        arena.reset(Configuration{rhs}.arena.release());
+
+    return *this;
+}
+
+biometry::util::Configuration& biometry::util::Configuration::operator=(Configuration&& rhs)
+{
+    if (this != &rhs)
+        std::swap(arena, rhs.arena);
+
+    return *this;
+}
+
+biometry::util::Configuration::Node& biometry::util::Configuration::root()
+{
+    return *arena->root;
+}
+
+const biometry::util::Configuration::Node& biometry::util::Configuration::root() const
+{
+    return *arena->root;
+}
+
+biometry::util::Configuration::Children biometry::util::Configuration::children() const
+{
+    return root().children();
+}
+
+biometry::util::Configuration::Node& biometry::util::Configuration::operator()(const std::string& name, const std::function<void()>& catcher)
+{
+    return root()(name, catcher);
 }
 
 const biometry::util::Configuration::Node& biometry::util::Configuration::operator()(const std::string& name, const std::function<void()>& catcher) const
 {
-    try
+    return root()(name, catcher);
+}
+
+biometry::util::Configuration::Node& biometry::util::Configuration::operator[](const std::string& name)
+{
+    return root()[name];
+}
+
+const biometry::util::Configuration::Node& biometry::util::Configuration::operator[](const std::string& name) const
+{
+    return root()[name];
+}
+
+bool biometry::util::operator==(const Configuration::Node& lhs, const Configuration::Node& rhs)
+{
+    if (&lhs == &rhs)
+        return true;
+
+    if (lhs.kind() != rhs.kind() || not (lhs.value() == rhs.value()))
+        return false;
+
+    auto lc = lhs.children();
+    auto rc = rhs.children();
+
+    if (lc.size() != rc.size())
+        return false;
+
+    if (lhs.kind() == Configuration::Kind::array)
+        return std::equal(lc.begin(), lc.end(), rc.begin(), [](const Configuration::Node& l, const Configuration::Node& r) { return l == r; });
+
+    for (const auto& child : lc)
     {
-        return children_.at(name);
+        auto key = child.key().to_string();
+        if (rc.count(key) == 0 || child != rhs[key])
+            return false;
     }
-    catch (...) { catcher(); }
 
-    util::not_reachable(__FUNCTION__, __FILE__, __LINE__);
+    return true;
 }
 
-biometry::util::Configuration::Node& biometry::util::Configuration::operator[](const std::string& name)
+bool biometry::util::operator!=(const Configuration::Node& lhs, const Configuration::Node& rhs)
 {
-    return children_[name];
+    return not (lhs == rhs);
 }
 
-const biometry::util::Configuration::Node& biometry::util::Configuration::operator[](const std::string& name) const
+std::vector<std::string> biometry::util::diff(const Configuration& lhs, const Configuration& rhs)
 {
-    auto it = children_.find(name);
-    if (it != children_.end())
-        return it->second;
+    std::vector<std::string> result;
 
-    return null();
+    for (const auto& child : lhs.children())
+    {
+        auto key = child.key().to_string();
+        if (rhs.children().count(key) == 0 || child != rhs[key])
+            result.push_back(key);
+    }
+
+    for (const auto& child : rhs.children())
+    {
+        auto key = child.key().to_string();
+        if (lhs.children().count(key) == 0)
+            result.push_back(key);
+    }
+
+    return result;
 }
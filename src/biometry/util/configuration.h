@@ -25,42 +25,124 @@
 #include <biometry/visibility.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace biometry
 {
 namespace util
 {
+/// @brief Configuration is a tree of named configuration values.
+///
+/// All nodes and keys of a Configuration live in a single arena owned by the
+/// Configuration instance. Nodes never move, references to them remain valid for the
+/// lifetime of the Configuration. Object children are resolved in O(1) through a hash
+/// table shared by all nodes, array elements are indexed directly.
 class BIOMETRY_DLL_PUBLIC Configuration
 {
 public:
     /// @cond
+    class Arena;
     class Node;
-    typedef std::map<std::string, Node> Children;
     /// @endcond
 
+    /// @brief Key is a non-owning reference to the name of a node, pointing into the arena of its Configuration.
+    typedef boost::string_ref Key;
+
+    /// @brief Kind enumerates the shapes of a Node.
+    enum class Kind
+    {
+        value,  ///< The node carries a value and no children.
+        object, ///< The node has named children.
+        array   ///< The node has indexed children.
+    };
+
+    /// @brief Children is a range over the immediate children of a Node.
+    class BIOMETRY_DLL_PUBLIC Children
+    {
+    public:
+        /// @brief Iterator iterates over the immediate children of a Node.
+        class Iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef const Node value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Node* pointer;
+            typedef const Node& reference;
+
+            explicit Iterator(Node* const* current = nullptr) : current{current} {}
+
+            const Node& operator*() const { return **current; }
+            const Node* operator->() const { return *current; }
+            Iterator& operator++() { ++current; return *this; }
+            Iterator operator++(int) { auto copy = *this; ++current; return copy; }
+            bool operator==(const Iterator& rhs) const { return current == rhs.current; }
+            bool operator!=(const Iterator& rhs) const { return current != rhs.current; }
+
+        private:
+            Node* const* current;
+        };
+
+        /// @brief Children initializes a new instance for the children of parent.
+        explicit Children(const Node& parent);
+
+        /// @brief begin returns an iterator pointing to the first child.
+        Iterator begin() const;
+        /// @brief end returns an iterator pointing past the last child.
+        Iterator end() const;
+        /// @brief size returns the number of children.
+        std::size_t size() const;
+        /// @brief empty returns true if there are no children.
+        bool empty() const;
+        /// @brief count returns 1 if a child named name exists, 0 otherwise.
+        std::size_t count(const std::string& name) const;
+
+    private:
+        const Node& parent;
+    };
+
     /// @brief Node represents a single named configuration value.
-    class Node
+    ///
+    /// Nodes are created by their Configuration only. Assigning a node to another one
+    /// replaces the value and children of the assignee by a copy of the ones of the source.
+    class BIOMETRY_DLL_PUBLIC Node
     {
     public:
-        /// @brief Node constructs a new instance with the given name,
-        /// initializing the contained value to value.
-        Node(const Variant& value = Variant{});
+        Node(const Node&) = delete;
+        Node(Node&&) = delete;
+        Node& operator=(Node&&) = delete;
+
+        /// @brief operator= replaces value and children by a deep copy of the ones of rhs.
+        Node& operator=(const Node& rhs);
 
         /// @brief operator bool returns true if the contained value is not empty.
         explicit operator bool() const;
 
+        /// @brief key returns the name of the node, empty for array elements.
+        Key key() const;
+
+        /// @brief kind returns the shape of the node.
+        Kind kind() const;
+        /// @brief kind adjusts the shape of the node.
+        /// @throws std::logic_error if the node already has children of a different shape.
+        Node& kind(Kind kind);
+
         /// @brief value returns an immutable reference to the contained value.
-        virtual const Variant& value() const;
+        const Variant& value() const;
         /// @brief value adjusts the contained value.
-        virtual Node& value(const Variant& value);
+        Node& value(const Variant& value);
 
         /// @brief children returns the set of all children of this node.
-        virtual const Children& children() const;
-        /// @brief children returns a mutable reference to the children of this node.
-        virtual Children& children();
+        Children children() const;
+
         /// @brief Returns a mutable reference to the child with the given name or throws.
         ///
         /// catcher is invoked in the catch block such that API users can wrap up the original exception
@@ -71,24 +153,59 @@ public:
         /// catcher is invoked in the catch block such that API users can wrap up the original exception
         /// in a custom type easily.
         const Node& operator()(const std::string& name, const std::function<void()>& catcher) const;
-        /// @brief Returns a mutable reference to the child with the given name.
+        /// @brief Returns a mutable reference to the child with the given name, creating it if necessary.
         Node& operator[](const std::string& name);
-        /// @brief Returns a mutable reference to the child with the given name.
+        /// @brief Returns an immutable reference to the child with the given name, or an empty node.
         const Node& operator[](const std::string& name) const;
+        /// @brief Returns a mutable reference to the array element at index.
+        /// @throws std::out_of_range if the node is not an array or index is out of bounds.
+        Node& operator[](std::size_t index);
+        /// @brief Returns an immutable reference to the array element at index, or an empty node.
+        const Node& operator[](std::size_t index) const;
+
+        /// @brief append adds a new element to the array, returning a mutable reference to it.
+        /// @throws std::logic_error if the node has named children.
+        Node& append();
 
-        /// @brief Returns a mutable reference to the child with the given name.
-        // Node& operator[](const char* name);
-        /// @brief Returns a mutable reference to the child with the given name.
-        // const Node& operator[](const char* name) const;
     private:
-        Variant value_; ///< mutable value of the Node.
-        Children children_; ///< mutable set of all children_ of this Node.
+        friend class Arena;
+        friend class Children;
+
+        Node(Arena* arena, Node* parent, Key key);
+
+        Node& child(Key key);
+        const Node* find(Key key) const;
+
+        Arena* arena;
+        Node* parent;
+        Key key_;
+        Kind kind_;
+        Variant value_;
+        Node** children_;
+        std::uint32_t size_;
+        std::uint32_t capacity_;
     };
 
-    /// @brief children returns the set of all children of this node.
-    virtual const Children& children() const;
-    /// @brief children returns a mutable reference to the children of this node.
-    virtual Children& children();
+    /// @brief Configuration initializes an empty instance.
+    Configuration();
+    /// @brief Configuration initializes a new instance with a deep copy of rhs.
+    Configuration(const Configuration& rhs);
+    /// @brief Configuration initializes a new instance, taking over the arena of rhs.
+    Configuration(Configuration&& rhs);
+    ~Configuration();
+
+    /// @brief operator= replaces all nodes by a deep copy of the ones in rhs.
+    Configuration& operator=(const Configuration& rhs);
+    /// @brief operator= replaces all nodes by the ones in rhs.
+    Configuration& operator=(Configuration&& rhs);
+
+    /// @brief root returns a mutable reference to the root node.
+    Node& root();
+    /// @brief root returns an immutable reference to the root node.
+    const Node& root() const;
+
+    /// @brief children returns the set of all children of the root node.
+    Children children() const;
     /// @brief Returns a mutable reference to the child with the given name or throws.
     ///
     /// catcher is invoked in the catch block such that API users can wrap up the original exception
@@ -103,10 +220,22 @@ public:
     Node& operator[](const std::string& name);
     /// @brief Returns a mutable reference to the child with the given name.
     const Node& operator[](const std::string& name) const;
+
 private:
-    Children children_; ///< mutable set of all children_ of this Node.
+    std::unique_ptr<Arena> arena;
 };
 
+/// @brief operator== returns true if lhs and rhs have the same kind and value, and equal children.
+///
+/// Named children are matched by key regardless of their order, array elements are compared in order.
+BIOMETRY_DLL_PUBLIC bool operator==(const Configuration::Node& lhs, const Configuration::Node& rhs);
+
+/// @brief operator!= returns true if lhs and rhs differ in kind, value or any of their children.
+BIOMETRY_DLL_PUBLIC bool operator!=(const Configuration::Node& lhs, const Configuration::Node& rhs);
+
+/// @brief diff returns the names of all top-level nodes that were added, removed or changed between lhs and rhs.
+BIOMETRY_DLL_PUBLIC std::vector<std::string> diff(const Configuration& lhs, const Configuration& rhs);
+
 /// @brief ConfigurationBuilder models loading of configuration from arbitrary sources.
 class BIOMETRY_DLL_PUBLIC ConfigurationBuilder : public biometry::DoNotCopyOrMove
 {
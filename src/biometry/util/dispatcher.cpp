@@ -19,29 +19,190 @@
 
 #include <biometry/util/dispatcher.h>
 
+#include <biometry/util/logging.h>
+#include <biometry/util/metrics.h>
+#include <biometry/util/mpsc_ring_buffer.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace
 {
+// queue_depth returns the gauge tracking the number of tasks waiting for execution on dispatchers labeled by labels.
+biometry::util::Metrics::Gauge& queue_depth(const biometry::util::Metrics::Labels& labels)
+{
+    return biometry::util::metrics().gauge("dispatcher_queue_depth", labels);
+}
+
 struct AsioStrandDispatcher : public biometry::util::Dispatcher
 {
 public:
-    AsioStrandDispatcher(const std::shared_ptr<biometry::Runtime>& rt)
+    // Dequeue leaves the queue when it starts executing the wrapped task,
+    // keeping the task visible to the watchdog of the runtime.
+    struct Dequeue
+    {
+        void operator()()
+        {
+            depth->decrement();
+            biometry::Runtime::Watch watch;
+            task();
+        }
+
+        Task task;
+        biometry::util::Metrics::Gauge* depth;
+    };
+
+    AsioStrandDispatcher(const std::shared_ptr<biometry::Runtime>& rt, biometry::Runtime::Lane lane)
         : rt{rt},
-          strand{rt->service()}
+          strand{rt->service(lane)},
+          depth(queue_depth({{"dispatcher", "strand"}, {"lane", biometry::Runtime::name(lane)}}))
     {
     }
 
-    void dispatch(const Task &task) override
+    void dispatch(Task&& task) override
     {
-        strand.post(task);
+        depth.increment();
+        biometry::post_to_strand(strand, Dequeue{std::move(task), &depth});
     }
 
 private:
     std::shared_ptr<biometry::Runtime> rt;
     boost::asio::io_service::strand strand;
+    biometry::util::Metrics::Gauge& depth;
+};
+
+struct WorkerThreadDispatcher : public biometry::util::Dispatcher
+{
+public:
+    // State is shared between the dispatcher and its worker thread, such that
+    // the dispatcher can safely be released by a task running on the worker.
+    struct State
+    {
+        explicit State(std::size_t capacity) : queue{capacity}, depth(queue_depth({{"dispatcher", "worker_thread"}}))
+        {
+        }
+
+        // run drains the queue until stop has been requested and
+        // all pending tasks have been executed.
+        void run()
+        {
+            Task task;
+
+            while (true)
+            {
+                while (queue.try_pop(task))
+                {
+                    depth.decrement();
+                    execute(task);
+                    task = nullptr;
+                }
+
+                std::unique_lock<std::mutex> ul{guard};
+                sleeping.store(true);
+                // Pairs with the fence in wake_up_worker: either the producer sees
+                // us sleeping, or we see the task it has just pushed.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (not queue.empty())
+                {
+                    sleeping.store(false);
+                    continue;
+                }
+
+                if (stopping.load())
+                    break;
+
+                wakeup.wait(ul, [this]() { return not sleeping.load(); });
+            }
+        }
+
+        void push(Task&& task)
+        {
+            depth.increment();
+
+            while (not queue.try_push(std::move(task)))
+                std::this_thread::yield();
+
+            wake_up_worker();
+        }
+
+        void stop()
+        {
+            stopping.store(true);
+            wake_up_worker(true);
+        }
+
+        void wake_up_worker(bool force = false)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (force || sleeping.load())
+            {
+                std::lock_guard<std::mutex> lg{guard};
+                sleeping.store(false);
+                wakeup.notify_one();
+            }
+        }
+
+        static void execute(Task& task)
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                biometry::util::logging::error("%s", e.what());
+            }
+            catch (...)
+            {
+                biometry::util::logging::error("Unknown exception caught while executing task");
+            }
+        }
+
+        biometry::util::MpscRingBuffer<Task> queue;
+        biometry::util::Metrics::Gauge& depth;
+        std::mutex guard;
+        std::condition_variable wakeup;
+        std::atomic<bool> sleeping{false};
+        std::atomic<bool> stopping{false};
+    };
+
+    WorkerThreadDispatcher(std::size_t capacity)
+        : state{std::make_shared<State>(capacity)},
+          worker{[state = state]() { state->run(); }}
+    {
+    }
+
+    ~WorkerThreadDispatcher()
+    {
+        state->stop();
+
+        if (worker.get_id() == std::this_thread::get_id())
+            worker.detach();
+        else if (worker.joinable())
+            worker.join();
+    }
+
+    void dispatch(Task&& task) override
+    {
+        state->push(std::move(task));
+    }
+
+private:
+    std::shared_ptr<State> state;
+    std::thread worker;
 };
 }
 
-std::shared_ptr<biometry::util::Dispatcher> biometry::util::create_dispatcher_for_runtime(const std::shared_ptr<biometry::Runtime>& rt)
+std::shared_ptr<biometry::util::Dispatcher> biometry::util::create_dispatcher_for_runtime(const std::shared_ptr<biometry::Runtime>& rt, biometry::Runtime::Lane lane)
+{
+    return std::make_shared<AsioStrandDispatcher>(rt, lane);
+}
+
+std::shared_ptr<biometry::util::Dispatcher> biometry::util::create_dispatcher_with_worker_thread(std::size_t capacity)
 {
-    return std::make_shared<AsioStrandDispatcher>(rt);
+    return std::make_shared<WorkerThreadDispatcher>(capacity);
 }
@@ -23,7 +23,9 @@
 #include <biometry/do_not_copy_or_move.h>
 #include <biometry/runtime.h>
 #include <biometry/visibility.h>
+#include <biometry/util/unique_function.h>
 
+#include <cstddef>
 #include <memory>
 
 namespace biometry
@@ -35,10 +37,13 @@ class BIOMETRY_DLL_PUBLIC Dispatcher : public DoNotCopyOrMove
 {
 public:
     /// @brief A Task is dispatched by a dispatcher.
-    typedef std::function<void()> Task;
+    ///
+    /// Tasks are move-only and handed over to the dispatcher, small tasks
+    /// are dispatched without allocating.
+    typedef UniqueFunction<void()> Task;
 
-    /// @brief dispatch enqueues the given task for execution.
-    virtual void dispatch(const Task& task) = 0;
+    /// @brief dispatch enqueues the given task for execution, taking over ownership.
+    virtual void dispatch(Task&& task) = 0;
 
 protected:
     /// @cond
@@ -46,8 +51,17 @@ protected:
     /// @endcond
 };
 
-/// @brief create_dispatcher_for_runtime creates a dispatcher enqueuing to the runtime's service.
-BIOMETRY_DLL_PUBLIC std::shared_ptr<Dispatcher> create_dispatcher_for_runtime(const std::shared_ptr<Runtime>&);
+/// @brief create_dispatcher_for_runtime creates a dispatcher enqueuing to the service of the given lane of the runtime.
+///
+/// The depth of its queue is reported to the dispatcher_queue_depth gauge of the lane.
+BIOMETRY_DLL_PUBLIC std::shared_ptr<Dispatcher> create_dispatcher_for_runtime(const std::shared_ptr<Runtime>&, Runtime::Lane lane = Runtime::Lane::bus);
+
+/// @brief create_dispatcher_with_worker_thread creates a dispatcher executing tasks in order on a
+/// dedicated thread, draining a lock-free queue with room for capacity tasks.
+///
+/// Producers calling dispatch on a full queue yield until the worker thread catches up.
+/// @throws std::invalid_argument if capacity is not a power of 2.
+BIOMETRY_DLL_PUBLIC std::shared_ptr<Dispatcher> create_dispatcher_with_worker_thread(std::size_t capacity = 1024);
 }
 }
 
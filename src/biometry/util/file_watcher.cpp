@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/file_watcher.h>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace
+{
+// The set of events indicating that the content of a file in the watched directory changed.
+constexpr const std::uint32_t watched_events = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+
+int inotify_descriptor_for_directory(const boost::filesystem::path& dir)
+{
+    auto fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error{errno, std::system_category(), "Failed to initialize inotify"};
+
+    if (::inotify_add_watch(fd, dir.c_str(), watched_events) < 0)
+    {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error{error, std::system_category(), "Failed to watch " + dir.string()};
+    }
+
+    return fd;
+}
+}
+
+biometry::util::FileWatcher::Ptr biometry::util::FileWatcher::create(
+        boost::asio::io_service& service,
+        const boost::filesystem::path& file,
+        const std::function<void()>& on_changed,
+        const std::chrono::milliseconds& settle)
+{
+    Ptr sp{new FileWatcher{service, file, on_changed, settle}};
+    sp->read();
+    return sp;
+}
+
+void biometry::util::FileWatcher::stop()
+{
+    auto sp = shared_from_this();
+    strand.dispatch([sp]()
+    {
+        boost::system::error_code ec;
+        sp->descriptor.cancel(ec);
+        sp->timer.cancel(ec);
+    });
+}
+
+biometry::util::FileWatcher::FileWatcher(
+        boost::asio::io_service& service,
+        const boost::filesystem::path& file,
+        const std::function<void()>& on_changed,
+        const std::chrono::milliseconds& settle)
+    : file{boost::filesystem::absolute(file)},
+      strand{service},
+      descriptor{service, inotify_descriptor_for_directory(this->file.parent_path())},
+      timer{service},
+      settle{settle},
+      on_changed{on_changed}
+{
+}
+
+void biometry::util::FileWatcher::read()
+{
+    std::weak_ptr<FileWatcher> wp{shared_from_this()};
+    descriptor.async_read_some(boost::asio::buffer(buffer), strand.wrap([wp](const boost::system::error_code& ec, std::size_t size)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+            return;
+
+        auto sp = wp.lock();
+        if (not sp || ec)
+            return;
+
+        if (sp->handle(size))
+            sp->arm();
+
+        sp->read();
+    }));
+}
+
+bool biometry::util::FileWatcher::handle(std::size_t size) const
+{
+    auto name = file.filename().string();
+    bool matched{false};
+
+    for (std::size_t offset = 0; offset < size;)
+    {
+        auto event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+
+        // The watch is gone, e.g., because the directory has been removed.
+        if (event->mask & IN_IGNORED)
+            return matched;
+
+        if (event->len > 0 && std::strcmp(event->name, name.c_str()) == 0)
+            matched = true;
+
+        offset += sizeof(inotify_event) + event->len;
+    }
+
+    return matched;
+}
+
+void biometry::util::FileWatcher::arm()
+{
+    timer.expires_from_now(settle);
+
+    std::weak_ptr<FileWatcher> wp{shared_from_this()};
+    timer.async_wait(strand.wrap([wp](const boost::system::error_code& ec)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+            return;
+
+        if (auto sp = wp.lock())
+            sp->on_changed();
+    }));
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRY_UTIL_FILE_WATCHER_H_
+#define BIOMETRY_UTIL_FILE_WATCHER_H_
+
+#include <biometry/do_not_copy_or_move.h>
+#include <biometry/visibility.h>
+
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief FileWatcher reports changes to a single file by means of inotify.
+///
+/// The directory containing the file is watched instead of the file itself, such that
+/// files replaced by renaming a new version over them, as most editors and package
+/// managers do, are picked up, too. Bursts of events are coalesced, on_changed is
+/// invoked once the file has not been touched for a configurable settle time.
+class BIOMETRY_DLL_PUBLIC FileWatcher : public DoNotCopyOrMove, public std::enable_shared_from_this<FileWatcher>
+{
+public:
+    // Safe us some typing.
+    typedef std::shared_ptr<FileWatcher> Ptr;
+
+    /// @brief create returns a new instance invoking on_changed on service whenever file changed.
+    /// @throws std::system_error if setting up the inotify watch fails.
+    static Ptr create(boost::asio::io_service& service,
+                      const boost::filesystem::path& file,
+                      const std::function<void()>& on_changed,
+                      const std::chrono::milliseconds& settle = std::chrono::milliseconds{100});
+
+    /// @brief stop cancels all pending reads, on_changed is not invoked afterwards.
+    void stop();
+
+private:
+    /// @brief FileWatcher initializes a new instance.
+    FileWatcher(boost::asio::io_service& service,
+                const boost::filesystem::path& file,
+                const std::function<void()>& on_changed,
+                const std::chrono::milliseconds& settle);
+
+    /// @brief read waits for the next batch of inotify events.
+    void read();
+
+    /// @brief handle inspects size bytes of inotify events, returning true if any of them refers to the watched file.
+    bool handle(std::size_t size) const;
+
+    /// @brief arm restarts the settle countdown.
+    void arm();
+
+    boost::filesystem::path file;
+    // All handlers run through strand, serializing access to descriptor and timer.
+    boost::asio::io_service::strand strand;
+    boost::asio::posix::stream_descriptor descriptor;
+    boost::asio::steady_timer timer;
+    std::chrono::milliseconds settle;
+    std::function<void()> on_changed;
+    // inotify hands out records starting with an int, the buffer has to be aligned accordingly.
+    alignas(int) std::array<char, 4096> buffer;
+};
+}
+}
+
+#endif // BIOMETRY_UTIL_FILE_WATCHER_H_
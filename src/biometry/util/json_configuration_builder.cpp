@@ -16,57 +16,392 @@
  * Authored by: Thomas Voß <thomas.voss@canonical.com>
  *
  */
-
 #include <biometry/util/json_configuration_builder.h>
 
-#include <biometry/util/json.hpp>
-
 #include <boost/format.hpp>
-#include <boost/optional.hpp>
-
-#include <fstream>
 
-namespace json = nlohmann;
+#include <cerrno>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
 
 namespace
 {
-boost::optional<biometry::util::Configuration::Node> build_from_json(const json::json& j)
+// Parser decodes JSON as specified by RFC 8259 in a single pass, placing values directly
+// into the nodes of a Configuration.
+//
+// null values are dropped from objects, and preserved as empty elements in arrays.
+class Parser
 {
-    if (j.is_boolean())
-        return biometry::util::Configuration::Node{biometry::Variant::b(j)};
+public:
+    // max_depth is the maximum number of nested objects and arrays, bounding the stack used by the parser.
+    static constexpr const std::size_t max_depth = 128;
 
-    if (j.is_number_integer())
-        return biometry::util::Configuration::Node{biometry::Variant::i(j)};
+    Parser(const char* begin, const char* end) : begin{begin}, current{begin}, end{end}
+    {
+    }
 
-    if (j.is_number_float())
-        return biometry::util::Configuration::Node{biometry::Variant::d(j)};
+    void parse(biometry::util::Configuration& configuration)
+    {
+        skip_whitespace();
+        parse_object(configuration.root());
+        skip_whitespace();
 
-    if (j.is_string())
-        return biometry::util::Configuration::Node{biometry::Variant::s(j)};
+        if (current != end)
+            fail("Unexpected trailing characters");
+    }
 
+private:
+    [[noreturn]] void fail(const std::string& what)
+    {
+        throw std::runtime_error{(boost::format("Invalid JSON at offset %1%: %2%") % (current - begin) % what).str()};
+    }
 
-    if (j.is_array())
+    void skip_whitespace()
     {
-        biometry::util::Configuration::Node result;
-        for (std::size_t i = 0; i < j.size(); i++)
-            if (auto n = build_from_json(j.at(i)))
-                result[std::to_string(i)] = *n;
+        while (current != end && (*current == ' ' || *current == '\t' || *current == '\n' || *current == '\r'))
+            ++current;
+    }
 
-        return result;
+    char peek()
+    {
+        if (current == end)
+            fail("Unexpected end of input");
+        return *current;
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c)
+            fail(std::string{"Expected '"} + c + "'");
+        ++current;
+    }
+
+    void expect(const char* literal)
+    {
+        for (; *literal; ++literal)
+            expect(*literal);
+    }
+
+    // accept consumes c if it is next in the input.
+    bool accept(char c)
+    {
+        if (current == end || *current != c)
+            return false;
+
+        ++current;
+        return true;
+    }
+
+    bool is_digit()
+    {
+        return current != end && *current >= '0' && *current <= '9';
+    }
+
+    // accept_digits consumes a run of digits, returning false if there is none.
+    bool accept_digits()
+    {
+        if (not is_digit())
+            return false;
+
+        while (is_digit())
+            ++current;
+
+        return true;
+    }
+
+    // Nesting tracks the depth of the object or array being parsed.
+    struct Nesting
+    {
+        explicit Nesting(Parser& parser) : parser(parser)
+        {
+            if (++parser.depth > max_depth)
+                parser.fail("Nesting too deep");
+        }
+
+        ~Nesting()
+        {
+            --parser.depth;
+        }
+
+        Parser& parser;
+    };
+
+    // parse_value places the value at current into node, leaving node empty for null.
+    void parse_value(biometry::util::Configuration::Node& node)
+    {
+        switch (peek())
+        {
+        case '{':
+            parse_object(node);
+            return;
+        case '[':
+            parse_array(node);
+            return;
+        case '"':
+            node.value(biometry::Variant::s(parse_string()));
+            return;
+        case 't':
+            expect("true");
+            node.value(biometry::Variant::b(true));
+            return;
+        case 'f':
+            expect("false");
+            node.value(biometry::Variant::b(false));
+            return;
+        case 'n':
+            expect("null");
+            return;
+        default:
+            node.value(parse_number());
+            return;
+        }
+    }
+
+    bool is_null()
+    {
+        return peek() == 'n';
+    }
+
+    void parse_object(biometry::util::Configuration::Node& node)
+    {
+        Nesting nesting{*this};
+
+        expect('{');
+        node.kind(biometry::util::Configuration::Kind::object);
+        skip_whitespace();
+
+        if (peek() == '}')
+        {
+            ++current;
+            return;
+        }
+
+        while (true)
+        {
+            skip_whitespace();
+            auto key = parse_string();
+            skip_whitespace();
+            expect(':');
+            skip_whitespace();
+
+            if (is_null())
+                expect("null");
+            else
+                parse_value(node[key]);
+
+            skip_whitespace();
+            if (peek() == ',')
+            {
+                ++current;
+                continue;
+            }
+
+            expect('}');
+            return;
+        }
+    }
+
+    void parse_array(biometry::util::Configuration::Node& node)
+    {
+        Nesting nesting{*this};
+
+        expect('[');
+        node.kind(biometry::util::Configuration::Kind::array);
+        skip_whitespace();
+
+        if (peek() == ']')
+        {
+            ++current;
+            return;
+        }
+
+        while (true)
+        {
+            skip_whitespace();
+            parse_value(node.append());
+            skip_whitespace();
+
+            if (peek() == ',')
+            {
+                ++current;
+                continue;
+            }
+
+            expect(']');
+            return;
+        }
     }
 
-    if (j.is_object())
+    std::string parse_string()
     {
-        biometry::util::Configuration::Node result;
-        for(auto it = j.begin(); it != j.end(); ++it)
-            if (auto n = build_from_json(*it))
-                result[it.key()] = *n;
+        expect('"');
+
+        std::string result;
+        while (true)
+        {
+            auto run = current;
+            while (current != end && *current != '"' && *current != '\\')
+            {
+                if (static_cast<unsigned char>(*current) < 0x20)
+                    fail("Control character in string");
+                ++current;
+            }
+
+            result.append(run, current);
+
+            switch (peek())
+            {
+            case '"':
+                ++current;
+                return result;
+            case '\\':
+                ++current;
+                parse_escape(result);
+                break;
+            }
+        }
+    }
+
+    void parse_escape(std::string& out)
+    {
+        auto c = peek(); ++current;
+        switch (c)
+        {
+        case '"': out.push_back('"'); return;
+        case '\\': out.push_back('\\'); return;
+        case '/': out.push_back('/'); return;
+        case 'b': out.push_back('\b'); return;
+        case 'f': out.push_back('\f'); return;
+        case 'n': out.push_back('\n'); return;
+        case 'r': out.push_back('\r'); return;
+        case 't': out.push_back('\t'); return;
+        case 'u': break;
+        default: fail("Invalid escape sequence");
+        }
+
+        auto cp = parse_hex4();
+        if (cp >= 0xd800 && cp <= 0xdbff)
+        {
+            expect("\\u");
+            auto low = parse_hex4();
+            if (low < 0xdc00 || low > 0xdfff)
+                fail("Invalid surrogate pair");
+            cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+        }
+        else if (cp >= 0xdc00 && cp <= 0xdfff)
+        {
+            fail("Unpaired low surrogate");
+        }
+
+        append_utf8(out, cp);
+    }
 
+    std::uint32_t parse_hex4()
+    {
+        std::uint32_t result = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            auto c = peek(); ++current;
+            result <<= 4;
+            if (c >= '0' && c <= '9') result |= c - '0';
+            else if (c >= 'a' && c <= 'f') result |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') result |= c - 'A' + 10;
+            else fail("Invalid unicode escape");
+        }
         return result;
     }
 
-    return boost::optional<biometry::util::Configuration::Node>{};
-}
+    static void append_utf8(std::string& out, std::uint32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out.push_back(static_cast<char>(cp));
+        }
+        else if (cp < 0x800)
+        {
+            out.push_back(static_cast<char>(0xc0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else if (cp < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xf0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+    }
+
+    // parse_number parses number = [ minus ] int [ frac ] [ exp ].
+    biometry::Variant parse_number()
+    {
+        auto start = current;
+        bool integral = true;
+
+        accept('-');
+
+        if (accept('0'))
+        {
+            if (is_digit())
+                fail("Leading zero in number");
+        }
+        else if (not accept_digits())
+        {
+            fail("Invalid value");
+        }
+
+        if (accept('.'))
+        {
+            integral = false;
+            if (not accept_digits())
+                fail("Expected digits in fraction");
+        }
+
+        if (accept('e') || accept('E'))
+        {
+            integral = false;
+            if (not accept('+'))
+                accept('-');
+            if (not accept_digits())
+                fail("Expected digits in exponent");
+        }
+
+        // The buffer is not null-terminated in general, we hand a copy to strto*.
+        const std::string number{start, current};
+
+        char* last = nullptr;
+        errno = 0;
+
+        if (integral)
+        {
+            auto value = std::strtoll(number.c_str(), &last, 10);
+            if (errno == 0 && *last == '\0')
+                return biometry::Variant::i(value);
+
+            // Integers exceeding 64 bits are represented as floating point values.
+            errno = 0;
+        }
+
+        auto value = std::strtod(number.c_str(), &last);
+        if (errno != 0 || *last != '\0')
+            fail("Invalid number");
+
+        return biometry::Variant::d(value);
+    }
+
+    const char* begin;
+    const char* current;
+    const char* end;
+    std::size_t depth{0};
+};
+
+constexpr const std::size_t Parser::max_depth;
 }
 
 biometry::util::JsonConfigurationBuilder::JsonConfigurationBuilder(std::istream& in) : in{in}
@@ -79,12 +414,10 @@ biometry::util::JsonConfigurationBuilder::JsonConfigurationBuilder(std::istream&
 
 biometry::util::Configuration biometry::util::JsonConfigurationBuilder::build_configuration()
 {
-    util::Configuration result;
+    const std::string buffer{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
 
-    auto j = json::json::parse(in);
-    for (auto it = j.begin(); it != j.end(); ++it)
-        if (auto n = build_from_json(*it))
-            result.children()[it.key()] = *n;
+    util::Configuration result;
+    Parser{buffer.data(), buffer.data() + buffer.size()}.parse(result);
 
     return result;
 }
@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/logging.h>
+
+#include <biometry/util/metrics.h>
+#include <biometry/util/mpsc_ring_buffer.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <istream>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <pthread.h>
+#include <syslog.h>
+
+namespace logging = biometry::util::logging;
+
+namespace
+{
+// An entry occupies 256 bytes, messages are truncated to fit.
+constexpr const std::size_t max_message_size = 240;
+constexpr const std::size_t queue_capacity = 1024;
+constexpr const std::uint32_t default_rate_limit = 200;
+constexpr const std::chrono::milliseconds flush_interval{100};
+
+const char* name(logging::Severity severity)
+{
+    switch (severity)
+    {
+    case logging::Severity::debug: return "debug";
+    case logging::Severity::info: return "info";
+    case logging::Severity::warning: return "warning";
+    case logging::Severity::error: return "error";
+    }
+
+    return "unknown";
+}
+
+// Entry is a formatted message waiting for the background thread.
+struct Entry
+{
+    logging::Severity severity;
+    std::chrono::system_clock::time_point when;
+    char message[max_message_size];
+};
+
+// RateLimit admits a configurable number of messages per second, allowing
+// for bursts of up to one second worth of messages. It tracks the theoretical
+// arrival time of the next message, following the generic cell rate algorithm.
+class RateLimit
+{
+public:
+    void set(std::uint32_t messages_per_second)
+    {
+        interval.store(messages_per_second > 0 ? std::nano::den / messages_per_second : 0, std::memory_order_relaxed);
+    }
+
+    bool try_acquire()
+    {
+        auto interval = this->interval.load(std::memory_order_relaxed);
+        if (interval == 0)
+            return true;
+
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto tat = this->tat.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto next = std::max(tat, now) + interval;
+            if (next - now > std::nano::den)
+                return false;
+            if (this->tat.compare_exchange_weak(tat, next, std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+private:
+    std::atomic<std::int64_t> interval{0};
+    std::atomic<std::int64_t> tat{0};
+};
+
+// Set in the child of a fork, the background thread does not exist there.
+std::atomic<bool> is_forked_child{false};
+
+// Logger owns the queue and the background thread writing entries to the sink.
+class Logger
+{
+public:
+    static Logger& instance()
+    {
+        // Never destroyed on purpose, messages are logged from threads that might outlive static destruction.
+        static std::aligned_storage<sizeof(Logger), alignof(Logger)>::type storage;
+        static Logger* instance = new (&storage) Logger{};
+        return *instance;
+    }
+
+    Logger()
+        : queue{queue_capacity},
+          sink{logging::stderr_sink()},
+          dropped_total(biometry::util::metrics().counter("log_messages_dropped_total"))
+    {
+        rate_limit.set(default_rate_limit);
+        ::pthread_atfork(nullptr, nullptr, []() { is_forked_child.store(true); });
+        std::thread{[this]() { run(); }}.detach();
+    }
+
+    void push(Entry&& entry)
+    {
+        if (is_forked_child.load(std::memory_order_relaxed))
+        {
+            std::fprintf(stderr, "[%s] %s\n", name(entry.severity), entry.message);
+            return;
+        }
+
+        if (not rate_limit.try_acquire() || not queue.try_push(std::move(entry)))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            dropped_total.increment();
+        }
+    }
+
+    void set_sink(const logging::Sink::Ptr& sink)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        this->sink = sink;
+    }
+
+    void set_rate_limit(std::uint32_t messages_per_second)
+    {
+        rate_limit.set(messages_per_second);
+    }
+
+    void flush()
+    {
+        if (is_forked_child.load(std::memory_order_relaxed))
+            return;
+
+        std::unique_lock<std::mutex> ul{guard};
+        auto requested = ++flush_requested;
+        wakeup.notify_one();
+        flushed_cond.wait(ul, [this, requested]() { return flushed >= requested; });
+    }
+
+private:
+    // run drains the queue every flush_interval or when a flush has been requested.
+    void run()
+    {
+        Entry entry;
+
+        while (true)
+        {
+            logging::Sink::Ptr sink;
+            std::uint64_t requested;
+
+            {
+                std::lock_guard<std::mutex> lg{guard};
+                sink = this->sink;
+                requested = flush_requested;
+            }
+
+            bool written{false};
+
+            while (queue.try_pop(entry))
+            {
+                sink->write(entry.severity, entry.when, entry.message);
+                written = true;
+            }
+
+            if (auto count = dropped.exchange(0, std::memory_order_relaxed))
+            {
+                char message[max_message_size];
+                std::snprintf(message, sizeof(message), "Dropped %llu messages exceeding the rate limit or the queue capacity",
+                              static_cast<unsigned long long>(count));
+                sink->write(logging::Severity::warning, std::chrono::system_clock::now(), message);
+                written = true;
+            }
+
+            if (written)
+                sink->flush();
+
+            std::unique_lock<std::mutex> ul{guard};
+            flushed = requested;
+            flushed_cond.notify_all();
+            wakeup.wait_for(ul, flush_interval, [this]() { return flush_requested != flushed; });
+        }
+    }
+
+    biometry::util::MpscRingBuffer<Entry> queue;
+    RateLimit rate_limit;
+    std::atomic<std::uint64_t> dropped{0};
+
+    std::mutex guard;
+    logging::Sink::Ptr sink;
+    std::uint64_t flush_requested{0};
+    std::uint64_t flushed{0};
+    std::condition_variable wakeup;
+    std::condition_variable flushed_cond;
+
+    biometry::util::Metrics::Counter& dropped_total;
+};
+
+class StderrSink : public logging::Sink
+{
+public:
+    void write(logging::Severity severity, std::chrono::system_clock::time_point, const char* message) override
+    {
+        std::fprintf(stderr, "[%s] %s\n", name(severity), message);
+    }
+
+    void flush() override
+    {
+        std::fflush(stderr);
+    }
+};
+
+class SyslogSink : public logging::Sink
+{
+public:
+    SyslogSink()
+    {
+        ::openlog("biometryd", LOG_PID, LOG_DAEMON);
+    }
+
+    ~SyslogSink()
+    {
+        ::closelog();
+    }
+
+    void write(logging::Severity severity, std::chrono::system_clock::time_point, const char* message) override
+    {
+        ::syslog(priority(severity), "%s", message);
+    }
+
+private:
+    static int priority(logging::Severity severity)
+    {
+        switch (severity)
+        {
+        case logging::Severity::debug: return LOG_DEBUG;
+        case logging::Severity::info: return LOG_INFO;
+        case logging::Severity::warning: return LOG_WARNING;
+        case logging::Severity::error: return LOG_ERR;
+        }
+
+        return LOG_NOTICE;
+    }
+};
+
+class FileSink : public logging::Sink
+{
+public:
+    explicit FileSink(const boost::filesystem::path& path) : file{std::fopen(path.string().c_str(), "ae")}
+    {
+        if (not file)
+            throw std::system_error{errno, std::system_category(), "Failed to open " + path.string()};
+    }
+
+    ~FileSink()
+    {
+        std::fclose(file);
+    }
+
+    void write(logging::Severity severity, std::chrono::system_clock::time_point when, const char* message) override
+    {
+        auto t = std::chrono::system_clock::to_time_t(when);
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count() % 1000000;
+
+        std::tm tm;
+        ::gmtime_r(&t, &tm);
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", &tm);
+
+        std::fprintf(file, "%s.%06lldZ [%s] %s\n", timestamp, static_cast<long long>(us), name(severity), message);
+    }
+
+    void flush() override
+    {
+        std::fflush(file);
+    }
+
+private:
+    std::FILE* file;
+};
+}
+
+std::atomic<logging::Severity> biometry::util::logging::detail::threshold{logging::Severity::info};
+
+void biometry::util::logging::Sink::flush()
+{
+}
+
+biometry::util::logging::Sink::Ptr biometry::util::logging::stderr_sink()
+{
+    return std::make_shared<StderrSink>();
+}
+
+biometry::util::logging::Sink::Ptr biometry::util::logging::syslog_sink()
+{
+    return std::make_shared<SyslogSink>();
+}
+
+biometry::util::logging::Sink::Ptr biometry::util::logging::file_sink(const boost::filesystem::path& path)
+{
+    return std::make_shared<FileSink>(path);
+}
+
+void biometry::util::logging::set_sink(const Sink::Ptr& sink)
+{
+    Logger::instance().set_sink(sink);
+}
+
+void biometry::util::logging::set_severity(Severity severity)
+{
+    detail::threshold.store(severity, std::memory_order_relaxed);
+}
+
+void biometry::util::logging::set_rate_limit(std::uint32_t messages_per_second)
+{
+    Logger::instance().set_rate_limit(messages_per_second);
+}
+
+void biometry::util::logging::flush()
+{
+    Logger::instance().flush();
+}
+
+void biometry::util::logging::detail::vwrite(Severity severity, const char* format, va_list args)
+{
+    Entry entry;
+    entry.severity = severity;
+    entry.when = std::chrono::system_clock::now();
+
+    // Truncated messages are marked with a trailing ellipsis.
+    if (std::vsnprintf(entry.message, sizeof(entry.message), format, args) >= static_cast<int>(sizeof(entry.message)))
+        std::memcpy(entry.message + sizeof(entry.message) - 4, "...", 4);
+
+    Logger::instance().push(std::move(entry));
+}
+
+std::ostream& biometry::util::logging::operator<<(std::ostream& out, Severity severity)
+{
+    return out << name(severity);
+}
+
+std::istream& biometry::util::logging::operator>>(std::istream& in, Severity& severity)
+{
+    std::string s; in >> s;
+
+    for (auto candidate : {Severity::debug, Severity::info, Severity::warning, Severity::error})
+    {
+        if (s == name(candidate))
+        {
+            severity = candidate;
+            return in;
+        }
+    }
+
+    in.setstate(std::ios_base::failbit);
+    return in;
+}
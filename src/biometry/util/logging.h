@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BIOMETRY_UTIL_LOGGING_H_
+#define BIOMETRY_UTIL_LOGGING_H_
+
+#include <biometry/visibility.h>
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+/// @brief BIOMETRY_LOGGING_MIN_SEVERITY is the numeric value of the lowest Severity compiled in.
+#ifndef BIOMETRY_LOGGING_MIN_SEVERITY
+#define BIOMETRY_LOGGING_MIN_SEVERITY 0
+#endif
+
+namespace biometry
+{
+namespace util
+{
+/// @brief logging writes leveled diagnostic messages from any thread without blocking it.
+///
+/// Messages are formatted into fixed-size entries on the calling thread, handed to a
+/// lock-free queue and written to a Sink by a background thread. Messages exceeding the
+/// rate limit or overflowing the queue are dropped and accounted for in the log.
+/// Messages below BIOMETRY_LOGGING_MIN_SEVERITY are compiled out.
+namespace logging
+{
+/// @brief Severity enumerates the levels of messages.
+enum class Severity : std::uint8_t
+{
+    debug,
+    info,
+    warning,
+    error
+};
+
+/// @brief compiled_in returns true if messages of severity have not been compiled out.
+constexpr bool compiled_in(Severity severity)
+{
+    return severity >= static_cast<Severity>(BIOMETRY_LOGGING_MIN_SEVERITY);
+}
+
+/// @brief Sink models the destination of messages.
+///
+/// A sink is only ever accessed from the background thread.
+class BIOMETRY_DLL_PUBLIC Sink
+{
+public:
+    // Safe us some typing.
+    typedef std::shared_ptr<Sink> Ptr;
+
+    virtual ~Sink() = default;
+
+    /// @brief write hands message of severity logged at when to the sink.
+    virtual void write(Severity severity, std::chrono::system_clock::time_point when, const char* message) = 0;
+    /// @brief flush is invoked whenever the queue has been drained.
+    virtual void flush();
+};
+
+/// @brief stderr_sink returns a Sink writing to stderr.
+BIOMETRY_DLL_PUBLIC Sink::Ptr stderr_sink();
+/// @brief syslog_sink returns a Sink writing to syslog, ending up in the journal on systemd-based systems.
+BIOMETRY_DLL_PUBLIC Sink::Ptr syslog_sink();
+/// @brief file_sink returns a Sink appending to the file at path.
+/// @throws std::system_error if the file cannot be opened.
+BIOMETRY_DLL_PUBLIC Sink::Ptr file_sink(const boost::filesystem::path& path);
+
+/// @brief set_sink makes all subsequently written messages go to sink, defaults to stderr_sink.
+BIOMETRY_DLL_PUBLIC void set_sink(const Sink::Ptr& sink);
+/// @brief set_severity drops all messages below severity at runtime, defaults to Severity::info.
+BIOMETRY_DLL_PUBLIC void set_severity(Severity severity);
+/// @brief set_rate_limit limits the number of messages accepted per second, 0 disables rate limiting.
+BIOMETRY_DLL_PUBLIC void set_rate_limit(std::uint32_t messages_per_second);
+/// @brief flush blocks until all messages logged before the call have been written.
+BIOMETRY_DLL_PUBLIC void flush();
+
+/// @cond
+namespace detail
+{
+BIOMETRY_DLL_PUBLIC extern std::atomic<Severity> threshold;
+
+inline bool is_enabled(Severity severity)
+{
+    return compiled_in(severity) && severity >= threshold.load(std::memory_order_relaxed);
+}
+
+BIOMETRY_DLL_PUBLIC void vwrite(Severity severity, const char* format, va_list args);
+}
+/// @endcond
+
+/// @brief debug logs a message formatted according to format with Severity::debug.
+__attribute__((format(printf, 1, 2))) inline void debug(const char* format, ...)
+{
+    if (not detail::is_enabled(Severity::debug))
+        return;
+
+    va_list args;
+    va_start(args, format);
+    detail::vwrite(Severity::debug, format, args);
+    va_end(args);
+}
+
+/// @brief info logs a message formatted according to format with Severity::info.
+__attribute__((format(printf, 1, 2))) inline void info(const char* format, ...)
+{
+    if (not detail::is_enabled(Severity::info))
+        return;
+
+    va_list args;
+    va_start(args, format);
+    detail::vwrite(Severity::info, format, args);
+    va_end(args);
+}
+
+/// @brief warning logs a message formatted according to format with Severity::warning.
+__attribute__((format(printf, 1, 2))) inline void warning(const char* format, ...)
+{
+    if (not detail::is_enabled(Severity::warning))
+        return;
+
+    va_list args;
+    va_start(args, format);
+    detail::vwrite(Severity::warning, format, args);
+    va_end(args);
+}
+
+/// @brief error logs a message formatted according to format with Severity::error.
+__attribute__((format(printf, 1, 2))) inline void error(const char* format, ...)
+{
+    if (not detail::is_enabled(Severity::error))
+        return;
+
+    va_list args;
+    va_start(args, format);
+    detail::vwrite(Severity::error, format, args);
+    va_end(args);
+}
+
+/// @brief operator<< inserts severity into out.
+BIOMETRY_DLL_PUBLIC std::ostream& operator<<(std::ostream& out, Severity severity);
+/// @brief operator>> extracts severity from in.
+BIOMETRY_DLL_PUBLIC std::istream& operator>>(std::istream& in, Severity& severity);
+}
+}
+}
+
+#endif // BIOMETRY_UTIL_LOGGING_H_
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <biometry/util/metrics.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+constexpr const char* prefix_counter{"counter:"};
+constexpr const char* prefix_gauge{"gauge:"};
+constexpr const char* prefix_histogram{"histogram:"};
+
+bool starts_with(const std::string& s, const std::string& prefix)
+{
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// decorate inserts suffix after the name part of key and adds the
+// given label, e.g., decorate("a{b=\"c\"}", "_bucket", "le=\"1\"") yields
+// a_bucket{b="c",le="1"}.
+std::string decorate(const std::string& key, const std::string& suffix, const std::string& label = std::string{})
+{
+    auto pos = key.find('{');
+
+    if (pos == std::string::npos)
+        return key + suffix + (label.empty() ? std::string{} : "{" + label + "}");
+
+    auto result = key.substr(0, pos) + suffix + key.substr(pos);
+
+    if (not label.empty())
+        result.insert(result.size() - 1, "," + label);
+
+    return result;
+}
+
+template<typename T>
+T& find_or_create(std::map<std::string, std::unique_ptr<T>>& metrics, const std::string& key)
+{
+    auto it = metrics.find(key);
+
+    if (it == metrics.end())
+        it = metrics.emplace(key, std::unique_ptr<T>{new T{}}).first;
+
+    return *it->second;
+}
+}
+
+void biometry::util::Metrics::Counter::increment(std::uint64_t delta)
+{
+    value_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+std::uint64_t biometry::util::Metrics::Counter::value() const
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+void biometry::util::Metrics::Gauge::set(std::int64_t value)
+{
+    value_.store(value, std::memory_order_relaxed);
+}
+
+void biometry::util::Metrics::Gauge::increment()
+{
+    value_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void biometry::util::Metrics::Gauge::decrement()
+{
+    value_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::int64_t biometry::util::Metrics::Gauge::value() const
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+biometry::util::Metrics::Histogram::Timer::Timer(Histogram& histogram)
+    : histogram(histogram),
+      then{std::chrono::steady_clock::now()}
+{
+}
+
+biometry::util::Metrics::Histogram::Timer::~Timer()
+{
+    histogram.observe(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - then));
+}
+
+std::uint64_t biometry::util::Metrics::Histogram::upper_bound(std::size_t bucket)
+{
+    return std::uint64_t{1} << bucket;
+}
+
+void biometry::util::Metrics::Histogram::observe(const std::chrono::microseconds& duration)
+{
+    auto value = static_cast<std::uint64_t>(std::max<std::chrono::microseconds::rep>(0, duration.count()));
+
+    // The bucket of value is the ceiling of its binary logarithm.
+    std::size_t bucket = value <= 1 ? 0 : 64 - __builtin_clzll(value - 1);
+    if (bucket >= bucket_count)
+        bucket = bucket_count - 1;
+
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t biometry::util::Metrics::Histogram::count() const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t biometry::util::Metrics::Histogram::sum() const
+{
+    return sum_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t biometry::util::Metrics::Histogram::bucket(std::size_t bucket) const
+{
+    return buckets.at(bucket).load(std::memory_order_relaxed);
+}
+
+void biometry::util::Metrics::Snapshot::from_dictionary(const biometry::Dictionary& dict)
+{
+    counters.clear();
+    gauges.clear();
+    histograms.clear();
+
+    for (const auto& pair : dict)
+    {
+        if (starts_with(pair.first, prefix_counter))
+        {
+            counters[pair.first.substr(std::strlen(prefix_counter))] = pair.second.integer();
+        }
+        else if (starts_with(pair.first, prefix_gauge))
+        {
+            gauges[pair.first.substr(std::strlen(prefix_gauge))] = pair.second.integer();
+        }
+        else if (starts_with(pair.first, prefix_histogram))
+        {
+            // Histograms are encoded as [count, sum, bucket_0, ..., bucket_n].
+            auto v = pair.second.vector();
+            if (v.size() < 2)
+                throw std::runtime_error{"Malformed histogram: " + pair.first};
+
+            Histogram h;
+            h.count = v[0].integer();
+            h.sum = v[1].integer();
+            for (std::size_t i = 2; i < v.size(); i++)
+                h.buckets.push_back(v[i].integer());
+
+            histograms[pair.first.substr(std::strlen(prefix_histogram))] = h;
+        }
+    }
+}
+
+biometry::Dictionary biometry::util::Metrics::Snapshot::to_dictionary() const
+{
+    biometry::Dictionary dict;
+
+    for (const auto& pair : counters)
+        dict[prefix_counter + pair.first] = biometry::Variant::i(pair.second);
+
+    for (const auto& pair : gauges)
+        dict[prefix_gauge + pair.first] = biometry::Variant::i(pair.second);
+
+    for (const auto& pair : histograms)
+    {
+        std::vector<biometry::Variant> v
+        {
+            biometry::Variant::i(pair.second.count),
+            biometry::Variant::i(pair.second.sum)
+        };
+
+        for (auto bucket : pair.second.buckets)
+            v.push_back(biometry::Variant::i(bucket));
+
+        dict[prefix_histogram + pair.first] = biometry::Variant::v(v);
+    }
+
+    return dict;
+}
+
+std::string biometry::util::Metrics::key(const std::string& name, const Labels& labels)
+{
+    if (labels.empty())
+        return name;
+
+    std::stringstream ss; ss << name << "{";
+
+    bool first = true;
+    for (const auto& label : labels)
+    {
+        if (not first)
+            ss << ",";
+        first = false;
+
+        ss << label.first << "=\"";
+        for (auto c : label.second)
+        {
+            if (c == '"' || c == '\\')
+                ss << '\\';
+            ss << c;
+        }
+        ss << "\"";
+    }
+
+    ss << "}";
+    return ss.str();
+}
+
+biometry::util::Metrics::Counter& biometry::util::Metrics::counter(const std::string& name, const Labels& labels)
+{
+    std::lock_guard<std::mutex> lg{guard};
+    return find_or_create(counters, key(name, labels));
+}
+
+biometry::util::Metrics::Gauge& biometry::util::Metrics::gauge(const std::string& name, const Labels& labels)
+{
+    std::lock_guard<std::mutex> lg{guard};
+    return find_or_create(gauges, key(name, labels));
+}
+
+biometry::util::Metrics::Histogram& biometry::util::Metrics::histogram(const std::string& name, const Labels& labels)
+{
+    std::lock_guard<std::mutex> lg{guard};
+    return find_or_create(histograms, key(name, labels));
+}
+
+biometry::util::Metrics::Snapshot biometry::util::Metrics::snapshot() const
+{
+    Snapshot result;
+
+    std::lock_guard<std::mutex> lg{guard};
+
+    for (const auto& pair : counters)
+        result.counters[pair.first] = pair.second->value();
+
+    for (const auto& pair : gauges)
+        result.gauges[pair.first] = pair.second->value();
+
+    for (const auto& pair : histograms)
+    {
+        auto& h = result.histograms[pair.first];
+        h.count = pair.second->count();
+        h.sum = pair.second->sum();
+
+        for (std::size_t i = 0; i < Histogram::bucket_count; i++)
+            h.buckets.push_back(pair.second->bucket(i));
+    }
+
+    return result;
+}
+
+biometry::util::Metrics& biometry::util::metrics()
+{
+    // Leaked on purpose, metrics are updated from threads that might outlive static destruction.
+    static Metrics* instance = new Metrics{};
+    return *instance;
+}
+
+std::ostream& biometry::util::operator<<(std::ostream& out, const biometry::util::Metrics::Snapshot& snapshot)
+{
+    for (const auto& pair : snapshot.counters)
+        out << pair.first << " " << pair.second << std::endl;
+
+    for (const auto& pair : snapshot.gauges)
+        out << pair.first << " " << pair.second << std::endl;
+
+    for (const auto& pair : snapshot.histograms)
+    {
+        std::uint64_t cumulative{0};
+        for (std::size_t i = 0; i < pair.second.buckets.size(); i++)
+        {
+            cumulative += pair.second.buckets[i];
+
+            auto le = i + 1 < pair.second.buckets.size() ?
+                        std::to_string(Metrics::Histogram::upper_bound(i)) : std::string{"+Inf"};
+
+            out << decorate(pair.first, "_bucket", "le=\"" + le + "\"") << " " << cumulative << std::endl;
+        }
+
+        out << decorate(pair.first, "_sum") << " " << pair.second.sum << std::endl;
+        out << decorate(pair.first, "_count") << " " << pair.second.count << std::endl;
+    }
+
+    return out;
+}
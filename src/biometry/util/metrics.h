@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BIOMETRY_UTIL_METRICS_H_
+#define BIOMETRY_UTIL_METRICS_H_
+
+#include <biometry/dictionary.h>
+#include <biometry/do_not_copy_or_move.h>
+#include <biometry/visibility.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief Metrics is a registry of named counters, gauges and histograms.
+///
+/// Looking up a metric is guarded by a mutex, updating a metric is lock-free.
+/// Metrics are never removed from the registry, references handed out by
+/// counter, gauge and histogram stay valid for the lifetime of the registry
+/// and callers on hot paths are expected to hold on to them.
+class BIOMETRY_DLL_PUBLIC Metrics : public DoNotCopyOrMove
+{
+public:
+    /// @brief Labels further qualify a metric, e.g., by the type of an operation.
+    typedef std::map<std::string, std::string> Labels;
+
+    /// @brief Counter models a monotonically increasing value.
+    class BIOMETRY_DLL_PUBLIC Counter : public DoNotCopyOrMove
+    {
+    public:
+        /// @brief increment adds delta to the counter.
+        void increment(std::uint64_t delta = 1);
+        /// @brief value returns the current value of the counter.
+        std::uint64_t value() const;
+
+    private:
+        /// @cond
+        std::atomic<std::uint64_t> value_{0};
+        /// @endcond
+    };
+
+    /// @brief Gauge models a value that goes up and down.
+    class BIOMETRY_DLL_PUBLIC Gauge : public DoNotCopyOrMove
+    {
+    public:
+        /// @brief set replaces the current value of the gauge with value.
+        void set(std::int64_t value);
+        /// @brief increment adds 1 to the gauge.
+        void increment();
+        /// @brief decrement subtracts 1 from the gauge.
+        void decrement();
+        /// @brief value returns the current value of the gauge.
+        std::int64_t value() const;
+
+    private:
+        /// @cond
+        std::atomic<std::int64_t> value_{0};
+        /// @endcond
+    };
+
+    /// @brief Histogram models the distribution of durations.
+    ///
+    /// Buckets have fixed upper bounds of 2^i µs for i in [0, bucket_count - 1),
+    /// the last bucket catches everything larger.
+    class BIOMETRY_DLL_PUBLIC Histogram : public DoNotCopyOrMove
+    {
+    public:
+        /// @brief bucket_count is the number of buckets of a histogram.
+        static constexpr const std::size_t bucket_count = 25;
+
+        /// @brief Timer records the time between its construction and destruction to a histogram.
+        class BIOMETRY_DLL_PUBLIC Timer : public DoNotCopyOrMove
+        {
+        public:
+            /// @brief Timer starts timing for histogram.
+            explicit Timer(Histogram& histogram);
+            /// @brief ~Timer records the elapsed time to the histogram.
+            ~Timer();
+
+        private:
+            /// @cond
+            Histogram& histogram;
+            std::chrono::steady_clock::time_point then;
+            /// @endcond
+        };
+
+        /// @brief upper_bound returns the inclusive upper bound of bucket in µs.
+        static std::uint64_t upper_bound(std::size_t bucket);
+
+        /// @brief observe records the given duration.
+        void observe(const std::chrono::microseconds& duration);
+        /// @brief count returns the number of observations.
+        std::uint64_t count() const;
+        /// @brief sum returns the sum of all observations in µs.
+        std::uint64_t sum() const;
+        /// @brief bucket returns the number of observations in bucket.
+        std::uint64_t bucket(std::size_t bucket) const;
+
+    private:
+        /// @cond
+        std::atomic<std::uint64_t> count_{0};
+        std::atomic<std::uint64_t> sum_{0};
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+        /// @endcond
+    };
+
+    /// @brief Snapshot is a copy of the values of all metrics in a registry at a given point in time.
+    ///
+    /// Metrics are keyed by their name and labels, following the text format
+    /// known from Prometheus, e.g., operations_started_total{type="identification"}.
+    struct BIOMETRY_DLL_PUBLIC Snapshot
+    {
+        /// @brief Histogram is a copy of the values of a Metrics::Histogram.
+        struct Histogram
+        {
+            std::uint64_t count{0}; ///< The number of observations.
+            std::uint64_t sum{0};   ///< The sum of all observations in µs.
+            std::vector<std::uint64_t> buckets; ///< The number of observations per bucket.
+        };
+
+        /// @brief from_dictionary decodes a snapshot from dict.
+        void from_dictionary(const Dictionary& dict);
+        /// @brief to_dictionary encodes a snapshot to a dictionary.
+        Dictionary to_dictionary() const;
+
+        std::map<std::string, std::uint64_t> counters; ///< All counters.
+        std::map<std::string, std::int64_t> gauges; ///< All gauges.
+        std::map<std::string, Histogram> histograms; ///< All histograms.
+    };
+
+    /// @brief key returns the key identifying the metric with name and labels.
+    static std::string key(const std::string& name, const Labels& labels = Labels{});
+
+    /// @brief counter returns the counter with name and labels, creating it if it does not exist yet.
+    Counter& counter(const std::string& name, const Labels& labels = Labels{});
+    /// @brief gauge returns the gauge with name and labels, creating it if it does not exist yet.
+    Gauge& gauge(const std::string& name, const Labels& labels = Labels{});
+    /// @brief histogram returns the histogram with name and labels, creating it if it does not exist yet.
+    Histogram& histogram(const std::string& name, const Labels& labels = Labels{});
+
+    /// @brief snapshot returns the current values of all metrics.
+    Snapshot snapshot() const;
+
+private:
+    /// @cond
+    mutable std::mutex guard;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    /// @endcond
+};
+
+/// @brief metrics returns the process-wide registry.
+BIOMETRY_DLL_PUBLIC Metrics& metrics();
+
+/// @brief operator<< inserts snapshot into out, in the text format known from Prometheus.
+BIOMETRY_DLL_PUBLIC std::ostream& operator<<(std::ostream& out, const Metrics::Snapshot& snapshot);
+}
+}
+
+#endif // BIOMETRY_UTIL_METRICS_H_
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRY_UTIL_MPSC_QUEUE_H_
+#define BIOMETRY_UTIL_MPSC_QUEUE_H_
+
+#include <biometry/do_not_copy_or_move.h>
+
+#include <biometry/util/logging.h>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief MpscQueue is an unbounded, lock-free queue accepting values from multiple
+/// producers and handing them out in batches to a single consumer.
+///
+/// Producers push onto an atomic list head. The consumer detaches the complete list
+/// in one atomic exchange and processes it in FIFO order, such that a single wake-up
+/// of the consumer suffices for draining an arbitrary number of values.
+template<typename T>
+class MpscQueue : public DoNotCopyOrMove
+{
+public:
+    MpscQueue() = default;
+
+    /// @brief ~MpscQueue releases all values that have not been drained.
+    ~MpscQueue()
+    {
+        release(head.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    /// @brief push appends value to the queue.
+    ///
+    /// Safe to call from multiple threads concurrently.
+    /// @return true if the queue was empty before, i.e., if the consumer needs to be woken up.
+    bool push(T&& value)
+    {
+        auto node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (not head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+        return node->next == nullptr;
+    }
+
+    /// @brief drain hands all values pushed so far to f in FIFO order, removing them from the queue.
+    ///
+    /// Must only be called from the single consumer thread. Exceptions thrown by f are
+    /// logged and do not prevent the remaining values from being handed to f.
+    /// @return the number of values handed to f.
+    template<typename F>
+    std::size_t drain(F&& f)
+    {
+        // Detached nodes are in LIFO order, reversing them restores FIFO order.
+        Node* fifo = nullptr;
+        for (auto node = head.exchange(nullptr, std::memory_order_acquire); node;)
+        {
+            auto next = node->next;
+            node->next = fifo;
+            fifo = node;
+            node = next;
+        }
+
+        std::size_t count{0};
+        while (fifo)
+        {
+            auto node = fifo;
+            fifo = fifo->next;
+
+            try
+            {
+                f(node->value);
+            }
+            catch (const std::exception& e)
+            {
+                biometry::util::logging::error("%s", e.what());
+            }
+            catch (...)
+            {
+                biometry::util::logging::error("Unknown exception caught while draining queue");
+            }
+
+            delete node;
+            ++count;
+        }
+
+        return count;
+    }
+
+private:
+    struct Node
+    {
+        T value;
+        Node* next;
+    };
+
+    static void release(Node* node)
+    {
+        while (node)
+        {
+            auto next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    std::atomic<Node*> head{nullptr};
+};
+}
+}
+
+#endif // BIOMETRY_UTIL_MPSC_QUEUE_H_
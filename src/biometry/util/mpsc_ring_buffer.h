@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRY_UTIL_MPSC_RING_BUFFER_H_
+#define BIOMETRY_UTIL_MPSC_RING_BUFFER_H_
+
+#include <biometry/do_not_copy_or_move.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief MpscRingBuffer is a bounded, lock-free queue accepting values from multiple
+/// producers and handing them to exactly one consumer.
+///
+/// Slots are allocated once at construction time and carry a sequence number
+/// that tells producers and the consumer whether a slot is free or filled,
+/// following Dmitry Vyukov's bounded queue design.
+template<typename T>
+class MpscRingBuffer : public DoNotCopyOrMove
+{
+public:
+    /// @brief MpscRingBuffer initializes a new instance with room for capacity values.
+    /// @throws std::invalid_argument if capacity is not a power of 2.
+    explicit MpscRingBuffer(std::size_t capacity)
+        : mask{capacity - 1},
+          slots{new Slot[capacity]}
+    {
+        if (capacity < 2 || (capacity & mask) != 0)
+            throw std::invalid_argument{"MpscRingBuffer capacity must be a power of 2"};
+
+        for (std::size_t i = 0; i < capacity; i++)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// @brief try_push moves value into the queue if there is room left, returning false otherwise.
+    ///
+    /// Safe to call from multiple threads concurrently.
+    bool try_push(T&& value)
+    {
+        auto pos = enqueue_pos.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto& slot = slots[pos & mask];
+            auto seq = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The consumer has not yet drained the slot, we are full.
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief try_pop moves the oldest value into value, returning false if the queue is empty.
+    ///
+    /// Must only be called from the single consumer thread.
+    bool try_pop(T& value)
+    {
+        auto& slot = slots[dequeue_pos & mask];
+
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos + 1)
+            return false;
+
+        value = std::move(slot.value);
+        // Leave a moved-from value in the slot, releasing resources held by the
+        // value before the slot is handed back to producers.
+        slot.value = T{};
+        slot.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+        ++dequeue_pos;
+
+        return true;
+    }
+
+    /// @brief empty returns true if the consumer would not be able to pop a value.
+    ///
+    /// Must only be called from the single consumer thread.
+    bool empty() const
+    {
+        return slots[dequeue_pos & mask].sequence.load(std::memory_order_acquire) != dequeue_pos + 1;
+    }
+
+    /// @brief capacity returns the maximum number of values held in the queue.
+    std::size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+private:
+    // We keep producer and consumer state on separate cache lines
+    // to prevent false sharing between them.
+    static constexpr const std::size_t cache_line_size = 64;
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(cache_line_size) std::size_t dequeue_pos{0};
+};
+}
+}
+
+#endif // BIOMETRY_UTIL_MPSC_RING_BUFFER_H_
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <biometry/util/tracing.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+// Event is a copy of a recorded event, handed out while dumping.
+struct Event
+{
+    std::uint64_t timestamp;
+    biometry::util::tracing::SpanId span;
+    const char* name;
+    char phase;
+};
+
+// Ring is a fixed-size ring buffer of events with exactly one writer, the thread owning it.
+//
+// Every slot is guarded by a sequence number, following the seqlock pattern: the writer
+// marks a slot as being written by an odd sequence number and readers discard slots that
+// were modified while being read.
+class Ring
+{
+public:
+    static constexpr const std::size_t capacity = 4096;
+
+    explicit Ring(std::uint32_t tid) : tid{tid}, slots{new Slot[capacity]}
+    {
+    }
+
+    void push(biometry::util::tracing::detail::Phase phase, biometry::util::tracing::SpanId span, const char* name, std::uint64_t timestamp)
+    {
+        auto pos = head.load(std::memory_order_relaxed);
+        auto& slot = slots[pos & (capacity - 1)];
+
+        slot.sequence.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.timestamp.store(timestamp, std::memory_order_relaxed);
+        slot.span.store(span, std::memory_order_relaxed);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.phase.store(static_cast<char>(phase), std::memory_order_relaxed);
+
+        slot.sequence.store(2 * pos + 2, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_release);
+    }
+
+    template<typename F>
+    void for_each(F f) const
+    {
+        auto end = head.load(std::memory_order_acquire);
+        auto begin = end > capacity ? end - capacity : 0;
+
+        for (auto pos = begin; pos < end; pos++)
+        {
+            const auto& slot = slots[pos & (capacity - 1)];
+
+            auto seq = slot.sequence.load(std::memory_order_acquire);
+            if (seq != 2 * pos + 2)
+                continue;
+
+            Event event
+            {
+                slot.timestamp.load(std::memory_order_relaxed),
+                slot.span.load(std::memory_order_relaxed),
+                slot.name.load(std::memory_order_relaxed),
+                slot.phase.load(std::memory_order_relaxed)
+            };
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != seq)
+                continue;
+
+            f(event);
+        }
+    }
+
+    const std::uint32_t tid;
+    // Rings of finished threads are handed over to new threads.
+    std::atomic<bool> in_use{true};
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> timestamp{0};
+        std::atomic<biometry::util::tracing::SpanId> span{biometry::util::tracing::no_span};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<char> phase{0};
+    };
+
+    std::atomic<std::uint64_t> head{0};
+    std::unique_ptr<Slot[]> slots;
+};
+
+// Registry knows about all rings ever handed out.
+class Registry
+{
+public:
+    Ring* acquire()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        for (const auto& ring : rings)
+        {
+            bool expected{false};
+            if (ring->in_use.compare_exchange_strong(expected, true))
+                return ring.get();
+        }
+
+        rings.emplace_back(new Ring{static_cast<std::uint32_t>(rings.size() + 1)});
+        return rings.back().get();
+    }
+
+    template<typename F>
+    void for_each(F f) const
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        for (const auto& ring : rings)
+            ring->for_each([&ring, &f](const Event& event) { f(ring->tid, event); });
+    }
+
+private:
+    mutable std::mutex guard;
+    std::vector<std::unique_ptr<Ring>> rings;
+};
+
+Registry& registry()
+{
+    // Leaked on purpose, threads might record events during static destruction.
+    static Registry* instance = new Registry{};
+    return *instance;
+}
+
+// RingHolder hands the ring of a thread back to the registry when the thread finishes.
+struct RingHolder
+{
+    ~RingHolder()
+    {
+        if (ring)
+            ring->in_use.store(false);
+    }
+
+    Ring* ring{nullptr};
+};
+
+thread_local RingHolder ring_holder;
+thread_local biometry::util::tracing::Span current_span;
+
+std::atomic<biometry::util::tracing::SpanId> next_span{biometry::util::tracing::no_span};
+}
+
+std::atomic<bool> biometry::util::tracing::detail::is_enabled{false};
+
+void biometry::util::tracing::detail::record(Phase phase, SpanId span, const char* name)
+{
+    if (not ring_holder.ring)
+        ring_holder.ring = registry().acquire();
+
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+    ring_holder.ring->push(phase, span, name, now.count());
+}
+
+void biometry::util::tracing::enable()
+{
+    detail::is_enabled.store(true);
+}
+
+void biometry::util::tracing::disable()
+{
+    detail::is_enabled.store(false);
+}
+
+biometry::util::tracing::Span biometry::util::tracing::current()
+{
+    return current_span;
+}
+
+biometry::util::tracing::Scope::Scope(const Span& span) : previous{current_span}
+{
+    current_span = span;
+}
+
+biometry::util::tracing::Scope::~Scope()
+{
+    current_span = previous;
+}
+
+biometry::util::tracing::Span biometry::util::tracing::begin_span(const char* name)
+{
+    Span span; span.name = name;
+
+    if (not enabled())
+        return span;
+
+    span.id = next_span.fetch_add(1, std::memory_order_relaxed) + 1;
+    detail::record(detail::Phase::begin, span.id, span.name);
+    return span;
+}
+
+void biometry::util::tracing::dump(std::ostream& out)
+{
+    auto pid = ::getpid();
+
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+    registry().for_each([&out, &first, pid](std::uint32_t tid, const Event& event)
+    {
+        if (not first)
+            out << ",";
+        first = false;
+
+        // Chrome expects timestamps in µs, we keep the sub-µs resolution.
+        out << "\n{\"name\":\"" << event.name << "\",\"cat\":\"biometryd\",\"ph\":\"" << event.phase
+            << "\",\"id\":" << event.span << ",\"ts\":" << event.timestamp / 1000 << "." << (event.timestamp % 1000) / 100
+            << ",\"pid\":" << pid << ",\"tid\":" << tid << "}";
+    });
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
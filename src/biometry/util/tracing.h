@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BIOMETRY_UTIL_TRACING_H_
+#define BIOMETRY_UTIL_TRACING_H_
+
+#include <biometry/visibility.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+namespace biometry
+{
+namespace util
+{
+/// @brief tracing records timestamped events of operation spans.
+///
+/// A span follows an operation from the skeleton method handler to the final
+/// reply to the remote observer. Events are written to a lock-free ring buffer
+/// owned by the calling thread and can be dumped as Chrome trace JSON, loadable
+/// in chrome://tracing or Perfetto. With tracing disabled, no spans are created
+/// and recording an event boils down to a relaxed load.
+namespace tracing
+{
+/// @brief SpanId uniquely identifies a span.
+typedef std::uint64_t SpanId;
+
+/// @brief no_span is handed out while tracing is disabled, events for it are dropped.
+static constexpr const SpanId no_span{0};
+
+/// @brief Span bundles the id and the name of a span.
+struct Span
+{
+    SpanId id{no_span}; ///< Unique id of the span.
+    const char* name{""}; ///< Name of the span, has to be a string literal.
+};
+
+/// @cond
+namespace detail
+{
+BIOMETRY_DLL_PUBLIC extern std::atomic<bool> is_enabled;
+
+enum class Phase : char
+{
+    begin = 'b',
+    end = 'e',
+    instant = 'n'
+};
+
+BIOMETRY_DLL_PUBLIC void record(Phase phase, SpanId span, const char* name);
+}
+/// @endcond
+
+/// @brief enabled returns true if events are recorded.
+inline bool enabled()
+{
+    return detail::is_enabled.load(std::memory_order_relaxed);
+}
+
+/// @brief enable starts recording events.
+BIOMETRY_DLL_PUBLIC void enable();
+/// @brief disable stops recording events.
+BIOMETRY_DLL_PUBLIC void disable();
+
+/// @brief current returns the span the calling thread is working on.
+BIOMETRY_DLL_PUBLIC Span current();
+
+/// @brief Scope makes a span the current one of the calling thread for its lifetime.
+class BIOMETRY_DLL_PUBLIC Scope
+{
+public:
+    /// @brief Scope makes span the current span of the calling thread.
+    explicit Scope(const Span& span);
+    Scope(const Scope&) = delete;
+    /// @brief ~Scope restores the previously current span.
+    ~Scope();
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    /// @cond
+    Span previous;
+    /// @endcond
+};
+
+/// @brief begin_span creates a new span named name, returning a span with id no_span if tracing is disabled.
+///
+/// name has to outlive the recorded events, i.e., has to be a string literal.
+BIOMETRY_DLL_PUBLIC Span begin_span(const char* name);
+
+/// @brief end_span marks the end of span.
+inline void end_span(const Span& span)
+{
+    if (span.id != no_span && enabled())
+        detail::record(detail::Phase::end, span.id, span.name);
+}
+
+/// @brief begin marks the beginning of a slice name nested in span.
+inline void begin(const Span& span, const char* name)
+{
+    if (span.id != no_span && enabled())
+        detail::record(detail::Phase::begin, span.id, name);
+}
+
+/// @brief end marks the end of a slice name nested in span.
+inline void end(const Span& span, const char* name)
+{
+    if (span.id != no_span && enabled())
+        detail::record(detail::Phase::end, span.id, name);
+}
+
+/// @brief instant marks an event name happening now on span.
+inline void instant(const Span& span, const char* name)
+{
+    if (span.id != no_span && enabled())
+        detail::record(detail::Phase::instant, span.id, name);
+}
+
+/// @brief dump writes all events still held in the per-thread ring buffers to out as Chrome trace JSON.
+///
+/// Safe to call while other threads keep on recording events.
+BIOMETRY_DLL_PUBLIC void dump(std::ostream& out);
+}
+}
+}
+
+#endif // BIOMETRY_UTIL_TRACING_H_
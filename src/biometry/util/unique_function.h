@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BIOMETRY_UTIL_UNIQUE_FUNCTION_H_
+#define BIOMETRY_UTIL_UNIQUE_FUNCTION_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace biometry
+{
+namespace util
+{
+/// @cond
+template<typename Signature, std::size_t inline_size = 6 * sizeof(void*)>
+class UniqueFunction;
+/// @endcond
+
+/// @brief UniqueFunction is a move-only, type-erased function wrapper.
+///
+/// In contrast to std::function, UniqueFunction neither requires the wrapped
+/// functor to be copyable nor ever copies it. Functors of up to inline_size bytes
+/// that are nothrow move constructible are stored in place, all others are
+/// allocated on the heap.
+template<typename R, typename... Args, std::size_t inline_size>
+class UniqueFunction<R(Args...), inline_size>
+{
+public:
+    /// @brief UniqueFunction initializes an empty instance.
+    UniqueFunction() noexcept = default;
+
+    /// @brief UniqueFunction initializes an empty instance.
+    UniqueFunction(std::nullptr_t) noexcept
+    {
+    }
+
+    /// @brief UniqueFunction initializes a new instance, taking over f.
+    template<
+        typename F,
+        typename = typename std::enable_if<not std::is_same<typename std::decay<F>::type, UniqueFunction>::value>::type>
+    UniqueFunction(F&& f)
+    {
+        typedef typename std::decay<F>::type Functor;
+        emplace<Functor>(std::forward<F>(f), std::integral_constant<bool, is_stored_inline<Functor>()>{});
+    }
+
+    /// @brief UniqueFunction takes over the functor held by rhs, leaving rhs empty.
+    UniqueFunction(UniqueFunction&& rhs) noexcept
+    {
+        take_over(rhs);
+    }
+
+    UniqueFunction(const UniqueFunction&) = delete;
+
+    ~UniqueFunction()
+    {
+        reset();
+    }
+
+    /// @brief operator= releases the currently held functor and takes over the one held by rhs.
+    UniqueFunction& operator=(UniqueFunction&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            reset();
+            take_over(rhs);
+        }
+
+        return *this;
+    }
+
+    /// @brief operator= releases the currently held functor.
+    UniqueFunction& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    UniqueFunction& operator=(const UniqueFunction&) = delete;
+
+    /// @brief operator bool returns true if a functor is held by this instance.
+    explicit operator bool() const noexcept
+    {
+        return ops != nullptr;
+    }
+
+    /// @brief operator() invokes the held functor with args.
+    /// @throws std::bad_function_call if the instance is empty.
+    R operator()(Args... args)
+    {
+        if (not ops)
+            throw std::bad_function_call{};
+
+        return ops->invoke(&storage, std::forward<Args>(args)...);
+    }
+
+private:
+    typedef typename std::aligned_storage<inline_size, alignof(std::max_align_t)>::type Storage;
+
+    // Operations bundles the type-specific operations for a stored functor.
+    struct Operations
+    {
+        R (*invoke)(Storage*, Args&&...);
+        // move move-constructs the functor from the first into the second
+        // storage, and destroys the moved-from functor.
+        void (*move)(Storage*, Storage*) noexcept;
+        void (*destroy)(Storage*) noexcept;
+    };
+
+    template<typename Functor>
+    static constexpr bool is_stored_inline()
+    {
+        return sizeof(Functor) <= sizeof(Storage) &&
+               alignof(Storage) % alignof(Functor) == 0 &&
+               std::is_nothrow_move_constructible<Functor>::value;
+    }
+
+    template<typename Functor>
+    struct Inline
+    {
+        static Functor* get(Storage* s)
+        {
+            return reinterpret_cast<Functor*>(s);
+        }
+
+        static R invoke(Storage* s, Args&&... args)
+        {
+            return (*get(s))(std::forward<Args>(args)...);
+        }
+
+        static void move(Storage* from, Storage* to) noexcept
+        {
+            new (to) Functor{std::move(*get(from))};
+            get(from)->~Functor();
+        }
+
+        static void destroy(Storage* s) noexcept
+        {
+            get(s)->~Functor();
+        }
+
+        static const Operations* operations()
+        {
+            static constexpr const Operations instance{invoke, move, destroy};
+            return &instance;
+        }
+    };
+
+    template<typename Functor>
+    struct Allocated
+    {
+        static Functor*& get(Storage* s)
+        {
+            return *reinterpret_cast<Functor**>(s);
+        }
+
+        static R invoke(Storage* s, Args&&... args)
+        {
+            return (*get(s))(std::forward<Args>(args)...);
+        }
+
+        static void move(Storage* from, Storage* to) noexcept
+        {
+            new (to) Functor*{get(from)};
+        }
+
+        static void destroy(Storage* s) noexcept
+        {
+            delete get(s);
+        }
+
+        static const Operations* operations()
+        {
+            static constexpr const Operations instance{invoke, move, destroy};
+            return &instance;
+        }
+    };
+
+    template<typename Functor, typename F>
+    void emplace(F&& f, std::true_type)
+    {
+        new (&storage) Functor(std::forward<F>(f));
+        ops = Inline<Functor>::operations();
+    }
+
+    template<typename Functor, typename F>
+    void emplace(F&& f, std::false_type)
+    {
+        new (&storage) Functor*{new Functor(std::forward<F>(f))};
+        ops = Allocated<Functor>::operations();
+    }
+
+    void take_over(UniqueFunction& rhs) noexcept
+    {
+        if (rhs.ops)
+        {
+            rhs.ops->move(&rhs.storage, &storage);
+            ops = rhs.ops;
+            rhs.ops = nullptr;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (ops)
+        {
+            ops->destroy(&storage);
+            ops = nullptr;
+        }
+    }
+
+    Storage storage;
+    const Operations* ops{nullptr};
+};
+}
+}
+
+#endif // BIOMETRY_UTIL_UNIQUE_FUNCTION_H_
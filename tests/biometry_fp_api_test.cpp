@@ -0,0 +1,523 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "biometry_fp_api_test.h"
+
+#include <biometry/devices/simulated.h>
+#include <biometry/util/json_configuration_builder.h>
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Safe us some typing.
+typedef biometry::devices::Simulated::Latency Latency;
+typedef biometry::devices::Simulated::Model Model;
+typedef std::chrono::steady_clock Clock;
+
+constexpr const std::uint64_t device_id{42};
+
+// load_model decodes the model from the file referenced by BIOMETRYD_FP_API_TEST_CONFIG,
+// falling back to a model responding without any delay.
+Model load_model()
+{
+    if (auto path = std::getenv("BIOMETRYD_FP_API_TEST_CONFIG"))
+    {
+        std::ifstream in{path};
+        if (not in)
+            throw std::runtime_error{std::string{"Failed to open sensor configuration: "} + path};
+
+        biometry::util::JsonConfigurationBuilder builder{in};
+        return Model::from_configuration(builder.build_configuration().root());
+    }
+
+    Model model;
+    model.latency.touch = model.latency.enroll = model.latency.identify = model.latency.verify = Latency::fixed(0);
+    model.latency.size = model.latency.list = model.latency.remove = model.latency.clear = Latency::fixed(0);
+    return model;
+}
+
+// Sensor models a fingerprint HAL, keeping the templates of all groups in memory.
+//
+// Just like the HIDL HAL, Sensor handles a single request at a time, with a new request
+// superseding the current one. Callbacks are delivered from a dedicated thread to the
+// most recently registered set of callbacks, never holding any locks.
+class Sensor
+{
+public:
+    typedef std::vector<std::function<void()>> Notifications;
+
+    // instance returns the process-wide sensor. The instance is never destroyed
+    // as callbacks might still be in flight when the process exits.
+    static Sensor& instance()
+    {
+        static Sensor* sensor = new Sensor{};
+        return *sensor;
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        model = load_model();
+        rng.seed(model.seed);
+        params = UHardwareBiometryParams{};
+        ++current;
+        active = false;
+        has_group = false;
+        path.clear();
+        templates.clear();
+        authenticator_id = 0;
+        rejections = 0;
+        locked_out_until = Clock::time_point{};
+    }
+
+    const char* active_group_path()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return has_group ? path.c_str() : nullptr;
+    }
+
+    uint64_t set_notify(const UHardwareBiometryParams* p)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        params = p ? *p : UHardwareBiometryParams{};
+        return device_id;
+    }
+
+    uint64_t pre_enroll()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return std::uniform_int_distribution<std::uint64_t>{1}(rng);
+    }
+
+    UHardwareBiometryRequestStatus enroll(uint32_t gid, uint32_t timeout_sec)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (not has_group)
+            return SYS_EINVAL;
+
+        auto token = begin();
+
+        if (templates[gid].size() >= model.capacity)
+        {
+            after(std::chrono::milliseconds{0}, token, [this](Notifications& n)
+            {
+                finish();
+                error(n, ERROR_NO_SPACE);
+            });
+            return SYS_OK;
+        }
+
+        // A timeout of 0 disables timeouts.
+        std::chrono::milliseconds timeout{timeout_sec > 0 ? std::chrono::seconds{timeout_sec} : std::chrono::milliseconds::max()};
+        enroll_step(token, gid, next_finger_id++, std::max<std::uint32_t>(model.enrollment_steps, 1), timeout);
+        return SYS_OK;
+    }
+
+    UHardwareBiometryRequestStatus post_enroll()
+    {
+        return SYS_OK;
+    }
+
+    uint64_t get_authenticator_id()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return authenticator_id;
+    }
+
+    UHardwareBiometryRequestStatus cancel()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (not active)
+            return SYS_OK;
+
+        ++current;
+        active = false;
+
+        auto p = params;
+        service.post([p]()
+        {
+            if (p.error_cb)
+                p.error_cb(device_id, ERROR_CANCELED, 0, p.context);
+        });
+
+        return SYS_OK;
+    }
+
+    UHardwareBiometryRequestStatus enumerate()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (not has_group)
+            return SYS_EINVAL;
+
+        auto gid = group;
+        after(model.latency.list.sample(rng), begin(), [this, gid](Notifications& n)
+        {
+            finish();
+
+            const auto& fingers = templates[gid];
+            if (fingers.empty())
+                enumerated(n, 0, gid, 0);
+
+            auto remaining = static_cast<std::uint32_t>(fingers.size());
+            for (auto fid : fingers)
+                enumerated(n, fid, gid, --remaining);
+        });
+
+        return SYS_OK;
+    }
+
+    UHardwareBiometryRequestStatus remove(uint32_t gid, uint32_t fid)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (not has_group)
+            return SYS_EINVAL;
+
+        // A finger id of 0 removes all templates of the group.
+        if (fid == 0)
+        {
+            after(model.latency.clear.sample(rng), begin(), [this, gid](Notifications& n)
+            {
+                finish();
+
+                auto& fingers = templates[gid];
+                if (fingers.empty())
+                    removed(n, 0, gid, 0);
+
+                auto remaining = static_cast<std::uint32_t>(fingers.size());
+                for (auto f : fingers)
+                    removed(n, f, gid, --remaining);
+
+                fingers.clear();
+                authenticator_id = 0;
+            });
+        }
+        else
+        {
+            after(model.latency.remove.sample(rng), begin(), [this, gid, fid](Notifications& n)
+            {
+                finish();
+
+                auto& fingers = templates[gid];
+                if (fingers.erase(fid) == 0)
+                    return error(n, ERROR_UNABLE_TO_REMOVE);
+
+                removed(n, fid, gid, 0);
+                if (fingers.empty())
+                    authenticator_id = 0;
+            });
+        }
+
+        return SYS_OK;
+    }
+
+    UHardwareBiometryRequestStatus set_active_group(uint32_t gid, const char* store_path)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (not store_path)
+            return SYS_EINVAL;
+
+        group = gid;
+        path = store_path;
+        has_group = true;
+
+        return SYS_OK;
+    }
+
+    UHardwareBiometryRequestStatus authenticate(uint32_t gid)
+    {
+        std::lock_guard<std::mutex> lg{guard};
+
+        if (not has_group)
+            return SYS_EINVAL;
+
+        auto token = begin();
+
+        if (Clock::now() < locked_out_until)
+        {
+            after(std::chrono::milliseconds{0}, token, [this](Notifications& n)
+            {
+                finish();
+                error(n, ERROR_LOCKOUT);
+            });
+            return SYS_OK;
+        }
+
+        // In contrast to the HAL, we finish after the first attempt. devices::android
+        // considers a rejection final and would otherwise see callbacks after the
+        // operation has been released.
+        after(model.latency.touch.sample(rng) + model.latency.identify.sample(rng), token, [this, gid](Notifications& n)
+        {
+            finish();
+            acquired(n, ACQUIRED_GOOD);
+
+            if (std::bernoulli_distribution{model.failure_rate}(rng))
+                return error(n, ERROR_UNABLE_TO_PROCESS);
+
+            const auto& fingers = templates[gid];
+            if (fingers.empty() || std::bernoulli_distribution{model.rejection_rate}(rng))
+            {
+                authenticated(n, 0, gid);
+
+                if (model.lockout.attempts > 0 && ++rejections >= model.lockout.attempts)
+                {
+                    rejections = 0;
+                    locked_out_until = Clock::now() + model.lockout.duration;
+                }
+
+                return;
+            }
+
+            rejections = 0;
+            auto it = fingers.begin();
+            std::advance(it, std::uniform_int_distribution<std::size_t>{0, fingers.size() - 1}(rng));
+            authenticated(n, *it, gid);
+        });
+
+        return SYS_OK;
+    }
+
+private:
+    Sensor() : keep_alive{service}, worker{[this]() { service.run(); }}
+    {
+        reset();
+    }
+
+    // begin starts a new request, superseding the current one. Must be called with guard held.
+    std::uint64_t begin()
+    {
+        active = true;
+        return ++current;
+    }
+
+    // finish marks the current request as done. Must be called with guard held.
+    void finish()
+    {
+        active = false;
+    }
+
+    // after runs step with guard held once delay has passed, unless the request
+    // identified by token has been superseded. Notifications collected by step are
+    // delivered after releasing guard.
+    void after(const std::chrono::milliseconds& delay, std::uint64_t token, const std::function<void(Notifications&)>& step)
+    {
+        auto timer = std::make_shared<boost::asio::steady_timer>(service, delay);
+        timer->async_wait([this, timer, token, step](const boost::system::error_code& ec)
+        {
+            if (ec)
+                return;
+
+            Notifications notifications;
+            {
+                std::lock_guard<std::mutex> lg{guard};
+                if (token != current)
+                    return;
+                step(notifications);
+            }
+
+            for (const auto& notification : notifications)
+                notification();
+        });
+    }
+
+    // enroll_step schedules the next touch of an enrollment. Must be called with guard held.
+    void enroll_step(std::uint64_t token, uint32_t gid, uint32_t fid, uint32_t remaining, const std::chrono::milliseconds& timeout)
+    {
+        auto touch = model.latency.touch.sample(rng);
+        if (touch > timeout)
+        {
+            after(timeout, token, [this](Notifications& n)
+            {
+                finish();
+                error(n, ERROR_TIMEOUT);
+            });
+            return;
+        }
+
+        after(touch + model.latency.enroll.sample(rng), token, [this, token, gid, fid, remaining, timeout](Notifications& n)
+        {
+            acquired(n, ACQUIRED_GOOD);
+
+            if (std::bernoulli_distribution{model.failure_rate}(rng))
+            {
+                finish();
+                return error(n, ERROR_UNABLE_TO_PROCESS);
+            }
+
+            if (remaining > 1)
+            {
+                enroll_step(token, gid, fid, remaining - 1, timeout);
+            }
+            else
+            {
+                finish();
+                templates[gid].insert(fid);
+                authenticator_id = std::uniform_int_distribution<std::uint64_t>{1}(rng);
+            }
+
+            enroll_result(n, fid, gid, remaining - 1);
+        });
+    }
+
+    void acquired(Notifications& n, UHardwareBiometryFingerprintAcquiredInfo info)
+    {
+        auto p = params;
+        n.push_back([p, info]() { if (p.acquired_cb) p.acquired_cb(device_id, info, 0, p.context); });
+    }
+
+    void enroll_result(Notifications& n, uint32_t fid, uint32_t gid, uint32_t remaining)
+    {
+        auto p = params;
+        n.push_back([p, fid, gid, remaining]() { if (p.enrollresult_cb) p.enrollresult_cb(device_id, fid, gid, remaining, p.context); });
+    }
+
+    void authenticated(Notifications& n, uint32_t fid, uint32_t gid)
+    {
+        auto p = params;
+        n.push_back([p, fid, gid]() { if (p.authenticated_cb) p.authenticated_cb(device_id, fid, gid, p.context); });
+    }
+
+    void error(Notifications& n, UHardwareBiometryFingerprintError error)
+    {
+        auto p = params;
+        n.push_back([p, error]() { if (p.error_cb) p.error_cb(device_id, error, 0, p.context); });
+    }
+
+    void removed(Notifications& n, uint32_t fid, uint32_t gid, uint32_t remaining)
+    {
+        auto p = params;
+        n.push_back([p, fid, gid, remaining]() { if (p.removed_cb) p.removed_cb(device_id, fid, gid, remaining, p.context); });
+    }
+
+    void enumerated(Notifications& n, uint32_t fid, uint32_t gid, uint32_t remaining)
+    {
+        auto p = params;
+        n.push_back([p, fid, gid, remaining]() { if (p.enumerate_cb) p.enumerate_cb(device_id, fid, gid, remaining, p.context); });
+    }
+
+    std::mutex guard;
+    Model model;
+    std::mt19937 rng;
+    UHardwareBiometryParams params;
+    std::uint64_t current{0};
+    bool active{false};
+    bool has_group{false};
+    std::uint32_t group{0};
+    std::string path;
+    std::map<std::uint32_t, std::set<std::uint32_t>> templates;
+    std::uint32_t next_finger_id{1};
+    std::uint64_t authenticator_id{0};
+    std::uint32_t rejections{0};
+    Clock::time_point locked_out_until;
+
+    boost::asio::io_service service;
+    boost::asio::io_service::work keep_alive;
+    // Stands in for the binder thread delivering callbacks.
+    std::thread worker;
+};
+
+Sensor& sensor(UHardwareBiometry self)
+{
+    return *reinterpret_cast<Sensor*>(self);
+}
+}
+
+UHardwareBiometry u_hardware_biometry_new()
+{
+    return reinterpret_cast<UHardwareBiometry>(&Sensor::instance());
+}
+
+uint64_t u_hardware_biometry_setNotify(UHardwareBiometry self, UHardwareBiometryParams* params)
+{
+    return sensor(self).set_notify(params);
+}
+
+uint64_t u_hardware_biometry_preEnroll(UHardwareBiometry self)
+{
+    return sensor(self).pre_enroll();
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_enroll(UHardwareBiometry self, uint32_t gid, uint32_t timeoutSec, uint32_t)
+{
+    return sensor(self).enroll(gid, timeoutSec);
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_postEnroll(UHardwareBiometry self)
+{
+    return sensor(self).post_enroll();
+}
+
+uint64_t u_hardware_biometry_getAuthenticatorId(UHardwareBiometry self)
+{
+    return sensor(self).get_authenticator_id();
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_cancel(UHardwareBiometry self)
+{
+    return sensor(self).cancel();
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_enumerate(UHardwareBiometry self)
+{
+    return sensor(self).enumerate();
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_remove(UHardwareBiometry self, uint32_t gid, uint32_t fid)
+{
+    return sensor(self).remove(gid, fid);
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_setActiveGroup(UHardwareBiometry self, uint32_t gid, char* storePath)
+{
+    return sensor(self).set_active_group(gid, storePath);
+}
+
+UHardwareBiometryRequestStatus u_hardware_biometry_authenticate(UHardwareBiometry self, uint64_t, uint32_t gid)
+{
+    return sensor(self).authenticate(gid);
+}
+
+const char* biometry_fp_api_test_active_group_path()
+{
+    return Sensor::instance().active_group_path();
+}
+
+void biometry_fp_api_test_reset()
+{
+    Sensor::instance().reset();
+}
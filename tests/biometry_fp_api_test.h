@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TESTING_BIOMETRY_FP_API_TEST_H_
+#define TESTING_BIOMETRY_FP_API_TEST_H_
+
+#include <biometry/hardware/biometry.h>
+
+// libbiometry_fp_api_test.so implements all u_hardware_biometry_* entry points
+// against a simulated sensor, delivering callbacks from its own thread in the
+// same way the binder threads of the HIDL fingerprint HAL do. The bridge picks it up
+// instead of the actual HAL if UBUNTU_PLATFORM_API_TEST_OVERRIDE is set in the environment.
+//
+// The sensor is configured from the JSON file pointed to by BIOMETRYD_FP_API_TEST_CONFIG,
+// accepting the same model as the Simulated device (see biometry::devices::Simulated::Model).
+// Without a configuration, the sensor responds without any delay.
+//
+// Beyond the HAL, the library exports the following hooks for tests to inspect
+// and reset the sensor, to be resolved with dlsym.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief biometry_fp_api_test_active_group_path returns the store path handed to
+/// the last successful call to u_hardware_biometry_setActiveGroup, or NULL.
+BIOMETRY_DLL_PUBLIC const char*
+biometry_fp_api_test_active_group_path();
+
+/// @brief biometry_fp_api_test_reset cancels all pending callbacks, forgets all
+/// templates, lockouts and the active group and reloads the configuration.
+BIOMETRY_DLL_PUBLIC void
+biometry_fp_api_test_reset();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TESTING_BIOMETRY_FP_API_TEST_H_
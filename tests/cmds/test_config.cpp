@@ -25,6 +25,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <fstream>
+
 namespace cli = biometry::util::cli;
 
 TEST(CmdConfig, returns_correct_result_for_default_plugin_directory)
@@ -49,3 +51,21 @@ TEST(CmdConfig, throws_flags_with_invalid_value_for_invalid_flag)
     biometry::cmds::Config config;
     EXPECT_THROW(config.run(cli::Command::Context{std::cin, std::cout, {"--flag=invalid"}}), cli::Command::FlagsWithInvalidValue);
 }
+
+TEST(CmdConfig, compile_throws_flags_missing_for_missing_config)
+{
+    biometry::cmds::Config config;
+    EXPECT_THROW(config.run(cli::Command::Context{std::cin, std::cout, {"compile"}}), cli::Command::FlagsMissing);
+}
+
+TEST(CmdConfig, compile_fails_for_invalid_json)
+{
+    auto source = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("biometryd-%%%%-%%%%.json");
+    std::ofstream{source.string()} << "{ not json";
+
+    std::stringstream cout;
+    biometry::cmds::Config config;
+    EXPECT_EQ(EXIT_FAILURE, config.run(cli::Command::Context{std::cin, cout, {"compile", "--config=" + source.string()}}));
+
+    boost::filesystem::remove(source);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/util/activity_monitor.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace
+{
+struct ActivityMonitor : public ::testing::Test
+{
+    ActivityMonitor()
+        : keep_alive{service},
+          worker{[this]() { service.run(); }}
+    {
+    }
+
+    ~ActivityMonitor()
+    {
+        service.stop();
+        worker.join();
+    }
+
+    boost::asio::io_service service;
+    boost::asio::io_service::work keep_alive;
+    std::thread worker;
+};
+}
+
+TEST_F(ActivityMonitor, reports_idle_without_any_activity)
+{
+    std::promise<void> idle;
+    auto monitor = biometry::util::ActivityMonitor::create(service, std::chrono::milliseconds{10}, [&idle]() { idle.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, idle.get_future().wait_for(std::chrono::seconds{5}));
+}
+
+TEST_F(ActivityMonitor, does_not_report_idle_while_activity_is_ongoing)
+{
+    std::atomic<int> idle{0};
+    auto monitor = biometry::util::ActivityMonitor::create(service, std::chrono::milliseconds{10}, [&idle]() { idle++; });
+
+    auto activity = monitor->begin();
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    EXPECT_EQ(0, idle.load());
+
+    activity.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    EXPECT_EQ(1, idle.load());
+}
+
+TEST_F(ActivityMonitor, touch_restarts_the_countdown)
+{
+    std::atomic<int> idle{0};
+    auto monitor = biometry::util::ActivityMonitor::create(service, std::chrono::milliseconds{200}, [&idle]() { idle++; });
+
+    for (int i = 0; i < 5; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        monitor->touch();
+    }
+
+    EXPECT_EQ(0, idle.load());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    EXPECT_EQ(1, idle.load());
+}
+
+TEST_F(ActivityMonitor, reports_busy_on_first_activity_after_idle)
+{
+    std::promise<void> idle;
+    std::atomic<int> busy{0};
+    auto monitor = biometry::util::ActivityMonitor::create(service, std::chrono::milliseconds{10}, [&idle]() { idle.set_value(); }, [&busy]() { busy++; });
+
+    // Activity before becoming idle does not count.
+    monitor->touch();
+    EXPECT_EQ(0, busy.load());
+
+    EXPECT_EQ(std::future_status::ready, idle.get_future().wait_for(std::chrono::seconds{5}));
+
+    // on_busy has returned by the time touch and begin return.
+    monitor->touch();
+    EXPECT_EQ(1, busy.load());
+    auto activity = monitor->begin();
+    EXPECT_EQ(1, busy.load());
+}
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/devices/android.h>
+#include <biometry/hardware/flight_recorder.h>
+
+#include <biometry/application.h>
+#include <biometry/reason.h>
+#include <biometry/user.h>
+
+#include <boost/filesystem.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "biometry_fp_api_test.h"
+#include "config.h"
+
+#include <dlfcn.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <thread>
+
+namespace
+{
+struct MockPropertyStore : public biometry::util::PropertyStore
+{
+    MockPropertyStore()
+    {
+        using namespace ::testing;
+        ON_CALL(*this, get(_)).WillByDefault(Return(std::string{}));
+    }
+
+    MOCK_CONST_METHOD1(get, std::string(const std::string&));
+};
+
+// Outcome captures the final state of an operation.
+template<typename T>
+struct Outcome
+{
+    bool succeeded{false};
+    typename T::Result result{};
+    std::string error{};
+    std::uint32_t progress{0};
+};
+
+// Waiter is an observer fulfilling a promise once the operation it observes finished.
+template<typename T>
+class Waiter : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    void on_started() override {}
+    void on_progress(const Progress&) override { outcome.progress++; }
+    void on_canceled(const Reason& reason) override { outcome.error = reason; promise.set_value(outcome); }
+    void on_failed(const Error& error) override { outcome.error = error; promise.set_value(outcome); }
+    void on_succeeded(const Result& result) override { outcome.succeeded = true; outcome.result = result; promise.set_value(outcome); }
+
+    Outcome<T> outcome;
+    std::promise<Outcome<T>> promise;
+};
+
+// run starts op, invokes between after starting and waits for op to finish.
+template<typename T>
+Outcome<T> run(const typename biometry::Operation<T>::Ptr& op, const std::function<void()>& between = []() {})
+{
+    auto waiter = std::make_shared<Waiter<T>>();
+    auto future = waiter->promise.get_future();
+    op->start_with_observer(waiter);
+    between();
+    EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{5}));
+    return future.get();
+}
+
+// instant returns the JSON configuration of a sensor without any latency, extended by fields.
+std::string instant(const std::string& fields = std::string{})
+{
+    static const std::string latency{
+        R"("latency": {)"
+        R"("touch": {"distribution": "fixed", "mean": 0}, "enroll": {"distribution": "fixed", "mean": 0},)"
+        R"("identify": {"distribution": "fixed", "mean": 0}, "list": {"distribution": "fixed", "mean": 0},)"
+        R"("remove": {"distribution": "fixed", "mean": 0}, "clear": {"distribution": "fixed", "mean": 0}})"};
+
+    return "{" + latency + (fields.empty() ? "" : ", " + fields) + "}";
+}
+
+const biometry::Application& app = biometry::Application::system();
+const biometry::User& user = biometry::User::current();
+
+// AndroidDevice routes the HAL bridge to libbiometry_fp_api_test.so, exercising
+// devices::android end-to-end without fingerprint hardware.
+struct AndroidDevice : public ::testing::Test
+{
+    static boost::filesystem::path library()
+    {
+        return testing::runtime_dir() / "libbiometry_fp_api_test.so";
+    }
+
+    static void SetUpTestCase()
+    {
+        ::setenv("UBUNTU_PLATFORM_API_TEST_OVERRIDE", "biometry", 1);
+        ::setenv("BIOMETRYD_FP_API_TEST_OVERRIDE_PATH", library().string().c_str(), 1);
+    }
+
+    void SetUp() override
+    {
+        handle = ::dlopen(library().string().c_str(), RTLD_LAZY);
+        ASSERT_NE(nullptr, handle) << ::dlerror();
+
+        reset = reinterpret_cast<decltype(reset)>(::dlsym(handle, "biometry_fp_api_test_reset"));
+        active_group_path = reinterpret_cast<decltype(active_group_path)>(::dlsym(handle, "biometry_fp_api_test_active_group_path"));
+        ASSERT_NE(nullptr, reset);
+        ASSERT_NE(nullptr, active_group_path);
+
+        configure(std::string{});
+    }
+
+    void TearDown() override
+    {
+        if (not config.empty())
+            boost::filesystem::remove(config);
+        ::unsetenv("BIOMETRYD_FP_API_TEST_CONFIG");
+
+        if (handle)
+            ::dlclose(handle);
+    }
+
+    // configure resets the sensor, simulating the model given in json. An empty
+    // json resets to a sensor without any delays.
+    void configure(const std::string& json)
+    {
+        if (json.empty())
+        {
+            ::unsetenv("BIOMETRYD_FP_API_TEST_CONFIG");
+        }
+        else
+        {
+            config = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+            std::ofstream{config.string()} << json;
+            ::setenv("BIOMETRYD_FP_API_TEST_CONFIG", config.string().c_str(), 1);
+        }
+
+        reset();
+    }
+
+    std::shared_ptr<biometry::devices::android> create_device(const std::string& sdk = "29")
+    {
+        using namespace ::testing;
+        NiceMock<MockPropertyStore> store;
+        ON_CALL(store, get("ro.build.version.sdk")).WillByDefault(Return(sdk));
+
+        const auto& api = biometry::hardware::FingerprintApi::resolve();
+        return std::make_shared<biometry::devices::android>(api, api.create(), store);
+    }
+
+    void* handle{nullptr};
+    void (*reset)(){nullptr};
+    const char* (*active_group_path)(){nullptr};
+    boost::filesystem::path config;
+};
+}
+
+TEST_F(AndroidDevice, sets_active_group_according_to_api_level)
+{
+    create_device("27");
+    EXPECT_STREQ("/data/system/users/0/fpdata/", active_group_path());
+
+    create_device("29");
+    EXPECT_STREQ("/data/vendor_de/0/fpdata/", active_group_path());
+}
+
+TEST_F(AndroidDevice, enrolls_lists_and_counts_templates)
+{
+    configure(instant(R"("enrollmentSteps": 3)"));
+    auto device = create_device();
+
+    auto enrollment = run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user));
+    EXPECT_TRUE(enrollment.succeeded);
+    EXPECT_EQ(3, enrollment.progress);
+
+    auto second = run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user));
+    EXPECT_TRUE(second.succeeded);
+
+    auto list = run<biometry::TemplateStore::List>(device->template_store().list(app, user));
+    EXPECT_EQ((std::vector<biometry::TemplateStore::TemplateId>{enrollment.result, second.result}), list.result);
+
+    EXPECT_EQ(2, run<biometry::TemplateStore::SizeQuery>(device->template_store().size(app, user)).result);
+}
+
+TEST_F(AndroidDevice, reports_exhausted_capacity)
+{
+    configure(instant(R"("capacity": 1)"));
+    auto device = create_device();
+
+    EXPECT_TRUE(run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user)).succeeded);
+    EXPECT_EQ("ERROR_NO_SPACE", run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user)).error);
+}
+
+TEST_F(AndroidDevice, removes_and_clears_templates)
+{
+    auto device = create_device();
+
+    auto first = run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user)).result;
+    run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user));
+
+    EXPECT_TRUE(run<biometry::TemplateStore::Removal>(device->template_store().remove(app, user, first)).succeeded);
+    EXPECT_EQ("ERROR_UNABLE_TO_REMOVE", run<biometry::TemplateStore::Removal>(device->template_store().remove(app, user, first)).error);
+    EXPECT_EQ(1, run<biometry::TemplateStore::SizeQuery>(device->template_store().size(app, user)).result);
+
+    EXPECT_TRUE(run<biometry::TemplateStore::Clearance>(device->template_store().clear(app, user)).succeeded);
+    EXPECT_EQ(0, run<biometry::TemplateStore::SizeQuery>(device->template_store().size(app, user)).result);
+}
+
+TEST_F(AndroidDevice, verifies_and_identifies_enrolled_fingers)
+{
+    auto device = create_device();
+
+    EXPECT_EQ("FINGER_NOT_RECOGNIZED", run<biometry::Verification>(device->verifier().verify_user(app, user, biometry::Reason::unknown())).error);
+    EXPECT_EQ("FINGER_NOT_RECOGNIZED", run<biometry::Identification>(device->identifier().identify_user(app, biometry::Reason::unknown())).error);
+
+    run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user));
+
+    EXPECT_EQ(biometry::Verification::Result::verified, run<biometry::Verification>(device->verifier().verify_user(app, user, biometry::Reason::unknown())).result);
+    EXPECT_TRUE(run<biometry::Identification>(device->identifier().identify_user(app, biometry::Reason::unknown())).succeeded);
+}
+
+TEST_F(AndroidDevice, locks_out_after_repeated_rejections)
+{
+    configure(instant(R"("rejectionRate": 1, "lockout": {"attempts": 2, "duration": 60000})"));
+    auto device = create_device();
+
+    run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user));
+
+    EXPECT_EQ("FINGER_NOT_RECOGNIZED", run<biometry::Verification>(device->verifier().verify_user(app, user, biometry::Reason::unknown())).error);
+    EXPECT_EQ("FINGER_NOT_RECOGNIZED", run<biometry::Verification>(device->verifier().verify_user(app, user, biometry::Reason::unknown())).error);
+    EXPECT_EQ("ERROR_LOCKOUT", run<biometry::Verification>(device->verifier().verify_user(app, user, biometry::Reason::unknown())).error);
+}
+
+TEST_F(AndroidDevice, reports_canceled_operations)
+{
+    configure(R"({"latency": {"touch": {"distribution": "fixed", "mean": 10000}}})");
+    auto device = create_device();
+
+    auto op = device->template_store().enroll(app, user);
+    EXPECT_EQ("ERROR_CANCELED", run<biometry::TemplateStore::Enrollment>(op, [op]() { op->cancel(); }).error);
+}
+
+TEST_F(AndroidDevice, records_hal_calls_and_callbacks_to_flight_recorder)
+{
+    auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    biometry::hardware::FlightRecorder::install(std::make_shared<biometry::hardware::FlightRecorder>(path, 64));
+
+    configure(instant(R"("enrollmentSteps": 2)"));
+    auto device = create_device();
+    EXPECT_TRUE(run<biometry::TemplateStore::Enrollment>(device->template_store().enroll(app, user)).succeeded);
+
+    biometry::hardware::FlightRecorder::install(nullptr);
+    auto records = biometry::hardware::FlightRecorder::read(path);
+    boost::filesystem::remove(path);
+
+    std::vector<biometry::hardware::FlightRecorder::Event> events;
+    std::uint64_t operation{0};
+    for (const auto& record : records)
+    {
+        if (record.operation == 0)
+            continue;
+
+        if (operation == 0)
+            operation = record.operation;
+
+        EXPECT_EQ(operation, record.operation);
+        events.push_back(record.event);
+    }
+
+    // Callbacks arrive on the thread of the HAL and interleave with the calls returning.
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(biometry::hardware::FlightRecorder::Event::enroll, events.front());
+    EXPECT_EQ(2, std::count(events.begin(), events.end(), biometry::hardware::FlightRecorder::Event::enrollresult_cb));
+    EXPECT_EQ(2, std::count(events.begin(), events.end(), biometry::hardware::FlightRecorder::Event::acquired_cb));
+    EXPECT_EQ(1, std::count(events.begin(), events.end(), biometry::hardware::FlightRecorder::Event::post_enroll));
+    EXPECT_EQ(2, std::count(events.begin(), events.end(), biometry::hardware::FlightRecorder::Event::returned));
+}
+
+TEST_F(AndroidDevice, delivers_callbacks_on_a_dedicated_thread)
+{
+    struct ThreadRecorder : public Waiter<biometry::TemplateStore::SizeQuery>
+    {
+        void on_succeeded(const Result& result) override
+        {
+            thread = std::this_thread::get_id();
+            Waiter<biometry::TemplateStore::SizeQuery>::on_succeeded(result);
+        }
+
+        std::thread::id thread;
+    };
+
+    auto device = create_device();
+
+    auto recorder = std::make_shared<ThreadRecorder>();
+    auto future = recorder->promise.get_future();
+    auto op = device->template_store().size(app, user);
+    op->start_with_observer(recorder);
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{5}));
+    EXPECT_NE(std::this_thread::get_id(), recorder->thread);
+}
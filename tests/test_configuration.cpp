@@ -17,6 +17,7 @@
  *
  */
 
+#include <biometry/util/binary_configuration_builder.h>
 #include <biometry/util/configuration.h>
 #include <biometry/util/json_configuration_builder.h>
 #include <biometry/util/streaming_configuration_builder.h>
@@ -24,6 +25,7 @@
 #include <gtest/gtest.h>
 
 #include <fstream>
+#include <sstream>
 
 TEST(Configuration, default_constructor_yields_valid_configuration)
 {
@@ -33,9 +35,78 @@ TEST(Configuration, default_constructor_yields_valid_configuration)
 TEST(ConfigurationNode, setting_value_of_node_works)
 {
     biometry::util::Configuration config;
-    config.children()["test"] = biometry::util::Configuration::Node{biometry::Variant::i(42)};
+    config["test"].value(biometry::Variant::i(42));
     ASSERT_EQ(1, config.children().count("test"));
-    ASSERT_EQ(42, config.children().at("test").value().integer());
+    ASSERT_EQ(42, config["test"].value().integer());
+}
+
+TEST(ConfigurationNode, assignment_copies_subtree)
+{
+    biometry::util::Configuration source;
+    source["device"]["id"].value(biometry::Variant::s("Dummy"));
+    source["device"]["config"]["retries"].value(biometry::Variant::i(3));
+
+    biometry::util::Configuration config;
+    config["config"] = source["device"]["config"];
+    source["device"]["config"]["retries"].value(biometry::Variant::i(4));
+
+    EXPECT_EQ(3, config["config"]["retries"].value().integer());
+    EXPECT_FALSE(config["config"]["id"]);
+}
+
+TEST(ConfigurationNode, references_remain_valid_while_adding_nodes)
+{
+    biometry::util::Configuration config;
+    auto& first = config["first"];
+    first.value(biometry::Variant::i(42));
+
+    for (int i = 0; i < 10000; i++)
+        config["node" + std::to_string(i)]["child"].value(biometry::Variant::i(i));
+
+    EXPECT_EQ(42, first.value().integer());
+    EXPECT_EQ(&first, &config["first"]);
+    EXPECT_EQ(9999, config["node9999"]["child"].value().integer());
+}
+
+TEST(ConfigurationNode, arrays_are_indexed_natively)
+{
+    biometry::util::Configuration config;
+    auto& array = config["array"];
+    array.append().value(biometry::Variant::i(0));
+    array.append().value(biometry::Variant::i(1));
+
+    EXPECT_EQ(biometry::util::Configuration::Kind::array, array.kind());
+    EXPECT_EQ(2, array.children().size());
+    EXPECT_EQ(1, array[1].value().integer());
+    EXPECT_FALSE(static_cast<const biometry::util::Configuration::Node&>(array)[2]);
+    EXPECT_THROW(array["named"], std::logic_error);
+}
+
+TEST(ConfigurationNode, equality_ignores_order_of_named_children)
+{
+    std::stringstream lhs{R"_({"a": 1, "b": {"c": [1, 2], "d": "e"}})_"};
+    std::stringstream rhs{R"_({"b": {"d": "e", "c": [1, 2]}, "a": 1})_"};
+    std::stringstream other{R"_({"b": {"d": "e", "c": [2, 1]}, "a": 1})_"};
+
+    auto l = biometry::util::JsonConfigurationBuilder{lhs}.build_configuration();
+    auto r = biometry::util::JsonConfigurationBuilder{rhs}.build_configuration();
+    auto o = biometry::util::JsonConfigurationBuilder{other}.build_configuration();
+
+    EXPECT_TRUE(l.root() == r.root());
+    EXPECT_TRUE(l.root() != o.root());
+    EXPECT_TRUE(l["a"] == o["a"]);
+}
+
+TEST(Configuration, diff_reports_changed_top_level_nodes)
+{
+    std::stringstream lhs{R"_({"defaultDevice": {"id": "android"}, "dispatcher": {"type": "strand"}, "removed": 1})_"};
+    std::stringstream rhs{R"_({"defaultDevice": {"id": "dummy"}, "dispatcher": {"type": "strand"}, "added": 1})_"};
+
+    auto l = biometry::util::JsonConfigurationBuilder{lhs}.build_configuration();
+    auto r = biometry::util::JsonConfigurationBuilder{rhs}.build_configuration();
+
+    EXPECT_EQ((std::vector<std::string>{"defaultDevice", "removed", "added"}), biometry::util::diff(l, r));
+    EXPECT_TRUE(biometry::util::diff(l, l).empty());
 }
 
 TEST(Variant, constructors_yield_correct_type_and_value)
@@ -100,11 +171,163 @@ TEST(JsonConfigurationBuilder, works_for_valid_json)
     EXPECT_EQ(1, config.children().count("devices"));
     EXPECT_EQ(2, config["devices"].children().size());
 
-    auto devices = config["devices"];
+    const auto& devices = config["devices"];
+    EXPECT_EQ(biometry::util::Configuration::Kind::array, devices.kind());
 
-    auto _0 = devices["0"];
-    auto _1 = devices["1"];
+    const auto& _0 = devices[0];
+    const auto& _1 = devices[1];
 
     EXPECT_EQ("meizu::FingerprintReader", _0["device.id"].value().string());
     EXPECT_EQ("biometryd::Plugin", _1["device.id"].value().string());
 }
+
+TEST(JsonConfigurationBuilder, decodes_escapes_and_numbers)
+{
+    std::stringstream in{R"_({"s": "a\"b\u00e9\ud83d\ude00", "i": -42, "d": 1e3, "big": 18446744073709551616, "n": null, "a": [1, null, true]})_"};
+    biometry::util::JsonConfigurationBuilder builder{in};
+    auto config = builder.build_configuration();
+
+    EXPECT_EQ("a\"b\xc3\xa9\xf0\x9f\x98\x80", config["s"].value().string());
+    EXPECT_EQ(-42, config["i"].value().integer());
+    EXPECT_DOUBLE_EQ(1000., config["d"].value().floating_point());
+    EXPECT_EQ(biometry::Variant::Type::floating_point, config["big"].value().type());
+    EXPECT_EQ(0, config.children().count("n"));
+    EXPECT_EQ(3, config["a"].children().size());
+    EXPECT_FALSE(config["a"][1]);
+    EXPECT_TRUE(config["a"][2].value().boolean());
+}
+
+TEST(JsonConfigurationBuilder, throws_for_invalid_json)
+{
+    for (const auto& json : {"", "{", "{\"a\": }", "{\"a\": 1,}", "[1]", "{\"a\": tru}", "{} x"})
+    {
+        std::stringstream in{json};
+        biometry::util::JsonConfigurationBuilder builder{in};
+        EXPECT_THROW(builder.build_configuration(), std::runtime_error) << json;
+    }
+}
+
+TEST(JsonConfigurationBuilder, throws_for_malformed_numbers)
+{
+    for (const auto& number : {"1-2", "01", "-01", "1.", "-", ".5", "+1", "1e", "1e+", "1.e3", "0x10", "1 2"})
+    {
+        std::stringstream in{std::string{"{\"a\": "} + number + "}"};
+        biometry::util::JsonConfigurationBuilder builder{in};
+        EXPECT_THROW(builder.build_configuration(), std::runtime_error) << number;
+    }
+}
+
+TEST(JsonConfigurationBuilder, accepts_numbers_of_rfc_8259)
+{
+    std::stringstream in{R"_({"a": [0, -0, 10, -0.5, 1.25e2, 1E-2, 2e+1]})_"};
+    biometry::util::JsonConfigurationBuilder builder{in};
+    auto config = builder.build_configuration();
+
+    EXPECT_EQ(0, config["a"][0].value().integer());
+    EXPECT_EQ(0, config["a"][1].value().integer());
+    EXPECT_EQ(10, config["a"][2].value().integer());
+    EXPECT_DOUBLE_EQ(-0.5, config["a"][3].value().floating_point());
+    EXPECT_DOUBLE_EQ(125., config["a"][4].value().floating_point());
+    EXPECT_DOUBLE_EQ(0.01, config["a"][5].value().floating_point());
+    EXPECT_DOUBLE_EQ(20., config["a"][6].value().floating_point());
+}
+
+TEST(JsonConfigurationBuilder, throws_for_malformed_strings)
+{
+    for (const auto& string : {R"_("\udc00")_", R"_("\udfff")_", R"_("\ud800")_", R"_("\ud800A")_", R"_("\x")_", R"_("\u12")_", "\"a\tb\""})
+    {
+        std::stringstream in{std::string{"{\"a\": "} + string + "}"};
+        biometry::util::JsonConfigurationBuilder builder{in};
+        EXPECT_THROW(builder.build_configuration(), std::runtime_error) << string;
+    }
+}
+
+TEST(JsonConfigurationBuilder, throws_for_nesting_beyond_limit)
+{
+    // An object holding depth - 1 nested arrays.
+    auto nested = [](std::size_t depth)
+    {
+        return "{\"a\": " + std::string(depth - 1, '[') + std::string(depth - 1, ']') + "}";
+    };
+
+    {
+        std::stringstream in{nested(128)};
+        biometry::util::JsonConfigurationBuilder builder{in};
+        EXPECT_NO_THROW(builder.build_configuration());
+    }
+
+    for (auto depth : {129, 100000})
+    {
+        std::stringstream in{nested(depth)};
+        biometry::util::JsonConfigurationBuilder builder{in};
+        EXPECT_THROW(builder.build_configuration(), std::runtime_error) << depth;
+    }
+}
+
+namespace
+{
+struct BinaryConfigurationBuilder : public ::testing::Test
+{
+    BinaryConfigurationBuilder()
+        : source{boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("biometryd-%%%%-%%%%.json")}
+    {
+        write_source(R"_({"defaultDevice": {"id": "Dummy", "config": {"enabled": true, "retries": 3, "threshold": 0.5, "sensors": [{"id": 1}, {"id": 2}]}}})_");
+    }
+
+    ~BinaryConfigurationBuilder()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(source, ec);
+        boost::filesystem::remove(biometry::util::compiled_configuration_path_for(source), ec);
+    }
+
+    void write_source(const std::string& json)
+    {
+        std::ofstream out{source.string()};
+        out << json;
+    }
+
+    boost::filesystem::path source;
+};
+}
+
+TEST_F(BinaryConfigurationBuilder, round_trips_configuration)
+{
+    auto compiled = biometry::util::compiled_configuration_path_for(source);
+    biometry::util::compile_configuration(source, compiled);
+
+    biometry::util::BinaryConfigurationBuilder builder{compiled};
+    auto config = builder.build_configuration();
+
+    const auto& device = config["defaultDevice"];
+    EXPECT_EQ("Dummy", device["id"].value().string());
+    EXPECT_TRUE(device["config"]["enabled"].value().boolean());
+    EXPECT_EQ(3, device["config"]["retries"].value().integer());
+    EXPECT_DOUBLE_EQ(0.5, device["config"]["threshold"].value().floating_point());
+    EXPECT_EQ(biometry::util::Configuration::Kind::array, device["config"]["sensors"].kind());
+    EXPECT_EQ(2, device["config"]["sensors"][1]["id"].value().integer());
+}
+
+TEST_F(BinaryConfigurationBuilder, load_configuration_ignores_stale_binary_configuration)
+{
+    biometry::util::compile_configuration(source, biometry::util::compiled_configuration_path_for(source));
+    write_source(R"_({"defaultDevice": {"id": "Plugin"}})_");
+
+    EXPECT_EQ("Plugin", biometry::util::load_configuration(source)["defaultDevice"]["id"].value().string());
+}
+
+TEST_F(BinaryConfigurationBuilder, load_configuration_ignores_invalid_binary_configuration)
+{
+    std::ofstream{biometry::util::compiled_configuration_path_for(source).string()} << "garbage";
+    EXPECT_EQ("Dummy", biometry::util::load_configuration(source)["defaultDevice"]["id"].value().string());
+}
+
+TEST_F(BinaryConfigurationBuilder, throws_for_invalid_binary_configuration)
+{
+    auto compiled = biometry::util::compiled_configuration_path_for(source);
+    biometry::util::compile_configuration(source, compiled);
+    boost::filesystem::resize_file(compiled, boost::filesystem::file_size(compiled) - 1);
+
+    biometry::util::BinaryConfigurationBuilder builder{compiled};
+    EXPECT_THROW(builder.build_configuration(), std::runtime_error);
+}
@@ -87,6 +87,7 @@ struct VerifyingEchoService : public testing::EchoService
                 biometry::Variant::d(0.42),
                 biometry::Variant::r(Reference::rectangle()),
                 biometry::Variant::s("42"),
+                biometry::Variant::bl({4, 2}),
                 biometry::Variant::v(
                 {
                     biometry::Variant::b(true),
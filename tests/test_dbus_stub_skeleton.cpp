@@ -19,9 +19,12 @@
 
 #include <biometry/runtime.h>
 
+#include <biometry/dbus/service.h>
 #include <biometry/dbus/skeleton/service.h>
 #include <biometry/dbus/stub/service.h>
 
+#include <biometry/util/metrics.h>
+
 #include <core/dbus/fixture.h>
 #include <core/posix/fork.h>
 #include <core/posix/signal.h>
@@ -30,6 +33,9 @@
 
 #include <gmock/gmock.h>
 
+#include <dirent.h>
+#include <unistd.h>
+
 #include "did_finish_successfully.h"
 #include "mock_device.h"
 
@@ -88,6 +94,25 @@ struct TestDbusStubSkeleton : public core::dbus::testing::Fixture
         return std::shared_ptr<SkeletonScope>{new SkeletonScope{trap, rt, bus}};
     }
 
+    // system_skeleton_scope returns a scope connected to the system bus, serving stubs
+    // created via biometry::dbus::Service::create_stub.
+    std::shared_ptr<SkeletonScope> system_skeleton_scope()
+    {
+        auto trap = core::posix::trap_signals_for_all_subsequent_threads({core::posix::Signal::sig_term});
+        trap->signal_raised().connect([trap](core::posix::Signal)
+        {
+            trap->stop();
+        });
+
+        auto rt = biometry::Runtime::create();
+        auto bus = system_bus();
+
+        bus->install_executor(core::dbus::asio::make_executor(bus, rt->service()));
+        rt->start();
+
+        return std::shared_ptr<SkeletonScope>{new SkeletonScope{trap, rt, bus}};
+    }
+
     std::shared_ptr<StubScope> stub_scope()
     {
         auto rt = biometry::Runtime::create();
@@ -111,6 +136,67 @@ struct MockKeepAliveObserver : public testing::MockObserver<T>
     typename biometry::Operation<T>::Ptr op;
 };
 
+// ReleasingObserver holds on to a service and a device, releasing both when the observed operation succeeds.
+struct ReleasingObserver : public testing::MockObserver<biometry::Identification>
+{
+    ReleasingObserver(const std::shared_ptr<biometry::Service>& service, const std::shared_ptr<biometry::Device>& device)
+        : service{service},
+          device{device}
+    {
+    }
+
+    void on_succeeded(const biometry::User&) override
+    {
+        service.reset();
+        device.reset();
+        released.set_value();
+    }
+
+    std::shared_ptr<biometry::Service> service;
+    std::shared_ptr<biometry::Device> device;
+    std::promise<void> released;
+};
+
+// client_contexts returns the number of client contexts alive in the calling process.
+std::int64_t client_contexts()
+{
+    return biometry::util::metrics().gauge("dbus_client_contexts").value();
+}
+
+// threads returns the number of threads of the calling process.
+std::size_t threads()
+{
+    std::size_t result{0};
+
+    if (auto dir = ::opendir("/proc/self/task"))
+    {
+        while (auto entry = ::readdir(dir))
+            if (entry->d_name[0] != '.')
+                result++;
+
+        ::closedir(dir);
+    }
+
+    return result;
+}
+
+// eventually returns true if pred is satisfied within timeout.
+template<typename Predicate>
+bool eventually(Predicate pred, std::chrono::milliseconds timeout = std::chrono::seconds{5})
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (not pred())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return true;
+}
+
 template<typename T>
 std::future<typename biometry::Operation<T>::Observer::Result> start(const typename biometry::Operation<T>::Ptr& op)
 {
@@ -182,3 +268,585 @@ TEST_F(TestDbusStubSkeleton, stub_skeleton_service_can_talk_with_one_another)
     ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
     EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
 }
+
+TEST_F(TestDbusStubSkeleton, stub_creates_and_starts_operations_with_a_single_call_on_start)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = skeleton_scope();
+
+        auto op = std::make_shared<NiceMock<MockOperation<biometry::Identification>>>();
+        EXPECT_CALL(*op, start_with_observer(_)).Times(1);
+
+        // The stub only reaches out to the skeleton for the operation that gets started.
+        auto identifier = std::make_shared<NiceMock<MockIdentifier>>();
+        EXPECT_CALL(*identifier, identify_user(_,_)).Times(1).WillOnce(Return(op));
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, identifier()).WillByDefault(ReturnRef(*identifier));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        auto status = scope->run();
+
+        if (not Mock::VerifyAndClearExpectations(op.get()) || not Mock::VerifyAndClearExpectations(identifier.get()))
+            return core::posix::exit::Status::failure;
+
+        return status;
+    };
+
+    auto stub = [this]()
+    {
+        auto app = biometry::Application::system();
+        auto reason = biometry::Reason::unknown();
+
+        auto scope = stub_scope();
+        auto service = biometry::dbus::stub::Service::create_for_bus(scope->bus);
+        auto device = service->default_device();
+
+        auto not_started = device->identifier().identify_user(app, reason);
+        auto started = device->identifier().identify_user(app, reason);
+
+        auto observer = std::make_shared<NiceMock<MockObserver<biometry::Identification>>>();
+        EXPECT_NO_THROW(started->start_with_observer(observer));
+        EXPECT_NO_THROW(not_started->cancel());
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, stub_creates_and_starts_template_store_operations_with_a_single_call_on_start)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = skeleton_scope();
+
+        auto size = std::make_shared<NiceMock<MockOperation<biometry::TemplateStore::SizeQuery>>>();
+        EXPECT_CALL(*size, start_with_observer(_)).Times(1);
+        auto list = std::make_shared<NiceMock<MockOperation<biometry::TemplateStore::List>>>();
+        EXPECT_CALL(*list, start_with_observer(_)).Times(1);
+        auto enrollment = std::make_shared<NiceMock<MockOperation<biometry::TemplateStore::Enrollment>>>();
+        EXPECT_CALL(*enrollment, start_with_observer(_)).Times(1);
+        auto removal = std::make_shared<NiceMock<MockOperation<biometry::TemplateStore::Removal>>>();
+        EXPECT_CALL(*removal, start_with_observer(_)).Times(1);
+        auto clearance = std::make_shared<NiceMock<MockOperation<biometry::TemplateStore::Clearance>>>();
+        EXPECT_CALL(*clearance, start_with_observer(_)).Times(1);
+
+        // The stub only reaches out to the skeleton for the operations that get started.
+        auto template_store = std::make_shared<NiceMock<MockTemplateStore>>();
+        EXPECT_CALL(*template_store, size(_, _)).Times(1).WillOnce(Return(size));
+        EXPECT_CALL(*template_store, list(_, _)).Times(1).WillOnce(Return(list));
+        EXPECT_CALL(*template_store, enroll(_, _)).Times(1).WillOnce(Return(enrollment));
+        EXPECT_CALL(*template_store, remove(_, _, biometry::TemplateStore::TemplateId{42})).Times(1).WillOnce(Return(removal));
+        EXPECT_CALL(*template_store, clear(_, _)).Times(1).WillOnce(Return(clearance));
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        auto status = scope->run();
+
+        if (not Mock::VerifyAndClearExpectations(size.get()) ||
+            not Mock::VerifyAndClearExpectations(list.get()) ||
+            not Mock::VerifyAndClearExpectations(enrollment.get()) ||
+            not Mock::VerifyAndClearExpectations(removal.get()) ||
+            not Mock::VerifyAndClearExpectations(clearance.get()) ||
+            not Mock::VerifyAndClearExpectations(template_store.get()))
+            return core::posix::exit::Status::failure;
+
+        return status;
+    };
+
+    auto stub = [this]()
+    {
+        auto app = biometry::Application::system();
+        auto user = biometry::User::current();
+        auto id = biometry::TemplateStore::TemplateId{42};
+
+        auto scope = stub_scope();
+        auto service = biometry::dbus::stub::Service::create_for_bus(scope->bus);
+        auto& template_store = service->default_device()->template_store();
+
+        // None of these operations are ever started.
+        template_store.size(app, user);
+        template_store.list(app, user);
+        template_store.enroll(app, user);
+        template_store.remove(app, user, id);
+        template_store.clear(app, user);
+
+        EXPECT_NO_THROW(template_store.size(app, user)->start_with_observer(
+                            std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::SizeQuery>>>()));
+        EXPECT_NO_THROW(template_store.list(app, user)->start_with_observer(
+                            std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::List>>>()));
+        EXPECT_NO_THROW(template_store.enroll(app, user)->start_with_observer(
+                            std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::Enrollment>>>()));
+        EXPECT_NO_THROW(template_store.remove(app, user, id)->start_with_observer(
+                            std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::Removal>>>()));
+        EXPECT_NO_THROW(template_store.clear(app, user)->start_with_observer(
+                            std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::Clearance>>>()));
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, stub_forwards_cancel_requested_before_start)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = skeleton_scope();
+
+        // The operation is started and canceled right away.
+        auto op = std::make_shared<NiceMock<MockOperation<biometry::Identification>>>();
+        {
+            InSequence seq;
+            EXPECT_CALL(*op, start_with_observer(_)).Times(1);
+            EXPECT_CALL(*op, cancel()).Times(1);
+        }
+
+        auto identifier = std::make_shared<NiceMock<MockIdentifier>>();
+        ON_CALL(*identifier, identify_user(_,_)).WillByDefault(Return(op));
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, identifier()).WillByDefault(ReturnRef(*identifier));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        auto status = scope->run();
+
+        if (not Mock::VerifyAndClearExpectations(op.get()))
+            return core::posix::exit::Status::failure;
+
+        return status;
+    };
+
+    auto stub = [this]()
+    {
+        auto app = biometry::Application::system();
+        auto reason = biometry::Reason::unknown();
+
+        auto scope = stub_scope();
+        auto service = biometry::dbus::stub::Service::create_for_bus(scope->bus);
+        auto device = service->default_device();
+
+        auto op = device->identifier().identify_user(app, reason);
+        EXPECT_NO_THROW(op->cancel());
+
+        auto observer = std::make_shared<NiceMock<MockObserver<biometry::Identification>>>();
+        EXPECT_NO_THROW(op->start_with_observer(observer));
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, stub_keeps_working_after_skeleton_restarted)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = skeleton_scope();
+
+        auto size = std::make_shared<NiceMock<MockOperation<biometry::TemplateStore::SizeQuery>>>();
+        ON_CALL(*size, start_with_observer(_)).WillByDefault(Invoke([](const biometry::Operation<biometry::TemplateStore::SizeQuery>::Observer::Ptr& observer)
+        {
+            observer->on_succeeded(42);
+        }));
+
+        auto template_store = std::make_shared<NiceMock<MockTemplateStore>>();
+        ON_CALL(*template_store, size(_, _)).WillByDefault(Return(size));
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        return scope->run();
+    };
+
+    auto stub = [this]()
+    {
+        auto app = biometry::Application::system();
+        auto user = biometry::User::current();
+
+        auto scope = stub_scope();
+        auto service = biometry::dbus::stub::Service::create_for_bus(scope->bus);
+        auto device = service->default_device();
+        auto& template_store = device->template_store();
+
+        auto query_size = [&]()
+        {
+            std::promise<void> succeeded;
+            auto observer = std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::SizeQuery>>>();
+            EXPECT_CALL(*observer, on_succeeded(42)).Times(1).WillOnce(InvokeWithoutArgs([&succeeded]() { succeeded.set_value(); }));
+
+            EXPECT_NO_THROW(template_store.size(app, user)->start_with_observer(observer));
+            EXPECT_EQ(std::future_status::ready, succeeded.get_future().wait_for(std::chrono::seconds{5}));
+        };
+
+        query_size();
+
+        // The skeleton is replaced by a new instance in the meantime.
+        std::this_thread::sleep_for(std::chrono::milliseconds{2000});
+
+        query_size();
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+
+    auto cp_restarted = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_restarted.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_restarted.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, stub_reports_failure_to_start_remote_operation_to_observer)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = skeleton_scope();
+
+        // Requests for other users are rejected before reaching the template store.
+        auto template_store = std::make_shared<NiceMock<MockTemplateStore>>();
+        EXPECT_CALL(*template_store, size(_, _)).Times(0);
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        auto status = scope->run();
+
+        if (not Mock::VerifyAndClearExpectations(template_store.get()))
+            return core::posix::exit::Status::failure;
+
+        return status;
+    };
+
+    auto stub = [this]()
+    {
+        auto scope = stub_scope();
+        auto service = biometry::dbus::stub::Service::create_for_bus(scope->bus);
+        auto device = service->default_device();
+
+        auto size = device->template_store().size(biometry::Application::system(), biometry::User{::getuid() + 1});
+
+        std::promise<void> failed;
+        auto observer = std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::SizeQuery>>>();
+        EXPECT_CALL(*observer, on_failed(_)).Times(1).WillOnce(InvokeWithoutArgs([&failed]() { failed.set_value(); }));
+
+        EXPECT_NO_THROW(size->start_with_observer(observer));
+        EXPECT_EQ(std::future_status::ready, failed.get_future().wait_for(std::chrono::seconds{5}));
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, stubs_share_one_client_context)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = system_skeleton_scope();
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        return scope->run();
+    };
+
+    auto stub = []()
+    {
+        auto before = threads();
+
+        auto first = biometry::dbus::Service::create_stub();
+        auto with_first = threads();
+        EXPECT_EQ(1, client_contexts());
+        EXPECT_LT(before, with_first);
+
+        // Further stubs reuse the bus, the runtime and its worker thread.
+        auto second = biometry::dbus::Service::create_stub();
+        EXPECT_EQ(1, client_contexts());
+        EXPECT_EQ(with_first, threads());
+
+        auto device = second->default_device();
+        EXPECT_NE(nullptr, device);
+
+        // Devices keep the context alive after all stubs have gone away.
+        first.reset();
+        second.reset();
+        EXPECT_EQ(1, client_contexts());
+
+        device.reset();
+        EXPECT_EQ(0, client_contexts());
+        EXPECT_TRUE(eventually([before]() { return threads() == before; }));
+
+        // A new context is created once all earlier stubs have gone away.
+        auto third = biometry::dbus::Service::create_stub();
+        EXPECT_EQ(1, client_contexts());
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, client_context_is_torn_down_if_released_on_its_worker)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = system_skeleton_scope();
+
+        // The operation succeeds after the stub has returned from starting it,
+        // such that no call of the stub is pending when the context goes away.
+        std::thread notifier;
+        auto op = std::make_shared<NiceMock<MockOperation<biometry::Identification>>>();
+        ON_CALL(*op, start_with_observer(_)).WillByDefault(Invoke([&notifier](const biometry::Operation<biometry::Identification>::Observer::Ptr& observer)
+        {
+            notifier = std::thread{[observer]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{200});
+                observer->on_succeeded(biometry::User::current());
+            }};
+        }));
+
+        auto identifier = std::make_shared<NiceMock<MockIdentifier>>();
+        ON_CALL(*identifier, identify_user(_,_)).WillByDefault(Return(op));
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, identifier()).WillByDefault(ReturnRef(*identifier));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        auto status = scope->run();
+
+        if (notifier.joinable())
+            notifier.join();
+
+        return status;
+    };
+
+    auto stub = []()
+    {
+        auto before = threads();
+
+        auto service = biometry::dbus::Service::create_stub();
+        auto device = service->default_device();
+        auto op = device->identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown());
+
+        // The observer holds the last references, releasing them from a handler running on the worker.
+        auto observer = std::make_shared<NiceMock<ReleasingObserver>>(service, device);
+        auto released = observer->released.get_future();
+        service.reset();
+        device.reset();
+
+        EXPECT_NO_THROW(op->start_with_observer(observer));
+        // The started observer keeps the context alive until the operation finishes.
+        op.reset();
+        EXPECT_EQ(1, client_contexts());
+
+        EXPECT_EQ(std::future_status::ready, released.wait_for(std::chrono::seconds{5}));
+        EXPECT_TRUE(eventually([]() { return client_contexts() == 0; }));
+        // The worker cannot join itself, a helper thread takes care of it.
+        EXPECT_TRUE(eventually([before]() { return threads() == before; }));
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, operations_keep_client_context_alive_after_service_and_device_went_away)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = system_skeleton_scope();
+
+        std::thread notifier;
+        auto op = std::make_shared<NiceMock<MockOperation<biometry::Identification>>>();
+        ON_CALL(*op, start_with_observer(_)).WillByDefault(Invoke([&notifier](const biometry::Operation<biometry::Identification>::Observer::Ptr& observer)
+        {
+            notifier = std::thread{[observer]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{200});
+                observer->on_succeeded(biometry::User::current());
+            }};
+        }));
+
+        auto identifier = std::make_shared<NiceMock<MockIdentifier>>();
+        ON_CALL(*identifier, identify_user(_,_)).WillByDefault(Return(op));
+
+        auto device = std::make_shared<NiceMock<MockDevice>>();
+        ON_CALL(*device, identifier()).WillByDefault(ReturnRef(*identifier));
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        ON_CALL(*service, default_device()).WillByDefault(Return(device));
+
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        auto status = scope->run();
+
+        if (notifier.joinable())
+            notifier.join();
+
+        return status;
+    };
+
+    auto stub = []()
+    {
+        auto service = biometry::dbus::Service::create_stub();
+        auto device = service->default_device();
+        auto op = device->identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown());
+
+        // Only the operation is left, it has to keep the bus and the runtime around.
+        service.reset();
+        device.reset();
+        EXPECT_EQ(1, client_contexts());
+
+        std::promise<void> succeeded;
+        auto observer = std::make_shared<NiceMock<MockObserver<biometry::Identification>>>();
+        EXPECT_CALL(*observer, on_succeeded(_)).Times(1).WillOnce(InvokeWithoutArgs([&succeeded]() { succeeded.set_value(); }));
+
+        EXPECT_NO_THROW(op->start_with_observer(observer));
+        EXPECT_EQ(std::future_status::ready, succeeded.get_future().wait_for(std::chrono::seconds{5}));
+
+        op.reset();
+        EXPECT_TRUE(eventually([]() { return client_contexts() == 0; }));
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
+
+TEST_F(TestDbusStubSkeleton, stub_queries_metrics_of_skeleton)
+{
+    using namespace ::testing;
+
+    auto skeleton = [this]()
+    {
+        auto scope = skeleton_scope();
+
+        biometry::util::metrics().counter("test_dbus_stub_skeleton_total", {{"case", "metrics"}}).increment(42);
+        biometry::util::metrics().gauge("test_dbus_stub_skeleton_gauge").set(-42);
+
+        auto service = std::make_shared<NiceMock<MockService>>();
+        auto skeleton = biometry::dbus::skeleton::Service::create_for_bus(scope->bus, service);
+
+        return scope->run();
+    };
+
+    auto stub = [this]()
+    {
+        auto scope = stub_scope();
+        auto service = biometry::dbus::stub::Service::create_for_bus(scope->bus);
+
+        auto snapshot = service->metrics();
+
+        EXPECT_EQ(42, snapshot.counters[biometry::util::Metrics::key("test_dbus_stub_skeleton_total", {{"case", "metrics"}})]);
+        EXPECT_EQ(-42, snapshot.gauges["test_dbus_stub_skeleton_gauge"]);
+
+        return ::testing::Test::HasFailure() ? core::posix::exit::Status::failure : core::posix::exit::Status::success;
+    };
+
+    auto cp_skeleton = core::posix::fork(skeleton, core::posix::StandardStream::empty);
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    auto cp_stub = core::posix::fork(stub, core::posix::StandardStream::empty);
+
+    EXPECT_TRUE(did_finish_successfully(cp_stub.wait_for(core::posix::wait::Flags::untraced)));
+    ASSERT_NO_THROW(cp_skeleton.send_signal_or_throw(core::posix::Signal::sig_term));
+    EXPECT_TRUE(did_finish_successfully(cp_skeleton.wait_for(core::posix::wait::Flags::untraced)));
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/devices/deferred.h>
+
+#include <gmock/gmock.h>
+
+#include "mock_device.h"
+
+TEST(Deferred, queues_operations_until_resolved)
+{
+    using namespace ::testing;
+
+    auto op = std::make_shared<MockOperation<biometry::TemplateStore::SizeQuery>>();
+    EXPECT_CALL(*op, start_with_observer(_)).Times(1);
+
+    MockTemplateStore ts;
+    EXPECT_CALL(ts, size(_, _)).Times(1).WillOnce(Return(op));
+
+    auto impl = std::make_shared<MockDevice>();
+    EXPECT_CALL(*impl, template_store()).Times(1).WillOnce(ReturnRef(ts));
+
+    biometry::devices::Deferred deferred;
+    auto deferred_op = deferred.template_store().size(biometry::Application::system(), biometry::User::current());
+    deferred_op->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::SizeQuery>>>());
+
+    deferred.resolve(impl);
+}
+
+TEST(Deferred, forwards_operations_once_resolved)
+{
+    using namespace ::testing;
+
+    auto op = std::make_shared<MockOperation<biometry::Identification>>();
+
+    MockIdentifier identifier;
+    EXPECT_CALL(identifier, identify_user(_, _)).Times(1).WillOnce(Return(op));
+
+    auto impl = std::make_shared<MockDevice>();
+    EXPECT_CALL(*impl, identifier()).Times(1).WillOnce(ReturnRef(identifier));
+
+    biometry::devices::Deferred deferred;
+    deferred.resolve(impl);
+
+    EXPECT_EQ(op, deferred.identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown()));
+}
+
+TEST(Deferred, fails_queued_operations_if_device_creation_failed)
+{
+    using namespace ::testing;
+
+    auto observer = std::make_shared<MockObserver<biometry::Verification>>();
+    EXPECT_CALL(*observer, on_failed(_)).Times(1);
+
+    biometry::devices::Deferred deferred;
+    auto op = deferred.verifier().verify_user(biometry::Application::system(), biometry::User::current(), biometry::Reason::unknown());
+    op->start_with_observer(observer);
+
+    deferred.fail("Could not create device");
+}
+
+TEST(Deferred, reports_cancelation_of_queued_operations)
+{
+    using namespace ::testing;
+
+    auto op = std::make_shared<MockOperation<biometry::TemplateStore::Clearance>>();
+    EXPECT_CALL(*op, start_with_observer(_)).Times(0);
+
+    MockTemplateStore ts;
+    EXPECT_CALL(ts, clear(_, _)).Times(1).WillOnce(Return(op));
+
+    auto impl = std::make_shared<MockDevice>();
+    EXPECT_CALL(*impl, template_store()).Times(1).WillOnce(ReturnRef(ts));
+
+    auto observer = std::make_shared<MockObserver<biometry::TemplateStore::Clearance>>();
+    EXPECT_CALL(*observer, on_canceled(_)).Times(1);
+
+    biometry::devices::Deferred deferred;
+    auto deferred_op = deferred.template_store().clear(biometry::Application::system(), biometry::User::current());
+    deferred_op->start_with_observer(observer);
+    deferred_op->cancel();
+
+    deferred.resolve(impl);
+}
+
+TEST(Deferred, throws_if_settled_twice)
+{
+    biometry::devices::Deferred deferred;
+    deferred.fail("Could not create device");
+
+    EXPECT_THROW(deferred.fail("Could not create device"), std::logic_error);
+}
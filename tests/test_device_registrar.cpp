@@ -24,6 +24,7 @@
 #include <biometry/devices/dummy.h>
 #include <biometry/devices/plugin/device.h>
 #include <biometry/devices/plugin/enumerator.h>
+#include <biometry/devices/simulated.h>
 
 #include "config.h"
 
@@ -35,15 +36,54 @@ struct MockPluginEnumerator : public biometry::devices::plugin::Enumerator
 {
     MOCK_CONST_METHOD1(enumerate, std::size_t(const Functor&));
 };
+
+struct MockDescriptor : public biometry::Device::Descriptor
+{
+    MOCK_METHOD1(create, std::shared_ptr<biometry::Device>(const biometry::util::Configuration&));
+    MOCK_CONST_METHOD0(name, std::string());
+    MOCK_CONST_METHOD0(author, std::string());
+    MOCK_CONST_METHOD0(description, std::string());
+};
 }
 
-TEST(DeviceRegistrar, cleans_out_device_registry)
+TEST(DeviceRegistrar, restores_device_registry)
 {
+    auto builtins = biometry::device_registry().size();
     {
         biometry::DeviceRegistrar dr{biometry::devices::plugin::DirectoryEnumerator{{testing::runtime_dir()}}};
-        EXPECT_GE(biometry::device_registry().size(), 2);
+        EXPECT_GE(biometry::device_registry().size(), builtins);
     }
-    EXPECT_EQ(0, biometry::device_registry().size());
+    EXPECT_EQ(builtins, biometry::device_registry().size());
+}
+
+TEST(DeviceRegistrar, merges_plugins_into_device_registry)
+{
+    using namespace ::testing;
+
+    auto plugin = std::make_shared<MockDescriptor>();
+    EXPECT_CALL(*plugin, name()).WillRepeatedly(Return("MockPlugin"));
+    EXPECT_CALL(*plugin, description()).WillRepeatedly(Return("MockPlugin is a plugin for testing purposes."));
+
+    MockPluginEnumerator enumerator;
+    EXPECT_CALL(enumerator, enumerate(_)).Times(1).WillOnce(DoAll(InvokeArgument<0>(plugin), Return(1)));
+
+    biometry::DeviceRegistrar dr{enumerator};
+    EXPECT_EQ(plugin, biometry::device_registry().at("MockPlugin"));
+    EXPECT_EQ(1, biometry::device_registry().count(biometry::devices::Dummy::id));
+}
+
+TEST(DeviceRegistry, knows_builtin_devices_without_registrar)
+{
+    EXPECT_EQ(1, biometry::device_registry().count(biometry::devices::Dummy::id));
+    EXPECT_EQ(1, biometry::device_registry().count(biometry::devices::plugin::id));
+    EXPECT_EQ(1, biometry::device_registry().count(biometry::devices::Simulated::id));
+    EXPECT_NO_THROW(biometry::device_registry().at(biometry::devices::Dummy::id));
+}
+
+TEST(DeviceRegistry, throws_for_unknown_device)
+{
+    EXPECT_EQ(0, biometry::device_registry().count("Unknown"));
+    EXPECT_THROW(biometry::device_registry().at("Unknown"), std::out_of_range);
 }
 
 TEST(DeviceRegistrar, calls_into_enumerator)
@@ -62,6 +102,12 @@ TEST(DeviceRegistrar, adds_dummy_device)
     EXPECT_EQ(1, biometry::device_registry().count(biometry::devices::Dummy::id));
 }
 
+TEST(DeviceRegistrar, adds_simulated_device)
+{
+    biometry::DeviceRegistrar dr{biometry::devices::plugin::DirectoryEnumerator{{testing::runtime_dir()}}};
+    EXPECT_EQ(1, biometry::device_registry().count(biometry::devices::Simulated::id));
+}
+
 TEST(DeviceRegistrar, adds_plugin_device)
 {
     biometry::DeviceRegistrar dr{biometry::devices::plugin::DirectoryEnumerator{{testing::runtime_dir()}}};
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/dispatcher.h>
+#include <biometry/util/metrics.h>
+#include <biometry/util/mpsc_ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(MpscRingBuffer, throws_for_capacity_not_being_a_power_of_two)
+{
+    EXPECT_THROW(biometry::util::MpscRingBuffer<int>{3}, std::invalid_argument);
+}
+
+TEST(MpscRingBuffer, try_pop_on_empty_queue_returns_false)
+{
+    biometry::util::MpscRingBuffer<int> queue{4};
+    int value{0};
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(MpscRingBuffer, try_push_on_full_queue_returns_false)
+{
+    biometry::util::MpscRingBuffer<int> queue{2};
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+}
+
+TEST(MpscRingBuffer, hands_out_values_in_fifo_order)
+{
+    biometry::util::MpscRingBuffer<int> queue{4};
+
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < 4; i++)
+            EXPECT_TRUE(queue.try_push(int{i}));
+
+        for (int i = 0; i < 4; i++)
+        {
+            int value{-1};
+            EXPECT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(i, value);
+        }
+    }
+}
+
+TEST(WorkerThreadDispatcher, executes_tasks_of_multiple_producers_in_per_producer_order)
+{
+    static constexpr const std::size_t producers{8};
+    static constexpr const std::size_t tasks_per_producer{10000};
+
+    std::vector<std::size_t> last_seen(producers, 0);
+    std::atomic<std::size_t> executed{0};
+    bool in_order{true};
+
+    {
+        auto dispatcher = biometry::util::create_dispatcher_with_worker_thread(64);
+
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; p++)
+        {
+            threads.emplace_back([&, p]()
+            {
+                for (std::size_t i = 1; i <= tasks_per_producer; i++)
+                {
+                    dispatcher->dispatch([&, p, i]()
+                    {
+                        // Only ever accessed from the worker thread.
+                        in_order = in_order && (last_seen[p] + 1 == i);
+                        last_seen[p] = i;
+                        executed++;
+                    });
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(producers * tasks_per_producer, executed.load());
+}
+
+TEST(WorkerThreadDispatcher, survives_throwing_tasks)
+{
+    auto dispatcher = biometry::util::create_dispatcher_with_worker_thread();
+
+    std::mutex guard;
+    std::condition_variable cv;
+    bool executed{false};
+
+    dispatcher->dispatch([]() { throw std::runtime_error{"42"}; });
+    dispatcher->dispatch([&]()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        executed = true;
+        cv.notify_all();
+    });
+
+    std::unique_lock<std::mutex> ul{guard};
+    EXPECT_TRUE(cv.wait_for(ul, std::chrono::seconds{1}, [&]() { return executed; }));
+}
+
+TEST(WorkerThreadDispatcher, can_be_released_from_within_a_task)
+{
+    std::mutex guard;
+    std::condition_variable cv;
+    bool executed{false};
+
+    auto dispatcher = biometry::util::create_dispatcher_with_worker_thread();
+    auto raw = dispatcher.get();
+    raw->dispatch([&guard, &cv, &executed, dispatcher]() mutable
+    {
+        dispatcher.reset();
+        std::lock_guard<std::mutex> lg{guard};
+        executed = true;
+        cv.notify_all();
+    });
+    dispatcher.reset();
+
+    std::unique_lock<std::mutex> ul{guard};
+    EXPECT_TRUE(cv.wait_for(ul, std::chrono::seconds{1}, [&]() { return executed; }));
+}
+
+TEST(AsioStrandDispatcher, executes_move_only_tasks)
+{
+    auto runtime = biometry::Runtime::create();
+    runtime->start();
+
+    auto dispatcher = biometry::util::create_dispatcher_for_runtime(runtime);
+
+    std::mutex guard;
+    std::condition_variable cv;
+    int value{0};
+
+    std::unique_ptr<int> ptr{new int{42}};
+    dispatcher->dispatch([&, ptr = std::move(ptr)]()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        value = *ptr;
+        cv.notify_all();
+    });
+
+    {
+        std::unique_lock<std::mutex> ul{guard};
+        EXPECT_TRUE(cv.wait_for(ul, std::chrono::seconds{1}, [&]() { return value == 42; }));
+    }
+
+    runtime->stop();
+}
+
+TEST(AsioStrandDispatcher, tracks_queue_depth_per_lane)
+{
+    auto& bus = biometry::util::metrics().gauge("dispatcher_queue_depth", {{"dispatcher", "strand"}, {"lane", "bus"}});
+    auto& device = biometry::util::metrics().gauge("dispatcher_queue_depth", {{"dispatcher", "strand"}, {"lane", "device"}});
+    auto bus_depth = bus.value();
+    auto device_depth = device.value();
+
+    // The runtime is not started, keeping all tasks queued.
+    auto runtime = biometry::Runtime::create();
+
+    auto on_bus = biometry::util::create_dispatcher_for_runtime(runtime, biometry::Runtime::Lane::bus);
+    auto on_device = biometry::util::create_dispatcher_for_runtime(runtime, biometry::Runtime::Lane::device);
+
+    on_bus->dispatch([]() {});
+    on_device->dispatch([]() {});
+    on_device->dispatch([]() {});
+
+    EXPECT_EQ(bus_depth + 1, bus.value());
+    EXPECT_EQ(device_depth + 2, device.value());
+}
@@ -27,7 +27,7 @@ namespace
 {
 struct MockDispatcher : public biometry::util::Dispatcher
 {
-    MOCK_METHOD1(dispatch, void(const Task&));
+    MOCK_METHOD1(dispatch, void(Task&&));
 };
 }
 
@@ -43,7 +43,7 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_template_store_size_query)
     ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
 
     auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
-    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](const biometry::util::Dispatcher::Task& task) { task(); }));
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
 
     auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device);
     auto op = dispatching->template_store().size(biometry::Application::system(), biometry::User::current());
@@ -63,7 +63,7 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_template_store_list)
     ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
 
     auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
-    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](const biometry::util::Dispatcher::Task& task) { task(); }));
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
 
     auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device);
     auto op = dispatching->template_store().list(biometry::Application::system(), biometry::User::current());
@@ -83,7 +83,7 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_template_store_size_enrollment
     ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
 
     auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
-    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](const biometry::util::Dispatcher::Task& task) { task(); }));
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
 
     auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device);
     auto op = dispatching->template_store().enroll(biometry::Application::system(), biometry::User::current());
@@ -103,7 +103,7 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_template_store_removal)
     ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
 
     auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
-    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](const biometry::util::Dispatcher::Task& task) { task(); }));
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
 
     auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device);
     auto op = dispatching->template_store().remove(biometry::Application::system(), biometry::User::current(), 42);
@@ -123,7 +123,7 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_template_store_clearance)
     ON_CALL(*device, template_store()).WillByDefault(ReturnRef(*template_store));
 
     auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
-    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](const biometry::util::Dispatcher::Task& task) { task(); }));
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
 
     auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device);
     auto op = dispatching->template_store().clear(biometry::Application::system(), biometry::User::current());
@@ -143,7 +143,7 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_identification)
     ON_CALL(*device, identifier()).WillByDefault(ReturnRef(*identifier));
 
     auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
-    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](const biometry::util::Dispatcher::Task& task) { task(); }));
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
 
     auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device);
     auto op = dispatching->identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown());
@@ -151,3 +151,32 @@ TEST(DispatchingDevice, calls_into_dispatcher_for_identification)
     op->start_with_observer(mock_observer);
 }
 
+TEST(DispatchingDevice, notifies_observers_via_replies_dispatcher)
+{
+    using namespace testing;
+    auto mock_observer = std::make_shared<NiceMock<MockObserver<biometry::Identification>>>();
+    EXPECT_CALL(*mock_observer, on_started()).Times(1);
+
+    auto mock_op = std::make_shared<NiceMock<MockOperation<biometry::Identification>>>();
+    ON_CALL(*mock_op, start_with_observer(_)).WillByDefault(Invoke([](const biometry::Operation<biometry::Identification>::Observer::Ptr& observer)
+    {
+        observer->on_started();
+    }));
+
+    auto identifier = std::make_shared<NiceMock<MockIdentifier>>();
+    ON_CALL(*identifier, identify_user(_, _)).WillByDefault(Return(mock_op));
+
+    auto device = std::make_shared<NiceMock<MockDevice>>();
+    ON_CALL(*device, identifier()).WillByDefault(ReturnRef(*identifier));
+
+    auto dispatcher = std::make_shared<NiceMock<MockDispatcher>>();
+    EXPECT_CALL(*dispatcher, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
+
+    auto replies = std::make_shared<NiceMock<MockDispatcher>>();
+    EXPECT_CALL(*replies, dispatch(_)).Times(1).WillOnce(Invoke([](biometry::util::Dispatcher::Task&& task) { task(); }));
+
+    auto dispatching = std::make_shared<biometry::devices::Dispatching>(dispatcher, device, replies);
+    auto op = dispatching->identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown());
+
+    op->start_with_observer(mock_observer);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/util/file_watcher.h>
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <thread>
+
+namespace
+{
+struct FileWatcher : public ::testing::Test
+{
+    FileWatcher()
+        : dir{boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()},
+          keep_alive{service},
+          worker{[this]() { service.run(); }}
+    {
+        boost::filesystem::create_directories(dir);
+    }
+
+    ~FileWatcher()
+    {
+        service.stop();
+        worker.join();
+        boost::filesystem::remove_all(dir);
+    }
+
+    void write(const boost::filesystem::path& path, const std::string& content)
+    {
+        std::ofstream out{path.string()};
+        out << content;
+    }
+
+    boost::filesystem::path dir;
+    boost::asio::io_service service;
+    boost::asio::io_service::work keep_alive;
+    std::thread worker;
+};
+}
+
+TEST_F(FileWatcher, reports_changes_to_the_watched_file)
+{
+    std::promise<void> changed;
+    auto watcher = biometry::util::FileWatcher::create(service, dir / "config.json", [&changed]() { changed.set_value(); });
+
+    write(dir / "config.json", "{}");
+
+    EXPECT_EQ(std::future_status::ready, changed.get_future().wait_for(std::chrono::seconds{5}));
+}
+
+TEST_F(FileWatcher, reports_files_renamed_over_the_watched_file)
+{
+    write(dir / "config.json", "{}");
+
+    std::promise<void> changed;
+    auto watcher = biometry::util::FileWatcher::create(service, dir / "config.json", [&changed]() { changed.set_value(); });
+
+    write(dir / "config.json.tmp", "{\"a\": 1}");
+    boost::filesystem::rename(dir / "config.json.tmp", dir / "config.json");
+
+    EXPECT_EQ(std::future_status::ready, changed.get_future().wait_for(std::chrono::seconds{5}));
+}
+
+TEST_F(FileWatcher, coalesces_bursts_of_changes)
+{
+    std::atomic<int> changed{0};
+    auto watcher = biometry::util::FileWatcher::create(service, dir / "config.json", [&changed]() { changed++; }, std::chrono::milliseconds{100});
+
+    for (int i = 0; i < 5; i++)
+        write(dir / "config.json", std::to_string(i));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    EXPECT_EQ(1, changed.load());
+}
+
+TEST_F(FileWatcher, ignores_other_files_in_the_same_directory)
+{
+    std::atomic<int> changed{0};
+    auto watcher = biometry::util::FileWatcher::create(service, dir / "config.json", [&changed]() { changed++; }, std::chrono::milliseconds{10});
+
+    write(dir / "other.json", "{}");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    EXPECT_EQ(0, changed.load());
+}
+
+TEST_F(FileWatcher, does_not_report_changes_after_being_stopped)
+{
+    std::atomic<int> changed{0};
+    auto watcher = biometry::util::FileWatcher::create(service, dir / "config.json", [&changed]() { changed++; }, std::chrono::milliseconds{10});
+    watcher->stop();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    write(dir / "config.json", "{}");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    EXPECT_EQ(0, changed.load());
+}
+
+TEST_F(FileWatcher, throws_for_missing_directory)
+{
+    EXPECT_THROW(biometry::util::FileWatcher::create(service, dir / "does" / "not" / "exist.json", []() {}), std::system_error);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/hardware/flight_recorder.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+struct FlightRecorder : public ::testing::Test
+{
+    ~FlightRecorder()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(dir, ec);
+    }
+
+    boost::filesystem::path dir{boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()};
+    boost::filesystem::path path{dir / "flight-recorder"};
+};
+}
+
+TEST_F(FlightRecorder, records_events_in_order)
+{
+    {
+        biometry::hardware::FlightRecorder recorder{path, 16};
+        recorder.append(biometry::hardware::FlightRecorder::Event::authenticate, 7, {0, 0});
+        recorder.append(biometry::hardware::FlightRecorder::Event::returned, 7, {static_cast<std::int64_t>(biometry::hardware::FlightRecorder::Event::authenticate), 0});
+        recorder.append(biometry::hardware::FlightRecorder::Event::authenticated_cb, 7, {3, 0});
+    }
+
+    auto records = biometry::hardware::FlightRecorder::read(path);
+    ASSERT_EQ(4, records.size());
+
+    EXPECT_EQ(biometry::hardware::FlightRecorder::Event::opened, records[0].event);
+    EXPECT_EQ(biometry::hardware::FlightRecorder::Event::authenticate, records[1].event);
+    EXPECT_EQ(biometry::hardware::FlightRecorder::Event::returned, records[2].event);
+    EXPECT_EQ(biometry::hardware::FlightRecorder::Event::authenticated_cb, records[3].event);
+    EXPECT_EQ(7, records[3].operation);
+    EXPECT_EQ(2, records[3].argument_count);
+    EXPECT_EQ(3, records[3].arguments[0]);
+
+    for (std::size_t i = 1; i < records.size(); i++)
+    {
+        EXPECT_LT(records[i - 1].sequence, records[i].sequence);
+        EXPECT_LE(records[i - 1].timestamp, records[i].timestamp);
+    }
+
+    std::stringstream ss; ss << records[2];
+    EXPECT_NE(std::string::npos, ss.str().find("returned(call=authenticate, status=0)")) << ss.str();
+}
+
+TEST_F(FlightRecorder, keeps_records_across_reopening)
+{
+    {
+        biometry::hardware::FlightRecorder recorder{path, 16};
+        recorder.append(biometry::hardware::FlightRecorder::Event::error_cb, 1, {5, 0});
+    }
+    {
+        biometry::hardware::FlightRecorder recorder{path, 16};
+        recorder.append(biometry::hardware::FlightRecorder::Event::error_cb, 2, {5, 0});
+    }
+
+    auto records = biometry::hardware::FlightRecorder::read(path);
+    ASSERT_EQ(4, records.size());
+    EXPECT_EQ(1, records[1].operation);
+    EXPECT_EQ(biometry::hardware::FlightRecorder::Event::opened, records[2].event);
+    EXPECT_EQ(2, records[3].operation);
+}
+
+TEST_F(FlightRecorder, resets_file_with_different_capacity)
+{
+    {
+        biometry::hardware::FlightRecorder recorder{path, 16};
+        recorder.append(biometry::hardware::FlightRecorder::Event::error_cb, 1, {5, 0});
+    }
+
+    biometry::hardware::FlightRecorder recorder{path, 32};
+    EXPECT_EQ(32, recorder.capacity());
+    EXPECT_EQ(1, biometry::hardware::FlightRecorder::read(path).size());
+}
+
+TEST_F(FlightRecorder, overwrites_oldest_records_once_full)
+{
+    biometry::hardware::FlightRecorder recorder{path, 8};
+    for (std::int64_t i = 0; i < 20; i++)
+        recorder.append(biometry::hardware::FlightRecorder::Event::acquired_cb, 1, {i, 0});
+
+    auto records = biometry::hardware::FlightRecorder::read(path);
+    ASSERT_EQ(8, records.size());
+    for (std::size_t i = 0; i < records.size(); i++)
+        EXPECT_EQ(12 + static_cast<std::int64_t>(i), records[i].arguments[0]);
+}
+
+TEST_F(FlightRecorder, drops_arguments_beyond_maximum)
+{
+    biometry::hardware::FlightRecorder recorder{path, 8};
+    recorder.append(biometry::hardware::FlightRecorder::Event::enroll, 1, {1, 2, 3, 4, 5, 6});
+
+    auto records = biometry::hardware::FlightRecorder::read(path);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(biometry::hardware::FlightRecorder::max_argument_count, records[1].argument_count);
+    EXPECT_EQ(4, records[1].arguments[3]);
+}
+
+TEST_F(FlightRecorder, concurrent_writers_do_not_lose_records)
+{
+    biometry::hardware::FlightRecorder recorder{path, 1024};
+
+    std::vector<std::thread> writers;
+    for (std::uint64_t op = 1; op <= 4; op++)
+        writers.emplace_back([&recorder, op]()
+        {
+            for (std::int64_t i = 0; i < 100; i++)
+                recorder.append(biometry::hardware::FlightRecorder::Event::acquired_cb, op, {i, 0});
+        });
+
+    for (auto& writer : writers)
+        writer.join();
+
+    EXPECT_EQ(401, biometry::hardware::FlightRecorder::read(path).size());
+}
+
+TEST_F(FlightRecorder, record_goes_to_installed_recorder)
+{
+    biometry::hardware::FlightRecorder::record(biometry::hardware::FlightRecorder::Event::cancel, 1, {});
+
+    auto recorder = std::make_shared<biometry::hardware::FlightRecorder>(path, 8);
+    biometry::hardware::FlightRecorder::install(recorder);
+    biometry::hardware::FlightRecorder::record(biometry::hardware::FlightRecorder::Event::cancel, 2, {});
+    biometry::hardware::FlightRecorder::install(nullptr);
+    biometry::hardware::FlightRecorder::record(biometry::hardware::FlightRecorder::Event::cancel, 3, {});
+
+    auto records = biometry::hardware::FlightRecorder::read(path);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(2, records[1].operation);
+}
+
+TEST_F(FlightRecorder, read_throws_for_files_that_are_not_recorder_files)
+{
+    boost::filesystem::create_directories(dir);
+    std::ofstream{path.string()} << "this is not a flight recorder file, but long enough to hold a header";
+
+    EXPECT_THROW(biometry::hardware::FlightRecorder::read(path), std::runtime_error);
+}
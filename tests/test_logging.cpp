@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/logging.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// RecordingSink remembers all messages handed to it.
+struct RecordingSink : public biometry::util::logging::Sink
+{
+    void write(biometry::util::logging::Severity severity, std::chrono::system_clock::time_point, const char* message) override
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        messages.emplace_back(severity, message);
+    }
+
+    std::vector<std::pair<biometry::util::logging::Severity, std::string>> snapshot()
+    {
+        std::lock_guard<std::mutex> lg{guard};
+        return messages;
+    }
+
+    std::mutex guard;
+    std::vector<std::pair<biometry::util::logging::Severity, std::string>> messages;
+};
+
+struct Logging : public ::testing::Test
+{
+    Logging()
+    {
+        biometry::util::logging::flush();
+        biometry::util::logging::set_sink(sink);
+        biometry::util::logging::set_rate_limit(0);
+    }
+
+    ~Logging()
+    {
+        biometry::util::logging::flush();
+        biometry::util::logging::set_sink(biometry::util::logging::stderr_sink());
+        biometry::util::logging::set_severity(biometry::util::logging::Severity::info);
+        biometry::util::logging::set_rate_limit(200);
+    }
+
+    std::shared_ptr<RecordingSink> sink{std::make_shared<RecordingSink>()};
+};
+}
+
+TEST_F(Logging, writes_messages_at_or_above_severity_to_sink)
+{
+    biometry::util::logging::set_severity(biometry::util::logging::Severity::info);
+
+    biometry::util::logging::debug("dropped");
+    biometry::util::logging::info("info %d", 42);
+    biometry::util::logging::warning("warning %s", "message");
+    biometry::util::logging::error("error");
+    biometry::util::logging::flush();
+
+    EXPECT_EQ((std::vector<std::pair<biometry::util::logging::Severity, std::string>>
+    {
+        {biometry::util::logging::Severity::info, "info 42"},
+        {biometry::util::logging::Severity::warning, "warning message"},
+        {biometry::util::logging::Severity::error, "error"}
+    }), sink->snapshot());
+}
+
+TEST_F(Logging, truncates_long_messages)
+{
+    biometry::util::logging::info("%s", std::string(1024, 'a').c_str());
+    biometry::util::logging::flush();
+
+    auto messages = sink->snapshot();
+    ASSERT_EQ(1, messages.size());
+    EXPECT_GT(1024, messages[0].second.size());
+    EXPECT_EQ("...", messages[0].second.substr(messages[0].second.size() - 3));
+}
+
+TEST_F(Logging, drops_messages_exceeding_rate_limit_and_reports_them)
+{
+    biometry::util::logging::set_rate_limit(10);
+
+    for (int i = 0; i < 100; i++)
+        biometry::util::logging::info("message %d", i);
+    biometry::util::logging::flush();
+
+    auto messages = sink->snapshot();
+    ASSERT_LT(messages.size(), 20);
+    EXPECT_EQ(biometry::util::logging::Severity::warning, messages.back().first);
+    EXPECT_EQ(0, messages.back().second.find("Dropped")) << messages.back().second;
+}
+
+TEST_F(Logging, accepts_messages_from_multiple_threads)
+{
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; t++)
+        producers.emplace_back([t]()
+        {
+            for (int i = 0; i < 100; i++)
+                biometry::util::logging::info("thread %d message %d", t, i);
+        });
+
+    for (auto& producer : producers)
+        producer.join();
+
+    biometry::util::logging::flush();
+    EXPECT_EQ(400, sink->snapshot().size());
+}
+
+TEST_F(Logging, file_sink_appends_timestamped_messages)
+{
+    auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    biometry::util::logging::set_sink(biometry::util::logging::file_sink(path));
+
+    biometry::util::logging::error("written to %s", "file");
+    biometry::util::logging::flush();
+    biometry::util::logging::set_sink(sink);
+
+    std::ifstream in{path.string()};
+    std::string line; std::getline(in, line);
+    boost::filesystem::remove(path);
+
+    EXPECT_EQ('Z', line[26]) << line;
+    EXPECT_EQ(" [error] written to file", line.substr(27));
+}
+
+TEST(LoggingSeverity, can_be_read_from_and_written_to_streams)
+{
+    for (auto severity : {biometry::util::logging::Severity::debug, biometry::util::logging::Severity::info,
+                          biometry::util::logging::Severity::warning, biometry::util::logging::Severity::error})
+    {
+        std::stringstream ss; ss << severity;
+        biometry::util::logging::Severity parsed{biometry::util::logging::Severity::debug};
+        ss >> parsed;
+        EXPECT_EQ(severity, parsed);
+    }
+
+    std::stringstream ss{"verbose"};
+    biometry::util::logging::Severity parsed;
+    EXPECT_FALSE(ss >> parsed);
+}
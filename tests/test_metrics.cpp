@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/devices/instrumented.h>
+#include <biometry/util/metrics.h>
+
+#include "mock_device.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST(Metrics, key_without_labels_equals_name)
+{
+    EXPECT_EQ("operations_started_total", biometry::util::Metrics::key("operations_started_total"));
+}
+
+TEST(Metrics, key_includes_sorted_and_escaped_labels)
+{
+    EXPECT_EQ("a{app=\"x\\\"y\",type=\"z\"}", biometry::util::Metrics::key("a", {{"type", "z"}, {"app", "x\"y"}}));
+}
+
+TEST(Metrics, lookup_returns_same_instance_for_same_name_and_labels)
+{
+    biometry::util::Metrics metrics;
+    EXPECT_EQ(&metrics.counter("a", {{"b", "c"}}), &metrics.counter("a", {{"b", "c"}}));
+    EXPECT_NE(&metrics.counter("a", {{"b", "c"}}), &metrics.counter("a", {{"b", "d"}}));
+}
+
+TEST(Metrics, counter_accumulates_increments_from_multiple_threads)
+{
+    static constexpr const std::size_t thread_count{8};
+    static constexpr const std::size_t increments{10000};
+
+    biometry::util::Metrics metrics;
+    auto& counter = metrics.counter("a");
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < thread_count; i++)
+        threads.emplace_back([&counter]() { for (std::size_t j = 0; j < increments; j++) counter.increment(); });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(thread_count * increments, counter.value());
+}
+
+TEST(Metrics, gauge_goes_up_and_down)
+{
+    biometry::util::Metrics metrics;
+    auto& gauge = metrics.gauge("a");
+
+    gauge.increment(); gauge.increment(); gauge.decrement();
+    EXPECT_EQ(1, gauge.value());
+    gauge.set(-42);
+    EXPECT_EQ(-42, gauge.value());
+}
+
+TEST(Metrics, histogram_sorts_observations_into_power_of_two_buckets)
+{
+    biometry::util::Metrics metrics;
+    auto& histogram = metrics.histogram("a");
+
+    histogram.observe(std::chrono::microseconds{1});
+    histogram.observe(std::chrono::microseconds{3});
+    histogram.observe(std::chrono::microseconds{4});
+    histogram.observe(std::chrono::microseconds{5});
+    histogram.observe(std::chrono::hours{1});
+
+    EXPECT_EQ(5, histogram.count());
+    EXPECT_EQ(1 + 3 + 4 + 5 + 3600000000ull, histogram.sum());
+    EXPECT_EQ(1, histogram.bucket(0));
+    EXPECT_EQ(2, histogram.bucket(2));
+    EXPECT_EQ(1, histogram.bucket(3));
+    EXPECT_EQ(1, histogram.bucket(biometry::util::Metrics::Histogram::bucket_count - 1));
+}
+
+TEST(Metrics, snapshot_survives_roundtrip_through_dictionary)
+{
+    biometry::util::Metrics metrics;
+    metrics.counter("c", {{"type", "enrollment"}}).increment(42);
+    metrics.gauge("g").set(-1);
+    metrics.histogram("h").observe(std::chrono::microseconds{10});
+
+    auto snapshot = metrics.snapshot();
+
+    biometry::util::Metrics::Snapshot decoded;
+    decoded.from_dictionary(snapshot.to_dictionary());
+
+    EXPECT_EQ(snapshot.counters, decoded.counters);
+    EXPECT_EQ(snapshot.gauges, decoded.gauges);
+    ASSERT_EQ(1, decoded.histograms.count("h"));
+    EXPECT_EQ(1, decoded.histograms.at("h").count);
+    EXPECT_EQ(10, decoded.histograms.at("h").sum);
+    EXPECT_EQ(snapshot.histograms.at("h").buckets, decoded.histograms.at("h").buckets);
+}
+
+TEST(Metrics, snapshot_prints_histograms_with_cumulative_buckets)
+{
+    biometry::util::Metrics metrics;
+    metrics.histogram("h", {{"call", "enroll"}}).observe(std::chrono::microseconds{2});
+
+    std::stringstream ss; ss << metrics.snapshot();
+    auto s = ss.str();
+
+    EXPECT_NE(std::string::npos, s.find("h_bucket{call=\"enroll\",le=\"1\"} 0\n"));
+    EXPECT_NE(std::string::npos, s.find("h_bucket{call=\"enroll\",le=\"2\"} 1\n"));
+    EXPECT_NE(std::string::npos, s.find("h_bucket{call=\"enroll\",le=\"+Inf\"} 1\n"));
+    EXPECT_NE(std::string::npos, s.find("h_sum{call=\"enroll\"} 2\n"));
+    EXPECT_NE(std::string::npos, s.find("h_count{call=\"enroll\"} 1\n"));
+}
+
+TEST(Instrumented, counts_operations_and_outcomes_per_type_and_app)
+{
+    using namespace ::testing;
+
+    typedef biometry::Operation<biometry::Identification> Operation;
+
+    const biometry::Application app{"com.ubuntu.test.metrics"};
+    const biometry::Reason reason{biometry::Reason::unknown()};
+
+    auto& started = biometry::util::metrics().counter("operations_started_total", {{"type", "identification"}, {"app", app.as_string()}});
+    auto& succeeded = biometry::util::metrics().counter("operations_succeeded_total", {{"type", "identification"}, {"app", app.as_string()}});
+    auto& failed = biometry::util::metrics().counter("operations_failed_total", {{"type", "identification"}, {"app", app.as_string()}});
+    auto& duration = biometry::util::metrics().histogram("operation_duration_us", {{"type", "identification"}});
+    auto count = duration.count();
+
+    auto op = std::make_shared<MockOperation<biometry::Identification>>();
+    Operation::Observer::Ptr observer;
+    EXPECT_CALL(*op, start_with_observer(_)).Times(1).WillOnce(SaveArg<0>(&observer));
+
+    MockIdentifier identifier;
+    EXPECT_CALL(identifier, identify_user(_, _)).Times(1).WillOnce(Return(op));
+
+    auto impl = std::make_shared<MockDevice>();
+    EXPECT_CALL(*impl, identifier()).Times(1).WillOnce(ReturnRef(identifier));
+
+    biometry::devices::Instrumented instrumented{impl};
+    instrumented.identifier().identify_user(app, reason)->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Identification>>>());
+
+    EXPECT_EQ(1, started.value());
+    ASSERT_NE(nullptr, observer);
+
+    observer->on_succeeded(biometry::User::current());
+    // Only the first final state of an operation is recorded.
+    observer->on_failed("failed");
+
+    EXPECT_EQ(1, succeeded.value());
+    EXPECT_EQ(0, failed.value());
+    EXPECT_EQ(count + 1, duration.count());
+}
+
+TEST(Instrumented, attributes_operations_to_the_requester_in_scope)
+{
+    using namespace ::testing;
+
+    const biometry::Application claimed{"com.ubuntu.test.metrics.claimed"};
+    const biometry::Application resolved{"com.ubuntu.test.metrics.resolved"};
+
+    auto& started = biometry::util::metrics().counter("operations_started_total", {{"type", "identification"}, {"app", resolved.as_string()}});
+    auto value = started.value();
+
+    MockIdentifier identifier;
+    EXPECT_CALL(identifier, identify_user(_, _)).Times(1).WillOnce(Return(std::make_shared<NiceMock<MockOperation<biometry::Identification>>>()));
+
+    auto impl = std::make_shared<MockDevice>();
+    EXPECT_CALL(*impl, identifier()).Times(1).WillOnce(ReturnRef(identifier));
+
+    biometry::devices::Instrumented instrumented{impl};
+    {
+        biometry::devices::Instrumented::Requester requester{resolved};
+        instrumented.identifier().identify_user(claimed, biometry::Reason::unknown())->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Identification>>>());
+    }
+
+    EXPECT_EQ(value + 1, started.value());
+    EXPECT_EQ(0, biometry::util::metrics().snapshot().counters.count(
+                  biometry::util::Metrics::key("operations_started_total", {{"type", "identification"}, {"app", claimed.as_string()}})));
+}
+
+TEST(Instrumented, counts_apps_beyond_max_apps_as_other)
+{
+    using namespace ::testing;
+
+    const std::size_t apps{2 * biometry::devices::Instrumented::max_apps};
+
+    auto& other = biometry::util::metrics().counter("operations_started_total", {{"type", "verification"}, {"app", "other"}});
+    auto value = other.value();
+
+    MockVerifier verifier;
+    EXPECT_CALL(verifier, verify_user(_, _, _)).Times(apps).WillRepeatedly(Return(std::make_shared<NiceMock<MockOperation<biometry::Verification>>>()));
+
+    auto impl = std::make_shared<MockDevice>();
+    EXPECT_CALL(*impl, verifier()).Times(apps).WillRepeatedly(ReturnRef(verifier));
+
+    biometry::devices::Instrumented instrumented{impl};
+    for (std::size_t i = 0; i < apps; i++)
+    {
+        biometry::Application app{"com.ubuntu.test.metrics.app" + std::to_string(i)};
+        instrumented.verifier().verify_user(app, biometry::User::current(), biometry::Reason::unknown())->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Verification>>>());
+    }
+
+    EXPECT_LE(value + biometry::devices::Instrumented::max_apps, other.value());
+
+    auto snapshot = biometry::util::metrics().snapshot();
+    EXPECT_EQ(0, snapshot.counters.count(biometry::util::Metrics::key(
+                  "operations_started_total", {{"type", "verification"}, {"app", "com.ubuntu.test.metrics.app" + std::to_string(apps - 1)}})));
+}
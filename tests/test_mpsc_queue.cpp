@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/mpsc_queue.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(MpscQueue, push_reports_transition_from_empty)
+{
+    biometry::util::MpscQueue<int> queue;
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_FALSE(queue.push(2));
+
+    queue.drain([](int) {});
+    EXPECT_TRUE(queue.push(3));
+}
+
+TEST(MpscQueue, drain_hands_out_values_in_fifo_order)
+{
+    biometry::util::MpscQueue<int> queue;
+    for (int i = 0; i < 10; i++)
+        queue.push(int{i});
+
+    std::vector<int> values;
+    EXPECT_EQ(10u, queue.drain([&values](int i) { values.push_back(i); }));
+
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(i, values[i]);
+
+    EXPECT_EQ(0u, queue.drain([](int) {}));
+}
+
+TEST(MpscQueue, releases_values_that_have_not_been_drained)
+{
+    auto sp = std::make_shared<int>(42);
+
+    {
+        biometry::util::MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(std::shared_ptr<int>{sp});
+        queue.push(std::shared_ptr<int>{sp});
+        EXPECT_EQ(3, sp.use_count());
+    }
+
+    EXPECT_EQ(1, sp.use_count());
+}
+
+TEST(MpscQueue, drain_hands_out_remaining_values_if_handler_throws)
+{
+    biometry::util::MpscQueue<int> queue;
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    std::vector<int> values;
+    EXPECT_EQ(3, queue.drain([&values](int value)
+    {
+        if (value == 2)
+            throw std::runtime_error{"42"};
+
+        values.push_back(value);
+    }));
+
+    EXPECT_EQ((std::vector<int>{1, 3}), values);
+    EXPECT_EQ(0, queue.drain([](int) {}));
+}
+
+TEST(MpscQueue, accepts_values_from_multiple_producers)
+{
+    static constexpr const std::size_t producers{8};
+    static constexpr const std::size_t values_per_producer{10000};
+
+    biometry::util::MpscQueue<std::size_t> queue;
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; p++)
+        threads.emplace_back([&queue]()
+        {
+            for (std::size_t i = 0; i < values_per_producer; i++)
+                queue.push(std::size_t{i});
+        });
+
+    std::size_t drained{0};
+    for (auto& thread : threads)
+    {
+        thread.join();
+        drained += queue.drain([](std::size_t) {});
+    }
+
+    EXPECT_EQ(producers * values_per_producer, drained);
+}
@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/runtime.h>
+
+#include <biometry/util/metrics.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+std::uint64_t exceptions(const std::string& action)
+{
+    return biometry::util::metrics().counter("runtime_handler_exceptions_total", {{"action", action}}).value();
+}
+
+std::uint64_t slow_handlers()
+{
+    return biometry::util::metrics().counter("runtime_slow_handlers_total").value();
+}
+
+biometry::Runtime::Supervision fast_supervision()
+{
+    biometry::Runtime::Supervision supervision;
+    supervision.min_backoff = std::chrono::milliseconds{5};
+    supervision.max_backoff = std::chrono::milliseconds{40};
+    supervision.slow_handler_threshold = std::chrono::milliseconds{50};
+    supervision.watchdog_interval = std::chrono::milliseconds{5};
+    return supervision;
+}
+}
+
+TEST(Runtime, resumes_workers_after_exceptions_with_retry_policy)
+{
+    auto before = exceptions("retry");
+
+    auto rt = biometry::Runtime::create(1, fast_supervision());
+    rt->start();
+
+    std::promise<void> done;
+    rt->service().post([]() { throw std::runtime_error{"from handler"}; });
+    rt->service().post([&done]() { done.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+    EXPECT_EQ(before + 1, exceptions("retry"));
+
+    rt->stop();
+}
+
+TEST(Runtime, ignores_repeated_start_and_stop)
+{
+    auto rt = biometry::Runtime::create(1, fast_supervision());
+    rt->start();
+    rt->start();
+
+    std::promise<void> done;
+    rt->service().post([&done]() { done.set_value(); });
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+
+    rt->stop();
+    rt->stop();
+}
+
+TEST(Runtime, can_be_restarted)
+{
+    auto rt = biometry::Runtime::create(1, fast_supervision());
+
+    for (int i = 0; i < 3; i++)
+    {
+        rt->start();
+
+        std::promise<void> done;
+        rt->service().post([&done]() { done.set_value(); });
+        EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+
+        rt->stop();
+    }
+
+    // Handlers posted while stopped are executed after starting again.
+    std::promise<void> done;
+    rt->service().post([&done]() { done.set_value(); });
+    rt->start();
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+    rt->stop();
+}
+
+TEST(Runtime, backs_off_from_poisoned_handlers)
+{
+    auto before = exceptions("retry");
+
+    auto rt = biometry::Runtime::create(1, fast_supervision());
+    rt->start();
+
+    // The handler keeps rescheduling itself, throwing on every invocation.
+    std::function<void()> poisoned;
+    poisoned = [&rt, &poisoned]()
+    {
+        rt->service().post(poisoned);
+        throw std::runtime_error{"poisoned"};
+    };
+    rt->service().post(poisoned);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    rt->stop();
+
+    // 5 + 10 + 20 + 40 + 40 + ... ms, a spinning worker would have thrown thousands of times.
+    EXPECT_LT(exceptions("retry") - before, 10);
+    EXPECT_GT(exceptions("retry") - before, 2);
+}
+
+TEST(Runtime, terminates_with_fatal_policy)
+{
+    auto supervision = fast_supervision();
+    supervision.exception_policy = biometry::Runtime::Supervision::fatal_all();
+
+    EXPECT_DEATH(
+    {
+        auto rt = biometry::Runtime::create(1, supervision);
+        rt->start();
+        rt->service().post([]() { throw std::runtime_error{"fatal"}; });
+        std::this_thread::sleep_for(std::chrono::seconds{5});
+    }, "");
+}
+
+TEST(Runtime, exception_policy_decides_per_exception)
+{
+    auto supervision = fast_supervision();
+    supervision.exception_policy = [](const std::exception_ptr& e)
+    {
+        try
+        {
+            std::rethrow_exception(e);
+        }
+        catch (const std::logic_error&)
+        {
+            return biometry::Runtime::Supervision::ExceptionAction::fatal;
+        }
+        catch (...)
+        {
+        }
+
+        return biometry::Runtime::Supervision::ExceptionAction::retry;
+    };
+
+    auto rt = biometry::Runtime::create(1, supervision);
+    rt->start();
+
+    std::promise<void> done;
+    rt->service().post([]() { throw std::runtime_error{"recoverable"}; });
+    rt->service().post([&done]() { done.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+    rt->stop();
+}
+
+TEST(Runtime, watchdog_reports_slow_watched_handlers)
+{
+    auto before = slow_handlers();
+
+    auto rt = biometry::Runtime::create(1, fast_supervision());
+    rt->start();
+
+    std::promise<void> done;
+    rt->to_dispatcher_functional()([&done]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        done.set_value();
+    });
+
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+    rt->stop();
+
+    // A slow handler is reported exactly once.
+    EXPECT_EQ(before + 1, slow_handlers());
+}
+
+TEST(Runtime, watchdog_ignores_fast_handlers)
+{
+    auto before = slow_handlers();
+
+    auto rt = biometry::Runtime::create(2, fast_supervision());
+    rt->start();
+
+    std::promise<void> done;
+    auto dispatch = rt->to_dispatcher_functional();
+    for (int i = 0; i < 100; i++)
+        dispatch([]() {});
+    dispatch([&done]() { done.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    rt->stop();
+
+    EXPECT_EQ(before, slow_handlers());
+}
+
+TEST(RuntimeWatch, does_nothing_outside_of_workers)
+{
+    biometry::Runtime::Watch watch;
+}
+
+TEST(RuntimeLanes, fall_back_to_the_bus_lane_without_threads)
+{
+    auto rt = biometry::Runtime::create(1);
+
+    EXPECT_EQ(&rt->service(), &rt->service(biometry::Runtime::Lane::bus));
+    EXPECT_EQ(&rt->service(), &rt->service(biometry::Runtime::Lane::device));
+    EXPECT_EQ(&rt->service(), &rt->service(biometry::Runtime::Lane::background));
+}
+
+TEST(RuntimeLanes, are_executed_on_distinct_threads)
+{
+    biometry::Runtime::Lanes lanes;
+    lanes.bus = biometry::Runtime::LaneConfiguration{1, 0};
+    lanes.device = biometry::Runtime::LaneConfiguration{1, 0};
+    lanes.background = biometry::Runtime::LaneConfiguration{1, 0};
+
+    auto rt = biometry::Runtime::create(lanes, fast_supervision());
+    rt->start();
+
+    std::promise<std::thread::id> bus, device, background;
+    rt->service(biometry::Runtime::Lane::bus).post([&bus]() { bus.set_value(std::this_thread::get_id()); });
+    rt->service(biometry::Runtime::Lane::device).post([&device]() { device.set_value(std::this_thread::get_id()); });
+    rt->service(biometry::Runtime::Lane::background).post([&background]() { background.set_value(std::this_thread::get_id()); });
+
+    auto b = bus.get_future().get();
+    auto d = device.get_future().get();
+    auto bg = background.get_future().get();
+
+    EXPECT_NE(b, d);
+    EXPECT_NE(b, bg);
+    EXPECT_NE(d, bg);
+
+    rt->stop();
+}
+
+TEST(RuntimeLanes, blocked_device_lane_does_not_delay_bus_lane)
+{
+    biometry::Runtime::Lanes lanes;
+    lanes.bus = biometry::Runtime::LaneConfiguration{1, 0};
+    lanes.device = biometry::Runtime::LaneConfiguration{1, 0};
+
+    auto rt = biometry::Runtime::create(lanes, fast_supervision());
+    rt->start();
+
+    // The device handler only returns once the bus lane has executed a handler.
+    std::promise<void> unblock;
+    auto unblocked = unblock.get_future();
+    std::promise<void> done;
+
+    rt->service(biometry::Runtime::Lane::device).post([&unblocked, &done]()
+    {
+        unblocked.wait();
+        done.set_value();
+    });
+    rt->service(biometry::Runtime::Lane::bus).post([&unblock]() { unblock.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds{5}));
+
+    rt->stop();
+}
+
+TEST(RuntimeLanes, apply_nice_value_to_worker_threads)
+{
+    biometry::Runtime::Lanes lanes;
+    lanes.bus = biometry::Runtime::LaneConfiguration{1, 0};
+    lanes.background = biometry::Runtime::LaneConfiguration{1, 10};
+
+    auto rt = biometry::Runtime::create(lanes, fast_supervision());
+    rt->start();
+
+    std::promise<int> nice;
+    rt->service(biometry::Runtime::Lane::background).post([&nice]()
+    {
+        nice.set_value(::getpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid))));
+    });
+
+    // Lowering the priority never requires privileges.
+    EXPECT_LE(10, nice.get_future().get());
+
+    rt->stop();
+}
+
+TEST(RuntimeLanes, suspended_lane_queues_handlers_until_resumed)
+{
+    biometry::Runtime::Lanes lanes;
+    lanes.bus = biometry::Runtime::LaneConfiguration{1, 0};
+    lanes.device = biometry::Runtime::LaneConfiguration{1, 0};
+
+    auto rt = biometry::Runtime::create(lanes, fast_supervision());
+    rt->start();
+    rt->suspend(biometry::Runtime::Lane::device);
+
+    std::promise<void> device, bus;
+    auto executed = device.get_future();
+    rt->service(biometry::Runtime::Lane::device).post([&device]() { device.set_value(); });
+    rt->service(biometry::Runtime::Lane::bus).post([&bus]() { bus.set_value(); });
+
+    // Other lanes carry on.
+    EXPECT_EQ(std::future_status::ready, bus.get_future().wait_for(std::chrono::seconds{5}));
+    EXPECT_EQ(std::future_status::timeout, executed.wait_for(std::chrono::milliseconds{100}));
+
+    rt->resume(biometry::Runtime::Lane::device);
+    EXPECT_EQ(std::future_status::ready, executed.wait_for(std::chrono::seconds{5}));
+
+    rt->stop();
+}
+
+TEST(RuntimeLanes, cannot_be_suspended_from_own_worker)
+{
+    biometry::Runtime::Lanes lanes;
+    lanes.bus = biometry::Runtime::LaneConfiguration{1, 0};
+    lanes.device = biometry::Runtime::LaneConfiguration{1, 0};
+
+    auto rt = biometry::Runtime::create(lanes, fast_supervision());
+    rt->start();
+
+    std::promise<bool> thrown;
+    rt->service(biometry::Runtime::Lane::device).post([&rt, &thrown]()
+    {
+        try
+        {
+            rt->suspend(biometry::Runtime::Lane::device);
+            thrown.set_value(false);
+        }
+        catch (const std::logic_error&)
+        {
+            thrown.set_value(true);
+        }
+    });
+
+    EXPECT_TRUE(thrown.get_future().get());
+
+    rt->stop();
+}
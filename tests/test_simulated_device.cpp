@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/devices/simulated.h>
+
+#include <biometry/application.h>
+#include <biometry/reason.h>
+#include <biometry/user.h>
+
+#include <biometry/util/json_configuration_builder.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <sstream>
+
+namespace
+{
+// Outcome captures the final state of an operation.
+template<typename T>
+struct Outcome
+{
+    bool succeeded{false};
+    typename T::Result result{};
+    std::string error{};
+    std::uint32_t progress{0};
+};
+
+// Waiter is an observer fulfilling a promise once the operation it observes finished.
+template<typename T>
+class Waiter : public biometry::Operation<T>::Observer
+{
+public:
+    typedef typename biometry::Operation<T>::Observer Super;
+
+    using typename Super::Progress;
+    using typename Super::Reason;
+    using typename Super::Error;
+    using typename Super::Result;
+
+    void on_started() override {}
+    void on_progress(const Progress&) override { outcome.progress++; }
+    void on_canceled(const Reason& reason) override { outcome.error = reason; promise.set_value(outcome); }
+    void on_failed(const Error& error) override { outcome.error = error; promise.set_value(outcome); }
+    void on_succeeded(const Result& result) override { outcome.succeeded = true; outcome.result = result; promise.set_value(outcome); }
+
+    Outcome<T> outcome;
+    std::promise<Outcome<T>> promise;
+};
+
+// run starts op and waits for it to finish.
+template<typename T>
+Outcome<T> run(const typename biometry::Operation<T>::Ptr& op)
+{
+    auto waiter = std::make_shared<Waiter<T>>();
+    auto future = waiter->promise.get_future();
+    op->start_with_observer(waiter);
+    EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{5}));
+    return future.get();
+}
+
+// instant returns a model without any latency, failures or rejections.
+biometry::devices::Simulated::Model instant()
+{
+    biometry::devices::Simulated::Model model;
+    auto zero = biometry::devices::Simulated::Latency::fixed(0);
+    model.latency = {zero, zero, zero, zero, zero, zero, zero, zero};
+    return model;
+}
+
+const biometry::Application& app = biometry::Application::system();
+const biometry::User& user = biometry::User::current();
+}
+
+TEST(Simulated, enrolls_templates_in_steps)
+{
+    auto model = instant();
+    model.enrollment_steps = 3;
+    biometry::devices::Simulated device{model};
+
+    auto enrollment = run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user));
+    EXPECT_TRUE(enrollment.succeeded);
+    // A touch and a completion per step, the final step reports completion once.
+    EXPECT_EQ(6, enrollment.progress);
+
+    auto size = run<biometry::TemplateStore::SizeQuery>(device.template_store().size(app, user));
+    EXPECT_EQ(1, size.result);
+
+    auto list = run<biometry::TemplateStore::List>(device.template_store().list(app, user));
+    EXPECT_EQ(std::vector<biometry::TemplateStore::TemplateId>{enrollment.result}, list.result);
+}
+
+TEST(Simulated, enforces_template_capacity)
+{
+    auto model = instant();
+    model.capacity = 1;
+    biometry::devices::Simulated device{model};
+
+    EXPECT_TRUE(run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user)).succeeded);
+    EXPECT_FALSE(run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user)).succeeded);
+}
+
+TEST(Simulated, removes_and_clears_templates)
+{
+    biometry::devices::Simulated device{instant()};
+
+    auto first = run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user)).result;
+    run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user));
+
+    EXPECT_TRUE(run<biometry::TemplateStore::Removal>(device.template_store().remove(app, user, first)).succeeded);
+    EXPECT_FALSE(run<biometry::TemplateStore::Removal>(device.template_store().remove(app, user, first)).succeeded);
+    EXPECT_EQ(1, run<biometry::TemplateStore::SizeQuery>(device.template_store().size(app, user)).result);
+
+    EXPECT_TRUE(run<biometry::TemplateStore::Clearance>(device.template_store().clear(app, user)).succeeded);
+    EXPECT_EQ(0, run<biometry::TemplateStore::SizeQuery>(device.template_store().size(app, user)).result);
+}
+
+TEST(Simulated, verifies_and_identifies_enrolled_users)
+{
+    biometry::devices::Simulated device{instant()};
+
+    EXPECT_EQ(biometry::Verification::Result::not_verified, run<biometry::Verification>(device.verifier().verify_user(app, user, biometry::Reason::unknown())).result);
+    EXPECT_FALSE(run<biometry::Identification>(device.identifier().identify_user(app, biometry::Reason::unknown())).succeeded);
+
+    run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user));
+
+    EXPECT_EQ(biometry::Verification::Result::verified, run<biometry::Verification>(device.verifier().verify_user(app, user, biometry::Reason::unknown())).result);
+    auto identification = run<biometry::Identification>(device.identifier().identify_user(app, biometry::Reason::unknown()));
+    EXPECT_TRUE(identification.succeeded);
+    EXPECT_EQ(user, identification.result);
+}
+
+TEST(Simulated, locks_out_after_repeated_rejections)
+{
+    auto model = instant();
+    model.rejection_rate = 1;
+    model.lockout.attempts = 2;
+    model.lockout.duration = std::chrono::seconds{60};
+    biometry::devices::Simulated device{model};
+
+    run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user));
+
+    for (int i = 0; i < 2; i++)
+        EXPECT_EQ(biometry::Verification::Result::not_verified, run<biometry::Verification>(device.verifier().verify_user(app, user, biometry::Reason::unknown())).result);
+
+    auto verification = run<biometry::Verification>(device.verifier().verify_user(app, user, biometry::Reason::unknown()));
+    EXPECT_FALSE(verification.succeeded);
+    EXPECT_EQ("Sensor is locked out", verification.error);
+}
+
+TEST(Simulated, fails_operations_according_to_failure_rate)
+{
+    auto model = instant();
+    model.failure_rate = 1;
+    biometry::devices::Simulated device{model};
+
+    EXPECT_FALSE(run<biometry::TemplateStore::SizeQuery>(device.template_store().size(app, user)).succeeded);
+    EXPECT_FALSE(run<biometry::TemplateStore::Enrollment>(device.template_store().enroll(app, user)).succeeded);
+}
+
+TEST(Simulated, cancels_pending_operations)
+{
+    auto model = instant();
+    model.latency.touch = biometry::devices::Simulated::Latency::fixed(60000);
+    biometry::devices::Simulated device{model};
+
+    auto op = device.verifier().verify_user(app, user, biometry::Reason::unknown());
+    auto waiter = std::make_shared<Waiter<biometry::Verification>>();
+    auto future = waiter->promise.get_future();
+    op->start_with_observer(waiter);
+    op->cancel();
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{5}));
+    EXPECT_FALSE(future.get().succeeded);
+}
+
+TEST(SimulatedLatency, samples_stay_within_bounds)
+{
+    std::mt19937 rng{0};
+
+    EXPECT_EQ(std::chrono::milliseconds{42}, biometry::devices::Simulated::Latency::fixed(42).sample(rng));
+
+    biometry::devices::Simulated::Latency normal{biometry::devices::Simulated::Latency::Distribution::normal, 50, 100, 10, 90};
+    for (int i = 0; i < 1000; i++)
+    {
+        auto sample = normal.sample(rng);
+        EXPECT_GE(sample.count(), 10);
+        EXPECT_LE(sample.count(), 90);
+    }
+}
+
+TEST(SimulatedModel, is_decoded_from_configuration)
+{
+    std::stringstream in{R"_({"config": {"seed": 7, "latency": {"verify": {"distribution": "uniform", "min": 5, "max": 10}},
+                              "enrollmentSteps": 8, "failureRate": 0.5, "rejectionRate": 0.25,
+                              "lockout": {"attempts": 3, "duration": 1000}, "capacity": 2}})_"};
+    auto config = biometry::util::JsonConfigurationBuilder{in}.build_configuration();
+    auto model = biometry::devices::Simulated::Model::from_configuration(config["config"]);
+
+    EXPECT_EQ(7, model.seed);
+    EXPECT_EQ(biometry::devices::Simulated::Latency::Distribution::uniform, model.latency.verify.distribution);
+    EXPECT_DOUBLE_EQ(5, model.latency.verify.min);
+    EXPECT_DOUBLE_EQ(10, model.latency.verify.max);
+    EXPECT_EQ(8, model.enrollment_steps);
+    EXPECT_DOUBLE_EQ(0.5, model.failure_rate);
+    EXPECT_DOUBLE_EQ(0.25, model.rejection_rate);
+    EXPECT_EQ(3, model.lockout.attempts);
+    EXPECT_EQ(std::chrono::milliseconds{1000}, model.lockout.duration);
+    EXPECT_EQ(2, model.capacity);
+}
+
+TEST(SimulatedModel, throws_for_invalid_configuration)
+{
+    std::stringstream rate{R"_({"failureRate": 2})_"};
+    EXPECT_THROW(biometry::devices::Simulated::Model::from_configuration(biometry::util::JsonConfigurationBuilder{rate}.build_configuration().root()), std::runtime_error);
+
+    std::stringstream distribution{R"_({"latency": {"touch": {"distribution": "pareto"}}})_"};
+    EXPECT_THROW(biometry::devices::Simulated::Model::from_configuration(biometry::util::JsonConfigurationBuilder{distribution}.build_configuration().root()), std::runtime_error);
+}
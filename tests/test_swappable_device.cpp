@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <biometry/devices/swappable.h>
+
+#include <gmock/gmock.h>
+
+#include "mock_device.h"
+
+namespace
+{
+// ImmediateDispatcher runs tasks right away on the calling thread.
+struct ImmediateDispatcher : public biometry::util::Dispatcher
+{
+    void dispatch(Task&& task) override
+    {
+        task();
+    }
+};
+
+// DestructionReportingDevice invokes a callback when being destroyed.
+struct DestructionReportingDevice : public ::testing::MockDevice
+{
+    explicit DestructionReportingDevice(bool& destroyed) : destroyed(destroyed)
+    {
+    }
+
+    ~DestructionReportingDevice()
+    {
+        destroyed = true;
+    }
+
+    bool& destroyed;
+};
+}
+
+TEST(Swappable, throws_for_null_impl)
+{
+    auto dispatcher = std::make_shared<ImmediateDispatcher>();
+    EXPECT_THROW(biometry::devices::Swappable(dispatcher, nullptr), std::runtime_error);
+
+    biometry::devices::Swappable swappable{dispatcher, std::make_shared<testing::MockDevice>()};
+    EXPECT_THROW(swappable.swap(nullptr), std::runtime_error);
+}
+
+TEST(Swappable, forwards_requests_to_the_current_impl)
+{
+    using namespace ::testing;
+
+    auto op = std::make_shared<MockOperation<biometry::Identification>>();
+    EXPECT_CALL(*op, start_with_observer(_)).Times(1);
+
+    MockIdentifier identifier;
+    EXPECT_CALL(identifier, identify_user(_, _)).Times(1).WillOnce(Return(op));
+
+    auto first = std::make_shared<MockDevice>();
+    EXPECT_CALL(*first, identifier()).Times(0);
+
+    auto second = std::make_shared<MockDevice>();
+    EXPECT_CALL(*second, identifier()).Times(1).WillOnce(ReturnRef(identifier));
+
+    biometry::devices::Swappable swappable{std::make_shared<ImmediateDispatcher>(), first};
+    swappable.swap(second);
+
+    swappable.identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown())
+            ->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Identification>>>());
+}
+
+TEST(Swappable, releases_previous_impl_right_away_if_idle)
+{
+    bool destroyed{false};
+    bool drained{false};
+
+    biometry::devices::Swappable swappable{std::make_shared<ImmediateDispatcher>(), std::make_shared<DestructionReportingDevice>(destroyed)};
+    swappable.swap(std::make_shared<testing::MockDevice>(), [&drained]() { drained = true; });
+
+    EXPECT_TRUE(destroyed);
+    EXPECT_TRUE(drained);
+}
+
+TEST(Swappable, releases_previous_impl_once_operations_drained)
+{
+    using namespace ::testing;
+
+    bool destroyed{false};
+    bool drained{false};
+
+    std::shared_ptr<biometry::Operation<biometry::TemplateStore::Enrollment>::Observer> bound;
+
+    auto op = std::make_shared<MockOperation<biometry::TemplateStore::Enrollment>>();
+    EXPECT_CALL(*op, start_with_observer(_)).Times(1).WillOnce(SaveArg<0>(&bound));
+
+    MockTemplateStore ts;
+    EXPECT_CALL(ts, enroll(_, _)).Times(1).WillOnce(Return(op));
+
+    auto first = std::make_shared<DestructionReportingDevice>(destroyed);
+    EXPECT_CALL(*first, template_store()).Times(1).WillOnce(ReturnRef(ts));
+
+    auto observer = std::make_shared<MockObserver<biometry::TemplateStore::Enrollment>>();
+    EXPECT_CALL(*observer, on_succeeded(_)).Times(1);
+
+    biometry::devices::Swappable swappable{std::make_shared<ImmediateDispatcher>(), first};
+    first.reset();
+
+    auto enrollment = swappable.template_store().enroll(biometry::Application::system(), biometry::User::current());
+    enrollment->start_with_observer(observer);
+
+    swappable.swap(std::make_shared<MockDevice>(), [&drained]() { drained = true; });
+    EXPECT_FALSE(destroyed);
+    EXPECT_FALSE(drained);
+
+    bound->on_succeeded(biometry::TemplateStore::Enrollment::Result{});
+    EXPECT_TRUE(destroyed);
+    EXPECT_TRUE(drained);
+}
+
+TEST(Swappable, operations_not_yet_started_keep_previous_impl_alive)
+{
+    using namespace ::testing;
+
+    bool destroyed{false};
+
+    auto op = std::make_shared<MockOperation<biometry::Verification>>();
+
+    MockVerifier verifier;
+    EXPECT_CALL(verifier, verify_user(_, _, _)).Times(1).WillOnce(Return(op));
+
+    auto first = std::make_shared<DestructionReportingDevice>(destroyed);
+    EXPECT_CALL(*first, verifier()).Times(1).WillOnce(ReturnRef(verifier));
+
+    biometry::devices::Swappable swappable{std::make_shared<ImmediateDispatcher>(), first};
+    first.reset();
+
+    auto verification = swappable.verifier().verify_user(biometry::Application::system(), biometry::User::current(), biometry::Reason::unknown());
+    swappable.swap(std::make_shared<MockDevice>());
+    EXPECT_FALSE(destroyed);
+
+    verification.reset();
+    EXPECT_TRUE(destroyed);
+}
+
+TEST(Swappable, queues_requests_until_previous_impl_drained)
+{
+    using namespace ::testing;
+
+    bool destroyed{false};
+
+    std::shared_ptr<biometry::Operation<biometry::TemplateStore::Enrollment>::Observer> bound;
+
+    auto enrollment_op = std::make_shared<MockOperation<biometry::TemplateStore::Enrollment>>();
+    EXPECT_CALL(*enrollment_op, start_with_observer(_)).Times(1).WillOnce(SaveArg<0>(&bound));
+
+    MockTemplateStore ts;
+    EXPECT_CALL(ts, enroll(_, _)).Times(1).WillOnce(Return(enrollment_op));
+
+    auto first = std::make_shared<DestructionReportingDevice>(destroyed);
+    EXPECT_CALL(*first, template_store()).Times(1).WillOnce(ReturnRef(ts));
+
+    auto identification_op = std::make_shared<MockOperation<biometry::Identification>>();
+    EXPECT_CALL(*identification_op, start_with_observer(_)).Times(1);
+
+    MockIdentifier identifier;
+    EXPECT_CALL(identifier, identify_user(_, _)).Times(1).WillOnce(Return(identification_op));
+
+    auto second = std::make_shared<MockDevice>();
+    EXPECT_CALL(*second, identifier()).Times(0);
+
+    biometry::devices::Swappable swappable{std::make_shared<ImmediateDispatcher>(), first};
+    first.reset();
+
+    swappable.template_store().enroll(biometry::Application::system(), biometry::User::current())
+            ->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::TemplateStore::Enrollment>>>());
+
+    swappable.swap(second);
+
+    swappable.identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown())
+            ->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Identification>>>());
+
+    Mock::VerifyAndClearExpectations(second.get());
+    EXPECT_FALSE(destroyed);
+
+    // Once the previous impl has been released, queued requests reach the new one.
+    EXPECT_CALL(*second, identifier()).Times(1).WillOnce(ReturnRef(identifier));
+    bound->on_succeeded(biometry::TemplateStore::Enrollment::Result{});
+    EXPECT_TRUE(destroyed);
+}
+
+TEST(Swappable, swapping_again_while_draining_releases_superseded_impl)
+{
+    using namespace ::testing;
+
+    bool first_destroyed{false};
+    bool second_destroyed{false};
+    bool first_drained{false};
+    bool second_drained{false};
+
+    std::shared_ptr<biometry::Operation<biometry::Verification>::Observer> bound;
+
+    auto verification_op = std::make_shared<MockOperation<biometry::Verification>>();
+    EXPECT_CALL(*verification_op, start_with_observer(_)).Times(1).WillOnce(SaveArg<0>(&bound));
+
+    MockVerifier verifier;
+    EXPECT_CALL(verifier, verify_user(_, _, _)).Times(1).WillOnce(Return(verification_op));
+
+    auto first = std::make_shared<DestructionReportingDevice>(first_destroyed);
+    EXPECT_CALL(*first, verifier()).Times(1).WillOnce(ReturnRef(verifier));
+
+    auto second = std::make_shared<DestructionReportingDevice>(second_destroyed);
+    EXPECT_CALL(*second, identifier()).Times(0);
+
+    auto identification_op = std::make_shared<MockOperation<biometry::Identification>>();
+    EXPECT_CALL(*identification_op, start_with_observer(_)).Times(1);
+
+    MockIdentifier identifier;
+    EXPECT_CALL(identifier, identify_user(_, _)).Times(1).WillOnce(Return(identification_op));
+
+    auto third = std::make_shared<MockDevice>();
+    EXPECT_CALL(*third, identifier()).Times(1).WillOnce(ReturnRef(identifier));
+
+    biometry::devices::Swappable swappable{std::make_shared<ImmediateDispatcher>(), first};
+    first.reset();
+
+    swappable.verifier().verify_user(biometry::Application::system(), biometry::User::current(), biometry::Reason::unknown())
+            ->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Verification>>>());
+
+    swappable.swap(second, [&first_drained]() { first_drained = true; });
+    second.reset();
+
+    swappable.identifier().identify_user(biometry::Application::system(), biometry::Reason::unknown())
+            ->start_with_observer(std::make_shared<NiceMock<MockObserver<biometry::Identification>>>());
+
+    swappable.swap(third, [&second_drained]() { second_drained = true; });
+    EXPECT_TRUE(second_destroyed);
+    EXPECT_TRUE(second_drained);
+    EXPECT_FALSE(first_destroyed);
+    EXPECT_FALSE(first_drained);
+
+    bound->on_succeeded(biometry::Verification::Result{});
+    EXPECT_TRUE(first_destroyed);
+    EXPECT_TRUE(first_drained);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/tracing.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace
+{
+std::size_t count(const std::string& haystack, const std::string& needle)
+{
+    std::size_t result{0};
+    for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1))
+        result++;
+    return result;
+}
+
+std::string dump()
+{
+    std::stringstream ss; biometry::util::tracing::dump(ss);
+    return ss.str();
+}
+}
+
+TEST(Tracing, hands_out_no_span_and_drops_events_if_disabled)
+{
+    biometry::util::tracing::disable();
+
+    auto span = biometry::util::tracing::begin_span("test_tracing_disabled");
+    EXPECT_EQ(biometry::util::tracing::no_span, span.id);
+    biometry::util::tracing::instant(biometry::util::tracing::Span{42, "test_tracing_disabled"}, "test_tracing_disabled");
+
+    EXPECT_EQ(0, count(dump(), "test_tracing_disabled"));
+}
+
+TEST(Tracing, scope_sets_and_restores_current_span)
+{
+    EXPECT_EQ(biometry::util::tracing::no_span, biometry::util::tracing::current().id);
+    {
+        biometry::util::tracing::Scope outer{biometry::util::tracing::Span{1, "outer"}};
+        EXPECT_EQ(1, biometry::util::tracing::current().id);
+        {
+            biometry::util::tracing::Scope inner{biometry::util::tracing::Span{2, "inner"}};
+            EXPECT_EQ(2, biometry::util::tracing::current().id);
+        }
+        EXPECT_EQ(1, biometry::util::tracing::current().id);
+    }
+    EXPECT_EQ(biometry::util::tracing::no_span, biometry::util::tracing::current().id);
+}
+
+TEST(Tracing, span_follows_operation_across_threads)
+{
+    biometry::util::tracing::enable();
+
+    auto span = biometry::util::tracing::begin_span("test_tracing_span");
+    EXPECT_NE(biometry::util::tracing::no_span, span.id);
+
+    std::thread worker{[span]()
+    {
+        biometry::util::tracing::begin(span, "test_tracing_slice");
+        biometry::util::tracing::end(span, "test_tracing_slice");
+    }};
+    worker.join();
+
+    biometry::util::tracing::end_span(span);
+    biometry::util::tracing::disable();
+
+    auto json = dump();
+    auto id = "\"id\":" + std::to_string(span.id) + ",";
+
+    EXPECT_EQ(0, json.find("{\"traceEvents\":["));
+    EXPECT_EQ(1, count(json, "{\"name\":\"test_tracing_span\",\"cat\":\"biometryd\",\"ph\":\"b\"," + id));
+    EXPECT_EQ(1, count(json, "{\"name\":\"test_tracing_span\",\"cat\":\"biometryd\",\"ph\":\"e\"," + id));
+    EXPECT_EQ(1, count(json, "{\"name\":\"test_tracing_slice\",\"cat\":\"biometryd\",\"ph\":\"b\"," + id));
+    EXPECT_EQ(1, count(json, "{\"name\":\"test_tracing_slice\",\"cat\":\"biometryd\",\"ph\":\"e\"," + id));
+}
+
+TEST(Tracing, keeps_most_recent_events_per_thread)
+{
+    static constexpr const std::size_t iterations{10000};
+
+    biometry::util::tracing::enable();
+
+    std::thread worker{[]()
+    {
+        for (std::size_t i = 0; i < iterations; i++)
+            biometry::util::tracing::instant(biometry::util::tracing::Span{1, "test_tracing_wrap"}, "test_tracing_wrap");
+    }};
+    worker.join();
+
+    biometry::util::tracing::disable();
+
+    auto n = count(dump(), "test_tracing_wrap");
+    EXPECT_LT(0, n);
+    EXPECT_GT(iterations, n);
+}
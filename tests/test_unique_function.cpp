@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <biometry/util/unique_function.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+TEST(UniqueFunction, default_constructed_instance_is_empty)
+{
+    biometry::util::UniqueFunction<void()> f;
+    EXPECT_FALSE(f);
+    EXPECT_THROW(f(), std::bad_function_call);
+}
+
+TEST(UniqueFunction, invokes_wrapped_functor_with_arguments)
+{
+    biometry::util::UniqueFunction<int(int, int)> f{[](int a, int b) { return a + b; }};
+    EXPECT_TRUE(f);
+    EXPECT_EQ(42, f(40, 2));
+}
+
+TEST(UniqueFunction, accepts_move_only_functors)
+{
+    std::unique_ptr<int> ptr{new int{42}};
+    biometry::util::UniqueFunction<int()> f{[ptr = std::move(ptr)]() { return *ptr; }};
+    EXPECT_EQ(42, f());
+}
+
+TEST(UniqueFunction, move_transfers_functor_and_leaves_source_empty)
+{
+    auto sp = std::make_shared<int>(42);
+
+    biometry::util::UniqueFunction<int()> f{[sp]() { return *sp; }};
+    biometry::util::UniqueFunction<int()> g{std::move(f)};
+
+    EXPECT_FALSE(f);
+    EXPECT_EQ(42, g());
+    // Moving must neither copy nor leak the captured reference.
+    EXPECT_EQ(2, sp.use_count());
+
+    f = std::move(g);
+    EXPECT_FALSE(g);
+    EXPECT_EQ(42, f());
+    EXPECT_EQ(2, sp.use_count());
+}
+
+TEST(UniqueFunction, releases_functor_on_reset_and_destruction)
+{
+    auto sp = std::make_shared<int>(42);
+
+    {
+        biometry::util::UniqueFunction<void()> f{[sp]() {}};
+        EXPECT_EQ(2, sp.use_count());
+        f = nullptr;
+        EXPECT_EQ(1, sp.use_count());
+    }
+
+    {
+        biometry::util::UniqueFunction<void()> f{[sp]() {}};
+        EXPECT_EQ(2, sp.use_count());
+    }
+
+    EXPECT_EQ(1, sp.use_count());
+}
+
+TEST(UniqueFunction, handles_functors_exceeding_the_inline_buffer)
+{
+    auto sp = std::make_shared<int>(42);
+    std::array<char, 256> payload; payload.fill('a');
+
+    biometry::util::UniqueFunction<char()> f{[sp, payload]() { return payload[255]; }};
+    biometry::util::UniqueFunction<char()> g{std::move(f)};
+
+    EXPECT_EQ('a', g());
+    EXPECT_EQ(2, sp.use_count());
+
+    g = nullptr;
+    EXPECT_EQ(1, sp.use_count());
+}
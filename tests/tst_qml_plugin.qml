@@ -22,10 +22,70 @@ import QtTest 1.0
 import Biometryd 0.0
 
 TestCase {
+    id: testCase
     name: "Biometryd"
 
+    // Signals received by the observers below, in order of arrival.
+    property var events: []
+    // Number of progress updates received by the observers below.
+    property int progressCount: 0
+    // True once an observed operation has been canceled, has failed or has succeeded.
+    property bool operationCompleted: false
+
+    function record(kind, value) {
+        events.push({kind: kind, value: value});
+        if (kind === "progressed")
+            progressCount++;
+        else
+            operationCompleted = true;
+    }
+
+    function progressUpdates() {
+        return events.filter(function(e) { return e.kind === "progressed"; });
+    }
+
+    // verifyCompletedAfterFlush checks that the operation completed with kind,
+    // and that the latest progress update has been delivered right before.
+    function verifyCompletedAfterFlush(kind) {
+        var last = events[events.length - 1];
+        compare(last.kind, kind);
+        compare(events[events.length - 2].kind, "progressed");
+        compare(events.filter(function(e) { return e.kind !== "progressed"; }).length, 1);
+    }
+
+    Observer {
+        id: unthrottledObserver
+        maximumProgressRate: 0
+        onProgressed: testCase.record("progressed", {percent: percent, details: details})
+        onCanceled: testCase.record("canceled", reason)
+        onFailed: testCase.record("failed", reason)
+        onSucceeded: testCase.record("succeeded", result)
+    }
+
+    Observer {
+        id: throttledObserver
+        // The testing operations report progress every 15 ms.
+        maximumProgressRate: 10
+        onProgressed: testCase.record("progressed", {percent: percent, details: details})
+        onCanceled: testCase.record("canceled", reason)
+        onFailed: testCase.record("failed", reason)
+        onSucceeded: testCase.record("succeeded", result)
+    }
+
+    Observer {
+        id: slowObserver
+        // Keeps progress updates pending for long enough to observe them being flushed.
+        maximumProgressRate: 1
+        onProgressed: testCase.record("progressed", {percent: percent, details: details})
+        onCanceled: testCase.record("canceled", reason)
+        onFailed: testCase.record("failed", reason)
+        onSucceeded: testCase.record("succeeded", result)
+    }
+
     Observer {
         id: observer
+        // Coalesce progress updates to at most 30 per second.
+        maximumProgressRate: 30
         onStarted: {
             console.log("started")
         }
@@ -68,6 +128,17 @@ TestCase {
         signalName: "succeeded"
     }
 
+    function initTestCase() {
+        // The default device is discovered asynchronously.
+        tryCompare(Biometryd, "ready", true, 5000);
+    }
+
+    function init() {
+        events = [];
+        progressCount = 0;
+        operationCompleted = false;
+    }
+
     function test_defaultDeviceIsAvailable() {
         console.log("Biometryd.available:", Biometryd.available);
 
@@ -112,4 +183,93 @@ TestCase {
         var op = identifier.identifyUser(); op.start(observer);
         spy.wait(5000);
     }
+
+    function test_progressIsNotThrottledWithoutMaximumRate() {
+        var op = Biometryd.defaultDevice.templateStore.size(user); op.start(unthrottledObserver);
+        tryCompare(testCase, "operationCompleted", true, 10000);
+
+        // Every single update reported by the operation makes it through.
+        compare(progressUpdates().length, 100);
+        compare(events[events.length - 1].kind, "succeeded");
+    }
+
+    function test_progressIsCoalescedWithinRateWindow() {
+        var started = Date.now();
+        var op = Biometryd.defaultDevice.templateStore.size(user); op.start(throttledObserver);
+        tryCompare(testCase, "operationCompleted", true, 10000);
+        var elapsed = Date.now() - started;
+
+        var updates = progressUpdates();
+        verify(updates.length > 1);
+        verify(updates.length < 100);
+        // At most one update per window of 100 ms, plus the leading and the flushed one.
+        verify(updates.length <= Math.ceil(elapsed / 100) + 2);
+
+        // The latest update within a window wins, older ones are dropped.
+        for (var i = 1; i < updates.length; i++)
+            verify(updates[i].value.percent > updates[i - 1].value.percent);
+        fuzzyCompare(updates[updates.length - 1].value.percent, 1.0, 0.001);
+    }
+
+    function test_pendingProgressIsFlushedBeforeSucceeded() {
+        var op = Biometryd.defaultDevice.templateStore.size(user); op.start(slowObserver);
+        tryCompare(testCase, "operationCompleted", true, 10000);
+
+        verifyCompletedAfterFlush("succeeded");
+        fuzzyCompare(events[events.length - 2].value.percent, 1.0, 0.001);
+    }
+
+    function test_pendingProgressIsFlushedBeforeCanceled() {
+        var op = Biometryd.defaultDevice.templateStore.size(user); op.start(slowObserver);
+        // The first update is delivered right away, later ones are held back for a second.
+        tryCompare(testCase, "progressCount", 1, 5000);
+        wait(300);
+        op.cancel();
+        tryCompare(testCase, "operationCompleted", true, 10000);
+
+        verifyCompletedAfterFlush("canceled");
+        compare(progressUpdates().length, 2);
+        verify(events[events.length - 2].value.percent > events[0].value.percent);
+    }
+
+    function test_pendingProgressIsFlushedBeforeFailed() {
+        // Removing this dedicated template fails after reporting half of the progress.
+        var op = Biometryd.defaultDevice.templateStore.remove(user, 4294967296); op.start(slowObserver);
+        tryCompare(testCase, "operationCompleted", true, 10000);
+
+        verifyCompletedAfterFlush("failed");
+        fuzzyCompare(events[events.length - 2].value.percent, 0.5, 0.001);
+    }
+
+    function test_progressDetailsCarryGuidedEnrollmentHints() {
+        var op = Biometryd.defaultDevice.templateStore.enroll(user); op.start(unthrottledObserver);
+        tryCompare(testCase, "operationCompleted", true, 10000);
+
+        var updates = progressUpdates();
+        compare(updates.length, 100);
+
+        var first = updates[0].value.details;
+        compare(first[FingerprintReader.isFingerPresent], true);
+        compare(first[FingerprintReader.hasMainClusterIdentified], false);
+        verify(first[FingerprintReader.suggestedNextDirection] !== undefined);
+
+        var masks = first[FingerprintReader.masks];
+        compare(masks.length, 2);
+        fuzzyCompare(masks[0].x, 0.1, 0.001);
+        fuzzyCompare(masks[0].y, 0.1, 0.001);
+        fuzzyCompare(masks[0].width, 0.4, 0.001);
+        fuzzyCompare(masks[0].height, 0.4, 0.001);
+        fuzzyCompare(masks[1].x, 0.5, 0.001);
+        fuzzyCompare(masks[1].width, 0.4, 0.001);
+
+        compare(updates[updates.length - 1].value.details[FingerprintReader.hasMainClusterIdentified], true);
+    }
+
+    function test_progressDetailsAreEmptyWithoutHints() {
+        var op = Biometryd.defaultDevice.templateStore.size(user); op.start(unthrottledObserver);
+        tryCompare(testCase, "operationCompleted", true, 10000);
+
+        var details = progressUpdates()[0].value.details;
+        compare(Object.keys(details).length, 0);
+    }
 }